@@ -0,0 +1,126 @@
+/**
+ * @file boot.h
+ * @brief Background sensor power-up and init sequencer
+ *
+ * main() brings up UART and the protocol first, so PING is answered
+ * right away, and then hands the sensors to this sequencer. It switches
+ * the 12V rail and runs the VL53L0X (I2C1) and MLX90640 (I2C4) bring-up
+ * as small state machines from the main loop. Delays come from datasheet
+ * minima or from polling the sensor instead of fixed waits, and the
+ * MLX90640 EEPROM dump runs on the I2C4 interrupt while the VL53L0X is
+ * initialised on I2C1. Each phase's completion time is recorded for
+ * CMD_BOOT_INFO.
+ *
+ * CMD_DUT_POWER_CYCLE reruns the sequence for a newly fitted DUT without
+ * resetting the MCU.
+ */
+
+#ifndef BOOT_H
+#define BOOT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define BOOT_INFO_SIZE          16      /* Serialized info bytes */
+#define BOOT_PHASE_NONE         0xFFFF  /* Phase not reached */
+
+/* Info flags */
+#define BOOT_FLAG_WARM_RESET    0x01    /* Reset without power loss: rail was discharged */
+#define BOOT_FLAG_VL53L0X_OK    0x02    /* VL53L0X init succeeded */
+#define BOOT_FLAG_MLX90640_OK   0x04    /* MLX90640 init succeeded */
+#define BOOT_FLAG_DUT_CYCLE     0x08    /* Started by Boot_PowerCycle: times are from the command */
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Boot phases, in the order they are usually reached
+ */
+typedef enum {
+    BOOT_PHASE_PROTOCOL     = 0,    /* UART and protocol up: PING answered (0 after a DUT cycle) */
+    BOOT_PHASE_RAIL_ON,             /* 12V switched on (after discharge on a warm reset) */
+    BOOT_PHASE_VL53L0X,             /* VL53L0X init finished */
+    BOOT_PHASE_MLX_ACK,             /* MLX90640 answers on I2C4 */
+    BOOT_PHASE_MLX_EEPROM,          /* MLX90640 EEPROM dump finished */
+    BOOT_PHASE_MLX90640,            /* MLX90640 parameters extracted */
+    BOOT_PHASE_READY,               /* All sensors done: sensor commands accepted */
+    BOOT_PHASE_COUNT
+} BootPhase_t;
+
+/**
+ * @brief Boot state
+ */
+typedef struct {
+    bool        ready;                          /* BOOT_PHASE_READY reached */
+    uint8_t     flags;                          /* BOOT_FLAG_* */
+    uint16_t    phase_ms[BOOT_PHASE_COUNT];     /* ms after HAL_Init or the DUT cycle (BOOT_PHASE_NONE = not reached) */
+} BootInfo_t;
+
+/*============================================================================*/
+/* Functions                                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Start the sequencer (call once the protocol is running)
+ *
+ * Reads and clears the RCC reset flags: after a power-on or brown-out
+ * reset the sensors are already unpowered, so the rail discharge wait is
+ * skipped.
+ */
+void Boot_Start(void);
+
+/**
+ * @brief Power-cycle the DUT and initialize it again in the background
+ *
+ * Marks every sensor driver uninitialized, switches XSHUT and the 12V
+ * rail off for off_ms, then runs the boot sequence again. Sensor
+ * commands are refused until Boot_IsComplete().
+ *
+ * @param off_ms Time the rail stays off (at least BOOT_RAIL_DISCHARGE_MS)
+ * @return false if a boot or power cycle is still running
+ */
+bool Boot_PowerCycle(uint32_t off_ms);
+
+/**
+ * @brief Advance the sequencer (call from the main loop)
+ *
+ * Never waits except for the VL53L0X driver init, which is blocking.
+ *
+ * @return true on the call that completed the boot
+ */
+bool Boot_Process(void);
+
+/**
+ * @brief Check whether all sensors have finished their init (pass or fail)
+ */
+bool Boot_IsComplete(void);
+
+/**
+ * @brief Get boot state
+ * @param info State (output)
+ */
+void Boot_GetInfo(BootInfo_t* info);
+
+/**
+ * @brief Serialize boot state to big-endian bytes
+ * @param info State
+ * @param buffer Output buffer (BOOT_INFO_SIZE bytes)
+ * @return Number of bytes written
+ */
+uint8_t Boot_SerializeInfo(const BootInfo_t* info, uint8_t* buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BOOT_H */
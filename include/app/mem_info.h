@@ -0,0 +1,84 @@
+/**
+ * @file mem_info.h
+ * @brief RAM budget and stack high-water-mark reporting
+ *
+ * DTCM holds .data, .bss, the newlib heap (growing up from _end) and the
+ * MSP stack (growing down from _estack). main() paints the free space
+ * between them with a known pattern before anything else runs; the
+ * deepest stack use since boot is found on demand by scanning for the
+ * first overwritten word. Section and region sizes come from linker
+ * symbols, the heap from the _sbrk break. CMD_MEM_INFO reports it all;
+ * tools/mem_report.py gives the matching build-time view.
+ */
+
+#ifndef MEM_INFO_H
+#define MEM_INFO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "config.h"
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define MEM_INFO_SIZE           56      /* Serialized info bytes (14 x uint32) */
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Memory usage in bytes
+ */
+typedef struct {
+    uint32_t    dtcm_size;      /* DTCM region (data, bss, heap, stack) */
+    uint32_t    data;           /* .data */
+    uint32_t    bss;            /* .bss */
+    uint32_t    heap_used;      /* _sbrk break above _end */
+    uint32_t    stack_reserved; /* _Min_Stack_Size checked by the linker */
+    uint32_t    stack_peak;     /* Deepest stack use since boot (watermark) */
+    uint32_t    stack_now;      /* Stack in use by the caller */
+    uint32_t    stack_free;     /* Never touched: heap break to the watermark */
+    uint32_t    axi_used;       /* AXI SRAM (.axi_sram, flight recorder) */
+    uint32_t    axi_size;
+    uint32_t    d3_used;        /* D3 SRAM (.my_nocache_d3, BDMA buffers) */
+    uint32_t    d3_size;
+    uint32_t    flash_used;     /* Code, constants and the .data image */
+    uint32_t    flash_size;     /* Application flash (journal and golden sectors excluded) */
+} MemInfo_t;
+
+/*============================================================================*/
+/* Functions                                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Paint the unused stack with the watermark pattern
+ *
+ * Call first thing in main(): everything from the heap break up to a
+ * small margin below the current stack pointer is overwritten.
+ */
+void MemInfo_PaintStack(void);
+
+/**
+ * @brief Measure memory usage (scans the stack paint)
+ * @param info Usage (output)
+ */
+void MemInfo_GetInfo(MemInfo_t* info);
+
+/**
+ * @brief Serialize memory usage to big-endian bytes
+ * @param info Usage
+ * @param buffer Output buffer (MEM_INFO_SIZE bytes)
+ * @return Number of bytes written
+ */
+uint8_t MemInfo_Serialize(const MemInfo_t* info, uint8_t* buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEM_INFO_H */
@@ -62,7 +62,11 @@ typedef enum {
 #define PROTOCOL_STX                0x02
 #define PROTOCOL_ETX                0x03
 #define PROTOCOL_MAX_PAYLOAD        64
-#define PROTOCOL_RX_BUFFER_SIZE     128
+#define PROTOCOL_RX_BUFFER_SIZE     128     /* Per transport */
+#define PROTOCOL_MAX_TRANSPORTS     4       /* UART4, RTT and future links */
+#define PROTOCOL_RTT_CHANNEL        1       /* RTT buffer index (0 stays the debug terminal) */
+#define PROTOCOL_RTT_UP_SIZE        1024    /* Target -> host frames */
+#define PROTOCOL_RTT_DOWN_SIZE      256     /* Host -> target frames */
 
 /*============================================================================*/
 /* Sensor Manager Settings                                                    */
@@ -77,6 +81,15 @@ typedef enum {
 #define UART_RX_BUFFER_SIZE         256
 #define UART_TX_BUFFER_SIZE         256
 
+/*============================================================================*/
+/* CRC Configuration                                                          */
+/*============================================================================*/
+
+#ifndef CRC_HW_ENABLED
+#define CRC_HW_ENABLED              1       /* 0: software tables only (host builds) */
+#endif
+#define CRC_HW_MIN_LEN              32      /* Shorter buffers are faster through the tables */
+
 /*============================================================================*/
 /* Debug Configuration                                                        */
 /*============================================================================*/
@@ -90,6 +103,17 @@ typedef enum {
 #define WATCHDOG_ENABLED            0   /* Disabled for development/debugging */
 #define WATCHDOG_TIMEOUT_MS         10000 /* Approximate timeout in milliseconds (10 seconds) */
 
+/*============================================================================*/
+/* Boot Sequencer Configuration                                               */
+/*============================================================================*/
+
+#define BOOT_RAIL_DISCHARGE_MS      1000    /* 12V held off after a warm reset (board RC, skipped at power-on) */
+#define BOOT_RAIL_SETTLE_MS         10      /* 12V regulator soft-start before touching the sensors */
+#define BOOT_VL53L0X_BOOT_MS        2       /* XSHUT high to firmware booted (tBOOT 1.2ms max) */
+#define BOOT_MLX90640_ACK_MS        100     /* Give up if the MLX90640 does not ACK by then */
+#define BOOT_MLX90640_EEPROM_MS     250     /* Give up if the EEPROM dump (~45ms at 400kHz) stalls */
+#define BOOT_I2C_ABORT_MS           5       /* Wait for the STOP of an aborted dump before resetting I2C4 */
+
 /*============================================================================*/
 /* VL53L0X Configuration                                                      */
 /*============================================================================*/
@@ -106,9 +130,66 @@ typedef enum {
 #define MLX90640_REFRESH_RATE       4       /* 0=0.5Hz, 1=1Hz, 2=2Hz, 3=4Hz, 4=8Hz, 5=16Hz, 6=32Hz, 7=64Hz */
 #define MLX90640_RESOLUTION         19      /* ADC resolution: 16, 17, 18, or 19 bits */
 #define MLX90640_EMISSIVITY         0.95f   /* Default emissivity */
+#define MLX90640_TR_OFFSET          8.0f    /* Reflected temperature = Ta - offset (°C) */
 #define MLX90640_DISCARD_READINGS   1       /* Initial readings to discard (reduced for faster response) */
 #define MLX90640_VALID_READINGS     1       /* Number of valid readings (reduced for faster response) */
 #define MLX90640_FRAME_INTERVAL_MS  65      /* Frame interval at 8Hz (125ms/2 for subpage) */
+#ifndef MLX90640_RAW_FAST_PATH
+#define MLX90640_RAW_FAST_PATH      0       /* 1: single-pixel specs compute only their pixel (min/max not measured) */
+#endif
+#define MLX90640_INSTANCES          1       /* Sensor arena budget (MLX90640_INSTANCE_BYTES each) */
+#ifndef MLX90640_PACKED_CALIBRATION
+#define MLX90640_PACKED_CALIBRATION 0       /* 1: per-pixel calibration in EEPROM form, decoded per frame (~2.7KB less per sensor) */
+#endif
+
+/* Sensor arena bytes per instance and for the shared scratch (mlx90640.c asserts the driver types fit) */
+#if MLX90640_PACKED_CALIBRATION
+#define MLX90640_INSTANCE_BYTES     5312
+#else
+#define MLX90640_INSTANCE_BYTES     8024
+#endif
+#define MLX90640_SCRATCH_BYTES      3208    /* Raw subpage plus one subpage of pixel values */
+
+/*============================================================================*/
+/* Thermal Analytics Configuration                                            */
+/*============================================================================*/
+
+#define THERMAL_BLOB_MAX_REPORT     5       /* Blobs returned per response (5 x 12B fits payload) */
+#define THERMAL_HIST_BINS           16      /* Histogram bins over [min, max] */
+#define THERMAL_STATS_P_LOW         5       /* Lower percentile / trimmed-mean cut */
+#define THERMAL_STATS_P_HIGH        95      /* Upper percentile / trimmed-mean cut */
+#define THERMAL_ZONE_MAX            8       /* Multi-ROI spec zones */
+#define THERMAL_NOISE_MAX_FRAMES    32      /* Frames per noise measurement (~8s at 8Hz, one blocking command) */
+#define THERMAL_NOISE_WORST         5       /* Noisiest pixels reported */
+#define THERMAL_NOISE_HIST_BINS     16      /* Sigma histogram bins */
+#define THERMAL_NOISE_BIN_MK        25      /* Sigma histogram bin width in mK */
+#define THERMAL_FILTER_MAX_WINDOW   8       /* Moving-window filter length (16-bit history per frame) */
+
+/* Off until a trained model is exported (tools/thermal_classifier/export_model.py) */
+#ifndef THERMAL_CLASSIFIER_ENABLED
+#define THERMAL_CLASSIFIER_ENABLED  0       /* CMSIS-NN defect class in the MLX90640 result (~4.5KB flash, ~3KB RAM) */
+#endif
+
+/* Golden reference image (last 128KB flash sector, excluded from the linker script) */
+#define GOLDEN_FLASH_ADDR           0x080E0000UL
+#define GOLDEN_FLASH_SECTOR         7
+#define GOLDEN_MAX_FRAMES           16      /* Frames averaged per capture */
+#define GOLDEN_DEFAULT_TOLERANCE    20      /* Per-pixel tolerance in 0.1°C units */
+
+/* Raw subpage flight recorder (NOLOAD section in RAM_D1, 1680 bytes per slot) */
+#define THERMAL_RECORDER_SLOTS      128     /* ~210KB of the 320KB AXI SRAM */
+
+/*============================================================================*/
+/* Test Journal Configuration                                                 */
+/*============================================================================*/
+
+#define TEST_JOURNAL_ENTRIES        64      /* RAM ring of finished reports (64 bytes each) */
+#define TEST_JOURNAL_FLASH_SPILL    1       /* Also append every entry to flash (survives reset) */
+
+/* Journal flash copy (two 128KB sectors below the golden image, excluded from the linker script) */
+#define TEST_JOURNAL_FLASH_ADDR     0x080A0000UL
+#define TEST_JOURNAL_FLASH_SECTOR   5       /* First of sectors 5 and 6 */
+#define TEST_JOURNAL_ERASE_AHEAD    256     /* Free slots left when the main loop erases the other sector */
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,105 @@
+/**
+ * @file crc_handler.h
+ * @brief CRC service shared by the protocol and flash storage
+ *
+ * Each CrcID_t names one CRC algorithm (width, polynomial, init, reflection,
+ * final XOR). Buffers of CRC_HW_MIN_LEN bytes or more go through the
+ * STM32H7 CRC peripheral, shorter ones through slice-by-4 tables. Both
+ * backends give bit-identical results, so a running CRC may pass through
+ * either; CRC_Handler_Init checks this before enabling the peripheral.
+ *
+ * With CRC_HW_ENABLED 0 only the tables are built and no HAL header is
+ * needed.
+ */
+
+#ifndef CRC_HANDLER_H
+#define CRC_HANDLER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief CRC algorithms in use
+ */
+typedef enum {
+    CRC_ID_FRAME    = 0,    /* CRC-8 poly 0x07 (protocol frames) */
+    CRC_ID_STORAGE,         /* CRC-32 poly 0x04C11DB7 reflected (flash records) */
+    CRC_ID_COUNT
+} CrcID_t;
+
+/**
+ * @brief Backend chosen by CRC_Handler_Init
+ */
+typedef enum {
+    CRC_BACKEND_SOFTWARE    = 0,    /* Tables only (CRC_HW_ENABLED 0 or self-check failed) */
+    CRC_BACKEND_HARDWARE    = 1,    /* Peripheral for buffers >= CRC_HW_MIN_LEN */
+} CrcBackend_t;
+
+/*============================================================================*/
+/* Functions                                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Build the tables and set up the CRC peripheral
+ *
+ * Every algorithm is checked against its catalogue check value, and the
+ * peripheral against the check values and the tables; on any mismatch
+ * the tables are used for everything.
+ *
+ * @return Backend in use
+ */
+CrcBackend_t CRC_Handler_Init(void);
+
+/**
+ * @brief Calculate a complete CRC (init, data, final XOR)
+ * @param id Algorithm
+ * @param data Data (any alignment)
+ * @param len Data length in bytes
+ * @return CRC value (width bits)
+ */
+uint32_t CRC_Handler_Calculate(CrcID_t id, const void* data, uint32_t len);
+
+/**
+ * @brief Start a CRC over several buffers
+ * @param id Algorithm
+ * @return Running CRC to pass to CRC_Handler_Update
+ */
+uint32_t CRC_Handler_Start(CrcID_t id);
+
+/**
+ * @brief Add data to a running CRC
+ * @param id Algorithm
+ * @param crc Running CRC from CRC_Handler_Start or a previous update
+ * @param data Data (any alignment)
+ * @param len Data length in bytes
+ * @return Updated running CRC
+ */
+uint32_t CRC_Handler_Update(CrcID_t id, uint32_t crc, const void* data, uint32_t len);
+
+/**
+ * @brief Finish a running CRC (final XOR)
+ * @param id Algorithm
+ * @param crc Running CRC
+ * @return CRC value (width bits)
+ */
+uint32_t CRC_Handler_Finish(CrcID_t id, uint32_t crc);
+
+/**
+ * @brief Get the backend chosen by CRC_Handler_Init
+ */
+CrcBackend_t CRC_Handler_GetBackend(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRC_HANDLER_H */
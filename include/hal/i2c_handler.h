@@ -99,6 +99,47 @@ HAL_StatusTypeDef I2C_Handler_Write8(I2C_BusID_t bus_id, uint8_t dev_addr,
                                       uint8_t reg_addr, const uint8_t* data,
                                       uint16_t len, uint32_t timeout_ms);
 
+/**
+ * @brief Start an interrupt-driven read from a 16-bit register address
+ *
+ * Returns immediately; poll I2C_Handler_AsyncStatus() for completion.
+ * Only one transfer per bus, and the bus must not be used for blocking
+ * transfers until it completes. Needs the bus event/error IRQs enabled
+ * (I2C4 only).
+ *
+ * @param bus_id Bus identifier
+ * @param dev_addr 7-bit device address
+ * @param reg_addr 16-bit register address
+ * @param data Buffer to store read data (must stay valid until completion)
+ * @param len Number of bytes to read
+ * @return HAL_OK if the transfer started
+ */
+HAL_StatusTypeDef I2C_Handler_Read16Async(I2C_BusID_t bus_id, uint8_t dev_addr,
+                                           uint16_t reg_addr, uint8_t* data,
+                                           uint16_t len);
+
+/**
+ * @brief Get the state of the last interrupt-driven transfer on a bus
+ * @param bus_id Bus identifier
+ * @return HAL_BUSY while running, HAL_OK when complete, HAL_ERROR on failure
+ */
+HAL_StatusTypeDef I2C_Handler_AsyncStatus(I2C_BusID_t bus_id);
+
+/**
+ * @brief Abort the interrupt-driven transfer on a bus
+ *
+ * Requests a STOP (HAL_I2C_Master_Abort_IT) and waits up to timeout_ms
+ * for it. If the HAL refuses the abort or the bus never releases (device
+ * holding SCL/SDA), the peripheral is reset with its interrupts masked.
+ * Either way no late completion can write into the transfer buffer, the
+ * async status reads HAL_ERROR and the bus accepts new transfers.
+ *
+ * @param bus_id Bus identifier
+ * @param timeout_ms Time to wait for the STOP
+ * @return HAL_OK if the transfer stopped, HAL_TIMEOUT if the peripheral was reset
+ */
+HAL_StatusTypeDef I2C_Handler_AbortAsync(I2C_BusID_t bus_id, uint32_t timeout_ms);
+
 /**
  * @brief Get the HAL I2C handle for a bus
  * @param bus_id Bus identifier
@@ -17,6 +17,15 @@ extern "C" {
 #include <stdbool.h>
 #include "protocol/protocol.h"
 
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+/* Largest encoded frame in either framing mode (classic: STX+LEN+CMD+CRC+ETX,
+ * COBS: code byte + LEN+CMD+CRC + delimiter) */
+#define FRAME_MAX_SIZE          (PROTOCOL_MAX_PAYLOAD + 5)
+#define FRAME_COBS_DELIMITER    0x00
+
 /*============================================================================*/
 /* Types                                                                      */
 /*============================================================================*/
@@ -40,6 +49,19 @@ typedef enum {
     FRAME_PARSE_FORMAT_ERR  = 3,    /* Frame format error */
 } FrameParseResult_t;
 
+/**
+ * @brief Framing of a transport
+ *
+ * Both modes carry the same [LEN][CMD][PAYLOAD][CRC] block. COBS removes
+ * every zero byte from it, so 0x00 can only be a frame delimiter and the
+ * parser resynchronizes at the next delimiter after any corruption.
+ */
+typedef enum {
+    FRAME_MODE_CLASSIC      = 0,    /* [STX][LEN][CMD][PAYLOAD][CRC][ETX] */
+    FRAME_MODE_COBS         = 1,    /* COBS([LEN][CMD][PAYLOAD][CRC]) 0x00 */
+    FRAME_MODE_COUNT
+} FrameMode_t;
+
 /*============================================================================*/
 /* Functions                                                                  */
 /*============================================================================*/
@@ -64,7 +86,31 @@ FrameParseResult_t Frame_Parse(const uint8_t* buffer, uint16_t len,
 uint16_t Frame_Build(const Frame_t* frame, uint8_t* buffer);
 
 /**
- * @brief Calculate CRC (XOR checksum)
+ * @brief Parse a COBS frame from byte buffer
+ *
+ * Consumes everything up to and including the first delimiter. A run of
+ * more than FRAME_MAX_SIZE bytes without one is discarded as a format
+ * error, so garbage never stalls the buffer.
+ *
+ * @param buffer Input byte buffer
+ * @param len Buffer length
+ * @param frame Output frame structure
+ * @param consumed Number of bytes consumed (output)
+ * @return Parse result status
+ */
+FrameParseResult_t Frame_ParseCOBS(const uint8_t* buffer, uint16_t len,
+                                    Frame_t* frame, uint16_t* consumed);
+
+/**
+ * @brief Build a COBS frame (including the trailing delimiter) into byte buffer
+ * @param frame Input frame structure
+ * @param buffer Output byte buffer (must be at least FRAME_MAX_SIZE bytes)
+ * @return Number of bytes written
+ */
+uint16_t Frame_BuildCOBS(const Frame_t* frame, uint8_t* buffer);
+
+/**
+ * @brief Calculate frame CRC (CRC-8, polynomial 0x07)
  * @param data Data buffer
  * @param len Data length
  * @return CRC value
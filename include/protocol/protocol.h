@@ -12,6 +12,9 @@
  *   - PAYLOAD: Command-specific data
  *   - CRC: XOR checksum of LEN+CMD+PAYLOAD
  *   - ETX: 0x03 (End of frame)
+ *
+ * CMD_SET_FRAMING switches a link to COBS framing, which carries the
+ * same LEN..CRC block COBS-encoded and terminated by 0x00 (see frame.h).
  */
 
 #ifndef PROTOCOL_H
@@ -24,6 +27,7 @@ extern "C" {
 #include <stdint.h>
 #include <stdbool.h>
 #include "config.h"
+#include "protocol/transport.h"
 
 /*============================================================================*/
 /* Command Codes                                                              */
@@ -38,6 +42,25 @@ typedef enum {
     CMD_READ_SENSOR         = 0x13,     /* Read sensor raw data (no spec comparison) */
     CMD_SET_SPEC            = 0x20,     /* Set sensor specification */
     CMD_GET_SPEC            = 0x21,     /* Get sensor specification */
+    CMD_THERMAL_BLOBS       = 0x30,     /* MLX90640 hotspot/blob analysis */
+    CMD_THERMAL_STATS       = 0x31,     /* MLX90640 percentile/histogram statistics */
+    CMD_SET_ZONES           = 0x32,     /* Set MLX90640 multi-ROI zone specs */
+    CMD_TEST_ZONES          = 0x33,     /* Evaluate all zones on one frame */
+    CMD_GOLDEN_CAPTURE      = 0x34,     /* Capture golden frame (frames=0: query) */
+    CMD_GOLDEN_TOLERANCE    = 0x35,     /* Write part of the golden tolerance map */
+    CMD_GOLDEN_SAVE         = 0x36,     /* Store golden image to flash */
+    CMD_GOLDEN_COMPARE      = 0x37,     /* Compare one frame against golden */
+    CMD_THERMAL_NOISE       = 0x38,     /* MLX90640 per-pixel temporal noise (NETD) */
+    CMD_THERMAL_FILTER      = 0x39,     /* Configure/query MLX90640 temporal filter */
+    CMD_THERMAL_ACQ_MODE    = 0x3A,     /* Set/query MLX90640 test acquisition mode */
+    CMD_RECORDER_INFO       = 0x3B,     /* Query (or clear) the raw frame flight recorder */
+    CMD_RECORDER_READ       = 0x3C,     /* Read one chunk of a recorded subpage */
+    CMD_JOURNAL_INFO        = 0x3D,     /* Query (or clear) the test result journal */
+    CMD_JOURNAL_READ        = 0x3E,     /* Read journal entries from a sequence number */
+    CMD_BOOT_INFO           = 0x3F,     /* Query boot progress and per-phase timings */
+    CMD_DUT_POWER_CYCLE     = 0x40,     /* Power-cycle the DUT and re-initialize its sensors */
+    CMD_SET_FRAMING         = 0x41,     /* Switch this link to classic or COBS framing (empty: query) */
+    CMD_MEM_INFO            = 0x42,     /* Query RAM/flash usage and the stack watermark */
 
     /* MCU → Host (Response) */
     CMD_PONG                = 0x01,     /* Ping response (same as PING) */
@@ -46,6 +69,22 @@ typedef enum {
     CMD_SPEC_ACK            = 0x82,     /* Specification set acknowledgement */
     CMD_SPEC_DATA           = 0x83,     /* Specification data response */
     CMD_SENSOR_DATA         = 0x84,     /* Raw sensor data response */
+    CMD_BLOB_DATA           = 0x85,     /* Blob analysis response */
+    CMD_STATS_DATA          = 0x86,     /* Thermal statistics response */
+    CMD_ZONE_ACK            = 0x87,     /* Zone specs set acknowledgement */
+    CMD_ZONE_RESULT         = 0x88,     /* Per-zone verdicts response */
+    CMD_GOLDEN_INFO         = 0x89,     /* Golden image state response */
+    CMD_GOLDEN_RESULT       = 0x8A,     /* Golden comparison response */
+    CMD_NOISE_DATA          = 0x8B,     /* Temporal noise report response */
+    CMD_FILTER_INFO         = 0x8C,     /* Temporal filter state response */
+    CMD_ACQ_MODE            = 0x8D,     /* Test acquisition mode response */
+    CMD_RECORDER_STATE      = 0x8E,     /* Flight recorder state response */
+    CMD_RECORDER_DATA       = 0x8F,     /* Flight recorder chunk response */
+    CMD_JOURNAL_STATE       = 0x90,     /* Test journal state response */
+    CMD_JOURNAL_DATA        = 0x91,     /* Test journal entries response */
+    CMD_BOOT_TIMING         = 0x92,     /* Boot state response */
+    CMD_FRAMING             = 0x93,     /* Framing mode response (sent in the old mode) */
+    CMD_MEM_USAGE           = 0x94,     /* Memory usage response */
     CMD_NAK                 = 0xFE,     /* Negative acknowledgement (error) */
 } CommandCode_t;
 
@@ -58,9 +97,11 @@ typedef enum {
     ERR_UNKNOWN_CMD         = 0x01,     /* Unknown command code */
     ERR_INVALID_SENSOR_ID   = 0x02,     /* Invalid sensor ID */
     ERR_INVALID_PAYLOAD     = 0x03,     /* Invalid payload format/length */
-    ERR_BUSY                = 0x04,     /* System busy (test in progress) */
+    ERR_BUSY                = 0x04,     /* System busy (test or sensor boot in progress) */
     ERR_CRC_FAIL            = 0x05,     /* CRC verification failed */
     ERR_NO_SPEC             = 0x06,     /* Specification not set */
+    ERR_FLASH               = 0x07,     /* Flash erase/program failed */
+    ERR_NO_RECORD           = 0x08,     /* Recorded frame overwritten or never written */
 } ErrorCode_t;
 
 /*============================================================================*/
@@ -70,15 +111,28 @@ typedef enum {
 /**
  * @brief Initialize protocol module
  * 
- * Initializes protocol internals and starts UART reception.
+ * Initializes protocol internals and registers the UART4 and RTT
+ * transports. UART_Handler_Init must have been called.
  */
 void Protocol_Init(void);
 
+/**
+ * @brief Register an additional transport
+ *
+ * The transport gets its own parser state and framing mode (classic
+ * until the host switches it with CMD_SET_FRAMING); responses are sent
+ * back on it.
+ *
+ * @param transport Transport (must stay valid; read and write required)
+ * @return false if invalid or PROTOCOL_MAX_TRANSPORTS are registered
+ */
+bool Protocol_AddTransport(const Transport_t* transport);
+
 /**
  * @brief Process protocol communications
  * 
- * Call this function from the main loop to process received frames
- * and send responses.
+ * Call this function from the main loop to poll every transport, process
+ * received frames and send responses.
  */
 void Protocol_Process(void);
 
@@ -88,16 +142,6 @@ void Protocol_Process(void);
  */
 bool Protocol_IsBusy(void);
 
-/**
- * @brief Feed data into protocol receive buffer
- *
- * Used to inject data from RTT or other sources into the protocol layer.
- *
- * @param data Pointer to data bytes
- * @param len Number of bytes to feed
- */
-void Protocol_FeedData(const uint8_t* data, uint16_t len);
-
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,50 @@
+/**
+ * @file transport.h
+ * @brief Byte-stream transport interface for the protocol layer
+ *
+ * Each transport (UART4, an RTT buffer pair, ...) is registered with
+ * Protocol_AddTransport and gets its own receive buffer and parser state,
+ * so frames from different hosts never interleave. Responses go back
+ * out on the transport the request came in on.
+ */
+
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/*============================================================================*/
+/* Transport Interface                                                        */
+/*============================================================================*/
+
+/**
+ * @brief Transport structure
+ *
+ * Function pointers can be NULL if not needed (init) or not supported.
+ */
+typedef struct Transport {
+    const char*     name;           /* Human-readable name */
+
+    void        (*init)(void);                                  /* Called once when registered */
+    uint16_t    (*read)(uint8_t* buffer, uint16_t max_len);     /* Bytes received so far (non-blocking) */
+    void        (*write)(const uint8_t* data, uint16_t len);    /* Send one whole frame */
+} Transport_t;
+
+/*============================================================================*/
+/* Built-in Transports                                                        */
+/*============================================================================*/
+
+extern const Transport_t UART_Transport;   /* UART4 via uart_handler */
+extern const Transport_t RTT_Transport;    /* RTT buffer pair PROTOCOL_RTT_CHANNEL */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRANSPORT_H */
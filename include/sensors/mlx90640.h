@@ -16,6 +16,56 @@ extern "C" {
 #endif
 
 #include "sensors/sensor_manager.h"
+#include "MLX90640_API.h"
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define MLX90640_COLS               32
+#define MLX90640_ROWS               24
+#define MLX90640_PIXEL_COUNT        (MLX90640_COLS * MLX90640_ROWS)
+#define MLX90640_EE_WORDS           832     /* EEPROM image */
+#define MLX90640_FRAME_WORDS        834     /* Subpage: RAM 0x0400-0x073F + control + status */
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Test acquisition mode
+ */
+typedef enum {
+    MLX90640_ACQ_FULL       = 0x00,     /* Both subpages for every test frame */
+    MLX90640_ACQ_SUBPAGE    = 0x01,     /* Only the subpage a spec needs, when one suffices */
+} MLX90640_AcqMode_t;
+
+/**
+ * @brief Per-sensor state kept for the sensor's lifetime (sensor arena, persistent)
+ */
+typedef struct {
+    paramsMLX90640          params;                     /* Calibration from the EEPROM */
+    MLX90640_BadPixelFix_t  bad_pixels[MLX90640_MAX_BAD_PIXELS];
+    int                     bad_pixel_count;
+    int                     bad_pixel_mode;             /* Readout mode the table was built for */
+    uint8_t                 bad_pixel_mask[MLX90640_PIXEL_COUNT / 8];
+    float                   temperatures[MLX90640_PIXEL_COUNT];     /* Output frame */
+} MLX90640_Instance_t;
+
+/**
+ * @brief Transient buffers (sensor arena, shared scratch)
+ *
+ * Each member is one lifetime; only one is live at a time, so the EEPROM
+ * image needed until the parameters are extracted is reused as the frame
+ * buffer afterwards.
+ */
+typedef union {
+    uint16_t    ee[MLX90640_EE_WORDS];                  /* Init: EEPROM dump to ExtractParameters */
+    struct {
+        uint16_t    data[MLX90640_FRAME_WORDS];         /* Acquisition: raw subpage */
+        float       subpage_values[MLX90640_PIXEL_COUNT / 2];   /* Acquisition: one subpage's pixels for statistics */
+    } frame;
+} MLX90640_Scratch_t;
 
 /*============================================================================*/
 /* Exported Driver Instance                                                   */
@@ -26,6 +76,98 @@ extern "C" {
  */
 extern const SensorDriver_t MLX90640_Driver;
 
+/*============================================================================*/
+/* Frame Access                                                               */
+/*============================================================================*/
+
+/**
+ * @brief Acquire one complete temperature frame
+ *
+ * Initializes the sensor if needed, discards MLX90640_DISCARD_READINGS
+ * frames and reads both subpages into the temperature buffer.
+ *
+ * @param ta_out Ambient temperature in °C (may be NULL)
+ * @return STATUS_PASS on success, failure status otherwise
+ */
+TestStatus_t MLX90640_AcquireFrame(float* ta_out);
+
+/**
+ * @brief Acquire one complete frame, streaming pixels of the valid frame
+ *
+ * As MLX90640_AcquireFrame, but each pixel of the final (non-discarded)
+ * frame is passed to sink as soon as its temperature is computed. Bad
+ * pixels are passed at the end of their subpage, after correction.
+ *
+ * @param ta_out Ambient temperature in °C (may be NULL)
+ * @param sink Pixel consumer (NULL for none)
+ * @param ctx Context passed to sink
+ * @return STATUS_PASS on success, failure status otherwise
+ */
+TestStatus_t MLX90640_AcquireFrameStream(float* ta_out, MLX90640_PixelSink_t sink, void* ctx);
+
+/**
+ * @brief Acquire consecutive frames, streaming every pixel of each
+ *
+ * Discards MLX90640_DISCARD_READINGS frames once, then reads frames
+ * back to back. The temperature buffer holds the last frame afterwards.
+ *
+ * @param frames Number of frames to stream
+ * @param ta_out Ambient temperature of the last frame in °C (may be NULL)
+ * @param sink Pixel consumer (NULL for none)
+ * @param ctx Context passed to sink
+ * @return STATUS_PASS on success, failure status otherwise
+ */
+TestStatus_t MLX90640_StreamFrames(uint16_t frames, float* ta_out, MLX90640_PixelSink_t sink, void* ctx);
+
+/**
+ * @brief Get the last acquired temperature frame
+ * @return Pointer to MLX90640_PIXEL_COUNT temperatures in °C, row-major
+ */
+const float* MLX90640_GetTemperatures(void);
+
+/**
+ * @brief Select how RunTest acquires frames
+ *
+ * In MLX90640_ACQ_SUBPAGE a spec that one subpage can answer is tested
+ * with the sensor repeating that subpage, so every read is useful and a
+ * test frame takes one subpage period instead of two: a single-pixel spec
+ * reads the pixel's subpage, and mean/percentile/trimmed-mean specs are
+ * evaluated on subpage 0 (half the pixels, evenly spread). Min/max specs,
+ * the legacy frame max and runs with the temporal filter on always read
+ * both subpages.
+ *
+ * @param mode MLX90640_AcqMode_t
+ * @return true if mode is valid
+ */
+bool MLX90640_SetAcqMode(uint8_t mode);
+
+/**
+ * @brief Get the test acquisition mode
+ * @return MLX90640_AcqMode_t
+ */
+uint8_t MLX90640_GetAcqMode(void);
+
+/**
+ * @brief Start a non-blocking init (boot sequencer)
+ *
+ * Sets refresh rate and resolution, then starts the EEPROM dump on the
+ * I2C4 interrupt so another bus can work meanwhile. Nothing else may use
+ * I2C4 until MLX90640_PollInit stops returning HAL_BUSY. The dump lands in
+ * the sensor arena scratch, which stays claimed until PollInit returns
+ * anything but HAL_BUSY (call it after a failed dump too). To give up on
+ * a stalled dump, stop it with I2C_Handler_AbortAsync first, then call
+ * PollInit to release the scratch.
+ *
+ * @return HAL_OK if the dump started (or the sensor is already initialized)
+ */
+HAL_StatusTypeDef MLX90640_StartInit(void);
+
+/**
+ * @brief Finish a non-blocking init once the EEPROM dump is done
+ * @return HAL_BUSY while dumping, then HAL_OK or HAL_ERROR
+ */
+HAL_StatusTypeDef MLX90640_PollInit(void);
+
 #ifdef __cplusplus
 }
 #endif
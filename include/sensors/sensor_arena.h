@@ -0,0 +1,92 @@
+/**
+ * @file sensor_arena.h
+ * @brief Sensor buffer arena: persistent per-instance state and shared scratch
+ *
+ * Sensor drivers take two kinds of RAM from one statically sized arena:
+ *   - Persistent: allocated once per sensor instance (calibration, output
+ *     frame) and never freed.
+ *   - Scratch: one region, sized for the largest transient user, that a
+ *     driver claims for the duration of one operation (EEPROM image during
+ *     init, raw subpage during an acquisition) and releases afterwards.
+ *     Every instance shares it, so an extra sensor costs only its
+ *     persistent state. Claims are owned: a second owner is refused until
+ *     the first releases, and the same owner may nest claims.
+ *
+ * The arena lives in DTCM .bss and is sized at compile time from the
+ * per-driver budgets in config.h (SENSOR_ARENA_SIZE); each driver asserts
+ * that its types fit, so allocation cannot fail at run time unless a
+ * driver allocates more instances than the budget allows.
+ */
+
+#ifndef SENSOR_ARENA_H
+#define SENSOR_ARENA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "config.h"
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define SENSOR_ARENA_ALIGN          8
+#define SENSOR_ARENA_ROUND(n)       (((n) + SENSOR_ARENA_ALIGN - 1) & ~(SENSOR_ARENA_ALIGN - 1))
+
+/* Persistent budget: every MLX90640 instance; scratch: the largest transient user */
+#define SENSOR_ARENA_PERSISTENT     (MLX90640_INSTANCES * SENSOR_ARENA_ROUND(MLX90640_INSTANCE_BYTES))
+#define SENSOR_ARENA_SCRATCH        SENSOR_ARENA_ROUND(MLX90640_SCRATCH_BYTES)
+#define SENSOR_ARENA_SIZE           (SENSOR_ARENA_PERSISTENT + SENSOR_ARENA_SCRATCH)
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Arena usage in bytes
+ */
+typedef struct {
+    uint32_t    size;               /* Whole arena */
+    uint32_t    persistent_used;    /* Allocated instance state */
+    uint32_t    scratch_size;       /* Shared scratch region */
+    uint32_t    scratch_peak;       /* Largest claim since boot */
+} SensorArenaInfo_t;
+
+/*============================================================================*/
+/* Functions                                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Allocate persistent instance state (never freed, zero-filled)
+ * @param size Bytes
+ * @return Pointer aligned to SENSOR_ARENA_ALIGN, NULL if the budget is spent
+ */
+void* SensorArena_Alloc(uint32_t size);
+
+/**
+ * @brief Claim the shared scratch region
+ * @param owner Claiming instance (any unique pointer)
+ * @param size Bytes needed
+ * @return Scratch pointer, NULL if another owner holds it or size is too large
+ */
+void* SensorArena_Claim(const void* owner, uint32_t size);
+
+/**
+ * @brief Release one claim on the shared scratch region
+ * @param owner Instance that claimed it
+ */
+void SensorArena_Release(const void* owner);
+
+/**
+ * @brief Get arena usage
+ * @param info Usage (output)
+ */
+void SensorArena_GetInfo(SensorArenaInfo_t* info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SENSOR_ARENA_H */
@@ -42,6 +42,28 @@ typedef enum {
     STATUS_NOT_TESTED       = 0xFF,     /* Not tested (skipped) */
 } TestStatus_t;
 
+/*============================================================================*/
+/* MLX90640 Result Constants                                                  */
+/*============================================================================*/
+
+#define MLX90640_TEMP_NOT_MEASURED  INT16_MIN   /* min/max of a single-pixel fast-path result */
+
+/*============================================================================*/
+/* MLX90640 Spec Statistic                                                    */
+/*============================================================================*/
+
+/**
+ * @brief Frame statistic compared against the MLX90640 spec target
+ */
+typedef enum {
+    MLX_STAT_PIXEL          = 0x00,     /* pixel_x/pixel_y, or max if 0xFF (legacy) */
+    MLX_STAT_MEAN           = 0x01,     /* Mean of all pixels */
+    MLX_STAT_PERCENTILE     = 0x02,     /* Percentile given by spec percentile field */
+    MLX_STAT_TRIMMED_MEAN   = 0x03,     /* Mean between THERMAL_STATS_P_LOW/P_HIGH ranks */
+    MLX_STAT_MAX            = 0x04,     /* Hottest pixel */
+    MLX_STAT_MIN            = 0x05,     /* Coldest pixel */
+} MLX90640_Statistic_t;
+
 /*============================================================================*/
 /* Sensor Specification (Union for different sensor types)                    */
 /*============================================================================*/
@@ -65,6 +87,8 @@ typedef union {
         int16_t     tolerance;      /* Tolerance in 0.1°C units */
         uint8_t     pixel_x;        /* Target pixel X (0-31) or 0xFF for average */
         uint8_t     pixel_y;        /* Target pixel Y (0-23) or 0xFF for average */
+        uint8_t     statistic;      /* MLX90640_Statistic_t (0xFF = MLX_STAT_PIXEL) */
+        uint8_t     percentile;     /* Percentile 0-100 for MLX_STAT_PERCENTILE */
     } mlx90640;
 
     /* Raw bytes for serialization */
@@ -97,8 +121,10 @@ typedef union {
         int16_t     tolerance;      /* Spec tolerance in 0.1°C units */
         int16_t     diff;           /* |measured - target| in 0.1°C units */
         int16_t     ambient;        /* Ambient temperature in 0.1°C units */
-        int16_t     min_temp;       /* Min pixel temperature in 0.1°C units */
-        int16_t     max_temp;       /* Max pixel temperature in 0.1°C units */
+        int16_t     min_temp;       /* Min pixel temperature in 0.1°C units (or MLX90640_TEMP_NOT_MEASURED) */
+        int16_t     max_temp;       /* Max pixel temperature in 0.1°C units (or MLX90640_TEMP_NOT_MEASURED) */
+        uint8_t     defect_class;   /* ThermalClass_t (0xFF: not classified) */
+        uint8_t     defect_conf;    /* Classifier confidence in percent */
     } mlx90640;
 
     /* Raw bytes for serialization */
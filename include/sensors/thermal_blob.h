@@ -0,0 +1,83 @@
+/**
+ * @file thermal_blob.h
+ * @brief Hotspot / blob analytics on MLX90640 temperature frames
+ *
+ * Thresholds a 32x24 temperature frame and labels connected regions
+ * (4- or 8-connected) with an iterative flood fill in fixed static memory.
+ * For each region the area, centroid, bounding box and peak/mean
+ * temperature are reported; the largest regions are kept.
+ */
+
+#ifndef THERMAL_BLOB_H
+#define THERMAL_BLOB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define THERMAL_BLOB_SERIALIZED_SIZE    12      /* Bytes per blob on the wire */
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Statistics for one connected region
+ */
+typedef struct {
+    uint16_t    area;           /* Pixel count */
+    uint8_t     centroid_x_q3;  /* Centroid X in 1/8 pixel units (0-255) */
+    uint8_t     centroid_y_q3;  /* Centroid Y in 1/8 pixel units (0-191) */
+    uint8_t     x_min;          /* Bounding box (inclusive) */
+    uint8_t     y_min;
+    uint8_t     x_max;
+    uint8_t     y_max;
+    int16_t     peak_temp;      /* Peak temperature in 0.1°C units */
+    int16_t     mean_temp;      /* Mean temperature in 0.1°C units */
+} ThermalBlob_t;
+
+/**
+ * @brief Blob analysis result
+ */
+typedef struct {
+    uint16_t        blob_total;                         /* Regions found (>= min_area) */
+    uint8_t         count;                              /* Regions stored in blobs[] */
+    ThermalBlob_t   blobs[THERMAL_BLOB_MAX_REPORT];     /* Largest regions, by area desc */
+} ThermalBlobResult_t;
+
+/*============================================================================*/
+/* Functions                                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Label hot regions in a temperature frame
+ * @param temps Temperature frame in °C (MLX90640_PIXEL_COUNT, row-major)
+ * @param threshold Pixels with temperature >= threshold are foreground (°C)
+ * @param eight_connected true for 8-connectivity, false for 4-connectivity
+ * @param min_area Regions smaller than this are ignored
+ * @param result Analysis result (output)
+ */
+void ThermalBlob_Analyze(const float* temps, float threshold, bool eight_connected,
+                         uint16_t min_area, ThermalBlobResult_t* result);
+
+/**
+ * @brief Serialize one blob to big-endian bytes
+ * @param blob Blob statistics
+ * @param buffer Output buffer (THERMAL_BLOB_SERIALIZED_SIZE bytes)
+ * @return Number of bytes written
+ */
+uint8_t ThermalBlob_Serialize(const ThermalBlob_t* blob, uint8_t* buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THERMAL_BLOB_H */
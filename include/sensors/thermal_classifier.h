@@ -0,0 +1,84 @@
+/**
+ * @file thermal_classifier.h
+ * @brief Quantised thermal defect classifier for MLX90640 frames
+ *
+ * A small int8 CNN (three strided 3x3 convolutions and one fully connected
+ * layer) run with the CMSIS-NN q7 kernels. The input is the 32x24 frame
+ * relative to the sensor ambient; the output is a defect class with a
+ * softmax confidence. Weights live in flash (thermal_classifier_model.c,
+ * generated by the host export tool), so inference needs no heap and only
+ * the static activation buffers reported by ThermalClassifier_GetStats().
+ */
+
+#ifndef THERMAL_CLASSIFIER_H
+#define THERMAL_CLASSIFIER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Defect classes (network output order)
+ */
+typedef enum {
+    THERMAL_CLASS_OK            = 0,    /* Heater pattern as expected */
+    THERMAL_CLASS_COLD_ZONE     = 1,    /* Part of the heater stays cold */
+    THERMAL_CLASS_HOTSPOT       = 2,    /* Local overheating */
+    THERMAL_CLASS_DEAD_HEATER   = 3,    /* No heating at all */
+    THERMAL_CLASS_MISALIGNED    = 4,    /* Heater pattern shifted in the field of view */
+    THERMAL_CLASS_COUNT,
+    THERMAL_CLASS_NONE          = 0xFF  /* Not classified (disabled, no model, partial frame) */
+} ThermalClass_t;
+
+/**
+ * @brief Inference cost figures
+ */
+typedef struct {
+    uint32_t    cycles;         /* CPU cycles of the last inference (0 if none ran) */
+    uint32_t    macs;           /* Multiply-accumulates per inference */
+    uint32_t    ram_bytes;      /* Static activation and scratch RAM */
+    uint32_t    flash_bytes;    /* Weights and biases */
+    bool        model_loaded;   /* Trained model present in flash */
+} ThermalClassifierStats_t;
+
+/*============================================================================*/
+/* Functions                                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Enable the cycle counter used for the inference figures
+ */
+void ThermalClassifier_Init(void);
+
+/**
+ * @brief Classify one full frame
+ *
+ * Returns THERMAL_CLASS_NONE with zero confidence when the classifier is
+ * compiled out or the flash holds the untrained placeholder model.
+ *
+ * @param temperatures 768 pixel temperatures in °C (row-major 32x24)
+ * @param ta Sensor ambient temperature in °C
+ * @param confidence Softmax confidence of the returned class in percent (output, may be NULL)
+ * @return Defect class
+ */
+ThermalClass_t ThermalClassifier_Classify(const float* temperatures, float ta, uint8_t* confidence);
+
+/**
+ * @brief Get inference cost figures
+ * @param stats Figures (output)
+ */
+void ThermalClassifier_GetStats(ThermalClassifierStats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THERMAL_CLASSIFIER_H */
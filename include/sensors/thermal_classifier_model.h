@@ -0,0 +1,90 @@
+/**
+ * @file thermal_classifier_model.h
+ * @brief Network topology and weight layout of the thermal defect classifier
+ *
+ * Shared by the classifier, the generated weights file and the host
+ * reference build, so the export tool and the firmware cannot disagree on
+ * tensor shapes. Fixed-point formats follow the CMSIS-NN q7 convention:
+ * each layer's bias is shifted left by bias_shift and its accumulator
+ * right by out_shift.
+ */
+
+#ifndef THERMAL_CLASSIFIER_MODEL_H
+#define THERMAL_CLASSIFIER_MODEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*============================================================================*/
+/* Topology                                                                   */
+/*============================================================================*/
+
+/* Input: 32x24x1 HWC, (To - Ta) in q7 with input_frac fractional bits */
+#define TC_IN_W             32
+#define TC_IN_H             24
+
+/* All convolutions: 3x3 kernel, padding 1, stride 2, ReLU */
+#define TC_KERNEL           3
+#define TC_PAD              1
+#define TC_STRIDE           2
+
+#define TC_CONV1_CH         8       /* 16x12x8 */
+#define TC_CONV1_W          16
+#define TC_CONV1_H          12
+#define TC_CONV2_CH         16      /* 8x6x16 */
+#define TC_CONV2_W          8
+#define TC_CONV2_H          6
+#define TC_CONV3_CH         16      /* 4x3x16 */
+#define TC_CONV3_W          4
+#define TC_CONV3_H          3
+
+#define TC_FC_IN            (TC_CONV3_W * TC_CONV3_H * TC_CONV3_CH)
+#define TC_FC_OUT           5       /* THERMAL_CLASS_COUNT */
+
+/* Weight counts ([out][ky][kx][in] for convolutions, [out][in] for FC) */
+#define TC_CONV1_WEIGHTS    (TC_CONV1_CH * TC_KERNEL * TC_KERNEL * 1)
+#define TC_CONV2_WEIGHTS    (TC_CONV2_CH * TC_KERNEL * TC_KERNEL * TC_CONV1_CH)
+#define TC_CONV3_WEIGHTS    (TC_CONV3_CH * TC_KERNEL * TC_KERNEL * TC_CONV2_CH)
+#define TC_FC_WEIGHTS       (TC_FC_OUT * TC_FC_IN)
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief One quantised layer
+ */
+typedef struct {
+    const int8_t*   weights;
+    const int8_t*   bias;
+    uint16_t        bias_shift;     /* Bias left shift into the accumulator format */
+    uint16_t        out_shift;      /* Accumulator right shift to the output format */
+} ThermalLayer_t;
+
+/**
+ * @brief Complete model as stored in flash
+ */
+typedef struct {
+    uint16_t        version;        /* 0: untrained placeholder, classifier stays off */
+    int8_t          input_frac;     /* Fractional bits of the q7 input (1 => 0.5°C LSB) */
+    int8_t          logit_frac;     /* Fractional bits of the FC output (base-2 logits) */
+    ThermalLayer_t  conv1;
+    ThermalLayer_t  conv2;
+    ThermalLayer_t  conv3;
+    ThermalLayer_t  fc;
+} ThermalClassifierModel_t;
+
+/*============================================================================*/
+/* Model                                                                      */
+/*============================================================================*/
+
+extern const ThermalClassifierModel_t ThermalClassifier_Model;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THERMAL_CLASSIFIER_MODEL_H */
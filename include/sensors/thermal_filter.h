@@ -0,0 +1,106 @@
+/**
+ * @file thermal_filter.h
+ * @brief Per-pixel temporal filter for the MLX90640 temperature buffer
+ *
+ * When enabled, every acquired frame is folded into the temperature
+ * buffer in place as its pixels are computed: either an exponential
+ * moving average or a moving window over the last N frames. Tests and
+ * reads then see the filtered image. Discarded stabilization frames do
+ * not enter the filter.
+ */
+
+#ifndef THERMAL_FILTER_H
+#define THERMAL_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define THERMAL_FILTER_INFO_SIZE        7       /* Serialized info bytes */
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Filter mode
+ */
+typedef enum {
+    THERMAL_FILTER_OFF      = 0x00,     /* Buffer holds the last raw frame */
+    THERMAL_FILTER_EMA      = 0x01,     /* y += alpha * (x - y), param = alpha in percent (1-100) */
+    THERMAL_FILTER_WINDOW   = 0x02,     /* Mean of last N frames, param = N (2-THERMAL_FILTER_MAX_WINDOW) */
+} ThermalFilterMode_t;
+
+/**
+ * @brief Filter state
+ */
+typedef struct {
+    uint8_t     mode;           /* ThermalFilterMode_t */
+    uint8_t     param;          /* Alpha percent or window length */
+    uint16_t    frames;         /* Frames filtered since reset (saturating) */
+    uint16_t    settle_frames;  /* Frames until the initial state has decayed */
+    bool        settled;        /* frames >= settle_frames */
+} ThermalFilterInfo_t;
+
+/*============================================================================*/
+/* Functions                                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Select filter mode and reset its state
+ * @param mode ThermalFilterMode_t
+ * @param param Alpha percent (EMA) or window length (WINDOW), ignored when OFF
+ * @return true if mode and param are valid
+ */
+bool ThermalFilter_Configure(uint8_t mode, uint8_t param);
+
+/**
+ * @brief Restart filtering from the next frame
+ */
+void ThermalFilter_Reset(void);
+
+/**
+ * @brief Check whether a filter mode is active
+ */
+bool ThermalFilter_IsEnabled(void);
+
+/**
+ * @brief Fold one pixel sample into the filtered image
+ * @param image Filtered temperature buffer (updated in place)
+ * @param pixel Pixel index
+ * @param to Raw pixel temperature in °C
+ */
+void ThermalFilter_Pixel(float* image, int pixel, float to);
+
+/**
+ * @brief Mark the end of one acquired frame
+ */
+void ThermalFilter_EndFrame(void);
+
+/**
+ * @brief Get filter state
+ * @param info State (output)
+ */
+void ThermalFilter_GetInfo(ThermalFilterInfo_t* info);
+
+/**
+ * @brief Serialize filter state to big-endian bytes
+ * @param info State
+ * @param buffer Output buffer (THERMAL_FILTER_INFO_SIZE bytes)
+ * @return Number of bytes written
+ */
+uint8_t ThermalFilter_SerializeInfo(const ThermalFilterInfo_t* info, uint8_t* buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THERMAL_FILTER_H */
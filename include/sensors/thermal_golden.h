@@ -0,0 +1,130 @@
+/**
+ * @file thermal_golden.h
+ * @brief Golden reference image comparison for MLX90640
+ *
+ * A golden frame (average of up to GOLDEN_MAX_FRAMES frames from a
+ * known-good unit) and a per-pixel tolerance map are kept in RAM and
+ * persisted to a dedicated flash sector. Test frames are compared while
+ * their temperatures are being computed, so no extra pass is needed.
+ */
+
+#ifndef THERMAL_GOLDEN_H
+#define THERMAL_GOLDEN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "sensors/sensor_types.h"
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define THERMAL_GOLDEN_INFO_SIZE        9       /* Serialized info bytes */
+#define THERMAL_GOLDEN_RESULT_SIZE      16      /* Serialized result bytes */
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Golden image state
+ */
+typedef struct {
+    bool        valid;          /* Golden frame available */
+    bool        saved;          /* RAM image matches flash */
+    uint8_t     frames;         /* Frames averaged into the golden frame */
+    int16_t     mean_temp;      /* Golden frame mean in 0.1°C units */
+    uint32_t    checksum;       /* Image checksum (CRC-32) */
+} ThermalGoldenInfo_t;
+
+/**
+ * @brief Comparison result (temperatures in 0.01°C units)
+ */
+typedef struct {
+    TestStatus_t    status;         /* Frame acquisition status */
+    TestStatus_t    verdict;        /* PASS if all pixels compared and out_count <= max_out */
+    uint16_t        compared;       /* Pixels compared */
+    uint16_t        out_count;      /* Pixels outside their tolerance */
+    uint16_t        worst_index;    /* Pixel with largest |deviation| (y * 32 + x) */
+    int16_t         worst_dev;      /* Signed deviation of worst pixel */
+    int16_t         mean_dev;       /* Mean deviation (offset) */
+    uint16_t        rms_dev;        /* RMS deviation */
+    int16_t         similarity;     /* Pearson correlation x1000 (0 if a frame is uniform) */
+} ThermalGoldenResult_t;
+
+/*============================================================================*/
+/* Functions                                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Load the golden image from flash (if present and intact)
+ */
+void ThermalGolden_Init(void);
+
+/**
+ * @brief Capture a new golden frame as the average of several frames
+ *
+ * The tolerance map is reset to default_tolerance. The image is held in
+ * RAM until ThermalGolden_Save is called.
+ *
+ * @param frames Frames to average (1-GOLDEN_MAX_FRAMES)
+ * @param default_tolerance Tolerance for every pixel in 0.1°C units
+ * @return STATUS_PASS on success, acquisition failure status otherwise
+ */
+TestStatus_t ThermalGolden_Capture(uint8_t frames, uint8_t default_tolerance);
+
+/**
+ * @brief Overwrite part of the per-pixel tolerance map
+ * @param offset First pixel index
+ * @param tolerances Tolerances in 0.1°C units
+ * @param count Number of pixels
+ * @return true if the range is valid and a golden frame exists
+ */
+bool ThermalGolden_SetTolerance(uint16_t offset, const uint8_t* tolerances, uint8_t count);
+
+/**
+ * @brief Write the golden image to flash
+ * @return HAL_OK on success
+ */
+HAL_StatusTypeDef ThermalGolden_Save(void);
+
+/**
+ * @brief Get golden image state
+ * @param info State (output)
+ */
+void ThermalGolden_GetInfo(ThermalGoldenInfo_t* info);
+
+/**
+ * @brief Acquire one frame and compare it against the golden frame
+ * @param max_out Out-of-tolerance pixels allowed for a PASS verdict
+ * @param result Comparison result (output)
+ * @return false if no golden frame is available
+ */
+bool ThermalGolden_Compare(uint16_t max_out, ThermalGoldenResult_t* result);
+
+/**
+ * @brief Serialize golden image state to bytes
+ * @param info State
+ * @param buffer Output buffer (THERMAL_GOLDEN_INFO_SIZE bytes)
+ * @return Number of bytes written
+ */
+uint8_t ThermalGolden_SerializeInfo(const ThermalGoldenInfo_t* info, uint8_t* buffer);
+
+/**
+ * @brief Serialize comparison result to big-endian bytes
+ * @param result Comparison result
+ * @param buffer Output buffer (THERMAL_GOLDEN_RESULT_SIZE bytes)
+ * @return Number of bytes written
+ */
+uint8_t ThermalGolden_SerializeResult(const ThermalGoldenResult_t* result, uint8_t* buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THERMAL_GOLDEN_H */
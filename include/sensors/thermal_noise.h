@@ -0,0 +1,86 @@
+/**
+ * @file thermal_noise.h
+ * @brief Per-pixel temporal noise (NETD) measurement for MLX90640
+ *
+ * Streams N consecutive frames through a per-pixel Welford mean/variance
+ * accumulator. Memory is fixed (no frame history); each pixel costs one
+ * update per frame. The report gives array NETD, the noisiest pixels and
+ * a histogram of per-pixel temporal sigma.
+ */
+
+#ifndef THERMAL_NOISE_H
+#define THERMAL_NOISE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "sensors/sensor_types.h"
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+/* [status][frames(2)][pixels(2)][netd(2)][max(2)][bin_width][worst x 4B][hist x 2B] */
+#define THERMAL_NOISE_SERIALIZED_SIZE   (10 + THERMAL_NOISE_WORST * 4 + THERMAL_NOISE_HIST_BINS * 2)
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief One noisy pixel
+ */
+typedef struct {
+    uint16_t    index;          /* Pixel index (y * 32 + x) */
+    uint16_t    sigma;          /* Temporal sigma in mK */
+} ThermalNoisePixel_t;
+
+/**
+ * @brief Noise measurement report (sigma values in mK)
+ */
+typedef struct {
+    TestStatus_t        status;                             /* Acquisition status */
+    uint16_t            frames;                             /* Frames requested */
+    uint16_t            pixels;                             /* Pixels with >= 2 samples */
+    uint16_t            netd;                               /* Array NETD: mean per-pixel sigma */
+    uint16_t            max_sigma;                          /* Largest per-pixel sigma */
+    ThermalNoisePixel_t worst[THERMAL_NOISE_WORST];         /* Noisiest pixels, descending */
+    uint16_t            histogram[THERMAL_NOISE_HIST_BINS]; /* Pixel counts per sigma bin */
+} ThermalNoiseResult_t;
+
+/*============================================================================*/
+/* Functions                                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Measure per-pixel temporal noise over consecutive frames
+ *
+ * Blocks for roughly frames x 2 subpage periods with no transport
+ * serviced, so THERMAL_NOISE_MAX_FRAMES is kept to a few seconds; run
+ * several measurements for longer statistics. Histogram bins are
+ * THERMAL_NOISE_BIN_MK wide starting at 0; the last bin also counts
+ * every larger sigma.
+ *
+ * @param frames Frames to accumulate (2-THERMAL_NOISE_MAX_FRAMES)
+ * @param result Report (output)
+ * @return Acquisition status (also stored in result)
+ */
+TestStatus_t ThermalNoise_Measure(uint16_t frames, ThermalNoiseResult_t* result);
+
+/**
+ * @brief Serialize noise report to big-endian bytes
+ * @param result Noise report
+ * @param buffer Output buffer (THERMAL_NOISE_SERIALIZED_SIZE bytes)
+ * @return Number of bytes written
+ */
+uint8_t ThermalNoise_Serialize(const ThermalNoiseResult_t* result, uint8_t* buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THERMAL_NOISE_H */
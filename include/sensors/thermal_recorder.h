@@ -0,0 +1,110 @@
+/**
+ * @file thermal_recorder.h
+ * @brief MLX90640 raw subpage flight recorder
+ *
+ * Every subpage read from the sensor is copied, with its capture tick and
+ * the id of the test it belongs to, into a ring of THERMAL_RECORDER_SLOTS
+ * records in AXI SRAM (RAM_D1). Recording costs one memcpy of frameData.
+ * The host downloads records in chunks addressed by (sequence, offset),
+ * so a transfer can resume at any chunk and re-run the calibration
+ * offline on a failed test.
+ */
+
+#ifndef THERMAL_RECORDER_H
+#define THERMAL_RECORDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "sensors/sensor_types.h"
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define THERMAL_RECORD_WORDS            834     /* frameData: RAM 0x0400-0x073F + control + status */
+
+/* Serialized record: [seq(4)][tick(4)][test_id(2)][frameData x 2B] - big-endian */
+#define THERMAL_RECORD_HEADER_SIZE      10
+#define THERMAL_RECORD_SIZE             (THERMAL_RECORD_HEADER_SIZE + THERMAL_RECORD_WORDS * 2)
+
+#define THERMAL_RECORDER_CHUNK          56      /* Record bytes per download response */
+#define THERMAL_RECORDER_INFO_SIZE      17      /* Serialized state bytes */
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Recorder state
+ */
+typedef struct {
+    uint16_t        count;          /* Records held */
+    uint16_t        capacity;       /* THERMAL_RECORDER_SLOTS */
+    uint32_t        oldest_seq;     /* Sequence number of the oldest record */
+    uint32_t        next_seq;       /* Sequence number the next record gets */
+    uint16_t        last_test_id;   /* Id of the last finished test (0 = none) */
+    TestStatus_t    last_status;    /* Its verdict */
+} ThermalRecorderInfo_t;
+
+/*============================================================================*/
+/* Functions                                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Append one raw subpage, overwriting the oldest record when full
+ * @param frame frameData (THERMAL_RECORD_WORDS words)
+ */
+void ThermalRecorder_Record(const uint16_t* frame);
+
+/**
+ * @brief Tag subsequent records with a new test id
+ * @return Test id (never 0)
+ */
+uint16_t ThermalRecorder_BeginTest(void);
+
+/**
+ * @brief Stop tagging records and remember the test verdict
+ * @param status Test status
+ */
+void ThermalRecorder_EndTest(TestStatus_t status);
+
+/**
+ * @brief Drop all records (test ids keep counting)
+ */
+void ThermalRecorder_Clear(void);
+
+/**
+ * @brief Get recorder state
+ * @param info State (output)
+ */
+void ThermalRecorder_GetInfo(ThermalRecorderInfo_t* info);
+
+/**
+ * @brief Serialize recorder state to big-endian bytes
+ * @param info State
+ * @param buffer Output buffer (THERMAL_RECORDER_INFO_SIZE bytes)
+ * @return Number of bytes written
+ */
+uint8_t ThermalRecorder_SerializeInfo(const ThermalRecorderInfo_t* info, uint8_t* buffer);
+
+/**
+ * @brief Copy part of a serialized record
+ * @param seq Record sequence number
+ * @param offset Byte offset into the serialized record
+ * @param buffer Output buffer (THERMAL_RECORDER_CHUNK bytes)
+ * @param len Bytes written, up to THERMAL_RECORDER_CHUNK (output)
+ * @return false if the record is not held (never written or overwritten)
+ *         or offset is past its end
+ */
+bool ThermalRecorder_ReadChunk(uint32_t seq, uint16_t offset, uint8_t* buffer, uint8_t* len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THERMAL_RECORDER_H */
@@ -0,0 +1,129 @@
+/**
+ * @file thermal_stats.h
+ * @brief Robust statistics over MLX90640 temperature frames
+ *
+ * Min/max/mean/standard deviation, a fixed-bin histogram and exact
+ * percentiles / trimmed mean over the full frame or a rectangular ROI.
+ * Percentiles use in-place selection (quickselect) on a scratch copy,
+ * so the cost is O(n) instead of sorting the frame.
+ */
+
+#ifndef THERMAL_STATS_H
+#define THERMAL_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define THERMAL_STATS_SERIALIZED_SIZE   (18 + 2 * THERMAL_HIST_BINS)
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Rectangular region of interest (inclusive pixel bounds)
+ */
+typedef struct {
+    uint8_t     x_min;
+    uint8_t     y_min;
+    uint8_t     x_max;
+    uint8_t     y_max;
+} ThermalRoi_t;
+
+/**
+ * @brief Frame / ROI statistics (temperatures in 0.1°C units)
+ */
+typedef struct {
+    uint16_t    count;                          /* Pixels in ROI */
+    int16_t     min_temp;
+    int16_t     max_temp;
+    int16_t     mean;
+    int16_t     stddev;
+    int16_t     p_low;                          /* THERMAL_STATS_P_LOW percentile */
+    int16_t     median;
+    int16_t     p_high;                         /* THERMAL_STATS_P_HIGH percentile */
+    int16_t     trimmed_mean;                   /* Mean of ranks p_low..p_high */
+    uint16_t    histogram[THERMAL_HIST_BINS];   /* Equal bins over [min, max] */
+} ThermalStats_t;
+
+/*============================================================================*/
+/* Functions                                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Set ROI to the full 32x24 frame
+ * @param roi ROI (output)
+ */
+void ThermalRoi_SetFull(ThermalRoi_t* roi);
+
+/**
+ * @brief Check ROI bounds lie within the frame and are ordered
+ * @param roi ROI to check
+ * @return true if valid
+ */
+bool ThermalRoi_IsValid(const ThermalRoi_t* roi);
+
+/**
+ * @brief Compute statistics over an ROI
+ * @param temps Temperature frame in °C (MLX90640_PIXEL_COUNT, row-major)
+ * @param roi Region (NULL for full frame)
+ * @param stats Statistics (output)
+ */
+void ThermalStats_Compute(const float* temps, const ThermalRoi_t* roi, ThermalStats_t* stats);
+
+/**
+ * @brief Compute a single percentile over an ROI
+ * @param temps Temperature frame in °C
+ * @param roi Region (NULL for full frame)
+ * @param percentile Percentile 0-100 (nearest rank)
+ * @return Percentile temperature in °C
+ */
+float ThermalStats_Percentile(const float* temps, const ThermalRoi_t* roi, uint8_t percentile);
+
+/**
+ * @brief Compute the mean of ranks p_low..p_high over an ROI
+ * @param temps Temperature frame in °C
+ * @param roi Region (NULL for full frame)
+ * @return Trimmed mean in °C
+ */
+float ThermalStats_TrimmedMean(const float* temps, const ThermalRoi_t* roi);
+
+/**
+ * @brief Percentile of an arbitrary value array (reorders values in place)
+ * @param values Values in °C
+ * @param count Number of values
+ * @param percentile Percentile 0-100 (nearest rank)
+ * @return Percentile value in °C (0 if count is 0)
+ */
+float ThermalStats_PercentileOf(float* values, uint16_t count, uint8_t percentile);
+
+/**
+ * @brief Trimmed mean of an arbitrary value array (reorders values in place)
+ * @param values Values in °C
+ * @param count Number of values
+ * @return Mean of ranks p_low..p_high in °C (0 if count is 0)
+ */
+float ThermalStats_TrimmedMeanOf(float* values, uint16_t count);
+
+/**
+ * @brief Serialize statistics to big-endian bytes
+ * @param stats Statistics
+ * @param buffer Output buffer (THERMAL_STATS_SERIALIZED_SIZE bytes)
+ * @return Number of bytes written
+ */
+uint8_t ThermalStats_Serialize(const ThermalStats_t* stats, uint8_t* buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THERMAL_STATS_H */
@@ -0,0 +1,104 @@
+/**
+ * @file thermal_zone.h
+ * @brief Multi-ROI thermal spec evaluation for MLX90640
+ *
+ * Up to THERMAL_ZONE_MAX rectangular zones, each with its own statistic,
+ * target, tolerance and optional emissivity. All zones are evaluated from
+ * one acquired frame in a single pass over the pixels.
+ */
+
+#ifndef THERMAL_ZONE_H
+#define THERMAL_ZONE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "sensors/sensor_types.h"
+#include "sensors/thermal_stats.h"
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define THERMAL_ZONE_SERIALIZED_SIZE        11      /* Bytes per zone spec on the wire */
+#define THERMAL_ZONE_RESULT_SIZE            5       /* Bytes per zone result on the wire */
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief One zone specification
+ */
+typedef struct {
+    ThermalRoi_t    roi;
+    uint8_t         statistic;      /* MLX90640_Statistic_t (PIXEL not allowed) */
+    uint8_t         percentile;     /* Percentile 0-100 for MLX_STAT_PERCENTILE */
+    int16_t         target_temp;    /* Target temperature in 0.1°C units */
+    int16_t         tolerance;      /* Tolerance in 0.1°C units */
+    uint8_t         emissivity;     /* Emissivity in percent (1-100), 0 = frame default */
+} ThermalZone_t;
+
+/**
+ * @brief One zone verdict
+ */
+typedef struct {
+    TestStatus_t    status;         /* STATUS_PASS or STATUS_FAIL_INVALID */
+    int16_t         measured;       /* Measured statistic in 0.1°C units */
+    int16_t         diff;           /* |measured - target| in 0.1°C units */
+} ThermalZoneResult_t;
+
+/*============================================================================*/
+/* Functions                                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Parse zone specs and store them from start_index onwards
+ *
+ * start_index 0 replaces the whole list; otherwise zones are appended
+ * (start_index must equal the current count). The list is left unchanged
+ * if any zone is invalid.
+ *
+ * @param start_index Index of the first zone in buffer
+ * @param buffer Serialized zones (THERMAL_ZONE_SERIALIZED_SIZE each)
+ * @param count Number of zones in buffer
+ * @return true if stored
+ */
+bool ThermalZone_Set(uint8_t start_index, const uint8_t* buffer, uint8_t count);
+
+/**
+ * @brief Remove all zones
+ */
+void ThermalZone_Clear(void);
+
+/**
+ * @brief Number of configured zones
+ */
+uint8_t ThermalZone_GetCount(void);
+
+/**
+ * @brief Evaluate all zones against a temperature frame
+ * @param temps Temperature frame in °C (computed at MLX90640_EMISSIVITY)
+ * @param ta Sensor ambient temperature in °C (for emissivity correction)
+ * @param results Per-zone results (output, ThermalZone_GetCount() entries)
+ * @return STATUS_PASS if every zone passes, STATUS_FAIL_INVALID otherwise
+ */
+TestStatus_t ThermalZone_Evaluate(const float* temps, float ta, ThermalZoneResult_t* results);
+
+/**
+ * @brief Serialize one zone result to big-endian bytes
+ * @param result Zone result
+ * @param buffer Output buffer (THERMAL_ZONE_RESULT_SIZE bytes)
+ * @return Number of bytes written
+ */
+uint8_t ThermalZone_SerializeResult(const ThermalZoneResult_t* result, uint8_t* buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THERMAL_ZONE_H */
@@ -0,0 +1,120 @@
+/**
+ * @file test_journal.h
+ * @brief Test result journal
+ *
+ * Every finished test report is appended to a journal with a monotonic
+ * sequence number, its start tick, total and per-sensor durations and a
+ * recipe id (FNV-1a of the specs it ran against). Entries are kept in a
+ * RAM ring of TEST_JOURNAL_ENTRIES and, with TEST_JOURNAL_FLASH_SPILL,
+ * also appended to two alternating flash sectors so history and sequence
+ * numbers survive a reset. The host reads entries from a sequence number
+ * onward, several per response, to recover a lost TEST_RESULT or to sync
+ * fixture history.
+ */
+
+#ifndef TEST_JOURNAL_H
+#define TEST_JOURNAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "test/test_runner.h"
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define TEST_JOURNAL_RESULTS        (SENSOR_ID_MAX - 1)     /* One result per sensor type */
+#define TEST_JOURNAL_INFO_SIZE      16      /* Serialized state bytes */
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Journal state
+ */
+typedef struct {
+    uint32_t    oldest_seq;         /* Oldest entry held in RAM or flash */
+    uint32_t    next_seq;           /* Sequence number the next entry gets */
+    uint16_t    ram_count;          /* Entries in the RAM ring */
+    uint16_t    ram_capacity;       /* TEST_JOURNAL_ENTRIES */
+    uint16_t    flash_count;        /* Flash slots used in both sectors */
+    uint16_t    flash_capacity;     /* Flash slots in both sectors (0 = spill disabled) */
+} TestJournalInfo_t;
+
+/*============================================================================*/
+/* Functions                                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Recover the flash copy and continue its sequence numbers
+ *
+ * A flash sector holding no readable entry is erased.
+ */
+void TestJournal_Init(void);
+
+/**
+ * @brief Erase the spare flash sector once the active one is nearly full
+ *
+ * Call from the main loop while no test is running: the sector erase
+ * blocks for up to a few seconds.
+ */
+void TestJournal_Process(void);
+
+/**
+ * @brief Append a finished test report
+ *
+ * With flash spill the entry is also programmed into flash. It never
+ * erases: if the active sector is full and TestJournal_Process has not
+ * erased the other one yet, the entry is kept in the RAM ring only.
+ *
+ * @param report Test report
+ */
+void TestJournal_Record(const TestReport_t* report);
+
+/**
+ * @brief Drop all entries, erasing both flash sectors (sequence numbers keep counting)
+ * @return HAL_OK, or the flash erase error
+ */
+HAL_StatusTypeDef TestJournal_Clear(void);
+
+/**
+ * @brief Get journal state
+ * @param info State (output)
+ */
+void TestJournal_GetInfo(TestJournalInfo_t* info);
+
+/**
+ * @brief Serialize journal state to big-endian bytes
+ * @param info State
+ * @param buffer Output buffer (TEST_JOURNAL_INFO_SIZE bytes)
+ * @return Number of bytes written
+ */
+uint8_t TestJournal_SerializeInfo(const TestJournalInfo_t* info, uint8_t* buffer);
+
+/**
+ * @brief Serialize as many entries as fit, starting at a sequence number
+ *
+ * Entries that are no longer held are skipped. Each entry is
+ * [len][seq(4)][recipe(4)][duration(2)][n][sensor duration(2) x n]
+ * followed by the TEST_RESULT report bytes, big-endian.
+ *
+ * @param seq First sequence number wanted; advanced past the last entry
+ *            written, so the next call continues there (in/out)
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @param count Entries written (output)
+ * @return Number of bytes written
+ */
+uint8_t TestJournal_Read(uint32_t* seq, uint8_t* buffer, uint8_t size, uint8_t* count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TEST_JOURNAL_H */
@@ -37,6 +37,7 @@ typedef struct {
     SensorID_t      sensor_id;      /* Sensor identifier */
     TestStatus_t    status;         /* Test result status */
     SensorResult_t  result;         /* Measurement result */
+    uint16_t        duration_ms;    /* Init + test time (journal only, not serialized) */
 } SensorTestResult_t;
 
 /**
@@ -34,16 +34,105 @@ static void ExtractTgcParameters(uint16_t *eeData, paramsMLX90640 *params);
 static void ExtractResolutionParameters(uint16_t *eeData, paramsMLX90640 *params);
 static void ExtractKsTaParameters(uint16_t *eeData, paramsMLX90640 *params);
 static void ExtractKsToParameters(uint16_t *eeData, paramsMLX90640 *params);
-static void ExtractAlphaParameters(uint16_t *eeData, paramsMLX90640 *params);
-static void ExtractOffsetParameters(uint16_t *eeData, paramsMLX90640 *params);
-static void ExtractKtaPixelParameters(uint16_t *eeData, paramsMLX90640 *params);
-static void ExtractKvPixelParameters(uint16_t *eeData, paramsMLX90640 *params);
+static void ExtractAlphaParameters(uint16_t *eeData, paramsMLX90640 *params, MLX90640_PixelCoeffs_t *pc);
+static void ExtractOffsetParameters(uint16_t *eeData, MLX90640_PixelCoeffs_t *pc);
+static void ExtractKtaPixelParameters(uint16_t *eeData, paramsMLX90640 *params, MLX90640_PixelCoeffs_t *pc);
+static void ExtractKvPixelParameters(uint16_t *eeData, paramsMLX90640 *params, MLX90640_PixelCoeffs_t *pc);
 static void ExtractCPParameters(uint16_t *eeData, paramsMLX90640 *params);
 static void ExtractCILCParameters(uint16_t *eeData, paramsMLX90640 *params);
 static int ExtractDeviatingPixels(uint16_t *eeData, paramsMLX90640 *params);
 static int CheckAdjacentPixels(uint16_t pix1, uint16_t pix2);
 static float GetMedian(float *values, int n);
 static int IsPixelBad(uint16_t pixel, const paramsMLX90640 *params);
+static int8_t GetToRange(const paramsMLX90640 *params, float To);
+
+/*============================================================================*/
+/* Per-pixel Calibration Decoding                                             */
+/*============================================================================*/
+
+/*
+ * Per-pixel step of the Melexis extraction. Expanded storage runs it once
+ * in ExtractParameters; packed storage runs it per pixel in the kernel.
+ * Same code, same values either way.
+ */
+
+/** @brief Round value * 2^shift to the nearest integer, halves away from zero */
+static inline int32_t RoundShift(int32_t value, int shift)
+{
+    if (shift >= 0) {
+        return value * (1 << shift);
+    }
+    int32_t half = 1 << (-shift - 1);
+    return (value < 0) ? -((-value + half) >> -shift) : ((value + half) >> -shift);
+}
+
+/** @brief Row/column parity group of a pixel (RoRe, ReCo, RoCo, ReRe) */
+static inline int PixelGroup(int p)
+{
+    return 2 * ((p / 32) & 1) + (p & 1);
+}
+
+/** @brief alpha * 2^alphaScaleEE */
+static inline int32_t AlphaNumerator(const MLX90640_PixelCoeffs_t *pc, int p)
+{
+    int32_t alpha = (pc->pixelEE[p] & 0x03F0) >> 4;
+    if (alpha > 31) {
+        alpha -= 64;
+    }
+    return alpha * (1 << pc->alphaRemScale) + pc->alphaRow[p / 32] + pc->alphaColumn[p % 32];
+}
+
+/** @brief kta * 2^ktaScale1 */
+static inline int32_t KtaNumerator(const MLX90640_PixelCoeffs_t *pc, int p)
+{
+    int32_t kta = (pc->pixelEE[p] & 0x000E) >> 1;
+    if (kta > 3) {
+        kta -= 8;
+    }
+    return kta * (1 << pc->ktaRemScale) + pc->ktaRC[PixelGroup(p)];
+}
+
+static inline int16_t DecodeOffset(const MLX90640_PixelCoeffs_t *pc, int p)
+{
+    int32_t offset = (pc->pixelEE[p] & 0xFC00) >> 10;
+    if (offset > 31) {
+        offset -= 64;
+    }
+    return (int16_t)(offset * (1 << pc->offsetRemScale) + pc->offsetRow[p / 32] + pc->offsetColumn[p % 32]);
+}
+
+/** @brief SCALEALPHA * 2^alphaScale / alpha, 0 if unusable (treated as broken) */
+static inline uint16_t DecodeAlpha(const MLX90640_PixelCoeffs_t *pc, int p)
+{
+    float alpha = AlphaNumerator(pc, p) * pc->alphaUnit;
+    if (!(alpha > 0.0f)) {
+        return 0;
+    }
+    float scaled = pc->alphaReciprocal / alpha;
+    return (scaled < 65535.0f) ? (uint16_t)(scaled + 0.5f) : 0;
+}
+
+static inline int8_t DecodeKta(const MLX90640_PixelCoeffs_t *pc, int p)
+{
+    return (int8_t)RoundShift(KtaNumerator(pc, p), pc->ktaShift);
+}
+
+static inline int8_t DecodeKv(const MLX90640_PixelCoeffs_t *pc, int p)
+{
+    return pc->kvRC[PixelGroup(p)];
+}
+
+#if MLX90640_PACKED_CALIBRATION
+#define PIXEL_OFFSET(params, p)     DecodeOffset(&(params)->pixel, (p))
+#define PIXEL_ALPHA(params, p)      DecodeAlpha(&(params)->pixel, (p))
+#define PIXEL_KTA(params, p)        DecodeKta(&(params)->pixel, (p))
+#define PIXEL_KV(params, p)         DecodeKv(&(params)->pixel, (p))
+#else
+#define PIXEL_OFFSET(params, p)     ((params)->offset[p])
+#define PIXEL_ALPHA(params, p)      ((params)->alpha[p])
+#define PIXEL_KTA(params, p)        ((params)->kta[p])
+#define PIXEL_KV(params, p)         ((params)->kv[p])
+#endif
 
 /*============================================================================*/
 /* Public Functions                                                           */
@@ -57,6 +146,14 @@ int MLX90640_DumpEE(uint8_t slaveAddr, uint16_t *eeData)
 int MLX90640_ExtractParameters(uint16_t *eeData, paramsMLX90640 *params)
 {
     int error = 0;
+#if MLX90640_PACKED_CALIBRATION
+    MLX90640_PixelCoeffs_t *pc = &params->pixel;
+#else
+    MLX90640_PixelCoeffs_t coeffs;     /* Expanded into the tables below, then dropped */
+    MLX90640_PixelCoeffs_t *pc = &coeffs;
+#endif
+    
+    memcpy(pc->pixelEE, &eeData[64], sizeof(pc->pixelEE));
     
     ExtractVDDParameters(eeData, params);
     ExtractPTATParameters(eeData, params);
@@ -65,14 +162,23 @@ int MLX90640_ExtractParameters(uint16_t *eeData, paramsMLX90640 *params)
     ExtractResolutionParameters(eeData, params);
     ExtractKsTaParameters(eeData, params);
     ExtractKsToParameters(eeData, params);
-    ExtractAlphaParameters(eeData, params);
-    ExtractOffsetParameters(eeData, params);
-    ExtractKtaPixelParameters(eeData, params);
-    ExtractKvPixelParameters(eeData, params);
+    ExtractAlphaParameters(eeData, params, pc);
+    ExtractOffsetParameters(eeData, pc);
+    ExtractKtaPixelParameters(eeData, params, pc);
+    ExtractKvPixelParameters(eeData, params, pc);
     ExtractCPParameters(eeData, params);
     ExtractCILCParameters(eeData, params);
     error = ExtractDeviatingPixels(eeData, params);
     
+#if !MLX90640_PACKED_CALIBRATION
+    for (int p = 0; p < 768; p++) {
+        params->alpha[p] = DecodeAlpha(pc, p);
+        params->offset[p] = DecodeOffset(pc, p);
+        params->kta[p] = DecodeKta(pc, p);
+        params->kv[p] = DecodeKv(pc, p);
+    }
+#endif
+    
     return error;
 }
 
@@ -222,35 +328,66 @@ float MLX90640_GetTa(uint16_t *frameData, const paramsMLX90640 *params)
 
 void MLX90640_CalculateTo(uint16_t *frameData, const paramsMLX90640 *params,
                           float emissivity, float tr, float *result)
+{
+    MLX90640_CalculateToStream(frameData, params, emissivity, tr, result, NULL, NULL);
+}
+
+void MLX90640_CalculateToStream(uint16_t *frameData, const paramsMLX90640 *params,
+                                float emissivity, float tr, float *result,
+                                MLX90640_PixelSink_t sink, void *ctx)
+{
+    MLX90640_FrameTerms_t terms;
+    float irData;
+    float alphaCompensated;
+    float To;
+    int signal;
+    
+    MLX90640_GetFrameTerms(frameData, params, emissivity, tr, &terms);
+    
+    /* Pixel calculation */
+    for (int pixelNumber = 0; pixelNumber < 768; pixelNumber++) {
+        signal = MLX90640_GetPixelSignal(frameData, params, &terms, pixelNumber,
+                                         &irData, &alphaCompensated);
+        if (signal == 0) {
+            continue;   /* Measured in the other subpage */
+        }
+        
+        if (signal < 0) {
+            if (result != NULL) {
+                result[pixelNumber] = 0.0f;  /* Skip broken pixel */
+            }
+            if (sink != NULL) {
+                sink(pixelNumber, 0.0f, ctx);
+            }
+            continue;
+        }
+        
+        To = MLX90640_SignalToTemperature(params, &terms, irData, alphaCompensated);
+        
+        if (result != NULL) {
+            result[pixelNumber] = To;
+        }
+        if (sink != NULL) {
+            sink(pixelNumber, To, ctx);
+        }
+    }
+}
+
+void MLX90640_GetFrameTerms(uint16_t *frameData, const paramsMLX90640 *params,
+                            float emissivity, float tr, MLX90640_FrameTerms_t *terms)
 {
     float vdd;
     float ta;
     float ta4;
     float tr4;
-    float taTr;
     float gain;
-    float irDataCP[2];
-    float irData;
-    float alphaCompensated;
-    int8_t mode;
-    int8_t ilPattern;
-    int8_t chessPattern;
-    int8_t pattern;
-    int8_t conversionPattern;
-    float Sx;
-    float To;
-    float alphaCorrR[5];
-    int8_t range;
-    uint16_t subPage;
-    float ktaScale;
-    float kvScale;
-    float alphaScale;
-    float kta;
-    float kv;
     
-    subPage = MLX90640_GetSubPageNumber(frameData);
+    terms->subPage = MLX90640_GetSubPageNumber(frameData);
     vdd = MLX90640_GetVdd(frameData, params);
     ta = MLX90640_GetTa(frameData, params);
+    terms->vdd = vdd;
+    terms->ta = ta;
+    terms->emissivity = emissivity;
     
     ta4 = (ta + 273.15f);
     ta4 = ta4 * ta4;
@@ -258,17 +395,17 @@ void MLX90640_CalculateTo(uint16_t *frameData, const paramsMLX90640 *params,
     tr4 = (tr + 273.15f);
     tr4 = tr4 * tr4;
     tr4 = tr4 * tr4;
-    taTr = tr4 - (tr4 - ta4) / emissivity;
+    terms->taTr = tr4 - (tr4 - ta4) / emissivity;
     
-    ktaScale = POW2(params->ktaScale);
-    kvScale = POW2(params->kvScale);
-    alphaScale = POW2(params->alphaScale);
+    terms->ktaScale = POW2(params->ktaScale);
+    terms->kvScale = POW2(params->kvScale);
+    terms->alphaScale = POW2(params->alphaScale);
     
-    alphaCorrR[0] = 1 / (1 + params->ksTo[0] * 40);
-    alphaCorrR[1] = 1;
-    alphaCorrR[2] = (1 + params->ksTo[1] * params->ct[2]);
-    alphaCorrR[3] = alphaCorrR[2] * (1 + params->ksTo[2] * (params->ct[3] - params->ct[2]));
-    alphaCorrR[4] = alphaCorrR[3] * (1 + params->ksTo[3] * (params->ct[4] - params->ct[3]));
+    terms->alphaCorrR[0] = 1 / (1 + params->ksTo[0] * 40);
+    terms->alphaCorrR[1] = 1;
+    terms->alphaCorrR[2] = (1 + params->ksTo[1] * params->ct[2]);
+    terms->alphaCorrR[3] = terms->alphaCorrR[2] * (1 + params->ksTo[2] * (params->ct[3] - params->ct[2]));
+    terms->alphaCorrR[4] = terms->alphaCorrR[3] * (1 + params->ksTo[3] * (params->ct[4] - params->ct[3]));
     
     /* Gain calculation */
     gain = (int16_t)frameData[778];
@@ -276,82 +413,100 @@ void MLX90640_CalculateTo(uint16_t *frameData, const paramsMLX90640 *params,
         gain -= 65536;
     }
     gain = params->gainEE / gain;
+    terms->gain = gain;
     
     /* CP calculation */
-    mode = (frameData[832] & 0x1000) >> 12;
+    terms->mode = (frameData[832] & 0x1000) >> 12;
+    
+    terms->irDataCP[0] = (int16_t)frameData[776];
+    terms->irDataCP[1] = (int16_t)frameData[808];
+    
+    terms->irDataCP[0] = terms->irDataCP[0] * gain;
+    terms->irDataCP[1] = terms->irDataCP[1] * gain;
     
-    irDataCP[0] = (int16_t)frameData[776];
-    irDataCP[1] = (int16_t)frameData[808];
+    terms->irDataCP[0] -= params->cpOffset[0] * (1 + params->cpKta * (ta - 25)) * (1 + params->cpKv * (vdd - 3.3f));
+    if (terms->mode == params->calibrationModeEE) {
+        terms->irDataCP[1] -= params->cpOffset[1] * (1 + params->cpKta * (ta - 25)) * (1 + params->cpKv * (vdd - 3.3f));
+    } else {
+        terms->irDataCP[1] -= (params->cpOffset[1] + params->ilChessC[0]) * (1 + params->cpKta * (ta - 25)) * (1 + params->cpKv * (vdd - 3.3f));
+    }
+}
+
+int MLX90640_GetPixelSignal(uint16_t *frameData, const paramsMLX90640 *params,
+                            const MLX90640_FrameTerms_t *terms, int pixelNumber,
+                            float *irDataOut, float *alphaOut)
+{
+    int8_t ilPattern;
+    int8_t chessPattern;
+    int8_t pattern;
+    int8_t conversionPattern;
+    float irData;
+    float alphaCompensated;
+    float kta;
+    float kv;
+    float ta = terms->ta;
+    float vdd = terms->vdd;
     
-    irDataCP[0] = irDataCP[0] * gain;
-    irDataCP[1] = irDataCP[1] * gain;
+    ilPattern = pixelNumber / 32 - (pixelNumber / 64) * 2;
+    chessPattern = ilPattern ^ (pixelNumber - (pixelNumber / 2) * 2);
+    conversionPattern = ((pixelNumber + 2) / 4 - (pixelNumber + 3) / 4 + (pixelNumber + 1) / 4 - pixelNumber / 4) * (1 - 2 * ilPattern);
     
-    irDataCP[0] -= params->cpOffset[0] * (1 + params->cpKta * (ta - 25)) * (1 + params->cpKv * (vdd - 3.3f));
-    if (mode == params->calibrationModeEE) {
-        irDataCP[1] -= params->cpOffset[1] * (1 + params->cpKta * (ta - 25)) * (1 + params->cpKv * (vdd - 3.3f));
+    if (terms->mode == 0) {
+        pattern = ilPattern;
     } else {
-        irDataCP[1] -= (params->cpOffset[1] + params->ilChessC[0]) * (1 + params->cpKta * (ta - 25)) * (1 + params->cpKv * (vdd - 3.3f));
+        pattern = chessPattern;
     }
     
-    /* Pixel calculation */
-    for (int pixelNumber = 0; pixelNumber < 768; pixelNumber++) {
-        ilPattern = pixelNumber / 32 - (pixelNumber / 64) * 2;
-        chessPattern = ilPattern ^ (pixelNumber - (pixelNumber / 2) * 2);
-        conversionPattern = ((pixelNumber + 2) / 4 - (pixelNumber + 3) / 4 + (pixelNumber + 1) / 4 - pixelNumber / 4) * (1 - 2 * ilPattern);
-        
-        if (mode == 0) {
-            pattern = ilPattern;
-        } else {
-            pattern = chessPattern;
-        }
-        
-        if (pattern == subPage) {
-            irData = (int16_t)frameData[pixelNumber];
-            irData = irData * gain;
-            
-            kta = params->kta[pixelNumber] / ktaScale;
-            kv = params->kv[pixelNumber] / kvScale;
-            
-            irData -= params->offset[pixelNumber] * (1 + kta * (ta - 25)) * (1 + kv * (vdd - 3.3f));
-            
-            if (mode != params->calibrationModeEE) {
-                irData += params->ilChessC[2] * (2 * ilPattern - 1) - params->ilChessC[1] * conversionPattern;
-            }
-            
-            irData = irData - params->tgc * irDataCP[subPage];
-            irData = irData / emissivity;
-            
-            /* CRITICAL: Correct alphaCompensated calculation (from Melexis reference) */
-            if (params->alpha[pixelNumber] == 0) {
-                result[pixelNumber] = 0.0f;  /* Skip broken pixel */
-                continue;
-            }
-            alphaCompensated = SCALEALPHA * alphaScale / params->alpha[pixelNumber];
-            alphaCompensated = alphaCompensated * (1 + params->KsTa * (ta - 25));
-            alphaCompensated = alphaCompensated - params->tgc * params->cpAlpha[subPage];
-            
-            Sx = alphaCompensated * alphaCompensated * alphaCompensated * (irData + alphaCompensated * taTr);
-            Sx = sqrtf(sqrtf(Sx)) * params->ksTo[1];
-            
-            To = sqrtf(sqrtf(irData / (alphaCompensated * (1 - params->ksTo[1] * 273.15f) + Sx) + taTr)) - 273.15f;
-            
-            if (To < params->ct[1]) {
-                range = 0;
-            } else if (To < params->ct[2]) {
-                range = 1;
-            } else if (To < params->ct[3]) {
-                range = 2;
-            } else if (To < params->ct[4]) {
-                range = 3;
-            } else {
-                range = 4;
-            }
-            
-            To = sqrtf(sqrtf(irData / (alphaCompensated * alphaCorrR[range] * (1 + params->ksTo[range] * (To - params->ct[range]))) + taTr)) - 273.15f;
-            
-            result[pixelNumber] = To;
-        }
+    if (pattern != terms->subPage) {
+        return 0;
     }
+    
+    irData = (int16_t)frameData[pixelNumber];
+    irData = irData * terms->gain;
+    
+    kta = PIXEL_KTA(params, pixelNumber) / terms->ktaScale;
+    kv = PIXEL_KV(params, pixelNumber) / terms->kvScale;
+    
+    irData -= PIXEL_OFFSET(params, pixelNumber) * (1 + kta * (ta - 25)) * (1 + kv * (vdd - 3.3f));
+    
+    if (terms->mode != params->calibrationModeEE) {
+        irData += params->ilChessC[2] * (2 * ilPattern - 1) - params->ilChessC[1] * conversionPattern;
+    }
+    
+    irData = irData - params->tgc * terms->irDataCP[terms->subPage];
+    irData = irData / terms->emissivity;
+    
+    /* CRITICAL: Correct alphaCompensated calculation (from Melexis reference) */
+    uint16_t alpha = PIXEL_ALPHA(params, pixelNumber);
+    if (alpha == 0) {
+        return -1;  /* Broken pixel */
+    }
+    alphaCompensated = SCALEALPHA * terms->alphaScale / alpha;
+    alphaCompensated = alphaCompensated * (1 + params->KsTa * (ta - 25));
+    alphaCompensated = alphaCompensated - params->tgc * params->cpAlpha[terms->subPage];
+    
+    *irDataOut = irData;
+    *alphaOut = alphaCompensated;
+    return 1;
+}
+
+float MLX90640_SignalToTemperature(const paramsMLX90640 *params, const MLX90640_FrameTerms_t *terms,
+                                   float irData, float alphaCompensated)
+{
+    float Sx;
+    float To;
+    int8_t range;
+    
+    Sx = alphaCompensated * alphaCompensated * alphaCompensated * (irData + alphaCompensated * terms->taTr);
+    Sx = sqrtf(sqrtf(Sx)) * params->ksTo[1];
+    
+    To = sqrtf(sqrtf(irData / (alphaCompensated * (1 - params->ksTo[1] * 273.15f) + Sx) + terms->taTr)) - 273.15f;
+    
+    range = GetToRange(params, To);
+    
+    To = sqrtf(sqrtf(irData / (alphaCompensated * terms->alphaCorrR[range] * (1 + params->ksTo[range] * (To - params->ct[range]))) + terms->taTr)) - 273.15f;
+    
+    return To;
 }
 
 int MLX90640_SetInterleavedMode(uint8_t slaveAddr)
@@ -388,6 +543,27 @@ int MLX90640_SetChessMode(uint8_t slaveAddr)
     return error;
 }
 
+int MLX90640_SetSubPageRepeat(uint8_t slaveAddr, int subPage)
+{
+    uint16_t controlRegister;
+    uint16_t value;
+    int error;
+    
+    error = MLX90640_I2CRead(slaveAddr, MLX90640_CTRL_REG, 1, &controlRegister);
+    if (error != 0) {
+        return error;
+    }
+    
+    /* Bit 3: subpage repeat, bits 4-6: selected subpage */
+    value = controlRegister & 0xFF87;
+    if (subPage >= 0) {
+        value |= 0x0008 | ((subPage & 0x01) << 4);
+    }
+    error = MLX90640_I2CWrite(slaveAddr, MLX90640_CTRL_REG, value);
+    
+    return error;
+}
+
 int MLX90640_GetCurMode(uint8_t slaveAddr)
 {
     uint16_t controlRegister;
@@ -401,31 +577,82 @@ int MLX90640_GetCurMode(uint8_t slaveAddr)
     return (controlRegister & 0x1000) >> 12;
 }
 
-void MLX90640_BadPixelsCorrection(uint16_t *pixels, float *to, int mode,
-                                   const paramsMLX90640 *params)
+int MLX90640_BuildBadPixelTable(const paramsMLX90640 *params, int mode,
+                                MLX90640_BadPixelFix_t *table)
 {
-    (void)mode;
-    (void)params;
+    static const int8_t diagonal[4][2] = { {-1, -1}, {-1, 1}, {1, -1}, {1, 1} };
+    int count = 0;
     
-    /* Simple bad pixel interpolation from neighbors */
-    for (int i = 0; i < 5; i++) {
-        if (pixels[i] != 0xFFFF && pixels[i] < 768) {
-            uint16_t pix = pixels[i];
-            int row = pix / 32;
-            int col = pix % 32;
-            float sum = 0;
-            int count = 0;
-            
-            /* Average from valid neighbors */
-            if (row > 0) { sum += to[pix - 32]; count++; }
-            if (row < 23) { sum += to[pix + 32]; count++; }
-            if (col > 0) { sum += to[pix - 1]; count++; }
-            if (col < 31) { sum += to[pix + 1]; count++; }
-            
-            if (count > 0) {
-                to[pix] = sum / count;
+    for (int i = 0; i < 10 && count < MLX90640_MAX_BAD_PIXELS; i++) {
+        uint16_t pix = (i < 5) ? params->brokenPixels[i] : params->outlierPixels[i - 5];
+        if (pix >= 768) {
+            continue;
+        }
+        
+        MLX90640_BadPixelFix_t *fix = &table[count++];
+        int row = pix / 32;
+        int col = pix % 32;
+        int n = 0;
+        
+        fix->pixel = pix;
+        
+        if (mode == 1) {
+            /* Chess: diagonal neighbours share the subpage */
+            fix->subPage = (uint8_t)((row ^ col) & 1);
+            for (int k = 0; k < 4; k++) {
+                int r = row + diagonal[k][0];
+                int c = col + diagonal[k][1];
+                if (r >= 0 && r < 24 && c >= 0 && c < 32 && !IsPixelBad(r * 32 + c, params)) {
+                    fix->neighbour[n++] = (uint16_t)(r * 32 + c);
+                }
+            }
+            for (int k = 0; k < n; k++) {
+                fix->weight[k] = 1.0f / n;
+            }
+        } else {
+            /* Interleaved: the row is one subpage */
+            fix->subPage = (uint8_t)(row & 1);
+            if (col > 0 && col < 31) {
+                fix->neighbour[0] = pix - 1;
+                fix->neighbour[1] = pix + 1;
+                fix->weight[0] = 0.5f;
+                fix->weight[1] = 0.5f;
+                n = 2;
+            } else {
+                int step = (col == 0) ? 1 : -1;
+                fix->neighbour[0] = (uint16_t)(pix + step);
+                fix->weight[0] = 1.0f;
+                n = 1;
+                if (!IsPixelBad(pix + 2 * step, params)) {
+                    /* Linear extrapolation from the two nearest pixels */
+                    fix->neighbour[1] = (uint16_t)(pix + 2 * step);
+                    fix->weight[0] = 2.0f;
+                    fix->weight[1] = -1.0f;
+                    n = 2;
+                }
             }
         }
+        
+        fix->count = (uint8_t)n;
+    }
+    
+    return count;
+}
+
+void MLX90640_BadPixelsCorrection(const MLX90640_BadPixelFix_t *table, int count,
+                                  int subPage, float *to)
+{
+    for (int i = 0; i < count; i++) {
+        const MLX90640_BadPixelFix_t *fix = &table[i];
+        if (fix->subPage != subPage || fix->count == 0) {
+            continue;
+        }
+        
+        float value = 0.0f;
+        for (int k = 0; k < fix->count; k++) {
+            value += fix->weight[k] * to[fix->neighbour[k]];
+        }
+        to[fix->pixel] = value;
     }
 }
 
@@ -556,23 +783,23 @@ static void ExtractKsToParameters(uint16_t *eeData, paramsMLX90640 *params)
     params->ksTo[4] = -0.0002f;
 }
 
-static void ExtractAlphaParameters(uint16_t *eeData, paramsMLX90640 *params)
+static void ExtractAlphaParameters(uint16_t *eeData, paramsMLX90640 *params, MLX90640_PixelCoeffs_t *pc)
 {
     int accRow[24];
     int accColumn[32];
     int p = 0;
     int alphaRef;
     uint8_t alphaScale;
+    uint8_t alphaScaleEE;
     uint8_t accRowScale;
     uint8_t accColumnScale;
     uint8_t accRemScale;
-    float alphaTemp[768];
     float temp;
     
     accRemScale = eeData[32] & 0x000F;
     accColumnScale = (eeData[32] & 0x00F0) >> 4;
     accRowScale = (eeData[32] & 0x0F00) >> 8;
-    alphaScale = ((eeData[32] & 0xF000) >> 12) + 30;
+    alphaScaleEE = ((eeData[32] & 0xF000) >> 12) + 30;
     alphaRef = eeData[33];
     
     for (int i = 0; i < 6; i++) {
@@ -587,6 +814,7 @@ static void ExtractAlphaParameters(uint16_t *eeData, paramsMLX90640 *params)
         if (accRow[i] > 7) {
             accRow[i] -= 16;
         }
+        pc->alphaRow[i] = alphaRef + accRow[i] * (1 << accRowScale);
     }
     
     for (int i = 0; i < 8; i++) {
@@ -601,25 +829,18 @@ static void ExtractAlphaParameters(uint16_t *eeData, paramsMLX90640 *params)
         if (accColumn[i] > 7) {
             accColumn[i] -= 16;
         }
+        pc->alphaColumn[i] = accColumn[i] * (1 << accColumnScale);
     }
+    pc->alphaRemScale = accRemScale;
     
-    for (int i = 0; i < 24; i++) {
-        for (int j = 0; j < 32; j++) {
-            p = 32 * i + j;
-            alphaTemp[p] = (eeData[64 + p] & 0x03F0) >> 4;
-            if (alphaTemp[p] > 31) {
-                alphaTemp[p] -= 64;
-            }
-            alphaTemp[p] *= POW2(accRemScale);
-            alphaTemp[p] += alphaRef + accRow[i] * POW2(accRowScale) + accColumn[j] * POW2(accColumnScale);
-            alphaTemp[p] /= POW2(alphaScale);
-        }
-    }
+    pc->alphaUnit = 1.0f / POW2(alphaScaleEE);
     
-    temp = alphaTemp[0];
-    for (int i = 1; i < 768; i++) {
-        if (alphaTemp[i] > temp) {
-            temp = alphaTemp[i];
+    /* Stored alpha is reciprocal: scale for the smallest sensitivity */
+    temp = 0.0f;
+    for (int i = 0; i < 768; i++) {
+        float alpha = AlphaNumerator(pc, i) * pc->alphaUnit;
+        if (alpha > 0.0f && SCALEALPHA / alpha > temp) {
+            temp = SCALEALPHA / alpha;
         }
     }
 
@@ -634,15 +855,11 @@ static void ExtractAlphaParameters(uint16_t *eeData, paramsMLX90640 *params)
         alphaScale++;
     }
     
-    for (int i = 0; i < 768; i++) {
-        temp = alphaTemp[i] * POW2(alphaScale);
-        params->alpha[i] = (uint16_t)(temp + 0.5f);
-    }
-    
     params->alphaScale = alphaScale;
+    pc->alphaReciprocal = SCALEALPHA * POW2(alphaScale);
 }
 
-static void ExtractOffsetParameters(uint16_t *eeData, paramsMLX90640 *params)
+static void ExtractOffsetParameters(uint16_t *eeData, MLX90640_PixelCoeffs_t *pc)
 {
     int occRow[24];
     int occColumn[32];
@@ -672,6 +889,7 @@ static void ExtractOffsetParameters(uint16_t *eeData, paramsMLX90640 *params)
         if (occRow[i] > 7) {
             occRow[i] -= 16;
         }
+        pc->offsetRow[i] = (int16_t)(offsetRef + occRow[i] * (1 << occRowScale));
     }
     
     for (int i = 0; i < 8; i++) {
@@ -686,32 +904,20 @@ static void ExtractOffsetParameters(uint16_t *eeData, paramsMLX90640 *params)
         if (occColumn[i] > 7) {
             occColumn[i] -= 16;
         }
+        pc->offsetColumn[i] = (int16_t)(occColumn[i] * (1 << occColumnScale));
     }
-    
-    for (int i = 0; i < 24; i++) {
-        for (int j = 0; j < 32; j++) {
-            p = 32 * i + j;
-            params->offset[p] = (eeData[64 + p] & 0xFC00) >> 10;
-            if (params->offset[p] > 31) {
-                params->offset[p] -= 64;
-            }
-            params->offset[p] *= (1 << occRemScale);
-            params->offset[p] += offsetRef + occRow[i] * (1 << occRowScale) + occColumn[j] * (1 << occColumnScale);
-        }
-    }
+    pc->offsetRemScale = occRemScale;
 }
 
-static void ExtractKtaPixelParameters(uint16_t *eeData, paramsMLX90640 *params)
+static void ExtractKtaPixelParameters(uint16_t *eeData, paramsMLX90640 *params, MLX90640_PixelCoeffs_t *pc)
 {
-    int p = 0;
     int8_t KtaRoRe;
     int8_t KtaRoCo;
     int8_t KtaReCo;
     int8_t KtaReRe;
     uint8_t ktaScale1;
     uint8_t ktaScale2;
-    uint8_t split;
-    float ktaTemp[768];
+    int32_t ktaMax;
     float temp;
     
     KtaRoRe = (eeData[54] & 0xFF00) >> 8;
@@ -734,125 +940,76 @@ static void ExtractKtaPixelParameters(uint16_t *eeData, paramsMLX90640 *params)
     ktaScale1 = ((eeData[56] & 0x00F0) >> 4) + 8;
     ktaScale2 = eeData[56] & 0x000F;
     
-    for (int i = 0; i < 24; i++) {
-        for (int j = 0; j < 32; j++) {
-            p = 32 * i + j;
-            split = 2 * (p / 32 - (p / 64) * 2) + p % 2;
-            ktaTemp[p] = (eeData[64 + p] & 0x000E) >> 1;
-            if (ktaTemp[p] > 3) {
-                ktaTemp[p] -= 8;
-            }
-            ktaTemp[p] *= (1 << ktaScale2);
-            
-            if (split == 0) {
-                ktaTemp[p] += KtaRoRe;
-            } else if (split == 1) {
-                ktaTemp[p] += KtaReCo;
-            } else if (split == 2) {
-                ktaTemp[p] += KtaRoCo;
-            } else {
-                ktaTemp[p] += KtaReRe;
-            }
-            
-            ktaTemp[p] /= POW2(ktaScale1);
-        }
-    }
+    pc->ktaRC[0] = KtaRoRe;
+    pc->ktaRC[1] = KtaReCo;
+    pc->ktaRC[2] = KtaRoCo;
+    pc->ktaRC[3] = KtaReRe;
+    pc->ktaRemScale = ktaScale2;
     
-    temp = fabsf(ktaTemp[0]);
-    for (int i = 1; i < 768; i++) {
-        if (fabsf(ktaTemp[i]) > temp) {
-            temp = fabsf(ktaTemp[i]);
+    /* Integer numerators: kta = numerator / 2^ktaScale1 */
+    ktaMax = 0;
+    for (int i = 0; i < 768; i++) {
+        int32_t numerator = KtaNumerator(pc, i);
+        if (numerator < 0) {
+            numerator = -numerator;
         }
+        if (numerator > ktaMax) {
+            ktaMax = numerator;
+        }
+    }
+    temp = ktaMax / POW2(ktaScale1);
+    if (temp <= 0.0f) {
+        temp = 1.0f;  /* All zero: any scale decodes to zero */
     }
     
-    ktaScale1 = 0;
+    uint8_t ktaScale = 0;
     while (temp < 63.4f) {
         temp *= 2;
-        ktaScale1++;
-    }
-    
-    for (int i = 0; i < 768; i++) {
-        temp = ktaTemp[i] * POW2(ktaScale1);
-        if (temp < 0) {
-            params->kta[i] = (int8_t)(temp - 0.5f);
-        } else {
-            params->kta[i] = (int8_t)(temp + 0.5f);
-        }
+        ktaScale++;
     }
     
-    params->ktaScale = ktaScale1;
+    params->ktaScale = ktaScale;
+    pc->ktaShift = (int8_t)(ktaScale - ktaScale1);
 }
 
-static void ExtractKvPixelParameters(uint16_t *eeData, paramsMLX90640 *params)
+static void ExtractKvPixelParameters(uint16_t *eeData, paramsMLX90640 *params, MLX90640_PixelCoeffs_t *pc)
 {
-    int p = 0;
-    int8_t KvRoRe;
-    int8_t KvRoCo;
-    int8_t KvReCo;
-    int8_t KvReRe;
-    uint8_t kvScale;
-    uint8_t split;
-    float kvTemp[768];
+    int8_t KvRC[4];
+    uint8_t kvScaleEE;
+    int32_t kvMax;
     float temp;
     
-    KvRoRe = (eeData[52] & 0xF000) >> 12;
-    if (KvRoRe > 7) {
-        KvRoRe -= 16;
-    }
-    KvReCo = (eeData[52] & 0x0F00) >> 8;
-    if (KvReCo > 7) {
-        KvReCo -= 16;
-    }
-    KvRoCo = (eeData[52] & 0x00F0) >> 4;
-    if (KvRoCo > 7) {
-        KvRoCo -= 16;
-    }
-    KvReRe = eeData[52] & 0x000F;
-    if (KvReRe > 7) {
-        KvReRe -= 16;
+    /* Row/column parity groups: RoRe, ReCo, RoCo, ReRe */
+    for (int i = 0; i < 4; i++) {
+        KvRC[i] = (eeData[52] >> (12 - 4 * i)) & 0x000F;
+        if (KvRC[i] > 7) {
+            KvRC[i] -= 16;
+        }
     }
     
-    kvScale = (eeData[56] & 0x0F00) >> 8;
+    kvScaleEE = (eeData[56] & 0x0F00) >> 8;
     
-    for (int i = 0; i < 24; i++) {
-        for (int j = 0; j < 32; j++) {
-            p = 32 * i + j;
-            split = 2 * (p / 32 - (p / 64) * 2) + p % 2;
-            
-            if (split == 0) {
-                kvTemp[p] = KvRoRe;
-            } else if (split == 1) {
-                kvTemp[p] = KvReCo;
-            } else if (split == 2) {
-                kvTemp[p] = KvRoCo;
-            } else {
-                kvTemp[p] = KvReRe;
-            }
-            
-            kvTemp[p] /= POW2(kvScale);
+    kvMax = 0;
+    for (int i = 0; i < 4; i++) {
+        int32_t kv = (KvRC[i] < 0) ? -KvRC[i] : KvRC[i];
+        if (kv > kvMax) {
+            kvMax = kv;
         }
     }
-    
-    temp = fabsf(kvTemp[0]);
-    for (int i = 1; i < 768; i++) {
-        if (fabsf(kvTemp[i]) > temp) {
-            temp = fabsf(kvTemp[i]);
-        }
+    temp = kvMax / POW2(kvScaleEE);
+    if (temp <= 0.0f) {
+        temp = 1.0f;  /* All zero: any scale decodes to zero */
     }
     
-    kvScale = 0;
+    uint8_t kvScale = 0;
     while (temp < 63.4f) {
         temp *= 2;
         kvScale++;
     }
     
-    for (int i = 0; i < 768; i++) {
-        temp = kvTemp[i] * POW2(kvScale);
-        if (temp < 0) {
-            params->kv[i] = (int8_t)(temp - 0.5f);
-        } else {
-            params->kv[i] = (int8_t)(temp + 0.5f);
-        }
+    /* kv depends only on the group: keep the four scaled values */
+    for (int i = 0; i < 4; i++) {
+        pc->kvRC[i] = (int8_t)RoundShift(KvRC[i], kvScale - kvScaleEE);
     }
     
     params->kvScale = kvScale;
@@ -1051,3 +1208,20 @@ static int IsPixelBad(uint16_t pixel, const paramsMLX90640 *params)
     }
     return 0;
 }
+
+/**
+ * @brief Select the temperature range of a first-pass To estimate
+ */
+static int8_t GetToRange(const paramsMLX90640 *params, float To)
+{
+    if (To < params->ct[1]) {
+        return 0;
+    } else if (To < params->ct[2]) {
+        return 1;
+    } else if (To < params->ct[3]) {
+        return 2;
+    } else if (To < params->ct[4]) {
+        return 3;
+    }
+    return 4;
+}
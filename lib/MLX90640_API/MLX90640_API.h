@@ -14,6 +14,7 @@ extern "C" {
 #endif
 
 #include <stdint.h>
+#include "config.h"
 
 /*============================================================================*/
 /* Constants                                                                  */
@@ -24,10 +25,43 @@ extern "C" {
 #define MLX90640_EEPROM_ERROR       -2
 #define MLX90640_BROKEN_PIXEL_ERROR -3
 
+#define MLX90640_MAX_BAD_PIXELS     4       /* Broken + outlier pixels accepted by ExtractParameters */
+
 /*============================================================================*/
 /* Types                                                                      */
 /*============================================================================*/
 
+/**
+ * @brief Per-pixel calibration in EEPROM form
+ *
+ * The 768 pixel words (offset 15:10, alpha 9:4, kta 3:1, outlier 0) plus
+ * the row/column corrections they are relative to. Pixel p in row r,
+ * column c and parity group g decodes as
+ *   offset = offsetRow[r] + offsetColumn[c] + offsetEE * 2^offsetRemScale
+ *   alpha  = round(alphaReciprocal / ((alphaRow[r] + alphaColumn[c]
+ *                  + alphaEE * 2^alphaRemScale) * alphaUnit))
+ *   kta    = round((ktaRC[g] + ktaEE * 2^ktaRemScale) * 2^ktaShift)
+ *   kv     = kvRC[g]
+ * giving exactly the alpha/offset/kta/kv table entries of the expanded
+ * form (alpha is the scaled reciprocal sensitivity, as in the Melexis
+ * reference). Kept in paramsMLX90640 when MLX90640_PACKED_CALIBRATION is set.
+ */
+typedef struct {
+    uint16_t pixelEE[768];
+    int16_t offsetRow[24];
+    int16_t offsetColumn[32];
+    int32_t alphaRow[24];
+    int32_t alphaColumn[32];
+    float alphaUnit;                /* 2^-alphaScaleEE */
+    float alphaReciprocal;          /* SCALEALPHA * 2^alphaScale */
+    int16_t ktaRC[4];
+    int8_t kvRC[4];
+    uint8_t offsetRemScale;
+    uint8_t alphaRemScale;
+    uint8_t ktaRemScale;
+    int8_t ktaShift;
+} MLX90640_PixelCoeffs_t;
+
 typedef struct {
     int16_t kVdd;
     int16_t vdd25;
@@ -44,12 +78,16 @@ typedef struct {
     float KsTa;
     float ksTo[5];
     int16_t ct[5];
+#if MLX90640_PACKED_CALIBRATION
+    MLX90640_PixelCoeffs_t pixel;   /* Decoded per pixel in the kernel */
+#else
     uint16_t alpha[768];
-    uint8_t alphaScale;
     int16_t offset[768];
     int8_t kta[768];
-    uint8_t ktaScale;
     int8_t kv[768];
+#endif
+    uint8_t alphaScale;
+    uint8_t ktaScale;
     uint8_t kvScale;
     float cpAlpha[2];
     int16_t cpOffset[2];
@@ -58,6 +96,51 @@ typedef struct {
     uint16_t outlierPixels[5];
 } paramsMLX90640;
 
+/**
+ * @brief Per-pixel consumer called as each temperature is computed
+ * @param pixelNumber Pixel index (0-767)
+ * @param to Object temperature (0.0 for broken pixels)
+ * @param ctx User context
+ */
+typedef void (*MLX90640_PixelSink_t)(int pixelNumber, float to, void *ctx);
+
+/**
+ * @brief Precomputed replacement for one broken/outlier pixel
+ *
+ * to[pixel] = sum(weight[k] * to[neighbour[k]]), where all neighbours
+ * belong to the same subpage as the pixel in the current mode.
+ */
+typedef struct {
+    uint16_t pixel;
+    uint8_t subPage;
+    uint8_t count;
+    uint16_t neighbour[4];
+    float weight[4];
+} MLX90640_BadPixelFix_t;
+
+/**
+ * @brief Per-subpage terms shared by every pixel of one frame
+ *
+ * Filled by MLX90640_GetFrameTerms. After compensation the object
+ * temperature of a pixel depends only on irData / alphaCompensated and
+ * these terms, so one pixel can be converted without the rest of the
+ * frame.
+ */
+typedef struct {
+    uint16_t subPage;
+    int8_t mode;
+    float vdd;
+    float ta;
+    float taTr;
+    float emissivity;
+    float gain;
+    float irDataCP[2];
+    float ktaScale;
+    float kvScale;
+    float alphaScale;
+    float alphaCorrR[5];
+} MLX90640_FrameTerms_t;
+
 /*============================================================================*/
 /* API Functions                                                              */
 /*============================================================================*/
@@ -156,6 +239,58 @@ float MLX90640_GetTa(uint16_t *frameData, const paramsMLX90640 *params);
 void MLX90640_CalculateTo(uint16_t *frameData, const paramsMLX90640 *params,
                           float emissivity, float tr, float *result);
 
+/**
+ * @brief Calculate object temperatures, streaming each pixel to a sink
+ *
+ * Same as MLX90640_CalculateTo, but every pixel of the subpage is also
+ * passed to sink right after it is computed (fused consumer pass).
+ *
+ * @param frameData Frame data
+ * @param params Calibration parameters
+ * @param emissivity Surface emissivity
+ * @param tr Reflected temperature
+ * @param result Output temperature array (768 pixels, NULL if the sink
+ *               stores the pixels itself)
+ * @param sink Pixel consumer (NULL for none)
+ * @param ctx Context passed to sink
+ */
+void MLX90640_CalculateToStream(uint16_t *frameData, const paramsMLX90640 *params,
+                                float emissivity, float tr, float *result,
+                                MLX90640_PixelSink_t sink, void *ctx);
+
+/**
+ * @brief Compute the per-subpage terms of a frame (no roots)
+ * @param frameData Frame data
+ * @param params Calibration parameters
+ * @param emissivity Surface emissivity
+ * @param tr Reflected temperature
+ * @param terms Output terms
+ */
+void MLX90640_GetFrameTerms(uint16_t *frameData, const paramsMLX90640 *params,
+                            float emissivity, float tr, MLX90640_FrameTerms_t *terms);
+
+/**
+ * @brief Compensated IR signal of one pixel
+ * @param frameData Frame data
+ * @param params Calibration parameters
+ * @param terms Terms from MLX90640_GetFrameTerms
+ * @param pixelNumber Pixel index (0-767)
+ * @param irData Compensated IR data (output)
+ * @param alphaCompensated Compensated sensitivity, always > 0 (output)
+ * @return 1 if measured, 0 if the pixel belongs to the other subpage,
+ *         -1 for a broken pixel
+ */
+int MLX90640_GetPixelSignal(uint16_t *frameData, const paramsMLX90640 *params,
+                            const MLX90640_FrameTerms_t *terms, int pixelNumber,
+                            float *irData, float *alphaCompensated);
+
+/**
+ * @brief Object temperature of a compensated signal (as in MLX90640_CalculateTo)
+ * @return Object temperature in °C
+ */
+float MLX90640_SignalToTemperature(const paramsMLX90640 *params, const MLX90640_FrameTerms_t *terms,
+                                   float irData, float alphaCompensated);
+
 /**
  * @brief Set interleaved mode
  * @param slaveAddr I2C slave address
@@ -170,6 +305,14 @@ int MLX90640_SetInterleavedMode(uint8_t slaveAddr);
  */
 int MLX90640_SetChessMode(uint8_t slaveAddr);
 
+/**
+ * @brief Measure one subpage repeatedly, or return to alternating subpages
+ * @param slaveAddr I2C slave address
+ * @param subPage Subpage to repeat (0/1), negative to alternate
+ * @return 0 on success
+ */
+int MLX90640_SetSubPageRepeat(uint8_t slaveAddr, int subPage);
+
 /**
  * @brief Get current mode
  * @param slaveAddr I2C slave address
@@ -178,14 +321,29 @@ int MLX90640_SetChessMode(uint8_t slaveAddr);
 int MLX90640_GetCurMode(uint8_t slaveAddr);
 
 /**
- * @brief Correct bad pixels
- * @param pixels Broken/outlier pixel indices
+ * @brief Build the bad-pixel correction table for a readout mode
+ *
+ * Chess mode uses the diagonal neighbours, interleaved mode the
+ * neighbours in the same row (extrapolated at the left/right edge), so
+ * every neighbour is measured in the same subpage as the bad pixel.
+ *
+ * @param params Calibration parameters (brokenPixels/outlierPixels)
+ * @param mode Readout mode (0=interleaved, 1=chess)
+ * @param table Output table (MLX90640_MAX_BAD_PIXELS entries)
+ * @return Number of entries
+ */
+int MLX90640_BuildBadPixelTable(const paramsMLX90640 *params, int mode,
+                                MLX90640_BadPixelFix_t *table);
+
+/**
+ * @brief Correct the bad pixels of one subpage
+ * @param table Correction table from MLX90640_BuildBadPixelTable
+ * @param count Number of entries
+ * @param subPage Subpage just computed into to
  * @param to Temperature array
- * @param mode Current mode
- * @param params Calibration parameters
  */
-void MLX90640_BadPixelsCorrection(uint16_t *pixels, float *to, int mode,
-                                   const paramsMLX90640 *params);
+void MLX90640_BadPixelsCorrection(const MLX90640_BadPixelFix_t *table, int count,
+                                  int subPage, float *to);
 
 #ifdef __cplusplus
 }
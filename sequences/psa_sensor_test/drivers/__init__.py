@@ -3,5 +3,6 @@ PSA Sensor Test Drivers Package
 """
 
 from .psa_mcu import PSAMCUDriver
+from .fixture_pool import PSAFixturePool
 
-__all__ = ["PSAMCUDriver"]
+__all__ = ["PSAMCUDriver", "PSAFixturePool"]
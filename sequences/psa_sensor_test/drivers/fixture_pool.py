@@ -0,0 +1,320 @@
+"""
+PSA Fixture Pool Driver Module
+
+Drives several PSA MCU fixtures from one station process. Every fixture
+gets its own AsyncSerialTransport/AsyncPSAClient, all serviced by the same
+event loop, so a test plan runs on all fixtures at the same time instead of
+one after another.
+"""
+
+import asyncio
+import logging
+import sys
+import time
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Any, Awaitable, Callable, Dict, List, Optional, Tuple, Union
+
+# Import BaseDriver - try relative import first, fallback to direct import
+try:
+    from .base import BaseDriver
+    from .psa_mcu import CELSIUS_MULTIPLIER, parse_test_report, resolve_mlx_statistic
+except ImportError:
+    from base import BaseDriver
+    from psa_mcu import CELSIUS_MULTIPLIER, parse_test_report, resolve_mlx_statistic
+
+# Add libs folder to sys.path for psa_protocol import
+_libs_path = Path(__file__).parent.parent / "libs"
+if str(_libs_path) not in sys.path:
+    sys.path.insert(0, str(_libs_path))
+
+from psa_protocol import (
+    AsyncSerialTransport,
+    AsyncPSAClient,
+    VL53L0XSpec,
+    MLX90640Spec,
+    SensorID,
+)
+
+logger = logging.getLogger(__name__)
+
+# Async callable run against one fixture: (fixture_name, client) -> result dict
+FixtureRoutine = Callable[[str, AsyncPSAClient], Awaitable[Dict[str, Any]]]
+
+
+@dataclass
+class Fixture:
+    """One MCU fixture managed by the pool."""
+    name: str
+    port: str
+    baudrate: int = 115200
+    timeout: float = 5.0
+    client: Optional[AsyncPSAClient] = None
+    firmware_version: Optional[Tuple[int, int, int]] = None
+    errors: List[str] = field(default_factory=list)
+
+    @property
+    def connected(self) -> bool:
+        return self.client is not None and self.client.transport.is_open
+
+
+class PSAFixturePool(BaseDriver):
+    """
+    Concurrent driver for multiple PSA MCU fixtures.
+
+    Attributes:
+        fixtures: Fixtures keyed by name
+        connect_retries: PING attempts per fixture during connect
+    """
+
+    def __init__(
+        self,
+        name: str = "PSAFixturePool",
+        config: Optional[Dict[str, Any]] = None
+    ):
+        """
+        Initialize fixture pool.
+
+        Args:
+            name: Driver name
+            config: Configuration with keys:
+                - fixtures: List of dicts with name, port, baudrate, timeout
+                - connect_retries: PING attempts on connect (default: 5)
+                - connect_ping_timeout: Per-attempt PING timeout (default: 0.2)
+        """
+        super().__init__(name=name, config=config)
+
+        self.connect_retries: int = self.config.get("connect_retries", 5)
+        self.connect_ping_timeout: float = self.config.get("connect_ping_timeout", 0.2)
+
+        self.fixtures: Dict[str, Fixture] = {}
+        for index, entry in enumerate(self.config.get("fixtures", [])):
+            fixture = Fixture(
+                name=entry.get("name", f"fixture{index}"),
+                port=entry["port"],
+                baudrate=entry.get("baudrate", 115200),
+                timeout=entry.get("timeout", 5.0),
+            )
+            self.fixtures[fixture.name] = fixture
+
+    async def connect(self) -> bool:
+        """
+        Open and verify all fixtures concurrently.
+
+        Returns:
+            bool: True if every fixture answered PING
+        """
+        if not self.fixtures:
+            logger.error("No fixtures configured")
+            return False
+
+        results = await asyncio.gather(
+            *(self._connect_fixture(f) for f in self.fixtures.values())
+        )
+
+        self._connected = any(results)
+        logger.info(f"Fixture pool connected: {sum(results)}/{len(results)}")
+        return all(results)
+
+    async def disconnect(self) -> None:
+        """Close all fixtures."""
+        await asyncio.gather(
+            *(self._disconnect_fixture(f) for f in self.fixtures.values())
+        )
+        self._connected = False
+        logger.info("Disconnected fixture pool")
+
+    async def reset(self) -> None:
+        """Re-ping all connected fixtures."""
+        if not self._connected:
+            raise RuntimeError("Fixture pool not connected")
+
+        async def _ping(fixture: Fixture) -> None:
+            fixture.firmware_version = await fixture.client.ping()
+
+        await asyncio.gather(
+            *(_ping(f) for f in self.fixtures.values() if f.connected)
+        )
+
+    async def identify(self) -> str:
+        """
+        Return pool identification string.
+
+        Returns:
+            str: Fixture names with their firmware versions
+        """
+        parts = []
+        for fixture in self.fixtures.values():
+            if fixture.firmware_version:
+                v = fixture.firmware_version
+                parts.append(f"{fixture.name}=FW-{v[0]}.{v[1]}.{v[2]}")
+            else:
+                parts.append(f"{fixture.name}=Unknown")
+        return "PSA-POOL," + ",".join(parts)
+
+    # === Measurement Methods ===
+
+    async def run_plan(
+        self,
+        plan: Union[Dict[str, Dict[str, Any]], FixtureRoutine],
+        fixtures: Optional[List[str]] = None
+    ) -> Dict[str, Dict[str, Any]]:
+        """
+        Run a test plan on all fixtures concurrently.
+
+        A plan is either a dict of sensor specs, e.g.
+        {"vl53l0x": {"target_mm": 500, "tolerance_mm": 100},
+         "mlx90640": {"target_celsius": 25.0, "tolerance_celsius": 10.0,
+                      "statistic": "percentile", "percentile": 95}},
+        or an async callable taking (fixture_name, client). The MLX90640
+        statistic names are those of PSAMCUDriver.test_mlx90640 (default
+        "max").
+
+        Args:
+            plan: Spec dict or async routine
+            fixtures: Fixture names to run on (None runs on all connected)
+
+        Returns:
+            Dict keyed by fixture name with passed, duration_s, results, error
+
+        Raises:
+            ValueError: If a fixture name is not configured or the spec
+                dict is invalid (checked before any fixture is touched)
+        """
+        if fixtures is not None:
+            unknown = [n for n in fixtures if n not in self.fixtures]
+            if unknown:
+                raise ValueError(
+                    f"Unknown fixture(s) {', '.join(unknown)}; "
+                    f"configured: {', '.join(self.fixtures) or 'none'}"
+                )
+        names = fixtures or [f.name for f in self.fixtures.values() if f.connected]
+        routine = plan if callable(plan) else self._spec_routine(plan)
+
+        outcomes = await asyncio.gather(
+            *(self._run_on_fixture(self.fixtures[n], routine) for n in names)
+        )
+        return dict(zip(names, outcomes))
+
+    def metrics(self) -> Dict[str, Dict[str, Any]]:
+        """
+        Return per-fixture latency/throughput metrics.
+
+        Returns:
+            Dict keyed by fixture name
+        """
+        return {
+            f.name: f.client.get_metrics()
+            for f in self.fixtures.values() if f.client is not None
+        }
+
+    # === Helper Methods ===
+
+    async def _connect_fixture(self, fixture: Fixture) -> bool:
+        """Open one fixture and wait for it to answer PING."""
+        transport = AsyncSerialTransport(port=fixture.port, baudrate=fixture.baudrate)
+        client = AsyncPSAClient(
+            transport=transport,
+            response_timeout=fixture.timeout,
+            retry_count=1
+        )
+
+        try:
+            await client.open()
+        except Exception as e:
+            fixture.errors.append(str(e))
+            logger.error(f"[{fixture.name}] Failed to open {fixture.port}: {e}")
+            return False
+
+        # Poll with short PINGs instead of a fixed settle delay
+        for attempt in range(self.connect_retries):
+            try:
+                fixture.firmware_version = await client.ping(timeout=self.connect_ping_timeout)
+                break
+            except Exception as e:
+                logger.debug(f"[{fixture.name}] PING attempt {attempt + 1} failed: {e}")
+        else:
+            fixture.errors.append("No PING response")
+            logger.error(f"[{fixture.name}] No PING response on {fixture.port}")
+            await client.close()
+            return False
+
+        client.retry_count = 3
+        fixture.client = client
+        v = fixture.firmware_version
+        logger.info(f"[{fixture.name}] Connected on {fixture.port}, firmware v{v[0]}.{v[1]}.{v[2]}")
+        return True
+
+    async def _disconnect_fixture(self, fixture: Fixture) -> None:
+        """Close one fixture."""
+        if fixture.client is not None:
+            try:
+                await fixture.client.close()
+            except Exception:
+                pass
+            fixture.client = None
+
+    async def _run_on_fixture(self, fixture: Fixture, routine: FixtureRoutine) -> Dict[str, Any]:
+        """Run routine on one fixture, capturing errors instead of raising."""
+        start = time.monotonic()
+        outcome: Dict[str, Any] = {"passed": False, "results": {}, "error": None}
+
+        if not fixture.connected:
+            outcome["error"] = "Not connected"
+        else:
+            try:
+                outcome["results"] = await routine(fixture.name, fixture.client)
+                outcome["passed"] = bool(outcome["results"]) and all(
+                    r.get("passed", False) for r in outcome["results"].values()
+                )
+            except Exception as e:
+                outcome["error"] = str(e)
+                fixture.errors.append(str(e))
+                logger.error(f"[{fixture.name}] Plan failed: {e}")
+
+        outcome["duration_s"] = time.monotonic() - start
+        return outcome
+
+    @staticmethod
+    def _spec_routine(plan: Dict[str, Dict[str, Any]]) -> FixtureRoutine:
+        """
+        Build a routine that sets each sensor spec and runs its test.
+
+        Raises:
+            ValueError: If the plan names an unknown sensor or statistic
+        """
+        unknown = [key for key in plan if key not in ("vl53l0x", "mlx90640")]
+        if unknown:
+            raise ValueError(f"Unknown sensor(s) in plan: {', '.join(unknown)}")
+
+        mlx = plan.get("mlx90640")
+        if mlx is not None:
+            mlx_statistic, mlx_percentile = resolve_mlx_statistic(
+                mlx.get("statistic", "max"), mlx.get("percentile", 95)
+            )
+
+        async def routine(name: str, client: AsyncPSAClient) -> Dict[str, Any]:
+            results = {}
+
+            vl = plan.get("vl53l0x")
+            if vl is not None:
+                await client.set_spec_vl53l0x(VL53L0XSpec(
+                    target_dist=vl.get("target_mm", 500),
+                    tolerance=vl.get("tolerance_mm", 100),
+                ))
+                report = await client.test_single(SensorID.VL53L0X, timeout=15.0)
+                results["vl53l0x"] = parse_test_report(report, "VL53L0X")
+
+            if mlx is not None:
+                await client.set_spec_mlx90640(MLX90640Spec(
+                    target_temp=int(mlx.get("target_celsius", 25.0) * CELSIUS_MULTIPLIER),
+                    tolerance=int(mlx.get("tolerance_celsius", 10.0) * CELSIUS_MULTIPLIER),
+                    statistic=mlx_statistic,
+                    percentile=mlx_percentile,
+                ))
+                report = await client.test_single(SensorID.MLX90640, timeout=20.0)
+                results["mlx90640"] = parse_test_report(report, "MLX90640")
+
+            return results
+
+        return routine
@@ -8,6 +8,7 @@ Uses libs/psa_protocol wrapper for clean imports.
 import asyncio
 import logging
 import sys
+import time
 from pathlib import Path
 from typing import Any, Dict, List, Optional, Tuple
 
@@ -24,11 +25,15 @@ if str(_libs_path) not in sys.path:
 
 from psa_protocol import (
     SerialTransport,
+    RecordingTransport,
+    ReplayTransport,
     PSAClient,
     VL53L0XSpec,
     MLX90640Spec,
+    MLXStatistic,
     SensorID,
     TestReport,
+    TestStatus,
 )
 
 logger = logging.getLogger(__name__)
@@ -36,6 +41,66 @@ logger = logging.getLogger(__name__)
 # MCU는 온도를 celsius * 10 형태로 전송/수신
 CELSIUS_MULTIPLIER = 10
 
+# Sequence statistic names -> (MLXStatistic, fixed percentile or None)
+MLX_STATISTICS = {
+    "max": (MLXStatistic.PIXEL, None),      # Legacy frame max
+    "min": (MLXStatistic.MIN, None),
+    "mean": (MLXStatistic.MEAN, None),
+    "median": (MLXStatistic.PERCENTILE, 50),
+    "percentile": (MLXStatistic.PERCENTILE, None),
+    "trimmed_mean": (MLXStatistic.TRIMMED_MEAN, None),
+}
+
+
+def resolve_mlx_statistic(statistic: str, percentile: int) -> Tuple[int, int]:
+    """
+    Map a sequence statistic name to the MLX90640Spec statistic and percentile.
+
+    Raises:
+        ValueError: If the statistic name is unknown
+    """
+    if statistic.lower() not in MLX_STATISTICS:
+        raise ValueError(f"Unknown MLX90640 statistic: {statistic}")
+    stat, fixed_percentile = MLX_STATISTICS[statistic.lower()]
+    if fixed_percentile is not None:
+        return stat, fixed_percentile
+    return stat, percentile if stat == MLXStatistic.PERCENTILE else 0
+
+
+def parse_test_report(report: TestReport, sensor_name: str) -> Dict[str, Any]:
+    """Parse TestReport into dictionary."""
+    result = {
+        "sensor": sensor_name,
+        "passed": report.pass_count > 0 and report.fail_count == 0,
+        "timestamp": report.timestamp,
+    }
+
+    if report.results:
+        r = report.results[0]
+        result.update({
+            "status": r.status,
+            "status_name": r.status_name,
+        })
+
+        if r.result:
+            if sensor_name == "VL53L0X":
+                result["measured_mm"] = r.result.measured
+                result["target_mm"] = r.result.target
+                result["tolerance_mm"] = r.result.tolerance
+                result["diff_mm"] = r.result.diff
+            elif sensor_name == "MLX90640":
+                # Use property methods for automatic x10 conversion
+                result["measured_celsius"] = r.result.measured_celsius
+                result["target_celsius"] = r.result.target_celsius
+                result["tolerance_celsius"] = r.result.tolerance_celsius
+                result["diff_celsius"] = r.result.diff_celsius
+                result["ambient_celsius"] = r.result.ambient_celsius
+                # None when a single-pixel spec was decided on the pixel path
+                result["min_temp_celsius"] = r.result.min_temp_celsius
+                result["max_temp_celsius"] = r.result.max_temp_celsius
+
+    return result
+
 
 class PSAMCUDriver(BaseDriver):
     """
@@ -47,8 +112,92 @@ class PSAMCUDriver(BaseDriver):
         port: Serial port path
         baudrate: Communication speed
         timeout: Response timeout in seconds
+        idle_revalidate_s: Idle time after which a reused session is
+            revalidated with a real PING (0 disables caching; applied specs
+            are then always sent)
     """
 
+    # Drivers kept open across sequence runs, keyed by _session_key()
+    _sessions: Dict[Tuple[Any, ...], "PSAMCUDriver"] = {}
+
+    @staticmethod
+    def _session_key(config: Dict[str, Any]) -> Tuple[Any, ...]:
+        """
+        Cache key for a driver configuration.
+
+        Live, capture and replay sessions on the same port are distinct, as
+        are captures to different files and replays at different speeds.
+        """
+        replay_file = config.get("replay_file")
+        capture_file = config.get("capture_file")
+        if replay_file:
+            transport = "replay"
+        elif capture_file:
+            transport = "capture"
+        else:
+            transport = "serial"
+        return (
+            transport,
+            config.get("port", "/dev/ttyUSB0"),
+            config.get("baudrate", 115200),
+            capture_file,
+            replay_file,
+            config.get("replay_speed", 1.0) if replay_file else None,
+            bool(config.get("replay_strict", False)) if replay_file else None,
+        )
+
+    @classmethod
+    async def acquire_session(cls, config: Dict[str, Any]) -> Optional["PSAMCUDriver"]:
+        """
+        Return an open driver for the configured port, reusing a cached one.
+
+        A cached session that has been idle longer than idle_revalidate_s is
+        revalidated with a single PING; if that fails the port is reopened.
+
+        Args:
+            config: Driver configuration (see __init__)
+
+        Returns:
+            Connected driver, or None if the MCU could not be reached
+        """
+        key = cls._session_key(config)
+        driver = cls._sessions.get(key)
+
+        if driver is not None and driver._connected and driver._transport and driver._transport.is_open:
+            driver.timeout = config.get("timeout", driver.timeout)
+            driver.idle_revalidate_s = config.get("idle_revalidate_s", driver.idle_revalidate_s)
+            if driver._client:
+                driver._client.response_timeout = driver.timeout
+            try:
+                await driver._revalidate()
+                logger.debug(f"Reusing PSA MCU session on {driver.port} ({key[0]})")
+                return driver
+            except Exception as e:
+                logger.warning(f"Cached PSA MCU session on {driver.port} is stale: {e}")
+                await driver.disconnect()
+
+        cls._sessions.pop(key, None)
+        driver = cls(config=config)
+        if not await driver.connect():
+            return None
+        cls._sessions[key] = driver
+        return driver
+
+    async def release_session(self, keep: bool = True) -> None:
+        """
+        Return driver to the session cache, or close it.
+
+        Args:
+            keep: Keep the port open for the next run
+        """
+        if keep and self._connected:
+            return
+
+        key = self._session_key(self.config)
+        if self._sessions.get(key) is self:
+            del self._sessions[key]
+        await self.disconnect()
+
     def __init__(
         self,
         name: str = "PSAMCUDriver",
@@ -63,17 +212,31 @@ class PSAMCUDriver(BaseDriver):
                 - port: Serial port (default: "/dev/ttyUSB0")
                 - baudrate: Baud rate (default: 115200)
                 - timeout: Response timeout (default: 5.0)
+                - idle_revalidate_s: Session cache idle threshold (default: 0)
+                - capture_file: Record all serial traffic to this file
+                - replay_file: Play back a capture instead of opening the port
+                - replay_speed: Replay timing scale (default: 1.0, 0 = instant)
+                - replay_strict: Fail on TX that differs from the capture (default: False)
         """
         super().__init__(name=name, config=config)
 
         self.port: str = self.config.get("port", "/dev/ttyUSB0")
         self.baudrate: int = self.config.get("baudrate", 115200)
         self.timeout: float = self.config.get("timeout", 5.0)
+        self.idle_revalidate_s: float = self.config.get("idle_revalidate_s", 0.0)
+        self.capture_file: Optional[str] = self.config.get("capture_file")
+        self.replay_file: Optional[str] = self.config.get("replay_file")
+        self.replay_speed: float = self.config.get("replay_speed", 1.0)
+        self.replay_strict: bool = self.config.get("replay_strict", False)
 
         self._transport: Optional[SerialTransport] = None
         self._client: Optional[PSAClient] = None
         self._firmware_version: Optional[Tuple[int, int, int]] = None
 
+        # Session cache (valid only while the port stays open)
+        self._last_activity: float = 0.0
+        self._applied_specs: Dict[int, Any] = {}
+
     async def connect(self) -> bool:
         """
         Connect to MCU via serial port.
@@ -85,11 +248,26 @@ class PSAMCUDriver(BaseDriver):
             logger.info(f"Connecting to PSA MCU on {self.port} at {self.baudrate} bps")
 
             # Create transport and client (synchronous operations)
-            self._transport = SerialTransport(
-                port=self.port,
-                baudrate=self.baudrate,
-                timeout=self.timeout
-            )
+            if self.replay_file:
+                self._transport = ReplayTransport(
+                    capture_path=self.replay_file,
+                    speed=self.replay_speed,
+                    strict=self.replay_strict,
+                    timeout=self.timeout
+                )
+            elif self.capture_file:
+                self._transport = RecordingTransport(
+                    port=self.port,
+                    capture_path=self.capture_file,
+                    baudrate=self.baudrate,
+                    timeout=self.timeout
+                )
+            else:
+                self._transport = SerialTransport(
+                    port=self.port,
+                    baudrate=self.baudrate,
+                    timeout=self.timeout
+                )
             self._transport.open()
 
             self._client = PSAClient(
@@ -98,7 +276,8 @@ class PSAMCUDriver(BaseDriver):
             )
 
             # Verify connection with PING
-            await asyncio.sleep(0.1)  # Brief delay for MCU ready
+            if not self.replay_file:
+                await asyncio.sleep(0.1)  # Brief delay for MCU ready
             self._firmware_version = await self._run_sync(self._client.ping)
 
             self._connected = True
@@ -122,6 +301,7 @@ class PSAMCUDriver(BaseDriver):
 
         self._client = None
         self._connected = False
+        self.invalidate_cache()
         logger.info("Disconnected from PSA MCU")
 
     async def reset(self) -> None:
@@ -150,19 +330,25 @@ class PSAMCUDriver(BaseDriver):
         """
         Send PING and return firmware version.
 
+        Always a real PING/PONG round trip, also on a cached session; use
+        this as the communication test.
+
         Returns:
             str: Firmware version (e.g., "1.0.0")
         """
         if not self._client:
             raise RuntimeError("Not connected to MCU")
 
-        version = await self._run_sync(self._client.ping)
+        self._firmware_version = await self._run_sync(self._client.ping)
+        version = self._firmware_version
         return f"{version[0]}.{version[1]}.{version[2]}"
 
     async def get_sensor_list(self) -> List[Dict[str, Any]]:
         """
         Get list of registered sensors.
 
+        Always queried from the MCU, also on a cached session.
+
         Returns:
             List of sensor info dictionaries
         """
@@ -187,12 +373,14 @@ class PSAMCUDriver(BaseDriver):
             raise RuntimeError("Not connected to MCU")
 
         spec = VL53L0XSpec(target_dist=target_mm, tolerance=tolerance_mm)
-        return await self._run_sync(self._client.set_spec_vl53l0x, spec)
+        return await self._apply_spec(SensorID.VL53L0X, spec, self._client.set_spec_vl53l0x)
 
     async def set_spec_mlx90640(
         self,
         target_celsius: float,
         tolerance_celsius: float,
+        statistic: int = MLXStatistic.PIXEL,
+        percentile: int = 0,
     ) -> bool:
         """
         Set MLX90640 test specification.
@@ -200,6 +388,8 @@ class PSAMCUDriver(BaseDriver):
         Args:
             target_celsius: Target temperature in Celsius
             tolerance_celsius: Tolerance in Celsius
+            statistic: Frame statistic compared against target (default: frame max)
+            percentile: Percentile 0-100 when statistic is PERCENTILE
 
         Returns:
             bool: True if successful
@@ -207,11 +397,10 @@ class PSAMCUDriver(BaseDriver):
         if not self._client:
             raise RuntimeError("Not connected to MCU")
 
-        spec = MLX90640Spec(
-            target_temp=int(target_celsius * CELSIUS_MULTIPLIER),
-            tolerance=int(tolerance_celsius * CELSIUS_MULTIPLIER),
-        )
-        return await self._run_sync(self._client.set_spec_mlx90640, spec)
+        spec = self._mlx_spec(target_celsius, tolerance_celsius, statistic, percentile)
+        # The report echoes only target and tolerance: read a cached spec back
+        return await self._apply_spec(SensorID.MLX90640, spec, self._client.set_spec_mlx90640,
+                                      self._client.get_spec_mlx90640)
 
     async def test_vl53l0x(
         self,
@@ -241,12 +430,25 @@ class PSAMCUDriver(BaseDriver):
             timeout=15.0
         )
 
+        if not self._spec_echoed(report, VL53L0XSpec(target_dist=target_mm, tolerance=tolerance_mm)):
+            # MCU lost the cached spec (e.g. reset between runs) - resend and retest
+            logger.warning("VL53L0X spec mismatch in report, re-applying spec")
+            self._applied_specs.clear()
+            await self.set_spec_vl53l0x(target_mm, tolerance_mm)
+            report = await self._run_sync(
+                self._client.test_single,
+                SensorID.VL53L0X,
+                timeout=15.0
+            )
+
         return self._parse_test_report(report, "VL53L0X")
 
     async def test_mlx90640(
         self,
         target_celsius: float = 25.0,
-        tolerance_celsius: float = 10.0
+        tolerance_celsius: float = 10.0,
+        statistic: str = "max",
+        percentile: int = 95
     ) -> Dict[str, Any]:
         """
         Run MLX90640 temperature test.
@@ -254,6 +456,9 @@ class PSAMCUDriver(BaseDriver):
         Args:
             target_celsius: Target temperature in Celsius
             tolerance_celsius: Tolerance in Celsius
+            statistic: Frame statistic compared against target
+                (max, min, mean, median, percentile, trimmed_mean)
+            percentile: Percentile 0-100 when statistic is "percentile"
 
         Returns:
             Dict with test results
@@ -261,8 +466,10 @@ class PSAMCUDriver(BaseDriver):
         if not self._client:
             raise RuntimeError("Not connected to MCU")
 
-        # Set spec first (use average temperature)
-        await self.set_spec_mlx90640(target_celsius, tolerance_celsius)
+        statistic, percentile = resolve_mlx_statistic(statistic, percentile)
+
+        # Set spec first
+        await self.set_spec_mlx90640(target_celsius, tolerance_celsius, statistic, percentile)
 
         # Run test (MLX90640 needs warmup time, use longer timeout)
         report = await self._run_sync(
@@ -271,6 +478,19 @@ class PSAMCUDriver(BaseDriver):
             timeout=20.0
         )
 
+        if not self._spec_echoed(
+            report,
+            self._mlx_spec(target_celsius, tolerance_celsius, statistic, percentile),
+        ):
+            logger.warning("MLX90640 spec mismatch in report, re-applying spec")
+            self._applied_specs.clear()
+            await self.set_spec_mlx90640(target_celsius, tolerance_celsius, statistic, percentile)
+            report = await self._run_sync(
+                self._client.test_single,
+                SensorID.MLX90640,
+                timeout=20.0
+            )
+
         return self._parse_test_report(report, "MLX90640")
 
     async def test_all(self) -> Dict[str, Any]:
@@ -300,40 +520,76 @@ class PSAMCUDriver(BaseDriver):
             ]
         }
 
+    # === Session Cache ===
+
+    def invalidate_cache(self) -> None:
+        """Forget cached firmware version and applied specs."""
+        self._firmware_version = None
+        self._applied_specs.clear()
+        self._last_activity = 0.0
+
+    def _session_fresh(self) -> bool:
+        """True if the link was active recently enough to skip revalidation."""
+        if not self.idle_revalidate_s:
+            return False
+        return (time.monotonic() - self._last_activity) < self.idle_revalidate_s
+
+    async def _revalidate(self) -> None:
+        """PING a reused session unless it was active within idle_revalidate_s."""
+        if self._firmware_version is None or not self._session_fresh():
+            self._firmware_version = await self._run_sync(self._client.ping)
+
+    async def _apply_spec(self, sensor_id: int, spec: Any, setter, getter=None) -> bool:
+        """
+        Send spec unless the same spec is already applied in this session.
+
+        getter reads the MCU spec back for sensors whose report does not
+        echo every spec field; a cached spec is then trusted only if the
+        MCU still holds exactly that spec.
+        """
+        if self.idle_revalidate_s and self._applied_specs.get(sensor_id) == spec:
+            if getter is None or await self._run_sync(getter) == spec:
+                return True
+            logger.warning(f"MCU spec for sensor 0x{sensor_id:02X} differs from cache, re-applying")
+            del self._applied_specs[sensor_id]
+
+        success = await self._run_sync(setter, spec)
+        if success:
+            self._applied_specs[sensor_id] = spec
+        return success
+
+    def _spec_echoed(self, report: TestReport, spec: Any) -> bool:
+        """Check the report carries the spec we believe is applied."""
+        if not self.idle_revalidate_s or not report.results:
+            return True
+        entry = report.results[0]
+        if entry.status == TestStatus.FAIL_NO_SPEC:
+            return False
+        # Only measured outcomes carry the spec back; errors report zeros
+        if entry.result is None or entry.status not in (TestStatus.PASS, TestStatus.FAIL_INVALID):
+            return True
+        if isinstance(spec, MLX90640Spec):
+            target = spec.target_temp
+        else:
+            target = spec.target_dist
+        return entry.result.target == target and entry.result.tolerance == spec.tolerance
+
     # === Helper Methods ===
 
+    @staticmethod
+    def _mlx_spec(target_celsius: float, tolerance_celsius: float,
+                  statistic: int, percentile: int) -> MLX90640Spec:
+        """Build the MLX90640 spec sent for a test."""
+        return MLX90640Spec(
+            target_temp=int(target_celsius * CELSIUS_MULTIPLIER),
+            tolerance=int(tolerance_celsius * CELSIUS_MULTIPLIER),
+            statistic=statistic,
+            percentile=percentile,
+        )
+
     def _parse_test_report(self, report: TestReport, sensor_name: str) -> Dict[str, Any]:
         """Parse TestReport into dictionary."""
-        result = {
-            "sensor": sensor_name,
-            "passed": report.pass_count > 0 and report.fail_count == 0,
-            "timestamp": report.timestamp,
-        }
-
-        if report.results:
-            r = report.results[0]
-            result.update({
-                "status": r.status,
-                "status_name": r.status_name,
-            })
-
-            if r.result:
-                if sensor_name == "VL53L0X":
-                    result["measured_mm"] = r.result.measured
-                    result["target_mm"] = r.result.target
-                    result["tolerance_mm"] = r.result.tolerance
-                    result["diff_mm"] = r.result.diff
-                elif sensor_name == "MLX90640":
-                    # Use property methods for automatic x10 conversion
-                    result["measured_celsius"] = r.result.measured_celsius
-                    result["target_celsius"] = r.result.target_celsius
-                    result["tolerance_celsius"] = r.result.tolerance_celsius
-                    result["diff_celsius"] = r.result.diff_celsius
-                    result["ambient_celsius"] = r.result.ambient_celsius
-                    result["min_temp_celsius"] = r.result.min_temp_celsius
-                    result["max_temp_celsius"] = r.result.max_temp_celsius
-
-        return result
+        return parse_test_report(report, sensor_name)
 
     async def _run_sync(self, func, *args, **kwargs) -> Any:
         """
@@ -343,4 +599,11 @@ class PSAMCUDriver(BaseDriver):
         so we run it in a thread pool to avoid blocking.
         """
         loop = asyncio.get_running_loop()
-        return await loop.run_in_executor(None, lambda: func(*args, **kwargs))
+        try:
+            result = await loop.run_in_executor(None, lambda: func(*args, **kwargs))
+        except Exception:
+            # MCU state is unknown after a failed exchange
+            self.invalidate_cache()
+            raise
+        self._last_activity = time.monotonic()
+        return result
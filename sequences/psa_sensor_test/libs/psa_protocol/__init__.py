@@ -5,46 +5,76 @@ This package provides:
 - Protocol constants and error codes
 - CRC-8 CCITT calculation
 - Frame parsing and building
-- Serial transport layer
-- High-level protocol client
+- Serial transport layer (threaded and asyncio)
+- Capture record/replay transports for hardware-free testing
+- High-level protocol client (sync and asyncio)
 - Sensor data structures
 """
 
 from .constants import (
-    STX, ETX, MAX_PAYLOAD,
-    Command, Response, SensorID, TestStatus, ErrorCode
+    STX, ETX, MAX_PAYLOAD, MLX_TEMP_NOT_MEASURED,
+    Command, Response, SensorID, TestStatus, ErrorCode, MLXStatistic,
+    ThermalFilterMode, ThermalAcqMode, Framing, DefectClass
 )
 from .crc import CRC8
 from .exceptions import (
     PSAProtocolError, NAKError, FrameError, CRCError, ConnectionError, TimeoutError
 )
-from .frame import Frame, FrameBuilder, FrameParser, ParseResult
+from .frame import (
+    Frame, FrameBuilder, FrameParser, CobsFrameParser, ParseResult,
+    cobs_encode, cobs_decode
+)
 from .sensors import (
     MLX90640Spec, MLX90640Result,
     VL53L0XSpec, VL53L0XResult,
-    SensorInfo, SensorTestResult, TestReport
+    SensorInfo, SensorTestResult, TestReport,
+    JournalInfo, JournalEntry, BootInfo, MemInfo
+)
+from .thermal import (
+    ThermalBlob, BlobReport, ThermalStats,
+    ThermalZone, ZoneResult, ZoneReport,
+    GoldenInfo, GoldenResult, NoiseReport, FilterInfo,
+    RecorderInfo, RecordedSubpage
 )
 from .transport import SerialTransport
+from .rtt_transport import RTTTransport
 from .client import PSAClient
+from .async_transport import AsyncSerialTransport
+from .async_client import AsyncPSAClient, ClientMetrics
+from .capture import (
+    CaptureRecord, CaptureWriter, read_capture,
+    RecordingTransport, ReplayTransport
+)
 
 __version__ = "1.0.0"
 __all__ = [
     # Constants
-    "STX", "ETX", "MAX_PAYLOAD",
-    "Command", "Response", "SensorID", "TestStatus", "ErrorCode",
+    "STX", "ETX", "MAX_PAYLOAD", "MLX_TEMP_NOT_MEASURED",
+    "Command", "Response", "SensorID", "TestStatus", "ErrorCode", "MLXStatistic",
+    "ThermalFilterMode", "ThermalAcqMode", "Framing", "DefectClass",
     # CRC
     "CRC8",
     # Exceptions
     "PSAProtocolError", "NAKError", "FrameError", "CRCError",
     "ConnectionError", "TimeoutError",
     # Frame
-    "Frame", "FrameBuilder", "FrameParser", "ParseResult",
+    "Frame", "FrameBuilder", "FrameParser", "CobsFrameParser", "ParseResult",
+    "cobs_encode", "cobs_decode",
     # Sensors
     "MLX90640Spec", "MLX90640Result",
     "VL53L0XSpec", "VL53L0XResult",
     "SensorInfo", "SensorTestResult", "TestReport",
+    "JournalInfo", "JournalEntry", "BootInfo", "MemInfo",
+    # Thermal analytics
+    "ThermalBlob", "BlobReport", "ThermalStats",
+    "ThermalZone", "ZoneResult", "ZoneReport",
+    "GoldenInfo", "GoldenResult", "NoiseReport", "FilterInfo",
+    "RecorderInfo", "RecordedSubpage",
     # Transport
-    "SerialTransport",
+    "SerialTransport", "AsyncSerialTransport", "RTTTransport",
+    # Capture / replay
+    "CaptureRecord", "CaptureWriter", "read_capture",
+    "RecordingTransport", "ReplayTransport",
     # Client
-    "PSAClient",
+    "PSAClient", "AsyncPSAClient", "ClientMetrics",
 ]
@@ -0,0 +1,327 @@
+"""
+Asyncio protocol client.
+
+Same API surface as PSAClient, but every call is a coroutine driven by an
+AsyncSerialTransport, so many MCUs can be talked to concurrently from a
+single event loop. Per-client latency and throughput metrics are kept.
+"""
+
+import asyncio
+import logging
+import time
+from dataclasses import dataclass
+from typing import List, Optional, Tuple
+
+from .constants import Response, SensorID
+from .frame import Frame, FrameBuilder, FrameParser, ParseResult
+from .sensors import (
+    MLX90640Spec, MLX90640Result,
+    VL53L0XSpec, VL53L0XResult,
+    SensorInfo, TestReport
+)
+from .async_transport import AsyncSerialTransport
+from .exceptions import NAKError, TimeoutError
+
+logger = logging.getLogger(__name__)
+
+
+@dataclass
+class ClientMetrics:
+    """Request latency and throughput counters for one client."""
+    requests: int = 0
+    timeouts: int = 0
+    naks: int = 0
+    crc_errors: int = 0
+    frames_rx: int = 0
+    latency_last: float = 0.0
+    latency_min: float = 0.0
+    latency_max: float = 0.0
+    latency_total: float = 0.0
+    started_at: float = 0.0
+
+    def record_latency(self, latency: float) -> None:
+        """Account one completed request."""
+        if self.requests == 0 or latency < self.latency_min:
+            self.latency_min = latency
+        if latency > self.latency_max:
+            self.latency_max = latency
+        self.latency_last = latency
+        self.latency_total += latency
+        self.requests += 1
+
+    @property
+    def latency_avg(self) -> float:
+        """Mean request latency in seconds."""
+        return self.latency_total / self.requests if self.requests else 0.0
+
+    def as_dict(self, bytes_tx: int = 0, bytes_rx: int = 0) -> dict:
+        """Snapshot including throughput since the client was started."""
+        elapsed = time.monotonic() - self.started_at if self.started_at else 0.0
+        return {
+            "requests": self.requests,
+            "timeouts": self.timeouts,
+            "naks": self.naks,
+            "crc_errors": self.crc_errors,
+            "frames_rx": self.frames_rx,
+            "bytes_tx": bytes_tx,
+            "bytes_rx": bytes_rx,
+            "latency_last_ms": self.latency_last * 1000.0,
+            "latency_min_ms": self.latency_min * 1000.0,
+            "latency_avg_ms": self.latency_avg * 1000.0,
+            "latency_max_ms": self.latency_max * 1000.0,
+            "requests_per_s": self.requests / elapsed if elapsed > 0 else 0.0,
+            "rx_bytes_per_s": bytes_rx / elapsed if elapsed > 0 else 0.0,
+        }
+
+
+class AsyncPSAClient:
+    """Event-loop based client for PSA Sensor Test protocol."""
+
+    def __init__(
+        self,
+        transport: AsyncSerialTransport,
+        response_timeout: float = 5.0,
+        retry_count: int = 3
+    ):
+        """
+        Initialize async PSA client.
+
+        Args:
+            transport: Async serial transport instance (not yet opened)
+            response_timeout: Timeout for response in seconds
+            retry_count: Number of retries on timeout
+        """
+        self.transport = transport
+        self.response_timeout = response_timeout
+        self.retry_count = retry_count
+        self.metrics = ClientMetrics()
+        self._parser = FrameParser()
+        self._lock = asyncio.Lock()
+        self._pending: Optional[asyncio.Future] = None
+        self._expected_cmd: Optional[int] = None
+        transport.on_data = self._on_data
+
+    async def open(self) -> None:
+        """Open the underlying transport."""
+        await self.transport.open()
+        self.metrics.started_at = time.monotonic()
+
+    async def close(self) -> None:
+        """Close the underlying transport and fail any pending request."""
+        if self._pending is not None and not self._pending.done():
+            self._pending.cancel()
+        await self.transport.close()
+
+    def _on_data(self, data: bytes) -> None:
+        """Transport callback: parse frames and complete the pending request."""
+        self._parser.feed(data)
+
+        while True:
+            result, frame, _ = self._parser.parse()
+
+            if result == ParseResult.INCOMPLETE:
+                break
+            if result == ParseResult.CRC_ERROR:
+                self.metrics.crc_errors += 1
+                logger.warning(f"CRC error in received frame on {self.transport.port}")
+                continue
+            if result == ParseResult.FORMAT_ERROR:
+                continue
+
+            self.metrics.frames_rx += 1
+            pending = self._pending
+            if pending is None or pending.done():
+                logger.debug(f"Unsolicited frame on {self.transport.port}: cmd=0x{frame.cmd:02X}")
+                continue
+
+            if frame.cmd == Response.NAK:
+                self.metrics.naks += 1
+                error_code = frame.payload[0] if frame.payload else 0
+                pending.set_exception(NAKError(error_code))
+            elif self._expected_cmd is None or frame.cmd == self._expected_cmd:
+                pending.set_result(frame)
+
+    async def _send_and_receive(
+        self,
+        frame_data: bytes,
+        expected_cmd: Optional[int] = None,
+        timeout: Optional[float] = None
+    ) -> Frame:
+        """
+        Send frame and wait for response without blocking the event loop.
+
+        Args:
+            frame_data: Frame bytes to send
+            expected_cmd: Expected response command (None accepts any)
+            timeout: Response timeout (None uses default)
+
+        Returns:
+            Received Frame
+
+        Raises:
+            NAKError: If NAK response received
+            TimeoutError: If no response within timeout
+        """
+        timeout = timeout or self.response_timeout
+        loop = asyncio.get_running_loop()
+
+        async with self._lock:
+            self._parser.clear()
+            self.transport.flush()
+
+            for attempt in range(self.retry_count):
+                self._pending = loop.create_future()
+                self._expected_cmd = expected_cmd
+
+                start_time = loop.time()
+                self.transport.send(frame_data)
+                try:
+                    frame = await asyncio.wait_for(self._pending, timeout)
+                except asyncio.TimeoutError:
+                    self.metrics.timeouts += 1
+                    logger.warning(f"Timeout on {self.transport.port} attempt {attempt + 1}")
+                    continue
+                finally:
+                    self._pending = None
+
+                self.metrics.record_latency(loop.time() - start_time)
+                return frame
+
+        raise TimeoutError(timeout, self.retry_count)
+
+    async def ping(self, timeout: Optional[float] = None) -> Tuple[int, int, int]:
+        """
+        Send PING and return firmware version.
+
+        Args:
+            timeout: Response timeout (None uses default)
+
+        Returns:
+            Tuple of (major, minor, patch) version numbers
+        """
+        frame = await self._send_and_receive(
+            FrameBuilder.build_ping(),
+            Response.PONG,
+            timeout=timeout
+        )
+        return (frame.payload[0], frame.payload[1], frame.payload[2])
+
+    async def get_sensor_list(self) -> List[SensorInfo]:
+        """
+        Get list of registered sensors.
+
+        Returns:
+            List of SensorInfo objects
+        """
+        frame = await self._send_and_receive(
+            FrameBuilder.build_get_sensor_list(),
+            Response.SENSOR_LIST
+        )
+
+        sensors = []
+        idx = 0
+        count = frame.payload[idx]; idx += 1
+
+        for _ in range(count):
+            sensor_id = frame.payload[idx]; idx += 1
+            name_len = frame.payload[idx]; idx += 1
+            name = frame.payload[idx:idx + name_len].decode('ascii')
+            idx += name_len
+            sensors.append(SensorInfo(sensor_id, name))
+
+        return sensors
+
+    async def set_spec_mlx90640(self, spec: MLX90640Spec) -> bool:
+        """Set MLX90640 specification."""
+        frame = await self._send_and_receive(
+            FrameBuilder.build_set_spec(SensorID.MLX90640, spec.to_bytes()),
+            Response.SPEC_ACK
+        )
+        return frame.payload[0] == SensorID.MLX90640
+
+    async def set_spec_vl53l0x(self, spec: VL53L0XSpec) -> bool:
+        """Set VL53L0X specification."""
+        frame = await self._send_and_receive(
+            FrameBuilder.build_set_spec(SensorID.VL53L0X, spec.to_bytes()),
+            Response.SPEC_ACK
+        )
+        return frame.payload[0] == SensorID.VL53L0X
+
+    async def get_spec_mlx90640(self) -> MLX90640Spec:
+        """Get current MLX90640 specification."""
+        frame = await self._send_and_receive(
+            FrameBuilder.build_get_spec(SensorID.MLX90640),
+            Response.SPEC_DATA
+        )
+        return MLX90640Spec.from_bytes(frame.payload[1:])
+
+    async def get_spec_vl53l0x(self) -> VL53L0XSpec:
+        """Get current VL53L0X specification."""
+        frame = await self._send_and_receive(
+            FrameBuilder.build_get_spec(SensorID.VL53L0X),
+            Response.SPEC_DATA
+        )
+        return VL53L0XSpec.from_bytes(frame.payload[1:])
+
+    async def test_single(self, sensor_id: int, timeout: Optional[float] = None) -> TestReport:
+        """
+        Run test on single sensor.
+
+        Args:
+            sensor_id: Sensor ID to test
+            timeout: Test timeout (None uses 10s)
+
+        Returns:
+            TestReport with single sensor result
+        """
+        frame = await self._send_and_receive(
+            FrameBuilder.build_test_single(sensor_id),
+            Response.TEST_RESULT,
+            timeout=timeout or 10.0
+        )
+        return TestReport.from_bytes(frame.payload)
+
+    async def test_all(self, timeout: Optional[float] = None) -> TestReport:
+        """
+        Run test on all sensors.
+
+        Args:
+            timeout: Test timeout (None uses 15s)
+
+        Returns:
+            TestReport with all sensor results
+        """
+        frame = await self._send_and_receive(
+            FrameBuilder.build_test_all(),
+            Response.TEST_RESULT,
+            timeout=timeout or 15.0
+        )
+        return TestReport.from_bytes(frame.payload)
+
+    async def read_sensor_mlx90640(
+        self,
+        timeout: Optional[float] = None
+    ) -> Tuple[int, MLX90640Result]:
+        """Read raw MLX90640 sensor data without spec comparison."""
+        frame = await self._send_and_receive(
+            FrameBuilder.build_read_sensor(SensorID.MLX90640),
+            Response.SENSOR_DATA,
+            timeout=timeout or 10.0
+        )
+        return (frame.payload[1], MLX90640Result.from_bytes(frame.payload[2:]))
+
+    async def read_sensor_vl53l0x(
+        self,
+        timeout: Optional[float] = None
+    ) -> Tuple[int, VL53L0XResult]:
+        """Read raw VL53L0X sensor data without spec comparison."""
+        frame = await self._send_and_receive(
+            FrameBuilder.build_read_sensor(SensorID.VL53L0X),
+            Response.SENSOR_DATA,
+            timeout=timeout or 10.0
+        )
+        return (frame.payload[1], VL53L0XResult.from_bytes(frame.payload[2:10]))
+
+    def get_metrics(self) -> dict:
+        """Return latency/throughput snapshot for this client."""
+        return self.metrics.as_dict(self.transport.bytes_tx, self.transport.bytes_rx)
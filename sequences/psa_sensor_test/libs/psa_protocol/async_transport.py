@@ -0,0 +1,181 @@
+"""
+Asyncio serial transport layer.
+
+Event-loop driven counterpart of SerialTransport. Instead of a receive
+thread per port, the port is opened non-blocking and registered with the
+running event loop, so any number of ports can be serviced from one thread.
+"""
+
+import asyncio
+import logging
+import sys
+from typing import Callable, Optional
+
+import serial
+
+from .exceptions import ConnectionError
+
+logger = logging.getLogger(__name__)
+
+# Callback invoked with each chunk of received bytes
+DataCallback = Callable[[bytes], None]
+
+
+class AsyncSerialTransport:
+    """Non-blocking serial transport serviced by the asyncio event loop."""
+
+    # Poll interval for platforms without add_reader support on serial ports
+    POLL_INTERVAL = 0.002
+
+    def __init__(
+        self,
+        port: str,
+        baudrate: int = 115200,
+        on_data: Optional[DataCallback] = None
+    ):
+        """
+        Initialize async serial transport.
+
+        Args:
+            port: Serial port name (e.g., '/dev/ttyUSB0' or 'COM3')
+            baudrate: Baud rate (default: 115200)
+            on_data: Callback receiving each chunk of RX bytes
+        """
+        self.port = port
+        self.baudrate = baudrate
+        self.on_data = on_data
+        self.bytes_tx = 0
+        self.bytes_rx = 0
+        self._serial: Optional[serial.Serial] = None
+        self._loop: Optional[asyncio.AbstractEventLoop] = None
+        self._poll_task: Optional[asyncio.Task] = None
+        self._reader_fd: Optional[int] = None
+
+    async def open(self) -> None:
+        """Open serial port and register it with the running event loop."""
+        self._loop = asyncio.get_running_loop()
+        try:
+            self._serial = serial.Serial(
+                port=self.port,
+                baudrate=self.baudrate,
+                bytesize=serial.EIGHTBITS,
+                parity=serial.PARITY_NONE,
+                stopbits=serial.STOPBITS_ONE,
+                timeout=0  # Non-blocking reads
+            )
+        except serial.SerialException as e:
+            raise ConnectionError(f"Failed to open {self.port}: {e}") from e
+
+        logger.info(f"Opened serial port {self.port} at {self.baudrate} bps (async)")
+
+        if sys.platform != "win32":
+            self._reader_fd = self._serial.fileno()
+            self._loop.add_reader(self._reader_fd, self._on_readable)
+        else:
+            # Proactor/selector loops on Windows cannot watch COM handles
+            self._poll_task = self._loop.create_task(self._poll_loop())
+
+    async def close(self) -> None:
+        """Unregister from the event loop and close serial port."""
+        if self._reader_fd is not None and self._loop is not None:
+            self._loop.remove_reader(self._reader_fd)
+            self._reader_fd = None
+
+        if self._poll_task is not None:
+            self._poll_task.cancel()
+            try:
+                await self._poll_task
+            except asyncio.CancelledError:
+                pass
+            self._poll_task = None
+
+        if self._serial:
+            try:
+                self._serial.close()
+            except Exception:
+                pass
+            self._serial = None
+            logger.info(f"Closed serial port {self.port}")
+
+    def send(self, data: bytes) -> int:
+        """
+        Send data over serial port.
+
+        Frames are small enough to fit the OS transmit buffer, so the write
+        does not block the event loop in practice.
+
+        Args:
+            data: Bytes to send
+
+        Returns:
+            Number of bytes sent
+
+        Raises:
+            ConnectionError: If port is not open
+        """
+        if not self._serial or not self._serial.is_open:
+            raise ConnectionError("Serial port not open")
+
+        try:
+            count = self._serial.write(data)
+            self.bytes_tx += count
+            logger.debug(f"TX {self.port} ({count} bytes): {data.hex(' ')}")
+            return count
+        except serial.SerialException as e:
+            raise ConnectionError(f"Send failed: {e}") from e
+
+    def flush(self) -> None:
+        """Discard any unread input."""
+        if self._serial and self._serial.is_open:
+            try:
+                self._serial.reset_input_buffer()
+            except Exception:
+                pass
+
+    def _on_readable(self) -> None:
+        """Event loop reader callback: drain available bytes."""
+        try:
+            data = self._serial.read(self._serial.in_waiting or 1)
+        except (serial.SerialException, OSError) as e:
+            logger.error(f"RX error on {self.port}: {e}")
+            self._loop.remove_reader(self._reader_fd)
+            self._reader_fd = None
+            return
+        self._deliver(data)
+
+    async def _poll_loop(self) -> None:
+        """Fallback receive loop for platforms without add_reader."""
+        while self._serial and self._serial.is_open:
+            try:
+                waiting = self._serial.in_waiting
+                if waiting:
+                    self._deliver(self._serial.read(waiting))
+            except serial.SerialException as e:
+                logger.error(f"RX error on {self.port}: {e}")
+                break
+            await asyncio.sleep(self.POLL_INTERVAL)
+
+    def _deliver(self, data: bytes) -> None:
+        """Forward received bytes to the registered callback."""
+        if not data:
+            return
+        self.bytes_rx += len(data)
+        logger.debug(f"RX {self.port} ({len(data)} bytes): {data.hex(' ')}")
+        if self.on_data is not None:
+            self.on_data(data)
+
+    @property
+    def is_open(self) -> bool:
+        """Check if port is open."""
+        return self._serial is not None and self._serial.is_open
+
+    async def __aenter__(self) -> 'AsyncSerialTransport':
+        await self.open()
+        return self
+
+    async def __aexit__(self, exc_type, exc_val, exc_tb) -> None:
+        await self.close()
+
+    def __repr__(self) -> str:
+        status = "open" if self.is_open else "closed"
+        return f"AsyncSerialTransport({self.port}, {self.baudrate}, {status})"
@@ -0,0 +1,322 @@
+"""
+Serial capture recording and replay.
+
+RecordingTransport is a SerialTransport that also writes every TX/RX chunk
+with its timestamp to a capture file. ReplayTransport serves such a capture
+back through the same interface without any hardware, either at the
+recorded timing, accelerated, or as fast as possible.
+
+Capture file format (big-endian):
+    Header:  magic "PSACAP" | version u8 | reserved u8 | start time f64 (unix)
+    Record:  direction 'T'/'R' | delta_us u32 (since previous record) |
+             length u16 | data
+"""
+
+import logging
+import struct
+import threading
+import time
+from dataclasses import dataclass
+from typing import BinaryIO, List, Optional
+
+from .transport import SerialTransport
+from .exceptions import ConnectionError
+
+logger = logging.getLogger(__name__)
+
+CAPTURE_MAGIC = b"PSACAP"
+CAPTURE_VERSION = 1
+
+DIR_TX = b"T"
+DIR_RX = b"R"
+
+_HEADER = struct.Struct(">6sBxd")
+_RECORD = struct.Struct(">cIH")
+_MAX_DELTA_US = 0xFFFFFFFF
+_MAX_CHUNK = 0xFFFF
+
+
+@dataclass
+class CaptureRecord:
+    """One captured chunk."""
+    direction: bytes   # DIR_TX or DIR_RX
+    timestamp: float   # Seconds since capture start
+    data: bytes
+
+    @property
+    def is_tx(self) -> bool:
+        return self.direction == DIR_TX
+
+
+class CaptureWriter:
+    """Thread-safe writer for capture files."""
+
+    def __init__(self, path: str):
+        """
+        Create capture file and write header.
+
+        Args:
+            path: Output file path
+        """
+        self.path = path
+        self._file: Optional[BinaryIO] = open(path, "wb")
+        self._lock = threading.Lock()
+        self._start = time.perf_counter()
+        self._last_us = 0
+        self._file.write(_HEADER.pack(CAPTURE_MAGIC, CAPTURE_VERSION, time.time()))
+
+    def write(self, direction: bytes, data: bytes, when: Optional[float] = None) -> None:
+        """
+        Append a record.
+
+        Args:
+            direction: DIR_TX or DIR_RX
+            data: Chunk bytes
+            when: perf_counter() timestamp (None uses now)
+        """
+        stamp = when if when is not None else time.perf_counter()
+        with self._lock:
+            if self._file is None:
+                return
+            now_us = max(int((stamp - self._start) * 1e6), self._last_us)
+            for offset in range(0, len(data), _MAX_CHUNK):
+                chunk = data[offset:offset + _MAX_CHUNK]
+                delta = min(now_us - self._last_us, _MAX_DELTA_US)
+                self._file.write(_RECORD.pack(direction, delta, len(chunk)))
+                self._file.write(chunk)
+                self._last_us += delta
+
+    def close(self) -> None:
+        """Flush and close the capture file."""
+        with self._lock:
+            if self._file is not None:
+                self._file.close()
+                self._file = None
+
+
+def read_capture(path: str) -> List[CaptureRecord]:
+    """
+    Load all records from a capture file.
+
+    Args:
+        path: Capture file path
+
+    Returns:
+        Records in file order with timestamps in seconds
+
+    Raises:
+        ValueError: If the file is not a valid capture
+    """
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if len(data) < _HEADER.size:
+        raise ValueError(f"{path}: truncated capture header")
+    magic, version, _ = _HEADER.unpack_from(data, 0)
+    if magic != CAPTURE_MAGIC or version != CAPTURE_VERSION:
+        raise ValueError(f"{path}: not a v{CAPTURE_VERSION} PSA capture")
+
+    records = []
+    idx = _HEADER.size
+    elapsed_us = 0
+    while idx + _RECORD.size <= len(data):
+        direction, delta, length = _RECORD.unpack_from(data, idx)
+        idx += _RECORD.size
+        if idx + length > len(data):
+            logger.warning(f"{path}: truncated record at offset {idx - _RECORD.size}")
+            break
+        elapsed_us += delta
+        records.append(CaptureRecord(direction, elapsed_us / 1e6, data[idx:idx + length]))
+        idx += length
+
+    return records
+
+
+class RecordingTransport(SerialTransport):
+    """SerialTransport that records all traffic to a capture file."""
+
+    def __init__(
+        self,
+        port: str,
+        capture_path: str,
+        baudrate: int = 115200,
+        timeout: float = 1.0,
+        read_timeout: float = 0.1
+    ):
+        """
+        Initialize recording transport.
+
+        Args:
+            port: Serial port name
+            capture_path: Capture file to create
+            baudrate: Baud rate (default: 115200)
+            timeout: Default receive timeout in seconds
+            read_timeout: Internal read timeout for background thread
+        """
+        super().__init__(port, baudrate, timeout, read_timeout)
+        self.capture_path = capture_path
+        self._writer: Optional[CaptureWriter] = None
+
+    def open(self) -> None:
+        """Create capture file, then open serial port."""
+        self._writer = CaptureWriter(self.capture_path)
+        try:
+            super().open()
+        except Exception:
+            self._writer.close()
+            self._writer = None
+            raise
+        logger.info(f"Recording {self.port} to {self.capture_path}")
+
+    def close(self) -> None:
+        """Close serial port and capture file."""
+        super().close()
+        if self._writer:
+            self._writer.close()
+            self._writer = None
+
+    def send(self, data: bytes) -> int:
+        """Send data and record it."""
+        stamp = time.perf_counter()
+        count = super().send(data)
+        if self._writer:
+            self._writer.write(DIR_TX, data[:count], stamp)
+        return count
+
+    def _on_rx(self, data: bytes) -> None:
+        if self._writer:
+            self._writer.write(DIR_RX, data)
+        super()._on_rx(data)
+
+
+class ReplayTransport(SerialTransport):
+    """
+    SerialTransport stand-in that plays back a capture file.
+
+    Every send() is matched against the next recorded TX chunk; the RX
+    chunks recorded after it (up to the following TX) then become
+    receivable with their original spacing divided by speed.
+    """
+
+    def __init__(
+        self,
+        capture_path: str,
+        speed: float = 1.0,
+        strict: bool = False,
+        timeout: float = 1.0
+    ):
+        """
+        Initialize replay transport.
+
+        Args:
+            capture_path: Capture file to play back
+            speed: Timing scale (1.0 = recorded timing, 10.0 = 10x faster,
+                0 = deliver immediately)
+            strict: Raise on TX data that differs from the capture
+            timeout: Default receive timeout in seconds
+        """
+        super().__init__(port=f"replay:{capture_path}", timeout=timeout)
+        self.capture_path = capture_path
+        self.speed = speed
+        self.strict = strict
+        self._records: List[CaptureRecord] = []
+        self._cursor = 0
+        self._pending: List[tuple] = []   # (due_time, data) in arrival order
+        self._cond = threading.Condition()
+        self._open = False
+
+    def open(self) -> None:
+        """Load capture and schedule any RX recorded before the first TX."""
+        try:
+            self._records = read_capture(self.capture_path)
+        except (OSError, ValueError) as e:
+            raise ConnectionError(f"Failed to open {self.capture_path}: {e}") from e
+
+        self._cursor = 0
+        self._pending = []
+        self._open = True
+        self._schedule_rx(0.0)
+        logger.info(f"Replaying {self.capture_path} ({len(self._records)} records, speed={self.speed})")
+
+    def close(self) -> None:
+        """Stop replay."""
+        with self._cond:
+            self._open = False
+            self._pending = []
+            self._cond.notify_all()
+
+    def send(self, data: bytes) -> int:
+        """
+        Consume the next recorded TX and release its responses.
+
+        Raises:
+            ConnectionError: If not open, or strict and data differs
+        """
+        if not self._open:
+            raise ConnectionError("Replay transport not open")
+
+        if self._cursor >= len(self._records):
+            if self.strict:
+                raise ConnectionError("Replay capture exhausted")
+            logger.warning("Replay capture exhausted, TX ignored")
+            return len(data)
+
+        record = self._records[self._cursor]
+        if record.data != data:
+            message = f"Replay TX mismatch: expected {record.data.hex(' ')}, got {data.hex(' ')}"
+            if self.strict:
+                raise ConnectionError(message)
+            logger.warning(message)
+
+        self._cursor += 1
+        self._schedule_rx(record.timestamp)
+        logger.debug(f"TX ({len(data)} bytes): {data.hex(' ')}")
+        return len(data)
+
+    def receive(self, timeout: Optional[float] = None) -> bytes:
+        """Receive the next due RX chunk (empty if timeout)."""
+        deadline = time.monotonic() + (timeout or self.timeout)
+        with self._cond:
+            while self._open:
+                now = time.monotonic()
+                if self._pending and self._pending[0][0] <= now:
+                    return self._pending.pop(0)[1]
+                if now >= deadline:
+                    break
+                wait = deadline - now
+                if self._pending:
+                    wait = min(wait, self._pending[0][0] - now)
+                self._cond.wait(wait)
+        return b''
+
+    def receive_all(self) -> bytes:
+        """Receive all RX chunks that are already due."""
+        data = bytearray()
+        now = time.monotonic()
+        with self._cond:
+            while self._pending and self._pending[0][0] <= now:
+                data.extend(self._pending.pop(0)[1])
+        return bytes(data)
+
+    def flush(self) -> None:
+        """Discard RX chunks that have already 'arrived'."""
+        self.receive_all()
+
+    @property
+    def is_open(self) -> bool:
+        return self._open
+
+    def _schedule_rx(self, origin: float) -> None:
+        """Queue RX records following the cursor, relative to origin."""
+        now = time.monotonic()
+        with self._cond:
+            while self._cursor < len(self._records) and not self._records[self._cursor].is_tx:
+                record = self._records[self._cursor]
+                offset = (record.timestamp - origin) / self.speed if self.speed > 0 else 0.0
+                self._pending.append((now + max(offset, 0.0), record.data))
+                self._cursor += 1
+            self._cond.notify_all()
+
+    def __repr__(self) -> str:
+        status = "open" if self.is_open else "closed"
+        return f"ReplayTransport({self.capture_path}, speed={self.speed}, {status})"
@@ -8,12 +8,18 @@ import time
 import logging
 from typing import List, Optional, Tuple
 
-from .constants import Command, Response, SensorID, ErrorCode
-from .frame import Frame, FrameBuilder, FrameParser, ParseResult
+from .constants import (
+    Command, Response, SensorID, ErrorCode, ThermalFilterMode, ThermalAcqMode, Framing, MAX_PAYLOAD
+)
+from .frame import Frame, FrameBuilder, FrameParser, CobsFrameParser, ParseResult
 from .sensors import (
     MLX90640Spec, MLX90640Result,
     VL53L0XSpec, VL53L0XResult,
-    SensorInfo, TestReport
+    SensorInfo, TestReport, JournalInfo, JournalEntry, BootInfo, MemInfo
+)
+from .thermal import (
+    BlobReport, ThermalStats, ThermalZone, ZoneReport, GoldenInfo, GoldenResult,
+    NoiseReport, FilterInfo, RecorderInfo, RecordedSubpage
 )
 from .transport import SerialTransport
 from .exceptions import NAKError, TimeoutError, PSAProtocolError
@@ -41,6 +47,7 @@ class PSAClient:
         self.transport = transport
         self.response_timeout = response_timeout
         self.retry_count = retry_count
+        self.framing = Framing.CLASSIC
         self._parser = FrameParser()
 
     def _send_and_receive(
@@ -67,6 +74,9 @@ class PSAClient:
         self._parser.clear()
         self.transport.flush()
 
+        if self.framing == Framing.COBS:
+            frame_data = FrameBuilder.to_cobs(frame_data)
+
         timeout = timeout or self.response_timeout
 
         for attempt in range(self.retry_count):
@@ -323,7 +333,7 @@ class PSAClient:
         )
 
         status = frame.payload[1]
-        result = MLX90640Result.from_bytes(frame.payload[2:16])  # 14 bytes
+        result = MLX90640Result.from_bytes(frame.payload[2:])  # 14 bytes, 16 with the defect class
 
         logger.info(f"Read MLX90640: status={status}, result={result}")
         return (status, result)
@@ -354,3 +364,562 @@ class PSAClient:
 
         logger.info(f"Read VL53L0X: status={status}, result={result}")
         return (status, result)
+
+    def get_thermal_blobs(
+        self,
+        threshold_celsius: float,
+        eight_connected: bool = True,
+        min_area: int = 1,
+        timeout: Optional[float] = None
+    ) -> BlobReport:
+        """
+        Acquire one MLX90640 frame and return its hot regions.
+
+        Args:
+            threshold_celsius: Pixels at or above this are foreground
+            eight_connected: Use 8-connectivity (False: 4-connectivity)
+            min_area: Ignore regions smaller than this (pixels)
+            timeout: Read timeout (None uses default, recommend 10s)
+
+        Returns:
+            BlobReport with the largest regions first
+        """
+        timeout = timeout or 10.0
+
+        frame = self._send_and_receive(
+            FrameBuilder.build_thermal_blobs(int(threshold_celsius * 10), eight_connected, min_area),
+            Response.BLOB_DATA,
+            timeout=timeout
+        )
+
+        report = BlobReport.from_bytes(frame.payload)
+        logger.info(f"Thermal blobs: status={report.status}, total={report.blob_total}")
+        return report
+
+    def get_thermal_stats(
+        self,
+        roi: Optional[Tuple[int, int, int, int]] = None,
+        timeout: Optional[float] = None
+    ) -> ThermalStats:
+        """
+        Acquire one MLX90640 frame and return percentile/histogram statistics.
+
+        Args:
+            roi: (x_min, y_min, x_max, y_max) inclusive, None for full frame
+            timeout: Read timeout (None uses default, recommend 10s)
+
+        Returns:
+            ThermalStats over the requested region
+        """
+        timeout = timeout or 10.0
+
+        frame = self._send_and_receive(
+            FrameBuilder.build_thermal_stats(roi),
+            Response.STATS_DATA,
+            timeout=timeout
+        )
+
+        stats = ThermalStats.from_bytes(frame.payload)
+        logger.info(f"Thermal stats: status={stats.status}, {stats}")
+        return stats
+
+    def set_thermal_zones(self, zones: List[ThermalZone]) -> int:
+        """
+        Replace the MLX90640 multi-ROI zone specs.
+
+        Zones are sent in as many SET_ZONES frames as the payload limit
+        requires; an empty list clears all zones.
+
+        Args:
+            zones: Zone specs (firmware limit THERMAL_ZONE_MAX)
+
+        Returns:
+            Number of zones configured on the MCU
+        """
+        per_frame = (MAX_PAYLOAD - 1) // ThermalZone.SIZE
+        count = 0
+        start = 0
+
+        while True:
+            chunk = zones[start:start + per_frame]
+            frame = self._send_and_receive(
+                FrameBuilder.build_set_zones(start, b''.join(z.to_bytes() for z in chunk)),
+                Response.ZONE_ACK
+            )
+            count = frame.payload[0]
+            start += len(chunk)
+            if start >= len(zones):
+                break
+
+        logger.info(f"Set {count} thermal zones")
+        return count
+
+    def test_thermal_zones(self, timeout: Optional[float] = None) -> ZoneReport:
+        """
+        Acquire one MLX90640 frame and evaluate every configured zone.
+
+        Args:
+            timeout: Read timeout (None uses default, recommend 10s)
+
+        Returns:
+            ZoneReport with one verdict per zone
+        """
+        timeout = timeout or 10.0
+
+        frame = self._send_and_receive(
+            FrameBuilder.build_test_zones(),
+            Response.ZONE_RESULT,
+            timeout=timeout
+        )
+
+        report = ZoneReport.from_bytes(frame.payload)
+        logger.info(f"Thermal zones: status={report.status}, overall={report.overall}, "
+                    f"zones={len(report.zones)}")
+        return report
+
+    def capture_golden(
+        self,
+        frames: int = 8,
+        tolerance: float = 2.0,
+        timeout: Optional[float] = None
+    ) -> GoldenInfo:
+        """
+        Capture the MLX90640 golden frame from a known-good unit.
+
+        The frame is held in MCU RAM until save_golden() is called, and every
+        pixel tolerance is reset to the given value.
+
+        Args:
+            frames: Frames to average (1-16)
+            tolerance: Default per-pixel tolerance in °C (0-25.5)
+            timeout: Read timeout (None uses ~1s per frame)
+
+        Returns:
+            GoldenInfo (status is the capture status)
+        """
+        timeout = timeout or 5.0 + frames
+
+        frame = self._send_and_receive(
+            FrameBuilder.build_golden_capture(frames, int(round(tolerance * 10))),
+            Response.GOLDEN_INFO,
+            timeout=timeout
+        )
+
+        info = GoldenInfo.from_bytes(frame.payload)
+        logger.info(f"Golden capture: status={info.status}, frames={info.frames}, "
+                    f"mean={info.mean_celsius:.1f}°C")
+        return info
+
+    def get_golden_info(self) -> GoldenInfo:
+        """Query the golden reference image state without capturing."""
+        frame = self._send_and_receive(
+            FrameBuilder.build_golden_capture(0, 0),
+            Response.GOLDEN_INFO
+        )
+        return GoldenInfo.from_bytes(frame.payload)
+
+    def set_golden_tolerance(self, tolerances: List[float], offset: int = 0) -> GoldenInfo:
+        """
+        Overwrite part of the per-pixel tolerance map.
+
+        Args:
+            tolerances: Tolerances in °C (0-25.5), one per pixel from offset
+            offset: First pixel index (y * 32 + x)
+
+        Returns:
+            GoldenInfo after the last update
+        """
+        data = bytes(min(255, max(0, int(round(t * 10)))) for t in tolerances)
+        per_frame = MAX_PAYLOAD - 2
+        frame = None
+
+        for start in range(0, len(data), per_frame):
+            frame = self._send_and_receive(
+                FrameBuilder.build_golden_tolerance(offset + start, data[start:start + per_frame]),
+                Response.GOLDEN_INFO
+            )
+
+        if frame is None:
+            return self.get_golden_info()
+        return GoldenInfo.from_bytes(frame.payload)
+
+    def save_golden(self, timeout: Optional[float] = None) -> GoldenInfo:
+        """
+        Write the golden image to MCU flash (sector erase takes ~1-2s).
+
+        Args:
+            timeout: Read timeout (None uses default, recommend 5s)
+        """
+        timeout = timeout or 5.0
+
+        frame = self._send_and_receive(
+            FrameBuilder.build_golden_save(),
+            Response.GOLDEN_INFO,
+            timeout=timeout
+        )
+
+        info = GoldenInfo.from_bytes(frame.payload)
+        logger.info(f"Golden image saved: checksum=0x{info.checksum:08X}")
+        return info
+
+    def compare_golden(self, max_out: int = 0, timeout: Optional[float] = None) -> GoldenResult:
+        """
+        Acquire one MLX90640 frame and compare it against the golden frame.
+
+        Args:
+            max_out: Out-of-tolerance pixels allowed for a PASS verdict
+            timeout: Read timeout (None uses default, recommend 10s)
+
+        Returns:
+            GoldenResult with deviation metrics
+        """
+        timeout = timeout or 10.0
+
+        frame = self._send_and_receive(
+            FrameBuilder.build_golden_compare(max_out),
+            Response.GOLDEN_RESULT,
+            timeout=timeout
+        )
+
+        result = GoldenResult.from_bytes(frame.payload)
+        logger.info(f"Golden compare: verdict={result.verdict}, out={result.out_count}, "
+                    f"rms={result.rms_dev / 100:.2f}°C, similarity={result.similarity / 1000:.3f}")
+        return result
+
+    def measure_noise(self, frames: int = 32, timeout: Optional[float] = None) -> NoiseReport:
+        """
+        Measure MLX90640 per-pixel temporal noise (NETD) over consecutive frames.
+
+        The MCU runs the whole measurement inside this one command, so it
+        accepts at most 32 frames (~8 s at 8 Hz); more is NAKed.
+
+        Args:
+            frames: Frames to accumulate (2-32)
+            timeout: Read timeout (None uses ~0.3s per frame)
+
+        Returns:
+            NoiseReport with NETD, noisiest pixels and sigma histogram
+        """
+        timeout = timeout or 5.0 + frames * 0.3
+
+        frame = self._send_and_receive(
+            FrameBuilder.build_thermal_noise(frames),
+            Response.NOISE_DATA,
+            timeout=timeout
+        )
+
+        report = NoiseReport.from_bytes(frame.payload)
+        logger.info(f"Thermal noise: status={report.status}, frames={report.frames}, "
+                    f"NETD={report.netd}mK, max={report.max_sigma}mK")
+        return report
+
+    def set_thermal_filter(self, mode: ThermalFilterMode, param: int = 0) -> FilterInfo:
+        """
+        Configure the MLX90640 per-pixel temporal filter and reset it.
+
+        Subsequent tests and reads use the filtered image; poll
+        get_thermal_filter() until settled before relying on it.
+
+        Args:
+            mode: ThermalFilterMode (OFF, EMA or WINDOW)
+            param: Alpha percent 1-100 for EMA, window length 2-8 for WINDOW
+
+        Returns:
+            FilterInfo after reset
+        """
+        frame = self._send_and_receive(
+            FrameBuilder.build_thermal_filter(int(mode), param),
+            Response.FILTER_INFO
+        )
+
+        info = FilterInfo.from_bytes(frame.payload)
+        logger.info(f"Thermal filter: mode={info.mode}, param={info.param}, "
+                    f"settle={info.settle_frames} frames")
+        return info
+
+    def get_thermal_filter(self) -> FilterInfo:
+        """Query the MLX90640 temporal filter state (frames since reset, settled)."""
+        frame = self._send_and_receive(
+            FrameBuilder.build_thermal_filter(),
+            Response.FILTER_INFO
+        )
+        return FilterInfo.from_bytes(frame.payload)
+
+    def set_acq_mode(self, mode: ThermalAcqMode) -> ThermalAcqMode:
+        """
+        Select how MLX90640 tests acquire frames.
+
+        SUBPAGE halves the acquisition time of single-pixel and
+        mean/percentile/trimmed-mean specs by reading only one subpage;
+        statistics then cover that subpage's pixels.
+
+        Args:
+            mode: ThermalAcqMode (FULL or SUBPAGE)
+
+        Returns:
+            Active mode reported by the MCU
+        """
+        frame = self._send_and_receive(
+            FrameBuilder.build_thermal_acq_mode(int(mode)),
+            Response.ACQ_MODE
+        )
+
+        active = ThermalAcqMode(frame.payload[0])
+        logger.info(f"Thermal acquisition mode: {active.name}")
+        return active
+
+    def get_acq_mode(self) -> ThermalAcqMode:
+        """Query the MLX90640 test acquisition mode."""
+        frame = self._send_and_receive(
+            FrameBuilder.build_thermal_acq_mode(),
+            Response.ACQ_MODE
+        )
+        return ThermalAcqMode(frame.payload[0])
+
+    def get_recorder_info(self, clear: bool = False) -> RecorderInfo:
+        """
+        Query the MLX90640 raw frame flight recorder.
+
+        Args:
+            clear: Drop all records before reporting
+
+        Returns:
+            RecorderInfo with the held sequence range and the last test verdict
+        """
+        frame = self._send_and_receive(
+            FrameBuilder.build_recorder_info(clear),
+            Response.RECORDER_STATE
+        )
+        return RecorderInfo.from_bytes(frame.payload)
+
+    def read_record_chunk(self, seq: int, offset: int) -> bytes:
+        """
+        Read one chunk of a recorded subpage.
+
+        Raises:
+            NAKError: NO_RECORD if the record was overwritten or never written
+        """
+        frame = self._send_and_receive(
+            FrameBuilder.build_recorder_read(seq, offset),
+            Response.RECORDER_DATA
+        )
+        return frame.payload[6:]
+
+    def download_record(self, seq: int, data: Optional[bytearray] = None) -> RecordedSubpage:
+        """
+        Download one recorded subpage chunk by chunk.
+
+        Chunks are appended to data as they arrive, so after a failed
+        transfer calling again with the same bytearray resumes where it
+        stopped.
+
+        Args:
+            seq: Record sequence number
+            data: Partial record from an interrupted download (None to start)
+
+        Returns:
+            RecordedSubpage
+        """
+        if data is None:
+            data = bytearray()
+
+        while len(data) < RecordedSubpage.SIZE:
+            chunk = self.read_record_chunk(seq, len(data))
+            if not chunk:
+                raise PSAProtocolError(f"Empty chunk at offset {len(data)} of record {seq}")
+            data.extend(chunk)
+
+        return RecordedSubpage.from_bytes(bytes(data))
+
+    def download_records(self, test_id: Optional[int] = None) -> List[RecordedSubpage]:
+        """
+        Download held records, optionally only those of one test.
+
+        The first chunk of each record carries its header, so records of
+        other tests cost one chunk each. Records overwritten during the
+        download are skipped.
+
+        Args:
+            test_id: Test id to keep (None for all, see RecorderInfo.last_test_id)
+
+        Returns:
+            Records in capture order
+        """
+        info = self.get_recorder_info()
+        records = []
+
+        for seq in range(info.oldest_seq, info.next_seq):
+            try:
+                data = bytearray(self.read_record_chunk(seq, 0))
+                if test_id is not None:
+                    record_test = int.from_bytes(data[8:10], 'big')
+                    if record_test != test_id:
+                        continue
+                records.append(self.download_record(seq, data))
+            except NAKError as e:
+                if e.error_code != ErrorCode.NO_RECORD:
+                    raise
+                logger.debug(f"Record {seq} overwritten during download")
+
+        logger.info(f"Downloaded {len(records)} recorded subpages")
+        return records
+
+    def get_journal_info(self, clear: bool = False) -> JournalInfo:
+        """
+        Query the test result journal.
+
+        Args:
+            clear: Drop all entries (and erase the flash copy) before reporting
+
+        Returns:
+            JournalInfo with the held sequence range
+        """
+        frame = self._send_and_receive(
+            FrameBuilder.build_journal_info(clear),
+            Response.JOURNAL_STATE
+        )
+        return JournalInfo.from_bytes(frame.payload)
+
+    def read_journal(self, seq: int) -> Tuple[List[JournalEntry], int]:
+        """
+        Read the journal entries that fit one response, from seq onward.
+
+        Entries no longer held are skipped, and a seq past the device's
+        next_seq (journal reset without flash) restarts at the oldest.
+
+        Returns:
+            (entries, next_seq to continue from); no entries means caught up
+        """
+        frame = self._send_and_receive(
+            FrameBuilder.build_journal_read(seq),
+            Response.JOURNAL_DATA
+        )
+        next_seq = int.from_bytes(frame.payload[0:4], 'big')
+        count = frame.payload[4]
+        entries = JournalEntry.parse_many(frame.payload[5:])
+        if len(entries) != count:
+            raise PSAProtocolError(f"JOURNAL_DATA announced {count} entries, parsed {len(entries)}")
+        return entries, next_seq
+
+    def sync_journal(self, since: int = 0) -> List[JournalEntry]:
+        """
+        Download every journal entry from a sequence number onward.
+
+        Pass the previous sync's last seq + 1 to fetch only new results,
+        or the journal next_seq read before a test whose TEST_RESULT was
+        lost to recover it without re-testing.
+
+        Args:
+            since: First sequence number wanted
+
+        Returns:
+            Entries in sequence order
+        """
+        entries = []
+        seq = since
+
+        while True:
+            chunk, seq = self.read_journal(seq)
+            if not chunk:
+                break
+            entries.extend(chunk)
+
+        logger.info(f"Synced {len(entries)} journal entries")
+        return entries
+
+    def get_boot_info(self) -> BootInfo:
+        """
+        Query sensor boot progress and per-phase timings.
+
+        Answered as soon as the protocol is up; sensor commands are NAKed
+        with BUSY until BootInfo.ready.
+        """
+        frame = self._send_and_receive(
+            FrameBuilder.build_boot_info(),
+            Response.BOOT_TIMING
+        )
+        return BootInfo.from_bytes(frame.payload)
+
+    def power_cycle_dut(self, off_ms: Optional[int] = None, wait: bool = True,
+                        timeout: float = 5.0) -> BootInfo:
+        """
+        Power-cycle the DUT and re-initialize its sensors without an MCU reset.
+
+        Use after fitting a new part. Sensor commands are NAKed with BUSY
+        until the sensors are initialized again.
+
+        Args:
+            off_ms: Time the 12V rail stays off (None = firmware default,
+                    shorter than the default is rejected)
+            wait: Poll BOOT_INFO until the sensors are ready
+            timeout: Seconds to wait for ready (from after the rail off time)
+
+        Returns:
+            BootInfo when ready (wait) or right after the cycle started
+        """
+        frame = self._send_and_receive(
+            FrameBuilder.build_dut_power_cycle(off_ms),
+            Response.BOOT_TIMING
+        )
+        info = BootInfo.from_bytes(frame.payload)
+        if not wait:
+            return info
+        return self.wait_ready(timeout + (off_ms or 0) / 1000.0)
+
+    def wait_ready(self, timeout: float = 3.0, poll_interval: float = 0.02) -> BootInfo:
+        """
+        Poll BOOT_INFO until the sensors have finished initializing.
+
+        Raises:
+            TimeoutError: If the device is not ready within timeout
+        """
+        start_time = time.time()
+        while True:
+            info = self.get_boot_info()
+            if info.ready:
+                logger.info(f"Device ready at {info.ready_ms} ms "
+                            f"(VL53L0X {'OK' if info.vl53l0x_ok else 'FAILED'}, "
+                            f"MLX90640 {'OK' if info.mlx90640_ok else 'FAILED'})")
+                return info
+            if time.time() - start_time >= timeout:
+                raise TimeoutError(timeout)
+            time.sleep(poll_interval)
+
+    def get_mem_info(self) -> MemInfo:
+        """Query RAM/flash usage and the stack high-water mark."""
+        frame = self._send_and_receive(
+            FrameBuilder.build_mem_info(),
+            Response.MEM_USAGE
+        )
+        info = MemInfo.from_bytes(frame.payload)
+        logger.info(f"Memory: stack peak {info.stack_peak} B, {info.stack_free} B never touched, "
+                    f"heap {info.heap_used} B")
+        return info
+
+    def set_framing(self, mode: Framing) -> None:
+        """
+        Switch this link between classic and COBS framing.
+
+        The firmware acknowledges in the old framing and switches right
+        after, so both sides change together. If the firmware is still in
+        the other mode (e.g. from an earlier session), the request is
+        retried in that mode once this one times out.
+
+        Args:
+            mode: Framing.CLASSIC or Framing.COBS
+        """
+        mode = Framing(mode)
+        request = FrameBuilder.build_set_framing(mode)
+        try:
+            frame = self._send_and_receive(request, Response.FRAMING)
+        except TimeoutError:
+            self._use_framing(Framing.COBS if self.framing == Framing.CLASSIC else Framing.CLASSIC)
+            frame = self._send_and_receive(request, Response.FRAMING)
+
+        self._use_framing(Framing(frame.payload[0]))
+        logger.info(f"Link framing: {self.framing.name}")
+
+    def _use_framing(self, mode: Framing) -> None:
+        """Encode requests and parse responses in the given framing."""
+        self.framing = mode
+        self._parser = CobsFrameParser() if mode == Framing.COBS else FrameParser()
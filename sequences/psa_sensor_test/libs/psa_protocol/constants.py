@@ -13,6 +13,9 @@ ETX = 0x03
 # Maximum payload size
 MAX_PAYLOAD = 64
 
+# MLX90640 result min/max when not measured (MLX90640_TEMP_NOT_MEASURED)
+MLX_TEMP_NOT_MEASURED = -32768
+
 
 class Command(IntEnum):
     """Command codes (Host -> MCU)."""
@@ -23,6 +26,25 @@ class Command(IntEnum):
     READ_SENSOR = 0x13
     SET_SPEC = 0x20
     GET_SPEC = 0x21
+    THERMAL_BLOBS = 0x30
+    THERMAL_STATS = 0x31
+    SET_ZONES = 0x32
+    TEST_ZONES = 0x33
+    GOLDEN_CAPTURE = 0x34
+    GOLDEN_TOLERANCE = 0x35
+    GOLDEN_SAVE = 0x36
+    GOLDEN_COMPARE = 0x37
+    THERMAL_NOISE = 0x38
+    THERMAL_FILTER = 0x39
+    THERMAL_ACQ_MODE = 0x3A
+    RECORDER_INFO = 0x3B
+    RECORDER_READ = 0x3C
+    JOURNAL_INFO = 0x3D
+    JOURNAL_READ = 0x3E
+    BOOT_INFO = 0x3F
+    DUT_POWER_CYCLE = 0x40
+    SET_FRAMING = 0x41
+    MEM_INFO = 0x42
 
 
 class Response(IntEnum):
@@ -33,6 +55,22 @@ class Response(IntEnum):
     SPEC_ACK = 0x82
     SPEC_DATA = 0x83
     SENSOR_DATA = 0x84
+    BLOB_DATA = 0x85
+    STATS_DATA = 0x86
+    ZONE_ACK = 0x87
+    ZONE_RESULT = 0x88
+    GOLDEN_INFO = 0x89
+    GOLDEN_RESULT = 0x8A
+    NOISE_DATA = 0x8B
+    FILTER_INFO = 0x8C
+    ACQ_MODE = 0x8D
+    RECORDER_STATE = 0x8E
+    RECORDER_DATA = 0x8F
+    JOURNAL_STATE = 0x90
+    JOURNAL_DATA = 0x91
+    BOOT_TIMING = 0x92
+    FRAMING = 0x93
+    MEM_USAGE = 0x94
     NAK = 0xFE
 
 
@@ -53,6 +91,45 @@ class SensorID(IntEnum):
         return names.get(sensor_id, f"Unknown(0x{sensor_id:02X})")
 
 
+class MLXStatistic(IntEnum):
+    """MLX90640 spec statistic selector (must match MCU sensor_types.h)."""
+    PIXEL = 0x00            # Single pixel, or frame max when pixel is 0xFF
+    MEAN = 0x01
+    PERCENTILE = 0x02
+    TRIMMED_MEAN = 0x03
+    MAX = 0x04
+    MIN = 0x05
+
+
+class ThermalFilterMode(IntEnum):
+    """MLX90640 temporal filter mode (must match MCU thermal_filter.h)."""
+    OFF = 0x00              # Buffer holds the last raw frame
+    EMA = 0x01              # Exponential moving average, param = alpha percent (1-100)
+    WINDOW = 0x02           # Mean of last N frames, param = N (2-8)
+
+
+class ThermalAcqMode(IntEnum):
+    """MLX90640 test acquisition mode (must match MCU mlx90640.h)."""
+    FULL = 0x00             # Both subpages for every test frame
+    SUBPAGE = 0x01          # Only the subpage a spec needs, when one suffices
+
+
+class Framing(IntEnum):
+    """Link framing mode (must match MCU frame.h FrameMode_t)."""
+    CLASSIC = 0x00          # [STX][LEN][CMD][PAYLOAD][CRC][ETX]
+    COBS = 0x01             # COBS([LEN][CMD][PAYLOAD][CRC]) + 0x00 delimiter
+
+
+class DefectClass(IntEnum):
+    """On-device thermal defect class (must match MCU thermal_classifier.h)."""
+    OK = 0x00
+    COLD_ZONE = 0x01
+    HOTSPOT = 0x02
+    DEAD_HEATER = 0x03
+    MISALIGNED = 0x04
+    NONE = 0xFF             # Not classified (no model, subpage or single-pixel test)
+
+
 class TestStatus(IntEnum):
     """Test status codes."""
     PASS = 0x00
@@ -87,6 +164,8 @@ class ErrorCode(IntEnum):
     BUSY = 0x04
     CRC_FAIL = 0x05
     NO_SPEC = 0x06
+    FLASH = 0x07
+    NO_RECORD = 0x08
 
     @classmethod
     def name_of(cls, error: int) -> str:
@@ -99,5 +178,7 @@ class ErrorCode(IntEnum):
             cls.BUSY: "BUSY",
             cls.CRC_FAIL: "CRC_FAIL",
             cls.NO_SPEC: "NO_SPEC",
+            cls.FLASH: "FLASH",
+            cls.NO_RECORD: "NO_RECORD",
         }
         return names.get(error, f"Unknown(0x{error:02X})")
@@ -52,7 +52,8 @@ class CRC8:
         Calculate CRC-8 over data bytes.
 
         Args:
-            data: Input bytes to calculate CRC over
+            data: Input bytes to calculate CRC over (bytes, bytearray or
+                  memoryview; memoryview slices are read without copying)
 
         Returns:
             CRC-8 value (0-255)
@@ -61,8 +62,9 @@ class CRC8:
             return 0
 
         crc = 0x00  # Initial value
+        table = cls._TABLE  # Local lookup avoids a class attribute fetch per byte
         for byte in data:
-            crc = cls._TABLE[crc ^ byte]
+            crc = table[crc ^ byte]
         return crc
 
     @classmethod
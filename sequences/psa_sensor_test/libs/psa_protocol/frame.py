@@ -9,9 +9,16 @@ Frame Format: [STX][LEN][CMD][PAYLOAD...][CRC][ETX]
 - CRC: CRC-8 CCITT of LEN+CMD+PAYLOAD
 - ETX: 0x03 (End of frame)
 
+COBS Format: COBS([LEN][CMD][PAYLOAD...][CRC]) 0x00
+- Same block without STX/ETX, Consistent Overhead Byte Stuffed so it
+  contains no zero bytes; 0x00 only ever ends a frame
+- One byte of overhead for every frame of this protocol
+- Selected per link with Command.SET_FRAMING
+
 Reference: src/protocol/frame.c
 """
 
+import struct
 from dataclasses import dataclass, field
 from enum import Enum
 from typing import Optional, Tuple
@@ -19,6 +26,53 @@ from typing import Optional, Tuple
 from .constants import STX, ETX, MAX_PAYLOAD, Command
 from .crc import CRC8
 
+COBS_DELIMITER = 0x00
+MAX_FRAME_SIZE = MAX_PAYLOAD + 5    # Largest encoded frame in either mode
+
+
+def cobs_encode(data: bytes) -> bytes:
+    """COBS-encode data in one pass (no delimiter appended)."""
+    out = bytearray(b'\x00')
+    code_idx = 0
+    code = 1
+    for byte in data:
+        if byte == 0:
+            out[code_idx] = code
+            code_idx = len(out)
+            out.append(0)
+            code = 1
+            continue
+        out.append(byte)
+        code += 1
+        if code == 0xFF:
+            out[code_idx] = code
+            code_idx = len(out)
+            out.append(0)
+            code = 1
+    out[code_idx] = code
+    return bytes(out)
+
+
+def cobs_decode(data: bytes) -> bytes:
+    """
+    Decode one COBS block (delimiter stripped).
+
+    Raises:
+        ValueError: If the block is malformed
+    """
+    out = bytearray()
+    idx = 0
+    length = len(data)
+    while idx < length:
+        code = data[idx]
+        if code == 0 or idx + code > length:
+            raise ValueError("Malformed COBS block")
+        out += data[idx + 1:idx + code]
+        idx += code
+        if code != 0xFF and idx < length:
+            out.append(0)
+    return bytes(out)
+
 
 class ParseResult(Enum):
     """Frame parse result codes."""
@@ -68,6 +122,16 @@ class FrameBuilder:
 
         return bytes([STX, length, frame.cmd]) + frame.payload + bytes([crc, ETX])
 
+    @staticmethod
+    def build_cobs(frame: Frame) -> bytes:
+        """Build complete COBS frame with CRC and delimiter."""
+        return FrameBuilder.to_cobs(FrameBuilder.build(frame))
+
+    @staticmethod
+    def to_cobs(frame_data: bytes) -> bytes:
+        """Re-encode a classic frame (as returned by the build_* methods) for COBS framing."""
+        return cobs_encode(frame_data[1:-1]) + bytes([COBS_DELIMITER])
+
     @staticmethod
     def build_ping() -> bytes:
         """Build PING command frame."""
@@ -104,17 +168,143 @@ class FrameBuilder:
         """Build READ_SENSOR command frame."""
         return FrameBuilder.build(Frame(Command.READ_SENSOR, bytes([sensor_id])))
 
+    @staticmethod
+    def build_thermal_blobs(threshold_x10: int, eight_connected: bool, min_area: int) -> bytes:
+        """Build THERMAL_BLOBS command frame."""
+        payload = struct.pack('>hBB', threshold_x10, 0x01 if eight_connected else 0x00, min_area)
+        return FrameBuilder.build(Frame(Command.THERMAL_BLOBS, payload))
+
+    @staticmethod
+    def build_thermal_stats(roi: Optional[Tuple[int, int, int, int]] = None) -> bytes:
+        """Build THERMAL_STATS command frame (roi = (x_min, y_min, x_max, y_max), None = full frame)."""
+        payload = bytes(roi) if roi is not None else b''
+        return FrameBuilder.build(Frame(Command.THERMAL_STATS, payload))
+
+    @staticmethod
+    def build_set_zones(start_index: int, zone_data: bytes) -> bytes:
+        """Build SET_ZONES command frame (start_index 0 replaces, otherwise appends)."""
+        return FrameBuilder.build(Frame(Command.SET_ZONES, bytes([start_index]) + zone_data))
+
+    @staticmethod
+    def build_test_zones() -> bytes:
+        """Build TEST_ZONES command frame."""
+        return FrameBuilder.build(Frame(Command.TEST_ZONES))
+
+    @staticmethod
+    def build_golden_capture(frames: int, default_tolerance_x10: int) -> bytes:
+        """Build GOLDEN_CAPTURE command frame (frames 0 only queries state)."""
+        return FrameBuilder.build(Frame(Command.GOLDEN_CAPTURE, bytes([frames, default_tolerance_x10])))
+
+    @staticmethod
+    def build_golden_tolerance(offset: int, tolerances_x10: bytes) -> bytes:
+        """Build GOLDEN_TOLERANCE command frame."""
+        return FrameBuilder.build(Frame(Command.GOLDEN_TOLERANCE, struct.pack('>H', offset) + tolerances_x10))
+
+    @staticmethod
+    def build_golden_save() -> bytes:
+        """Build GOLDEN_SAVE command frame."""
+        return FrameBuilder.build(Frame(Command.GOLDEN_SAVE))
+
+    @staticmethod
+    def build_golden_compare(max_out: int = 0) -> bytes:
+        """Build GOLDEN_COMPARE command frame."""
+        return FrameBuilder.build(Frame(Command.GOLDEN_COMPARE, struct.pack('>H', max_out)))
+
+    @staticmethod
+    def build_thermal_noise(frames: int) -> bytes:
+        """Build THERMAL_NOISE command frame."""
+        return FrameBuilder.build(Frame(Command.THERMAL_NOISE, struct.pack('>H', frames)))
+
+    @staticmethod
+    def build_thermal_filter(mode: Optional[int] = None, param: int = 0) -> bytes:
+        """Build THERMAL_FILTER command frame (mode None only queries state)."""
+        payload = bytes([mode, param]) if mode is not None else b''
+        return FrameBuilder.build(Frame(Command.THERMAL_FILTER, payload))
+
+    @staticmethod
+    def build_thermal_acq_mode(mode: Optional[int] = None) -> bytes:
+        """Build THERMAL_ACQ_MODE command frame (mode None only queries)."""
+        payload = bytes([mode]) if mode is not None else b''
+        return FrameBuilder.build(Frame(Command.THERMAL_ACQ_MODE, payload))
+
+    @staticmethod
+    def build_recorder_info(clear: bool = False) -> bytes:
+        """Build RECORDER_INFO command frame (clear drops all records first)."""
+        payload = b'\x01' if clear else b''
+        return FrameBuilder.build(Frame(Command.RECORDER_INFO, payload))
+
+    @staticmethod
+    def build_recorder_read(seq: int, offset: int) -> bytes:
+        """Build RECORDER_READ command frame for one chunk of a record."""
+        payload = struct.pack('>IH', seq, offset)
+        return FrameBuilder.build(Frame(Command.RECORDER_READ, payload))
+
+    @staticmethod
+    def build_journal_info(clear: bool = False) -> bytes:
+        """Build JOURNAL_INFO command frame (clear drops all entries first)."""
+        payload = b'\x01' if clear else b''
+        return FrameBuilder.build(Frame(Command.JOURNAL_INFO, payload))
+
+    @staticmethod
+    def build_journal_read(seq: int) -> bytes:
+        """Build JOURNAL_READ command frame for entries from seq onward."""
+        return FrameBuilder.build(Frame(Command.JOURNAL_READ, struct.pack('>I', seq)))
+
+    @staticmethod
+    def build_boot_info() -> bytes:
+        """Build BOOT_INFO command frame."""
+        return FrameBuilder.build(Frame(Command.BOOT_INFO))
+
+    @staticmethod
+    def build_dut_power_cycle(off_ms: Optional[int] = None) -> bytes:
+        """Build DUT_POWER_CYCLE command frame (off_ms: rail off time, None = default)."""
+        payload = b'' if off_ms is None else struct.pack('>H', off_ms)
+        return FrameBuilder.build(Frame(Command.DUT_POWER_CYCLE, payload))
+
+    @staticmethod
+    def build_set_framing(mode: Optional[int] = None) -> bytes:
+        """Build SET_FRAMING command frame (mode None = query)."""
+        payload = b'' if mode is None else bytes([mode])
+        return FrameBuilder.build(Frame(Command.SET_FRAMING, payload))
+
+    @staticmethod
+    def build_mem_info() -> bytes:
+        """Build MEM_INFO command frame."""
+        return FrameBuilder.build(Frame(Command.MEM_INFO))
+
 
 class FrameParser:
-    """Parses frames from byte stream."""
+    """
+    Parses frames from byte stream.
+
+    Data is appended to one reusable buffer and a read offset advances as
+    frames are consumed, so parsing stays linear in the stream length.
+    Consumed bytes are discarded only once the dead prefix exceeds
+    COMPACT_THRESHOLD and outweighs the unread data.
+    """
+
+    COMPACT_THRESHOLD = 4096
 
     def __init__(self):
         self._buffer = bytearray()
+        self._offset = 0
 
     def feed(self, data: bytes) -> None:
-        """Add data to parse buffer."""
+        """Add data (bytes, bytearray or memoryview) to parse buffer."""
         self._buffer.extend(data)
 
+    def _advance(self, count: int) -> None:
+        """Move the read offset forward and compact when worthwhile."""
+        self._offset += count
+        buffer_len = len(self._buffer)
+        if self._offset >= buffer_len:
+            self._buffer.clear()
+            self._offset = 0
+        elif (self._offset >= self.COMPACT_THRESHOLD and
+              self._offset * 2 >= buffer_len):
+            del self._buffer[:self._offset]
+            self._offset = 0
+
     def parse(self) -> Tuple[ParseResult, Optional[Frame], int]:
         """
         Attempt to parse a frame from the buffer.
@@ -125,63 +315,110 @@ class FrameParser:
             - frame: Parsed Frame object if successful, None otherwise
             - consumed_bytes: Number of bytes consumed from buffer
         """
-        consumed = 0
+        buffer = self._buffer
 
         # Search for STX
-        while consumed < len(self._buffer) and self._buffer[consumed] != STX:
-            consumed += 1
-
-        if consumed >= len(self._buffer):
-            self._buffer = bytearray()
+        start = buffer.find(STX, self._offset)
+        if start < 0:
+            buffer.clear()
+            self._offset = 0
             return (ParseResult.INCOMPLETE, None, 0)
 
-        # Remove bytes before STX
-        if consumed > 0:
-            self._buffer = self._buffer[consumed:]
-            consumed = 0
+        # Skip bytes before STX
+        self._offset = start
+
+        available = len(buffer) - start
 
         # Need at least STX + LEN
-        if len(self._buffer) < 2:
+        if available < 2:
             return (ParseResult.INCOMPLETE, None, 0)
 
         # Get payload length
-        payload_len = self._buffer[1]
+        payload_len = buffer[start + 1]
         if payload_len > MAX_PAYLOAD:
-            self._buffer = self._buffer[1:]
+            self._advance(1)
             return (ParseResult.FORMAT_ERROR, None, 1)
 
         # Expected frame size: STX + LEN + CMD + PAYLOAD + CRC + ETX
         expected_size = 1 + 1 + 1 + payload_len + 1 + 1
 
-        if len(self._buffer) < expected_size:
+        if available < expected_size:
             return (ParseResult.INCOMPLETE, None, 0)
 
         # Verify ETX
-        if self._buffer[expected_size - 1] != ETX:
-            self._buffer = self._buffer[1:]
+        end = start + expected_size
+        if buffer[end - 1] != ETX:
+            self._advance(1)
             return (ParseResult.FORMAT_ERROR, None, 1)
 
         # Verify CRC (covers LEN + CMD + PAYLOAD)
-        crc_data = bytes(self._buffer[1:expected_size - 2])
-        calc_crc = CRC8.calculate(crc_data)
-        recv_crc = self._buffer[expected_size - 2]
+        with memoryview(buffer) as view, view[start + 1:end - 2] as region:
+            calc_crc = CRC8.calculate(region)
+        recv_crc = buffer[end - 2]
 
         if calc_crc != recv_crc:
-            self._buffer = self._buffer[expected_size:]
+            self._advance(expected_size)
             return (ParseResult.CRC_ERROR, None, expected_size)
 
         # Parse frame
-        cmd = self._buffer[2]
-        payload = bytes(self._buffer[3:3 + payload_len])
+        cmd = buffer[start + 2]
+        payload = bytes(buffer[start + 3:start + 3 + payload_len])
 
-        self._buffer = self._buffer[expected_size:]
+        self._advance(expected_size)
         return (ParseResult.OK, Frame(cmd, payload), expected_size)
 
     def clear(self) -> None:
         """Clear parse buffer."""
-        self._buffer = bytearray()
+        self._buffer.clear()
+        self._offset = 0
 
     @property
     def buffer_size(self) -> int:
-        """Get current buffer size."""
-        return len(self._buffer)
+        """Get number of unparsed bytes in buffer."""
+        return len(self._buffer) - self._offset
+
+
+class CobsFrameParser(FrameParser):
+    """
+    Parses COBS frames from byte stream.
+
+    Every frame ends at the next zero byte, so after corruption the parser
+    loses at most the frame in progress instead of hunting for STX byte by
+    byte.
+    """
+
+    def parse(self) -> Tuple[ParseResult, Optional[Frame], int]:
+        """
+        Attempt to parse a frame from the buffer.
+
+        Returns:
+            Tuple of (result, frame, consumed_bytes), as FrameParser.parse
+        """
+        buffer = self._buffer
+
+        end = buffer.find(COBS_DELIMITER, self._offset)
+        if end < 0:
+            available = len(buffer) - self._offset
+            if available > MAX_FRAME_SIZE:
+                # No frame is this long: drop it and wait for the next delimiter
+                self._advance(available)
+                return (ParseResult.FORMAT_ERROR, None, available)
+            return (ParseResult.INCOMPLETE, None, 0)
+
+        consumed = end + 1 - self._offset
+        encoded = bytes(buffer[self._offset:end])
+        self._advance(consumed)
+
+        try:
+            block = cobs_decode(encoded)
+        except ValueError:
+            return (ParseResult.FORMAT_ERROR, None, consumed)
+
+        # Block: [LEN][CMD][PAYLOAD...][CRC]
+        if len(block) < 3 or block[0] > MAX_PAYLOAD or len(block) != block[0] + 3:
+            return (ParseResult.FORMAT_ERROR, None, consumed)
+
+        if CRC8.calculate(block[:-1]) != block[-1]:
+            return (ParseResult.CRC_ERROR, None, consumed)
+
+        return (ParseResult.OK, Frame(block[1], block[2:-1]), consumed)
@@ -9,7 +9,7 @@ from dataclasses import dataclass
 from typing import List, Optional, Union
 import struct
 
-from .constants import SensorID, TestStatus
+from .constants import SensorID, TestStatus, MLXStatistic, DefectClass, MLX_TEMP_NOT_MEASURED
 
 
 @dataclass
@@ -17,20 +17,28 @@ class MLX90640Spec:
     """
     MLX90640 test specification.
 
-    Temperature values are in 0.1°C units (x10).
+    Temperature values are in 0.1°C units (x10). The measured value is
+    selected by statistic; the defaults reproduce the legacy frame max.
     """
     target_temp: int   # Target temperature x10 (0.1°C units), int16
     tolerance: int     # Tolerance x10 (0.1°C units), int16
+    pixel_x: int = 0xFF                     # Pixel for MLXStatistic.PIXEL (0xFF = max)
+    pixel_y: int = 0xFF
+    statistic: int = MLXStatistic.PIXEL
+    percentile: int = 0                     # 0-100 for MLXStatistic.PERCENTILE
 
     def to_bytes(self) -> bytes:
         """Serialize to big-endian bytes."""
-        return struct.pack('>hh', self.target_temp, self.tolerance)
+        return struct.pack('>hhBBBB', self.target_temp, self.tolerance,
+                           self.pixel_x, self.pixel_y, self.statistic, self.percentile)
 
     @classmethod
     def from_bytes(cls, data: bytes) -> 'MLX90640Spec':
-        """Deserialize from big-endian bytes."""
+        """Deserialize from big-endian bytes (4, 6 or 8 bytes)."""
         target, tolerance = struct.unpack('>hh', data[:4])
-        return cls(target, tolerance)
+        extra = bytes(data[4:8]) + b'\xff' * (4 - len(data[4:8]))
+        statistic = MLXStatistic.PIXEL if extra[2] == 0xFF else extra[2]
+        return cls(target, tolerance, extra[0], extra[1], statistic, extra[3] if extra[3] != 0xFF else 0)
 
     @property
     def target_celsius(self) -> float:
@@ -43,7 +51,18 @@ class MLX90640Spec:
         return self.tolerance / 10.0
 
     def __repr__(self) -> str:
-        return f"MLX90640Spec(target={self.target_celsius:.1f}C, tolerance=+/-{self.tolerance_celsius:.1f}C)"
+        if self.statistic == MLXStatistic.PERCENTILE:
+            stat = f"P{self.percentile}"
+        elif self.statistic == MLXStatistic.PIXEL and self.pixel_x != 0xFF and self.pixel_y != 0xFF:
+            stat = f"pixel({self.pixel_x},{self.pixel_y})"
+        elif self.statistic == MLXStatistic.PIXEL:
+            stat = "MAX"
+        elif self.statistic in tuple(MLXStatistic):
+            stat = MLXStatistic(self.statistic).name
+        else:
+            stat = f"0x{self.statistic:02X}"
+        return (f"MLX90640Spec(target={self.target_celsius:.1f}C, tolerance=+/-{self.tolerance_celsius:.1f}C, "
+                f"stat={stat})")
 
 
 @dataclass
@@ -52,21 +71,35 @@ class MLX90640Result:
     MLX90640 test result.
 
     All temperature values are in 0.1°C units (x10).
-    Total size: 14 bytes (7 x int16).
+    Size: 14 bytes (7 x int16); firmware built with the defect classifier
+    appends the class and confidence (16 bytes).
+
+    A single-pixel spec decided on the pixel path (MLX90640_RAW_FAST_PATH)
+    computes no other pixel: min_temp/max_temp are MLX_TEMP_NOT_MEASURED
+    and their Celsius properties return None.
     """
+    SIZE = 14
+    SIZE_CLASSIFIED = 16
+
     measured: int      # Measured temperature x10, int16
     target: int        # Target temperature x10, int16
     tolerance: int     # Tolerance x10, int16
     diff: int          # Absolute difference x10, int16
     ambient: int       # Ambient temperature x10, int16
-    min_temp: int      # Min pixel temperature x10, int16
-    max_temp: int      # Max pixel temperature x10, int16
+    min_temp: int      # Min pixel temperature x10, int16 (or MLX_TEMP_NOT_MEASURED)
+    max_temp: int      # Max pixel temperature x10, int16 (or MLX_TEMP_NOT_MEASURED)
+    defect_class: int = DefectClass.NONE    # On-device classifier output
+    defect_conf: int = 0                    # Classifier confidence in percent
 
     @classmethod
     def from_bytes(cls, data: bytes) -> 'MLX90640Result':
-        """Deserialize from big-endian bytes (14 bytes)."""
-        measured, target, tolerance, diff, ambient, min_temp, max_temp = struct.unpack('>hhhhhhh', data[:14])
-        return cls(measured, target, tolerance, diff, ambient, min_temp, max_temp)
+        """Deserialize from big-endian bytes (14 bytes, or 16 with the defect class)."""
+        measured, target, tolerance, diff, ambient, min_temp, max_temp = struct.unpack('>hhhhhhh', data[:cls.SIZE])
+        defect_class, defect_conf = DefectClass.NONE, 0
+        if len(data) >= cls.SIZE_CLASSIFIED:
+            defect_class, defect_conf = data[cls.SIZE], data[cls.SIZE + 1]
+        return cls(measured, target, tolerance, diff, ambient, min_temp, max_temp,
+                   defect_class, defect_conf)
 
     @property
     def measured_celsius(self) -> float:
@@ -94,13 +127,17 @@ class MLX90640Result:
         return self.ambient / 10.0
 
     @property
-    def min_temp_celsius(self) -> float:
-        """Min pixel temperature in Celsius."""
+    def min_temp_celsius(self) -> Optional[float]:
+        """Min pixel temperature in Celsius, or None if not measured."""
+        if self.min_temp == MLX_TEMP_NOT_MEASURED:
+            return None
         return self.min_temp / 10.0
 
     @property
-    def max_temp_celsius(self) -> float:
-        """Max pixel temperature in Celsius."""
+    def max_temp_celsius(self) -> Optional[float]:
+        """Max pixel temperature in Celsius, or None if not measured."""
+        if self.max_temp == MLX_TEMP_NOT_MEASURED:
+            return None
         return self.max_temp / 10.0
 
     @property
@@ -114,8 +151,21 @@ class MLX90640Result:
                 f"target={self.target_celsius:.1f}C, "
                 f"diff={self.diff_celsius:.1f}C, "
                 f"ambient={self.ambient_celsius:.1f}C, "
-                f"min={self.min_temp_celsius:.1f}C, "
-                f"max={self.max_temp_celsius:.1f}C, {status})")
+                f"{self._range_repr()}{status}{self._defect_repr()})")
+
+    def _range_repr(self) -> str:
+        if self.min_temp_celsius is None or self.max_temp_celsius is None:
+            return ""
+        return f"min={self.min_temp_celsius:.1f}C, max={self.max_temp_celsius:.1f}C, "
+
+    def _defect_repr(self) -> str:
+        if self.defect_class == DefectClass.NONE:
+            return ""
+        try:
+            name = DefectClass(self.defect_class).name
+        except ValueError:
+            name = f"0x{self.defect_class:02X}"
+        return f", defect={name} {self.defect_conf}%"
 
 
 @dataclass
@@ -229,6 +279,7 @@ class TestReport:
         pass_count = data[idx]; idx += 1
         fail_count = data[idx]; idx += 1
         timestamp = struct.unpack('>I', data[idx:idx+4])[0]; idx += 4
+        mlx_size = cls._mlx_result_size(data, idx, sensor_count)
 
         results = []
         data_len = len(data)
@@ -240,7 +291,7 @@ class TestReport:
             # MCU always serializes result data regardless of status
             result: Optional[Union[MLX90640Result, VL53L0XResult]] = None
             if sensor_id == SensorID.MLX90640:
-                result_size = 14  # MLX90640: 14 bytes
+                result_size = mlx_size  # MLX90640: 14 bytes, 16 with the defect class
                 remaining = data_len - idx
                 if remaining >= result_size:
                     result_data = data[idx:idx+result_size]
@@ -273,6 +324,25 @@ class TestReport:
 
         return cls(sensor_count, pass_count, fail_count, timestamp, results)
 
+    @staticmethod
+    def _mlx_result_size(data: bytes, idx: int, sensor_count: int) -> int:
+        """
+        MLX90640 result size used by the firmware that sent this report.
+
+        Entries carry no length, so walk them with each size and keep the
+        one that ends exactly at the end of the payload (14 if neither does).
+        """
+        for size in (MLX90640Result.SIZE, MLX90640Result.SIZE_CLASSIFIED):
+            pos = idx
+            for _ in range(sensor_count):
+                if pos >= len(data):
+                    break
+                sensor_id = data[pos]
+                pos += 2 + (size if sensor_id == SensorID.MLX90640 else 8)
+            if pos == len(data):
+                return size
+        return MLX90640Result.SIZE
+
     @property
     def all_passed(self) -> bool:
         """Check if all tests passed."""
@@ -282,3 +352,121 @@ class TestReport:
         return (f"TestReport(sensors={self.sensor_count}, "
                 f"pass={self.pass_count}, fail={self.fail_count}, "
                 f"timestamp={self.timestamp}ms)")
+
+
+@dataclass
+class JournalInfo:
+    """JOURNAL_INFO response: test result journal state."""
+    oldest_seq: int         # Oldest entry held in RAM or flash
+    next_seq: int           # Sequence number the next entry gets
+    ram_count: int          # Entries in the RAM ring
+    ram_capacity: int       # RAM ring size
+    flash_count: int        # Flash slots used in both sectors
+    flash_capacity: int     # Flash slots in both sectors (0 = flash spill disabled)
+
+    SIZE = 16
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> 'JournalInfo':
+        """
+        Deserialize from protocol bytes.
+
+        Format: [oldest_seq(4)][next_seq(4)][ram_count(2)][ram_capacity(2)]
+                [flash_count(2)][flash_capacity(2)] - big-endian
+        """
+        return cls(*struct.unpack('>IIHHHH', data[:cls.SIZE]))
+
+
+@dataclass
+class BootInfo:
+    """BOOT_INFO response: sensor boot progress and phase times (ms after reset or DUT cycle)."""
+    ready: bool                     # Sensors initialized, sensor commands accepted
+    warm_reset: bool                # Rail was discharged (reset without power loss)
+    vl53l0x_ok: bool
+    mlx90640_ok: bool
+    dut_cycle: bool                 # Started by DUT_POWER_CYCLE (times from the command)
+    protocol_ms: Optional[int]      # PING answered from here (0 after a DUT cycle)
+    rail_on_ms: Optional[int]       # 12V switched on
+    vl53l0x_ms: Optional[int]       # VL53L0X init finished
+    mlx_ack_ms: Optional[int]       # MLX90640 answers on I2C
+    mlx_eeprom_ms: Optional[int]    # MLX90640 EEPROM dump finished
+    mlx90640_ms: Optional[int]      # MLX90640 parameters extracted
+    ready_ms: Optional[int]         # All sensors done
+
+    SIZE = 16
+    NOT_REACHED = 0xFFFF
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> 'BootInfo':
+        """
+        Deserialize from protocol bytes.
+
+        Format: [ready][flags][phase_ms(2) x 7] - big-endian, 0xFFFF = not reached
+        """
+        ready, flags = data[0], data[1]
+        phases = [None if ms == cls.NOT_REACHED else ms
+                  for ms in struct.unpack('>7H', data[2:cls.SIZE])]
+        return cls(
+            bool(ready), bool(flags & 0x01), bool(flags & 0x02), bool(flags & 0x04),
+            bool(flags & 0x08), *phases
+        )
+
+
+@dataclass
+class MemInfo:
+    """MEM_INFO response: RAM/flash usage and stack watermark, all in bytes."""
+    dtcm_size: int          # DTCM region (data, bss, heap, stack)
+    data: int               # .data
+    bss: int                # .bss
+    heap_used: int          # _sbrk break above _end
+    stack_reserved: int     # _Min_Stack_Size checked by the linker
+    stack_peak: int         # Deepest stack use since boot (watermark)
+    stack_now: int          # Stack in use while answering
+    stack_free: int         # Never touched: heap break to the watermark
+    axi_used: int           # AXI SRAM (flight recorder)
+    axi_size: int
+    d3_used: int            # D3 SRAM (BDMA buffers)
+    d3_size: int
+    flash_used: int         # Code, constants and the .data image
+    flash_size: int
+
+    SIZE = 56
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> 'MemInfo':
+        """Deserialize from protocol bytes (14 x uint32, big-endian)."""
+        return cls(*struct.unpack('>14I', data[:cls.SIZE]))
+
+
+@dataclass
+class JournalEntry:
+    """One finished test report from the journal."""
+    seq: int                        # Journal sequence number
+    recipe: int                     # FNV-1a of the specs the test ran against
+    duration_ms: int                # Whole report
+    sensor_durations: List[int]     # Init + test time per result (ms)
+    report: TestReport
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> 'JournalEntry':
+        """
+        Deserialize one entry (without its length byte).
+
+        Format: [seq(4)][recipe(4)][duration(2)][n][duration(2) x n]
+                [TEST_RESULT report] - big-endian
+        """
+        seq, recipe, duration, n = struct.unpack('>IIHB', data[:11])
+        sensor_durations = list(struct.unpack(f'>{n}H', data[11:11 + 2 * n]))
+        report = TestReport.from_bytes(data[11 + 2 * n:])
+        return cls(seq, recipe, duration, sensor_durations, report)
+
+    @classmethod
+    def parse_many(cls, data: bytes) -> List['JournalEntry']:
+        """Split a JOURNAL_DATA entry block ([len][entry] ...)."""
+        entries = []
+        idx = 0
+        while idx < len(data):
+            length = data[idx]
+            entries.append(cls.from_bytes(data[idx + 1:idx + 1 + length]))
+            idx += 1 + length
+        return entries
@@ -0,0 +1,384 @@
+"""
+MLX90640 on-device thermal analytics data structures.
+
+Reference: include/sensors/thermal_blob.h, include/sensors/thermal_stats.h,
+           include/sensors/thermal_zone.h, include/sensors/thermal_golden.h,
+           include/sensors/thermal_noise.h, include/sensors/thermal_filter.h,
+           include/sensors/thermal_recorder.h
+"""
+
+import struct
+from dataclasses import dataclass
+from typing import List, Tuple
+
+from .constants import MLXStatistic
+
+
+@dataclass
+class ThermalBlob:
+    """One connected hot region reported by THERMAL_BLOBS."""
+    area: int           # Pixel count
+    centroid_x: float   # Pixel units (0-31)
+    centroid_y: float   # Pixel units (0-23)
+    x_min: int
+    y_min: int
+    x_max: int
+    y_max: int
+    peak_temp: int      # x10 (0.1°C units)
+    mean_temp: int      # x10 (0.1°C units)
+
+    SIZE = 12
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> 'ThermalBlob':
+        """Deserialize from big-endian bytes."""
+        area, cx, cy, x0, y0, x1, y1, peak, mean = struct.unpack('>HBBBBBBhh', data[:cls.SIZE])
+        return cls(area, cx / 8.0, cy / 8.0, x0, y0, x1, y1, peak, mean)
+
+    @property
+    def peak_celsius(self) -> float:
+        return self.peak_temp / 10.0
+
+    @property
+    def mean_celsius(self) -> float:
+        return self.mean_temp / 10.0
+
+    def __repr__(self) -> str:
+        return (f"ThermalBlob(area={self.area}, centroid=({self.centroid_x:.2f},{self.centroid_y:.2f}), "
+                f"bbox=({self.x_min},{self.y_min})-({self.x_max},{self.y_max}), "
+                f"peak={self.peak_celsius:.1f}C, mean={self.mean_celsius:.1f}C)")
+
+
+@dataclass
+class BlobReport:
+    """THERMAL_BLOBS response: largest regions first."""
+    status: int
+    blob_total: int
+    blobs: List[ThermalBlob]
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> 'BlobReport':
+        """
+        Deserialize from protocol bytes.
+
+        Format:
+        - status: uint8
+        - blob_total: uint16 (big-endian)
+        - count: uint8
+        - count x 12-byte blob records
+        """
+        status = data[0]
+        blob_total = struct.unpack('>H', data[1:3])[0]
+        count = data[3]
+        blobs = [
+            ThermalBlob.from_bytes(data[4 + i * ThermalBlob.SIZE:])
+            for i in range(count)
+        ]
+        return cls(status, blob_total, blobs)
+
+
+@dataclass
+class ThermalStats:
+    """THERMAL_STATS response: frame / ROI statistics (temperatures x10)."""
+    status: int
+    count: int
+    min_temp: int
+    max_temp: int
+    mean: int
+    stddev: int
+    p_low: int          # 5th percentile (THERMAL_STATS_P_LOW)
+    median: int
+    p_high: int         # 95th percentile (THERMAL_STATS_P_HIGH)
+    trimmed_mean: int   # Mean of ranks p_low..p_high
+    histogram: List[int]
+
+    HEADER_SIZE = 18
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> 'ThermalStats':
+        """
+        Deserialize from protocol bytes.
+
+        Format:
+        - status: uint8
+        - count: uint16, then min/max/mean/stddev/p_low/median/p_high/trimmed: int16
+        - histogram: uint16 per bin (equal bins over [min, max])
+        """
+        status = data[0]
+        count, *temps = struct.unpack('>H8h', data[1:1 + cls.HEADER_SIZE])
+        hist_data = data[1 + cls.HEADER_SIZE:]
+        bins = len(hist_data) // 2
+        histogram = list(struct.unpack(f'>{bins}H', hist_data[:bins * 2]))
+        return cls(status, count, *temps, histogram)
+
+    @property
+    def median_celsius(self) -> float:
+        return self.median / 10.0
+
+    @property
+    def trimmed_mean_celsius(self) -> float:
+        return self.trimmed_mean / 10.0
+
+    def __repr__(self) -> str:
+        return (f"ThermalStats(n={self.count}, min={self.min_temp / 10:.1f}C, max={self.max_temp / 10:.1f}C, "
+                f"mean={self.mean / 10:.1f}C, sd={self.stddev / 10:.1f}C, "
+                f"p_low={self.p_low / 10:.1f}C, median={self.median_celsius:.1f}C, "
+                f"p_high={self.p_high / 10:.1f}C, trimmed={self.trimmed_mean_celsius:.1f}C)")
+
+
+@dataclass
+class ThermalZone:
+    """
+    One multi-ROI zone spec for SET_ZONES.
+
+    Temperature values are in 0.1°C units (x10).
+    """
+    roi: Tuple[int, int, int, int]      # (x_min, y_min, x_max, y_max) inclusive
+    target_temp: int                    # Target temperature x10, int16
+    tolerance: int                      # Tolerance x10, int16
+    statistic: int = MLXStatistic.MEAN  # PIXEL is not allowed for zones
+    percentile: int = 0                 # 0-100 for MLXStatistic.PERCENTILE
+    emissivity: float = 0.0             # 0 = frame default, else 0.01-1.00
+
+    SIZE = 11
+
+    def to_bytes(self) -> bytes:
+        """Serialize to big-endian bytes."""
+        return struct.pack('>4BBBhhB', *self.roi, self.statistic, self.percentile,
+                           self.target_temp, self.tolerance, int(round(self.emissivity * 100)))
+
+
+@dataclass
+class ZoneResult:
+    """Per-zone verdict from TEST_ZONES."""
+    status: int
+    measured: int       # x10 (0.1°C units)
+    diff: int           # x10 (0.1°C units)
+
+    SIZE = 5
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> 'ZoneResult':
+        """Deserialize from big-endian bytes."""
+        return cls(*struct.unpack('>Bhh', data[:cls.SIZE]))
+
+    @property
+    def passed(self) -> bool:
+        return self.status == 0
+
+    @property
+    def measured_celsius(self) -> float:
+        return self.measured / 10.0
+
+
+@dataclass
+class ZoneReport:
+    """TEST_ZONES response: one verdict per configured zone."""
+    status: int         # Frame acquisition status
+    overall: int        # PASS only if every zone passed
+    zones: List[ZoneResult]
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> 'ZoneReport':
+        """
+        Deserialize from protocol bytes.
+
+        Format:
+        - status: uint8
+        - overall: uint8
+        - count: uint8
+        - count x 5-byte zone results
+        """
+        status, overall, count = data[0], data[1], data[2]
+        zones = [
+            ZoneResult.from_bytes(data[3 + i * ZoneResult.SIZE:])
+            for i in range(count)
+        ]
+        return cls(status, overall, zones)
+
+    @property
+    def passed(self) -> bool:
+        return self.overall == 0
+
+
+
+@dataclass
+class GoldenInfo:
+    """GOLDEN_INFO response: golden reference image state."""
+    status: int         # Capture status (PASS for queries, tolerance updates and saves)
+    valid: bool         # Golden frame available
+    saved: bool         # RAM image matches flash
+    frames: int         # Frames averaged into the golden frame
+    mean_temp: int      # x10 (0.1°C units)
+    checksum: int       # CRC-32 over golden and tolerance maps
+
+    SIZE = 10
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> 'GoldenInfo':
+        """
+        Deserialize from protocol bytes.
+
+        Format: [status][valid][saved][frames][mean_temp(2)][checksum(4)] - big-endian
+        """
+        status, valid, saved, frames, mean, checksum = struct.unpack('>BBBBhI', data[:cls.SIZE])
+        return cls(status, bool(valid), bool(saved), frames, mean, checksum)
+
+    @property
+    def mean_celsius(self) -> float:
+        return self.mean_temp / 10.0
+
+
+@dataclass
+class GoldenResult:
+    """
+    GOLDEN_COMPARE response.
+
+    Deviations are test minus golden in 0.01°C units (x100).
+    """
+    status: int         # Frame acquisition status
+    verdict: int        # PASS if all pixels compared and out_count <= max_out
+    compared: int       # Pixels compared
+    out_count: int      # Pixels outside their tolerance
+    worst_index: int    # Pixel index (y * 32 + x)
+    worst_dev: int      # Signed deviation of worst pixel, x100
+    mean_dev: int       # Mean deviation (offset), x100
+    rms_dev: int        # RMS deviation, x100
+    similarity: int     # Pearson correlation x1000
+
+    SIZE = 16
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> 'GoldenResult':
+        """Deserialize from big-endian bytes."""
+        return cls(*struct.unpack('>BBHHHhhHh', data[:cls.SIZE]))
+
+    @property
+    def passed(self) -> bool:
+        return self.verdict == 0
+
+    @property
+    def worst_xy(self) -> Tuple[int, int]:
+        return self.worst_index % 32, self.worst_index // 32
+
+
+@dataclass
+class NoiseReport:
+    """
+    THERMAL_NOISE response: per-pixel temporal noise over N frames.
+
+    Sigma values are in mK (0.001°C units).
+    """
+    status: int                     # Acquisition status
+    frames: int                     # Frames accumulated
+    pixels: int                     # Pixels with >= 2 samples (broken pixels excluded)
+    netd: int                       # Array NETD: mean per-pixel sigma
+    max_sigma: int                  # Largest per-pixel sigma
+    bin_width: int                  # Histogram bin width in mK (last bin is open-ended)
+    worst: List[Tuple[int, int]]    # (pixel index, sigma) noisiest first
+    histogram: List[int]            # Pixel counts per sigma bin
+
+    WORST_COUNT = 5
+    HIST_BINS = 16
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> 'NoiseReport':
+        """
+        Deserialize from protocol bytes.
+
+        Format:
+        - status: uint8
+        - frames, pixels, netd, max_sigma: uint16 x4
+        - bin_width: uint8
+        - worst: (index uint16, sigma uint16) x 5, unused slots are index 0xFFFF
+        - histogram: uint16 x 16
+        """
+        status, frames, pixels, netd, max_sigma, bin_width = struct.unpack('>BHHHHB', data[:10])
+        offset = 10
+        worst = []
+        for _ in range(cls.WORST_COUNT):
+            index, sigma = struct.unpack('>HH', data[offset:offset + 4])
+            offset += 4
+            if index != 0xFFFF:
+                worst.append((index, sigma))
+        histogram = list(struct.unpack(f'>{cls.HIST_BINS}H', data[offset:offset + cls.HIST_BINS * 2]))
+        return cls(status, frames, pixels, netd, max_sigma, bin_width, worst, histogram)
+
+    @property
+    def netd_kelvin(self) -> float:
+        return self.netd / 1000.0
+
+
+@dataclass
+class FilterInfo:
+    """THERMAL_FILTER response: temporal filter state."""
+    mode: int               # ThermalFilterMode
+    param: int              # Alpha percent (EMA) or window length (WINDOW)
+    frames: int             # Frames filtered since reset (saturating)
+    settle_frames: int      # Frames until the initial state has decayed
+    settled: bool
+
+    SIZE = 7
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> 'FilterInfo':
+        """
+        Deserialize from protocol bytes.
+
+        Format: [mode][param][frames(2)][settle_frames(2)][settled] - big-endian
+        """
+        mode, param, frames, settle, settled = struct.unpack('>BBHHB', data[:cls.SIZE])
+        return cls(mode, param, frames, settle, bool(settled))
+
+
+@dataclass
+class RecorderInfo:
+    """RECORDER_INFO response: flight recorder state."""
+    count: int              # Records held
+    capacity: int           # Ring slots
+    oldest_seq: int         # Sequence number of the oldest record
+    next_seq: int           # Sequence number the next record gets
+    record_size: int        # Serialized record bytes
+    last_test_id: int       # Id of the last finished test (0 = none)
+    last_status: int        # Its TestStatus
+
+    SIZE = 17
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> 'RecorderInfo':
+        """
+        Deserialize from protocol bytes.
+
+        Format: [count(2)][capacity(2)][oldest_seq(4)][next_seq(4)]
+                [record_size(2)][last_test_id(2)][last_status] - big-endian
+        """
+        return cls(*struct.unpack('>HHIIHHB', data[:cls.SIZE]))
+
+
+@dataclass
+class RecordedSubpage:
+    """One raw MLX90640 subpage from the flight recorder."""
+    seq: int                # Record sequence number
+    tick: int               # MCU tick at capture (ms)
+    test_id: int            # Test the read belonged to (0 = outside tests)
+    frame: List[int]        # frameData: 832 RAM words + control + status
+
+    HEADER_SIZE = 10
+    WORDS = 834
+    SIZE = HEADER_SIZE + WORDS * 2
+
+    @property
+    def subpage(self) -> int:
+        """Subpage number from the recorded status register."""
+        return self.frame[833] & 0x01
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> 'RecordedSubpage':
+        """
+        Deserialize from protocol bytes.
+
+        Format: [seq(4)][tick(4)][test_id(2)][frameData x 2B] - big-endian
+        """
+        seq, tick, test_id = struct.unpack('>IIH', data[:cls.HEADER_SIZE])
+        frame = list(struct.unpack(f'>{cls.WORDS}H', data[cls.HEADER_SIZE:cls.SIZE]))
+        return cls(seq, tick, test_id, frame)
@@ -148,16 +148,24 @@ class SerialTransport:
         """Background receive thread."""
         while self._running and self._serial and self._serial.is_open:
             try:
-                data = self._serial.read(256)
+                # Wait up to read_timeout for the first byte only, then take
+                # whatever else has arrived; read(256) would hold every short
+                # reply (and its capture timestamp) for the full read_timeout
+                data = self._serial.read(1)
                 if data:
-                    logger.debug(f"RX ({len(data)} bytes): {data.hex(' ')}")
-                    self._rx_queue.put(data)
+                    data += self._serial.read(self._serial.in_waiting)
+                    self._on_rx(data)
             except serial.SerialException:
                 break
             except Exception as e:
                 logger.error(f"RX error: {e}")
                 break
 
+    def _on_rx(self, data: bytes) -> None:
+        """Hand received bytes to the receive queue (runs on RX thread)."""
+        logger.debug(f"RX ({len(data)} bytes): {data.hex(' ')}")
+        self._rx_queue.put(data)
+
     @property
     def is_open(self) -> bool:
         """Check if port is open."""
@@ -110,6 +110,10 @@ class PSASensorTestSequence(SequenceBase):
         self.baudrate: int = self.get_parameter("baudrate", 115200)
         self.timeout: float = self.get_parameter("timeout", 5.0)
 
+        # Session reuse: keep the MCU port open between runs
+        self.reuse_session: bool = self.get_parameter("reuse_session", True)
+        self.session_idle_revalidate_s: float = self.get_parameter("session_idle_revalidate_s", 5.0)
+
         # VL53L0X parameters
         self.vl53l0x_target_mm: int = self.get_parameter("vl53l0x_target_mm", 500)
         self.vl53l0x_tolerance_mm: int = self.get_parameter("vl53l0x_tolerance_mm", 100)
@@ -117,6 +121,8 @@ class PSASensorTestSequence(SequenceBase):
         # MLX90640 parameters
         self.mlx90640_target_celsius: float = self.get_parameter("mlx90640_target_celsius", 25.0)
         self.mlx90640_tolerance_celsius: float = self.get_parameter("mlx90640_tolerance_celsius", 10.0)
+        self.mlx90640_statistic: str = self.get_parameter("mlx90640_statistic", "max")
+        self.mlx90640_percentile: int = self.get_parameter("mlx90640_percentile", 95)
 
         # Sensor enable flags
         self.test_vl53l0x_enabled: bool = self.get_parameter("test_vl53l0x_enabled", True)
@@ -161,13 +167,24 @@ class PSASensorTestSequence(SequenceBase):
             self.emit_log("info", f"MCU 연결 중: {port} @ {baudrate} bps")
 
             driver_class = _get_driver_class()
-            self.mcu = driver_class(config={
+            driver_config = {
                 "port": port,
                 "baudrate": baudrate,
                 "timeout": timeout,
-            })
+            }
+            # Optional serial capture / replay (host regression runs without MCU)
+            for key in ("capture_file", "replay_file", "replay_speed", "replay_strict"):
+                if hw_config.get(key) is not None:
+                    driver_config[key] = hw_config[key]
+
+            if self.reuse_session:
+                driver_config["idle_revalidate_s"] = self.session_idle_revalidate_s
+                self.mcu = await driver_class.acquire_session(driver_config)
+                connected = self.mcu is not None
+            else:
+                self.mcu = driver_class(config=driver_config)
+                connected = await self.mcu.connect()
 
-            connected = await self.mcu.connect()
             if not connected:
                 raise SetupError("MCU 연결 실패", details={"error_code": "MCU_CONNECTION_FAILED"})
 
@@ -335,6 +352,8 @@ class PSASensorTestSequence(SequenceBase):
                     result = await self.mcu.test_mlx90640(
                         target_celsius=self.mlx90640_target_celsius,
                         tolerance_celsius=self.mlx90640_tolerance_celsius,
+                        statistic=self.mlx90640_statistic,
+                        percentile=self.mlx90640_percentile,
                     )
 
                     measured_celsius = result.get("measured_celsius", 0)
@@ -419,7 +438,11 @@ class PSASensorTestSequence(SequenceBase):
 
         try:
             if self.mcu:
-                if hasattr(self.mcu, "is_connected"):
+                if hasattr(self.mcu, "release_session") and not self.context.dry_run:
+                    # Keeps the port open for the next DUT when reuse is enabled
+                    await self.mcu.release_session(keep=self.reuse_session)
+                    self.emit_log("info", "MCU 세션 유지" if self.reuse_session else "MCU 연결 해제 완료")
+                elif hasattr(self.mcu, "is_connected"):
                     if await self.mcu.is_connected():
                         await self.mcu.disconnect()
                         self.emit_log("info", "MCU 연결 해제 완료")
@@ -0,0 +1,51 @@
+"""
+Shared pytest setup for the PSA sensor test host code.
+
+Puts libs/ (psa_protocol) and drivers/ on sys.path the same way the
+sequence does at runtime, and provides frame stream helpers.
+"""
+
+import random
+import sys
+from pathlib import Path
+from typing import List, Tuple
+
+import pytest
+
+_root = Path(__file__).parent.parent
+for _path in (_root / "libs", _root / "drivers"):
+    if str(_path) not in sys.path:
+        sys.path.insert(0, str(_path))
+
+from psa_protocol.frame import Frame, FrameBuilder, ParseResult  # noqa: E402
+from psa_protocol.constants import MAX_PAYLOAD  # noqa: E402
+
+
+def make_frames(count: int, seed: int = 1) -> List[Frame]:
+    """Frames with random commands and payload lengths 0..MAX_PAYLOAD."""
+    rng = random.Random(seed)
+    return [
+        Frame(rng.randrange(256), bytes(rng.randrange(256) for _ in range(rng.randrange(MAX_PAYLOAD + 1))))
+        for _ in range(count)
+    ]
+
+
+def encode(frames: List[Frame], cobs: bool = False) -> bytes:
+    """Concatenate frames as they appear on the wire."""
+    build = FrameBuilder.build_cobs if cobs else FrameBuilder.build
+    return b"".join(build(f) for f in frames)
+
+
+def drain(parser) -> List[Tuple[ParseResult, object]]:
+    """Parse until the parser needs more data; return (result, frame) pairs."""
+    results = []
+    while True:
+        result, frame, _ = parser.parse()
+        if result == ParseResult.INCOMPLETE:
+            return results
+        results.append((result, frame))
+
+
+@pytest.fixture
+def frames() -> List[Frame]:
+    return make_frames(200)
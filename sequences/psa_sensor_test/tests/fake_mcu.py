@@ -0,0 +1,134 @@
+"""
+pty-backed fake PSA MCU.
+
+Each FakeMCU owns a pseudo-terminal: the host side opens FakeMCU.port
+like a real serial port (pyserial, AsyncSerialTransport), while the fake
+answers frames on the master side from the running event loop. It speaks
+the classic framing and implements PING, GET_SENSOR_LIST, SET_SPEC,
+GET_SPEC and TEST_SINGLE the way the firmware does; anything else gets a
+NAK. TEST_SINGLE replies after test_delay_s so concurrent runs on several
+fakes overlap like real fixtures.
+
+Linux/macOS only (pty).
+"""
+
+import asyncio
+import os
+import pty
+import struct
+import tty
+from typing import Dict, List, Optional, Tuple
+
+from psa_protocol.constants import Command, ErrorCode, Response, SensorID, TestStatus
+from psa_protocol.frame import Frame, FrameBuilder, FrameParser, ParseResult
+from psa_protocol.sensors import MLX90640Spec, VL53L0XSpec
+
+SENSOR_NAMES = {SensorID.VL53L0X: "VL53L0X", SensorID.MLX90640: "MLX90640"}
+
+
+class FakeMCU:
+    """One fake fixture on a pty."""
+
+    def __init__(
+        self,
+        version: Tuple[int, int, int] = (1, 0, 0),
+        distance_mm: int = 500,
+        temperature_c: float = 25.0,
+        ambient_c: float = 24.0,
+        test_delay_s: float = 0.05,
+    ):
+        self.version = version
+        self.distance_mm = distance_mm
+        self.temperature_c = temperature_c
+        self.ambient_c = ambient_c
+        self.test_delay_s = test_delay_s
+
+        self.specs: Dict[int, object] = {}
+        self.commands: List[int] = []       # Every command received, in order
+
+        self._master, self._slave = pty.openpty()
+        tty.setraw(self._slave)
+        self.port = os.ttyname(self._slave)
+        self._parser = FrameParser()
+        self._loop: Optional[asyncio.AbstractEventLoop] = None
+        self._timestamp = 0
+
+    def start(self) -> "FakeMCU":
+        """Start answering on the running event loop."""
+        self._loop = asyncio.get_running_loop()
+        self._loop.add_reader(self._master, self._on_readable)
+        return self
+
+    def close(self) -> None:
+        if self._loop is not None:
+            self._loop.remove_reader(self._master)
+            self._loop = None
+        for fd in (self._master, self._slave):
+            try:
+                os.close(fd)
+            except OSError:
+                pass
+
+    # === Protocol ===
+
+    def _on_readable(self) -> None:
+        try:
+            data = os.read(self._master, 4096)
+        except OSError:
+            return
+        self._parser.feed(data)
+        while True:
+            result, frame, _ = self._parser.parse()
+            if result == ParseResult.INCOMPLETE:
+                return
+            if result == ParseResult.OK:
+                self._handle(frame)
+
+    def _send(self, cmd: int, payload: bytes = b"") -> None:
+        if self._loop is not None:
+            os.write(self._master, FrameBuilder.build(Frame(cmd, payload)))
+
+    def _handle(self, frame: Frame) -> None:
+        self.commands.append(frame.cmd)
+        payload = frame.payload
+
+        if frame.cmd == Command.PING:
+            self._send(Response.PONG, bytes(self.version))
+        elif frame.cmd == Command.GET_SENSOR_LIST:
+            body = bytearray([len(SENSOR_NAMES)])
+            for sensor_id, name in SENSOR_NAMES.items():
+                body += bytes([sensor_id, len(name)]) + name.encode("ascii")
+            self._send(Response.SENSOR_LIST, bytes(body))
+        elif frame.cmd == Command.SET_SPEC and payload and payload[0] in SENSOR_NAMES:
+            spec_class = MLX90640Spec if payload[0] == SensorID.MLX90640 else VL53L0XSpec
+            self.specs[payload[0]] = spec_class.from_bytes(payload[1:])
+            self._send(Response.SPEC_ACK, payload[:1])
+        elif frame.cmd == Command.GET_SPEC and payload and payload[0] in self.specs:
+            self._send(Response.SPEC_DATA, payload[:1] + self.specs[payload[0]].to_bytes())
+        elif frame.cmd == Command.TEST_SINGLE and payload and payload[0] in SENSOR_NAMES:
+            report = self._report(payload[0])
+            self._loop.call_later(self.test_delay_s, self._send, Response.TEST_RESULT, report)
+        else:
+            self._send(Response.NAK, bytes([ErrorCode.UNKNOWN_CMD]))
+
+    def _report(self, sensor_id: int) -> bytes:
+        """TEST_RESULT payload for one sensor, judged like the firmware."""
+        spec = self.specs.get(sensor_id)
+        self._timestamp += 1000
+
+        if spec is None:
+            status, result = TestStatus.FAIL_NO_SPEC, bytes(8 if sensor_id == SensorID.VL53L0X else 14)
+        elif sensor_id == SensorID.VL53L0X:
+            diff = abs(self.distance_mm - spec.target_dist)
+            status = TestStatus.PASS if diff <= spec.tolerance else TestStatus.FAIL_INVALID
+            result = struct.pack(">HHHH", self.distance_mm, spec.target_dist, spec.tolerance, diff)
+        else:
+            measured = int(self.temperature_c * 10)
+            diff = abs(measured - spec.target_temp)
+            status = TestStatus.PASS if diff <= spec.tolerance else TestStatus.FAIL_INVALID
+            result = struct.pack(">hhhhhhh", measured, spec.target_temp, spec.tolerance, diff,
+                                 int(self.ambient_c * 10), measured, measured)
+
+        passed = status == TestStatus.PASS
+        return (bytes([1, int(passed), int(not passed)]) + struct.pack(">I", self._timestamp) +
+                bytes([sensor_id, status]) + result)
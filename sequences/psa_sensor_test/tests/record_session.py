@@ -0,0 +1,83 @@
+"""
+Driver session behind the replay regression gate (test_replay_regression.py).
+
+SESSION is the host side of one sequence run through PSAMCUDriver. Run
+this file to (re)record tests/captures/driver_session.psacap, against a
+pty FakeMCU by default or a real board with --port:
+
+    python tests/record_session.py [--port /dev/ttyUSB0] [--out FILE]
+
+Re-record only when a host change is meant to alter the traffic, and
+update EXPECTED in test_replay_regression.py from the printed results.
+"""
+
+import argparse
+import asyncio
+import sys
+from pathlib import Path
+from typing import Any, Dict
+
+_root = Path(__file__).parent.parent
+for _path in (_root / "libs", _root / "drivers"):
+    if str(_path) not in sys.path:
+        sys.path.insert(0, str(_path))
+
+from psa_mcu import PSAMCUDriver  # noqa: E402
+
+CAPTURE = Path(__file__).parent / "captures" / "driver_session.psacap"
+
+# Driver settings shared by recording and replay; the spec cache is on so
+# the repeated tests must go out without SET_SPEC
+DRIVER_CONFIG = {"timeout": 2.0, "idle_revalidate_s": 60.0}
+
+FAKE_TEST_DELAY_S = 0.1
+
+
+async def run_session(driver: PSAMCUDriver) -> Dict[str, Any]:
+    """Run the recorded session on a connected driver and return its results."""
+    return {
+        "version": await driver.ping(),
+        "sensors": await driver.get_sensor_list(),
+        "vl53l0x": await driver.test_vl53l0x(target_mm=500, tolerance_mm=20),
+        "mlx90640": await driver.test_mlx90640(25.0, 2.0, statistic="percentile", percentile=90),
+        "vl53l0x_cached": await driver.test_vl53l0x(target_mm=500, tolerance_mm=20),
+        "mlx90640_cached": await driver.test_mlx90640(25.0, 2.0, statistic="percentile", percentile=90),
+        "vl53l0x_fail": await driver.test_vl53l0x(target_mm=300, tolerance_mm=20),
+    }
+
+
+async def record(port: str, out: Path) -> Dict[str, Any]:
+    driver = PSAMCUDriver(config=dict(DRIVER_CONFIG, port=port, capture_file=str(out)))
+    if not await driver.connect():
+        raise SystemExit(f"Cannot connect to {port}")
+    try:
+        return await run_session(driver)
+    finally:
+        await driver.disconnect()
+
+
+async def record_fake(out: Path) -> Dict[str, Any]:
+    from fake_mcu import FakeMCU
+
+    fake = FakeMCU(version=(1, 4, 2), distance_mm=507, temperature_c=25.6,
+                   test_delay_s=FAKE_TEST_DELAY_S).start()
+    try:
+        return await record(fake.port, out)
+    finally:
+        fake.close()
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--port", help="Serial port of a real board (default: pty FakeMCU)")
+    parser.add_argument("--out", type=Path, default=CAPTURE, help="Capture file to write")
+    args = parser.parse_args()
+
+    args.out.parent.mkdir(parents=True, exist_ok=True)
+    results = asyncio.run(record(args.port, args.out) if args.port else record_fake(args.out))
+    for key, value in results.items():
+        print(f"{key}: {value!r}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,130 @@
+"""
+PSAFixturePool against pty-based fake fixtures (tests/fake_mcu.py).
+
+Every fake answers on its own pty from the same event loop as the pool,
+so these run the real AsyncSerialTransport/AsyncPSAClient stack end to
+end without hardware.
+"""
+
+import asyncio
+import sys
+import time
+
+import pytest
+
+from psa_protocol.constants import Command, MLXStatistic, SensorID
+
+pytestmark = pytest.mark.skipif(sys.platform == "win32", reason="pty fake devices need a POSIX host")
+
+if sys.platform != "win32":
+    from fake_mcu import FakeMCU
+    from fixture_pool import PSAFixturePool
+
+FIXTURES = 16
+TEST_DELAY_S = 0.2
+
+PLAN = {
+    "vl53l0x": {"target_mm": 500, "tolerance_mm": 20},
+    "mlx90640": {"target_celsius": 25.0, "tolerance_celsius": 2.0,
+                 "statistic": "percentile", "percentile": 90},
+}
+
+
+async def _with_pool(fakes, body):
+    for fake in fakes:
+        fake.start()
+    pool = PSAFixturePool(config={
+        "fixtures": [{"name": f"fx{i}", "port": fake.port, "timeout": 2.0} for i, fake in enumerate(fakes)],
+        "connect_ping_timeout": 0.5,
+    })
+    try:
+        return await body(pool)
+    finally:
+        await pool.disconnect()
+        for fake in fakes:
+            fake.close()
+
+
+def test_plan_runs_concurrently_on_all_fixtures():
+    fakes = [FakeMCU(version=(2, 1, i), test_delay_s=TEST_DELAY_S) for i in range(FIXTURES)]
+    fakes[3].distance_mm = 600         # Out of tolerance
+
+    async def body(pool):
+        assert await pool.connect()
+        start = time.monotonic()
+        outcome = await pool.run_plan(PLAN)
+        return outcome, time.monotonic() - start, pool.metrics(), await pool.identify()
+
+    outcome, elapsed, metrics, idn = asyncio.run(_with_pool(fakes, body))
+
+    assert set(outcome) == {f"fx{i}" for i in range(FIXTURES)}
+    assert [name for name, o in outcome.items() if not o["passed"]] == ["fx3"]
+    assert outcome["fx3"]["results"]["vl53l0x"]["measured_mm"] == 600
+    assert outcome["fx0"]["results"]["mlx90640"]["measured_celsius"] == 25.0
+    assert all(o["error"] is None for o in outcome.values())
+
+    # Two tests of TEST_DELAY_S each per fixture: sequential would take 16x longer
+    assert elapsed < 2 * TEST_DELAY_S * 4
+
+    assert "fx15=FW-2.1.15" in idn
+    assert all(m["requests"] >= 5 and m["latency_max_ms"] >= TEST_DELAY_S * 1000 * 0.9
+               for m in metrics.values())
+
+
+def test_mlx_statistic_reaches_the_fixture():
+    fake = FakeMCU()
+
+    async def body(pool):
+        await pool.connect()
+        return await pool.run_plan({"mlx90640": PLAN["mlx90640"]})
+
+    outcome = asyncio.run(_with_pool([fake], body))
+
+    assert outcome["fx0"]["passed"]
+    spec = fake.specs[SensorID.MLX90640]
+    assert (spec.statistic, spec.percentile) == (MLXStatistic.PERCENTILE, 90)
+    assert (spec.target_temp, spec.tolerance) == (250, 20)
+
+
+def test_unknown_fixture_rejected_before_anything_is_sent():
+    fakes = [FakeMCU(), FakeMCU()]
+
+    async def body(pool):
+        await pool.connect()
+        before = [list(f.commands) for f in fakes]
+        with pytest.raises(ValueError, match="fx9"):
+            await pool.run_plan(PLAN, fixtures=["fx0", "fx9"])
+        return before
+
+    before = asyncio.run(_with_pool(fakes, body))
+    assert [f.commands for f in fakes] == before
+
+
+def test_invalid_plan_rejected_before_anything_is_sent():
+    fake = FakeMCU()
+
+    async def body(pool):
+        await pool.connect()
+        with pytest.raises(ValueError, match="statistic"):
+            await pool.run_plan({"mlx90640": {"statistic": "mode"}})
+        with pytest.raises(ValueError, match="vl53l1x"):
+            await pool.run_plan({"vl53l1x": {}})
+
+    asyncio.run(_with_pool([fake], body))
+    assert fake.commands == [Command.PING]
+
+
+def test_unreachable_fixture_reported_not_raised():
+    fake = FakeMCU()
+    silent = FakeMCU()
+
+    async def body(pool):
+        silent.close()              # Configured port is gone: open fails
+        connected = await pool.connect()
+        return connected, await pool.run_plan(PLAN, fixtures=["fx0", "fx1"])
+
+    connected, outcome = asyncio.run(_with_pool([fake, silent], body))
+
+    assert not connected
+    assert outcome["fx0"]["passed"]
+    assert outcome["fx1"]["error"] == "Not connected"
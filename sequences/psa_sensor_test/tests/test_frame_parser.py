@@ -0,0 +1,222 @@
+"""
+FrameParser / CobsFrameParser correctness.
+
+Frames split at every byte, garbage between frames, CRC and format
+errors, and the read offset / compaction boundary at
+FrameParser.COMPACT_THRESHOLD.
+"""
+
+import pytest
+
+from conftest import drain, encode, make_frames
+from psa_protocol.constants import ETX, MAX_PAYLOAD, STX
+from psa_protocol.frame import (
+    CobsFrameParser,
+    Frame,
+    FrameBuilder,
+    FrameParser,
+    ParseResult,
+)
+
+PARSERS = [(FrameParser, False), (CobsFrameParser, True)]
+
+
+def ok_frames(results):
+    return [frame for result, frame in results if result == ParseResult.OK]
+
+
+@pytest.mark.parametrize("parser_class, cobs", PARSERS)
+def test_parses_back_to_back_frames(parser_class, cobs, frames):
+    parser = parser_class()
+    parser.feed(encode(frames, cobs))
+
+    assert ok_frames(drain(parser)) == frames
+    assert parser.buffer_size == 0
+
+
+@pytest.mark.parametrize("parser_class, cobs", PARSERS)
+def test_frame_split_at_every_byte(parser_class, cobs):
+    pair = make_frames(2, seed=7)
+    pair[0] = Frame(0x80, bytes(range(1, MAX_PAYLOAD + 1)))
+    data = encode(pair, cobs)
+
+    for split in range(len(data) + 1):
+        parser = parser_class()
+        parser.feed(data[:split])
+        first = drain(parser)
+        parser.feed(data[split:])
+        assert ok_frames(first + drain(parser)) == pair, f"split at {split}"
+
+
+@pytest.mark.parametrize("parser_class, cobs", PARSERS)
+def test_byte_at_a_time(parser_class, cobs, frames):
+    parser = parser_class()
+    parsed = []
+    for byte in encode(frames, cobs):
+        parser.feed(bytes([byte]))
+        parsed += drain(parser)
+
+    assert ok_frames(parsed) == frames
+
+
+@pytest.mark.parametrize("parser_class, cobs", PARSERS)
+def test_memoryview_slices(parser_class, cobs, frames):
+    data = memoryview(encode(frames, cobs))
+    parser = parser_class()
+    parsed = []
+    for start in range(0, len(data), 37):
+        parser.feed(data[start:start + 37])
+        parsed += drain(parser)
+
+    assert ok_frames(parsed) == frames
+
+
+def test_garbage_before_and_between_frames():
+    frames = make_frames(20, seed=3)
+    noise = bytes([0x00, 0xFF, 0x55, ETX, 0x10])      # No STX
+    data = noise + b"".join(noise + FrameBuilder.build(f) for f in frames)
+
+    parser = FrameParser()
+    parser.feed(data)
+
+    assert ok_frames(drain(parser)) == frames
+
+
+def test_garbage_without_stx_is_dropped():
+    parser = FrameParser()
+    parser.feed(bytes(range(3, 256)) * 40)
+
+    assert parser.parse() == (ParseResult.INCOMPLETE, None, 0)
+    assert parser.buffer_size == 0
+
+
+def test_false_stx_resyncs_on_next_frame():
+    frame = Frame(0x81, b"\x01\x02")
+    # STX followed by a plausible length but no ETX where expected
+    data = bytes([STX, 0x02, 0x44, 0x45]) + FrameBuilder.build(frame)
+
+    parser = FrameParser()
+    parser.feed(data)
+    results = drain(parser)
+
+    assert ParseResult.FORMAT_ERROR in [r for r, _ in results]
+    assert ok_frames(results) == [frame]
+
+
+def test_length_over_max_is_format_error():
+    frame = Frame(0x01)
+    parser = FrameParser()
+    parser.feed(bytes([STX, MAX_PAYLOAD + 1]) + FrameBuilder.build(frame))
+
+    result, _, consumed = parser.parse()
+    assert (result, consumed) == (ParseResult.FORMAT_ERROR, 1)
+    assert ok_frames(drain(parser)) == [frame]
+
+
+@pytest.mark.parametrize("parser_class, cobs", PARSERS)
+def test_bad_crc_skips_only_that_frame(parser_class, cobs):
+    frames = make_frames(3, seed=5)
+    bad = bytearray(FrameBuilder.build(frames[1]))
+    bad[-2] ^= 0x5A
+    bad = FrameBuilder.to_cobs(bytes(bad)) if cobs else bytes(bad)
+
+    build = FrameBuilder.build_cobs if cobs else FrameBuilder.build
+    parser = parser_class()
+    parser.feed(build(frames[0]) + bad + build(frames[2]))
+    results = drain(parser)
+
+    assert [r for r, _ in results] == [ParseResult.OK, ParseResult.CRC_ERROR, ParseResult.OK]
+    assert ok_frames(results) == [frames[0], frames[2]]
+
+
+def test_cobs_overlong_run_is_dropped():
+    frame = Frame(0x01, b"\x10")
+    parser = CobsFrameParser()
+    parser.feed(b"\x55" * 200)
+
+    result, _, consumed = parser.parse()
+    assert (result, consumed) == (ParseResult.FORMAT_ERROR, 200)
+
+    parser.feed(b"\x00" + FrameBuilder.build_cobs(frame))
+    assert ok_frames(drain(parser)) == [frame]
+
+
+def test_cobs_malformed_block_is_format_error():
+    frame = Frame(0x01)
+    parser = CobsFrameParser()
+    parser.feed(b"\x05\x01\x00" + FrameBuilder.build_cobs(frame))    # Code runs past the delimiter
+
+    assert [r for r, _ in drain(parser)] == [ParseResult.FORMAT_ERROR, ParseResult.OK]
+
+
+def test_compaction_boundary_with_frame_straddling_it():
+    threshold = FrameParser.COMPACT_THRESHOLD
+    frame = Frame(0x84, bytes(range(MAX_PAYLOAD)))
+    wire = FrameBuilder.build(frame)
+    count = threshold // len(wire) + 2           # Consumed prefix crosses the threshold
+    data = wire * count
+
+    # Leave the frame that crosses the threshold incomplete
+    cut = (threshold // len(wire)) * len(wire) + len(wire) // 2
+    parser = FrameParser()
+    parser.feed(data[:cut])
+    first = drain(parser)
+
+    assert len(first) == threshold // len(wire)
+    assert parser.buffer_size == cut - len(first) * len(wire)
+    assert len(parser._buffer) == cut             # Below the threshold: nothing discarded yet
+
+    parser.feed(data[cut:])
+    second = drain(parser)
+
+    assert ok_frames(first + second) == [frame] * count
+    assert parser.buffer_size == 0
+
+
+def test_compaction_keeps_unread_tail():
+    threshold = FrameParser.COMPACT_THRESHOLD
+    frame = Frame(0x85, bytes(MAX_PAYLOAD))
+    wire = FrameBuilder.build(frame)
+    consumed_frames = threshold // len(wire) + 1
+    tail = wire[:10]
+
+    parser = FrameParser()
+    parser.feed(wire * consumed_frames + tail)
+    results = drain(parser)
+
+    assert ok_frames(results) == [frame] * consumed_frames
+    # Dead prefix passed the threshold and outweighs the tail: compacted
+    assert parser._offset == 0
+    assert bytes(parser._buffer) == tail
+    assert parser.buffer_size == len(tail)
+
+    parser.feed(wire[10:])
+    assert ok_frames(drain(parser)) == [frame]
+
+
+def test_no_compaction_while_tail_outweighs_prefix():
+    threshold = FrameParser.COMPACT_THRESHOLD
+    frame = Frame(0x85, bytes(MAX_PAYLOAD))
+    wire = FrameBuilder.build(frame)
+    consumed_frames = threshold // len(wire) + 1
+    tail_frames = consumed_frames * 2
+
+    parser = FrameParser()
+    parser.feed(wire * (consumed_frames + tail_frames))
+    for _ in range(consumed_frames):
+        assert parser.parse()[0] == ParseResult.OK
+
+    assert parser._offset == consumed_frames * len(wire)
+    assert parser.buffer_size == tail_frames * len(wire)
+    assert len(ok_frames(drain(parser))) == tail_frames
+
+
+def test_clear_resets_offset():
+    parser = FrameParser()
+    parser.feed(encode(make_frames(3)) + bytes([STX]))
+    drain(parser)
+    parser.clear()
+
+    assert parser.buffer_size == 0
+    parser.feed(FrameBuilder.build_ping())
+    assert ok_frames(drain(parser)) == [Frame(0x01)]
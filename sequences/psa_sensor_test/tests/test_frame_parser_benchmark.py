@@ -0,0 +1,54 @@
+"""
+FrameParser throughput on multi-megabyte captures (pytest-benchmark).
+
+Run with:
+    pytest tests/test_frame_parser_benchmark.py --benchmark-only
+
+Each case parses a ~2 MB stream of random frames fed in chunks of the
+given size and records frames/s in the benchmark's extra_info. Whole-
+capture feeding is the case that was quadratic before the read offset.
+"""
+
+import pytest
+
+from conftest import encode, make_frames
+from psa_protocol.frame import CobsFrameParser, FrameParser, ParseResult
+
+pytest.importorskip("pytest_benchmark")
+
+CAPTURE_FRAMES = 50_000         # ~1.8 MB classic, ~1.7 MB COBS
+ROUNDS = 3
+
+_frames = make_frames(CAPTURE_FRAMES, seed=51)
+_captures = {
+    False: encode(_frames),
+    True: encode(_frames, cobs=True),
+}
+
+
+def _parse_capture(parser_class, data: bytes, chunk: int) -> int:
+    parser = parser_class()
+    view = memoryview(data)
+    count = 0
+    for start in range(0, len(data), chunk):
+        parser.feed(view[start:start + chunk])
+        while True:
+            result, _, _ = parser.parse()
+            if result == ParseResult.INCOMPLETE:
+                break
+            count += result == ParseResult.OK
+    return count
+
+
+@pytest.mark.parametrize("chunk", [256, 4096, 1 << 30], ids=["256B", "4KiB", "whole"])
+@pytest.mark.parametrize("parser_class, cobs", [(FrameParser, False), (CobsFrameParser, True)],
+                         ids=["classic", "cobs"])
+def test_parser_throughput(benchmark, parser_class, cobs, chunk):
+    data = _captures[cobs]
+
+    count = benchmark.pedantic(_parse_capture, args=(parser_class, data, chunk),
+                               rounds=ROUNDS, iterations=1)
+
+    assert count == CAPTURE_FRAMES
+    benchmark.extra_info["capture_bytes"] = len(data)
+    benchmark.extra_info["frames_per_s"] = round(CAPTURE_FRAMES / benchmark.stats.stats.mean)
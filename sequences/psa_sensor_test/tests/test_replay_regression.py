@@ -0,0 +1,107 @@
+"""
+Replay regression gate for the host stack.
+
+Plays tests/captures/driver_session.psacap (recorded with
+tests/record_session.py) back through PSAMCUDriver with a strict
+ReplayTransport. The driver must send exactly the recorded requests in
+order, consume the whole capture and decode the same results, and at
+recorded timing it may add only HOST_BUDGET_S per exchange on top of
+the device's recorded response times.
+"""
+
+import asyncio
+import time
+
+import pytest
+
+from psa_protocol.capture import read_capture
+from psa_protocol.exceptions import ConnectionError
+from psa_mcu import PSAMCUDriver
+from record_session import CAPTURE, DRIVER_CONFIG, run_session
+
+# Host time allowed per request/response exchange at replay speed 1.0
+HOST_BUDGET_S = 0.010
+
+_VL53 = {"sensor": "VL53L0X", "status": 0, "status_name": "PASS", "passed": True,
+         "measured_mm": 507, "target_mm": 500, "tolerance_mm": 20, "diff_mm": 7}
+_MLX = {"sensor": "MLX90640", "status": 0, "status_name": "PASS", "passed": True,
+        "measured_celsius": 25.6, "target_celsius": 25.0, "tolerance_celsius": 2.0,
+        "diff_celsius": 0.6, "ambient_celsius": 24.0,
+        "min_temp_celsius": 25.6, "max_temp_celsius": 25.6}
+
+EXPECTED = {
+    "version": "1.4.2",
+    "sensors": [{"id": 1, "name": "VL53L0X"}, {"id": 2, "name": "MLX90640"}],
+    "vl53l0x": dict(_VL53, timestamp=1000),
+    "mlx90640": dict(_MLX, timestamp=2000),
+    "vl53l0x_cached": dict(_VL53, timestamp=3000),
+    "mlx90640_cached": dict(_MLX, timestamp=4000),
+    "vl53l0x_fail": dict(_VL53, timestamp=5000, passed=False, status=3, status_name="FAIL_INVALID",
+                         target_mm=300, diff_mm=207),
+}
+
+
+def _device_time(records) -> float:
+    """Sum over exchanges of recorded TX to last RX before the next TX."""
+    total = 0.0
+    sent = None
+    last_rx = None
+    for record in records:
+        if record.is_tx:
+            if sent is not None and last_rx is not None:
+                total += last_rx - sent
+            sent, last_rx = record.timestamp, None
+        else:
+            last_rx = record.timestamp
+    if sent is not None and last_rx is not None:
+        total += last_rx - sent
+    return total
+
+
+def _replay(speed: float):
+    async def body():
+        driver = PSAMCUDriver(config=dict(DRIVER_CONFIG, replay_file=str(CAPTURE),
+                                          replay_speed=speed, replay_strict=True))
+        start = time.monotonic()
+        assert await driver.connect()
+        transport = driver._transport
+        try:
+            results = await run_session(driver)
+            return results, time.monotonic() - start, transport
+        finally:
+            await driver.disconnect()
+
+    return asyncio.run(body())
+
+
+def test_replay_reproduces_recorded_session():
+    results, _, transport = _replay(speed=0)
+
+    assert results == EXPECTED
+    assert transport._cursor == len(transport._records)     # No recorded request skipped
+
+
+def test_replay_host_overhead_within_budget():
+    records = read_capture(str(CAPTURE))
+    exchanges = sum(record.is_tx for record in records)
+    device_time = _device_time(records)
+
+    _, elapsed, _ = _replay(speed=1.0)
+
+    overhead = elapsed - device_time
+    assert overhead < exchanges * HOST_BUDGET_S, (
+        f"host added {overhead * 1000:.0f} ms over {exchanges} exchanges "
+        f"(budget {exchanges * HOST_BUDGET_S * 1000:.0f} ms, device {device_time * 1000:.0f} ms)"
+    )
+
+
+def test_diverging_request_fails_the_gate(monkeypatch):
+    # A host change that alters the traffic (here: a different VL53L0X spec) must not pass silently
+    original = PSAMCUDriver.test_vl53l0x
+
+    async def shifted(self, target_mm=500, tolerance_mm=100):
+        return await original(self, target_mm + 1, tolerance_mm)
+
+    monkeypatch.setattr(PSAMCUDriver, "test_vl53l0x", shifted)
+    with pytest.raises(ConnectionError, match="Replay TX mismatch"):
+        _replay(speed=0)
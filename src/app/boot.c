@@ -0,0 +1,327 @@
+/**
+ * @file boot.c
+ * @brief Background sensor power-up and init sequencer implementation
+ *
+ * The rail has one state machine and each sensor its own, all advanced
+ * from the main loop:
+ *
+ *   rail:     [discharge (warm reset only)] -> on -> settle
+ *   MLX90640: poll for ACK -> configure + start EEPROM dump (I2C4 IRQ)
+ *             -> wait for dump -> extract parameters
+ *   VL53L0X:  XSHUT high -> tBOOT -> driver init (blocking)
+ *
+ * The blocking VL53L0X init is held back until the MLX90640 dump is
+ * running, so the two buses overlap instead of the slower sensor
+ * waiting behind the other.
+ *
+ * A DUT power cycle reruns the same sequence without an MCU reset, after
+ * marking every driver uninitialized so the new part is read from scratch.
+ */
+
+#include "app/boot.h"
+#include "main.h"
+#include "hal/i2c_handler.h"
+#include "sensors/sensor_manager.h"
+#include "sensors/mlx90640.h"
+#include <string.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define BOOT_ACK_POLL_MS        2       /* Per-poll IsDeviceReady timeout */
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+typedef enum {
+    RAIL_DISCHARGE = 0,     /* 12V off, waiting BOOT_RAIL_DISCHARGE_MS */
+    RAIL_SETTLE,            /* 12V on, waiting BOOT_RAIL_SETTLE_MS */
+    RAIL_UP,                /* Sensors may be accessed */
+} RailState_t;
+
+typedef enum {
+    SENSOR_WAIT = 0,        /* Waiting for the rail */
+    SENSOR_BOOTING,         /* VL53L0X: tBOOT / MLX90640: polling for ACK */
+    SENSOR_INIT,            /* VL53L0X: ready for init / MLX90640: EEPROM dump running */
+    SENSOR_DONE,            /* Init finished (see BOOT_FLAG_*_OK) */
+} SensorState_t;
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static RailState_t rail_state = RAIL_DISCHARGE;
+static SensorState_t vl53l0x_state = SENSOR_WAIT;
+static SensorState_t mlx90640_state = SENSOR_WAIT;
+static uint32_t rail_tick = 0;
+static uint32_t vl53l0x_tick = 0;
+static uint32_t mlx90640_tick = 0;
+static bool boot_started = false;
+static bool boot_complete = false;
+static uint8_t boot_flags = 0;
+static uint32_t boot_base = 0;              /* Tick phase times are relative to */
+static uint32_t rail_off_ms = 0;            /* Discharge time for this sequence */
+static uint16_t phase_ms[BOOT_PHASE_COUNT];
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static void Boot_Begin(uint8_t flags, uint32_t off_ms);
+static void Boot_Mark(BootPhase_t phase);
+static void Boot_ProcessRail(uint32_t now);
+static void Boot_ProcessMLX90640(uint32_t now);
+static void Boot_ProcessVL53L0X(uint32_t now);
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+void Boot_Start(void)
+{
+    /* Sensors only keep state across a reset that left the rail powered */
+    bool cold = __HAL_RCC_GET_FLAG(RCC_FLAG_PORRST) || __HAL_RCC_GET_FLAG(RCC_FLAG_BORRST);
+    __HAL_RCC_CLEAR_RESET_FLAGS();
+
+    boot_base = 0;
+    Boot_Begin(cold ? 0 : BOOT_FLAG_WARM_RESET, cold ? 0 : BOOT_RAIL_DISCHARGE_MS);
+}
+
+bool Boot_PowerCycle(uint32_t off_ms)
+{
+    if (!boot_complete) {
+        return false;   /* Previous sequence still owns the buses */
+    }
+
+    /* New part: every driver must read its device again */
+    uint8_t count = SensorManager_GetCount();
+    for (uint8_t i = 0; i < count; i++) {
+        const SensorDriver_t* driver = SensorManager_GetByIndex(i);
+        if (driver && driver->deinit) {
+            driver->deinit();
+        }
+    }
+
+    boot_base = HAL_GetTick();
+    Boot_Begin(BOOT_FLAG_DUT_CYCLE, off_ms);
+    return true;
+}
+
+bool Boot_Process(void)
+{
+    if (!boot_started || boot_complete) {
+        return false;
+    }
+
+    uint32_t now = HAL_GetTick();
+
+    Boot_ProcessRail(now);
+    if (rail_state != RAIL_UP) {
+        return false;
+    }
+
+    Boot_ProcessMLX90640(now);
+    Boot_ProcessVL53L0X(now);
+
+    if (vl53l0x_state == SENSOR_DONE && mlx90640_state == SENSOR_DONE) {
+        Boot_Mark(BOOT_PHASE_READY);
+        boot_complete = true;
+        return true;
+    }
+    return false;
+}
+
+bool Boot_IsComplete(void)
+{
+    return boot_complete;
+}
+
+void Boot_GetInfo(BootInfo_t* info)
+{
+    if (info == NULL) {
+        return;
+    }
+
+    info->ready = boot_complete;
+    info->flags = boot_flags;
+    memcpy(info->phase_ms, phase_ms, sizeof(info->phase_ms));
+}
+
+uint8_t Boot_SerializeInfo(const BootInfo_t* info, uint8_t* buffer)
+{
+    if (info == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    /* Format: [ready][flags][phase_ms(2) x BOOT_PHASE_COUNT] - big-endian */
+    uint8_t idx = 0;
+    buffer[idx++] = info->ready ? 1 : 0;
+    buffer[idx++] = info->flags;
+    for (uint8_t i = 0; i < BOOT_PHASE_COUNT; i++) {
+        buffer[idx++] = (uint8_t)(info->phase_ms[i] >> 8);
+        buffer[idx++] = (uint8_t)(info->phase_ms[i] & 0xFF);
+    }
+
+    return idx;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Switch the rail off and restart all state machines
+ */
+static void Boot_Begin(uint8_t flags, uint32_t off_ms)
+{
+    memset(phase_ms, 0xFF, sizeof(phase_ms));
+    boot_flags = flags;
+    boot_complete = false;
+    vl53l0x_state = SENSOR_WAIT;
+    mlx90640_state = SENSOR_WAIT;
+
+    Boot_Mark(BOOT_PHASE_PROTOCOL);
+
+    HAL_GPIO_WritePin(DO_TOF1_SHUT_GPIO_Port, DO_TOF1_SHUT_Pin, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(DO_12VA_EN_GPIO_Port, DO_12VA_EN_Pin, GPIO_PIN_RESET);
+    rail_tick = HAL_GetTick();
+    rail_off_ms = off_ms;
+    rail_state = RAIL_DISCHARGE;
+
+    boot_started = true;
+}
+
+/**
+ * @brief Record the time a phase was reached
+ */
+static void Boot_Mark(BootPhase_t phase)
+{
+    uint32_t elapsed = HAL_GetTick() - boot_base;
+    phase_ms[phase] = (elapsed < BOOT_PHASE_NONE) ? (uint16_t)elapsed : (uint16_t)(BOOT_PHASE_NONE - 1);
+}
+
+/**
+ * @brief Discharge (not after power-on), switch on and settle the 12V rail
+ */
+static void Boot_ProcessRail(uint32_t now)
+{
+    switch (rail_state) {
+        case RAIL_DISCHARGE:
+            if ((now - rail_tick) < rail_off_ms) {
+                break;
+            }
+            HAL_GPIO_WritePin(DO_12VA_EN_GPIO_Port, DO_12VA_EN_Pin, GPIO_PIN_SET);
+            Boot_Mark(BOOT_PHASE_RAIL_ON);
+            rail_tick = now;
+            rail_state = RAIL_SETTLE;
+            break;
+
+        case RAIL_SETTLE:
+            if ((now - rail_tick) < BOOT_RAIL_SETTLE_MS) {
+                break;
+            }
+            /* Release VL53L0X from reset; the MLX90640 boots on its own */
+            HAL_GPIO_WritePin(DO_TOF1_SHUT_GPIO_Port, DO_TOF1_SHUT_Pin, GPIO_PIN_SET);
+            vl53l0x_tick = now;
+            mlx90640_tick = now;
+            vl53l0x_state = SENSOR_BOOTING;
+            mlx90640_state = SENSOR_BOOTING;
+            rail_state = RAIL_UP;
+            break;
+
+        case RAIL_UP:
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief MLX90640 on I2C4: wait for ACK, dump EEPROM in the background, extract
+ */
+static void Boot_ProcessMLX90640(uint32_t now)
+{
+    HAL_StatusTypeDef status;
+
+    switch (mlx90640_state) {
+        case SENSOR_BOOTING:
+            if (I2C_Handler_IsDeviceReady(MLX90640_I2C_BUS, MLX90640_I2C_ADDR, BOOT_ACK_POLL_MS) != HAL_OK) {
+                if ((now - mlx90640_tick) >= BOOT_MLX90640_ACK_MS) {
+                    mlx90640_state = SENSOR_DONE;
+                }
+                break;
+            }
+            Boot_Mark(BOOT_PHASE_MLX_ACK);
+
+            if (MLX90640_StartInit() != HAL_OK) {
+                mlx90640_state = SENSOR_DONE;
+                break;
+            }
+            mlx90640_tick = HAL_GetTick();
+            mlx90640_state = SENSOR_INIT;
+            break;
+
+        case SENSOR_INIT:
+            status = I2C_Handler_AsyncStatus(MLX90640_I2C_BUS);
+            if (status == HAL_BUSY) {
+                if ((now - mlx90640_tick) < BOOT_MLX90640_EEPROM_MS) {
+                    break;
+                }
+                /* Stalled dump: stop it so no late completion lands in the scratch */
+                I2C_Handler_AbortAsync(MLX90640_I2C_BUS, BOOT_I2C_ABORT_MS);
+                status = HAL_ERROR;
+            }
+
+            if (status == HAL_OK) {
+                Boot_Mark(BOOT_PHASE_MLX_EEPROM);
+            }
+            /* PollInit releases the EEPROM scratch once the dump is no longer busy */
+            if (MLX90640_PollInit() == HAL_OK) {
+                boot_flags |= BOOT_FLAG_MLX90640_OK;
+                Boot_Mark(BOOT_PHASE_MLX90640);
+            }
+            mlx90640_state = SENSOR_DONE;
+            break;
+
+        case SENSOR_WAIT:
+        case SENSOR_DONE:
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief VL53L0X on I2C1: wait tBOOT, then init while the MLX90640 EEPROM dump runs
+ */
+static void Boot_ProcessVL53L0X(uint32_t now)
+{
+    switch (vl53l0x_state) {
+        case SENSOR_BOOTING:
+            if ((now - vl53l0x_tick) < BOOT_VL53L0X_BOOT_MS) {
+                break;
+            }
+            vl53l0x_state = SENSOR_INIT;
+            /* fall through */
+
+        case SENSOR_INIT: {
+            /* The init blocks: start it only behind the MLX90640 EEPROM dump */
+            if (mlx90640_state == SENSOR_BOOTING) {
+                break;
+            }
+
+            const SensorDriver_t* driver = SensorManager_GetByID(SENSOR_ID_VL53L0X);
+            if (driver && driver->init && driver->init() == HAL_OK) {
+                boot_flags |= BOOT_FLAG_VL53L0X_OK;
+            }
+            Boot_Mark(BOOT_PHASE_VL53L0X);
+            vl53l0x_state = SENSOR_DONE;
+            break;
+        }
+
+        case SENSOR_WAIT:
+        case SENSOR_DONE:
+        default:
+            break;
+    }
+}
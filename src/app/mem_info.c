@@ -0,0 +1,141 @@
+/**
+ * @file mem_info.c
+ * @brief RAM budget and stack high-water-mark reporting implementation
+ *
+ * The paint covers [heap break, SP - margin) at the top of main(). A scan
+ * walks up from the current heap break (a heap that grew after painting
+ * has overwritten the bottom of the paint, not stack) until the first
+ * word that no longer holds the pattern: everything above it has been
+ * stack at some point. A frame that reserves stack without writing all
+ * of it can hide a few words, so treat the watermark as a lower bound
+ * and keep some headroom.
+ */
+
+#include "app/mem_info.h"
+#include "main.h"
+#include <stddef.h>
+#include <string.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define MEM_STACK_PAINT         0xC5C5C5C5UL
+#define MEM_PAINT_MARGIN        256     /* Left unpainted below SP (painter's own frame) */
+
+_Static_assert(sizeof(MemInfo_t) == MEM_INFO_SIZE, "MemInfo_t must match the serialized size");
+
+/*============================================================================*/
+/* Linker Symbols                                                             */
+/*============================================================================*/
+
+extern uint8_t _sdata[], _edata[], _sidata[];
+extern uint8_t _sbss[], _ebss[];
+extern uint8_t _end[], _estack[], _Min_Stack_Size[];
+extern uint8_t __dtcm_size[];
+extern uint8_t __axi_start[], __axi_end[], __axi_size[];
+extern uint8_t __d3_start[], __d3_end[], __d3_size[];
+extern uint8_t __flash_start[], __flash_size[];
+
+extern void* _sbrk(ptrdiff_t incr);
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static uint32_t* paint_top = NULL;     /* First unpainted word above the paint */
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static uint32_t* Mem_HeapBreak(void);
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+void MemInfo_PaintStack(void)
+{
+    uint32_t* p = Mem_HeapBreak();
+    uint32_t* top = (uint32_t*)((__get_MSP() - MEM_PAINT_MARGIN) & ~3UL);
+
+    while (p < top) {
+        *p++ = MEM_STACK_PAINT;
+    }
+    paint_top = top;
+}
+
+void MemInfo_GetInfo(MemInfo_t* info)
+{
+    if (info == NULL) {
+        return;
+    }
+
+    memset(info, 0, sizeof(*info));
+
+    uint32_t* heap_break = Mem_HeapBreak();
+    uint32_t estack = (uint32_t)_estack;
+
+    info->dtcm_size = (uint32_t)__dtcm_size;
+    info->data = (uint32_t)(_edata - _sdata);
+    info->bss = (uint32_t)(_ebss - _sbss);
+    info->heap_used = (uint32_t)((uint8_t*)heap_break - _end);
+    info->stack_reserved = (uint32_t)_Min_Stack_Size;
+    info->stack_now = estack - __get_MSP();
+
+    /* Watermark: lowest word the stack has ever written */
+    uint32_t* p = heap_break;
+    if (paint_top != NULL) {
+        while (p < paint_top && *p == MEM_STACK_PAINT) {
+            p++;
+        }
+    }
+    info->stack_peak = estack - (uint32_t)p;
+    info->stack_free = (uint32_t)((uint8_t*)p - (uint8_t*)heap_break);
+
+    info->axi_used = (uint32_t)(__axi_end - __axi_start);
+    info->axi_size = (uint32_t)__axi_size;
+    info->d3_used = (uint32_t)(__d3_end - __d3_start);
+    info->d3_size = (uint32_t)__d3_size;
+    info->flash_used = (uint32_t)(_sidata - __flash_start) + info->data;
+    info->flash_size = (uint32_t)__flash_size;
+}
+
+uint8_t MemInfo_Serialize(const MemInfo_t* info, uint8_t* buffer)
+{
+    if (info == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    /* Format: 14 x uint32 big-endian in MemInfo_t field order */
+    const uint32_t fields[] = {
+        info->dtcm_size, info->data, info->bss, info->heap_used,
+        info->stack_reserved, info->stack_peak, info->stack_now, info->stack_free,
+        info->axi_used, info->axi_size, info->d3_used, info->d3_size,
+        info->flash_used, info->flash_size,
+    };
+
+    uint8_t idx = 0;
+    for (uint8_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        buffer[idx++] = (uint8_t)(fields[i] >> 24);
+        buffer[idx++] = (uint8_t)(fields[i] >> 16);
+        buffer[idx++] = (uint8_t)(fields[i] >> 8);
+        buffer[idx++] = (uint8_t)(fields[i] & 0xFF);
+    }
+
+    return idx;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Current heap break, rounded up to a word
+ */
+static uint32_t* Mem_HeapBreak(void)
+{
+    uintptr_t brk = (uintptr_t)_sbrk(0);
+    return (uint32_t*)((brk + 3) & ~(uintptr_t)3);
+}
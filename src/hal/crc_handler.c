@@ -0,0 +1,312 @@
+/**
+ * @file crc_handler.c
+ * @brief CRC service implementation
+ *
+ * Software backend: slice-by-4 tables built at init. Non-reflected CRCs
+ * are kept left-aligned in a 32-bit register so one loop serves every
+ * width; reflected CRCs stay right-aligned, as in the usual byte loop.
+ *
+ * Hardware backend: the CRC peripheral is reprogrammed only when the
+ * algorithm changes. It runs with byte-wise input reversal for reflected
+ * CRCs but without output reversal, so its register is the bit-reverse
+ * of the software one and a running CRC converts with one __RBIT.
+ *
+ * DMA feeding is not used: the peripheral takes a word per AHB write,
+ * so a whole golden image (3KB) is done in a few microseconds, less
+ * than an MDMA transfer takes to set up.
+ */
+
+#include "hal/crc_handler.h"
+#include <stddef.h>
+
+#if CRC_HW_ENABLED
+#include "stm32h7xx_hal.h"
+#endif
+
+/*============================================================================*/
+/* Private Types                                                              */
+/*============================================================================*/
+
+typedef struct {
+    uint8_t     width;          /* 8, 16 or 32 */
+    uint32_t    poly;           /* Normal (MSB-first) form, odd for the peripheral */
+    uint32_t    init;           /* Register start value, normal form */
+    uint32_t    xor_out;        /* Applied by CRC_Handler_Finish */
+    bool        reflect;        /* Reflected input and output */
+    uint32_t    check;          /* CRC of "123456789" */
+} CrcAlgorithm_t;
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static const CrcAlgorithm_t algorithms[CRC_ID_COUNT] = {
+    [CRC_ID_FRAME]   = {  8, 0x07UL,       0x00UL,       0x00UL,       false, 0xF4UL },
+    [CRC_ID_STORAGE] = { 32, 0x04C11DB7UL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, true,  0xCBF43926UL },
+};
+
+/* Catalogue check input: each check value is the CRC of these bytes */
+static const uint8_t check_data[9] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+static uint32_t crc_tables[CRC_ID_COUNT][4][256];
+static CrcBackend_t backend = CRC_BACKEND_SOFTWARE;
+
+#if CRC_HW_ENABLED
+static CRC_HandleTypeDef crc_handle;
+static CrcID_t hw_id = CRC_ID_COUNT;        /* Algorithm the peripheral is set up for */
+#endif
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static void CRC_BuildTables(CrcID_t id);
+static uint32_t CRC_Reflect(uint32_t value, uint8_t width);
+static uint32_t CRC_SoftUpdate(CrcID_t id, uint32_t crc, const uint8_t* data, uint32_t len);
+#if CRC_HW_ENABLED
+static bool CRC_HwSelfCheck(void);
+static uint32_t CRC_HwUpdate(CrcID_t id, uint32_t crc, const uint8_t* data, uint32_t len);
+#endif
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+CrcBackend_t CRC_Handler_Init(void)
+{
+    backend = CRC_BACKEND_SOFTWARE;
+
+    for (uint8_t id = 0; id < CRC_ID_COUNT; id++) {
+        CRC_BuildTables((CrcID_t)id);
+    }
+
+    for (uint8_t id = 0; id < CRC_ID_COUNT; id++) {
+        if (CRC_Handler_Calculate((CrcID_t)id, check_data, sizeof(check_data)) != algorithms[id].check) {
+            return backend;     /* Bad algorithm entry: the peripheral cannot match it either */
+        }
+    }
+
+#if CRC_HW_ENABLED
+    if (CRC_HwSelfCheck()) {
+        backend = CRC_BACKEND_HARDWARE;
+    }
+#endif
+
+    return backend;
+}
+
+uint32_t CRC_Handler_Calculate(CrcID_t id, const void* data, uint32_t len)
+{
+    return CRC_Handler_Finish(id, CRC_Handler_Update(id, CRC_Handler_Start(id), data, len));
+}
+
+uint32_t CRC_Handler_Start(CrcID_t id)
+{
+    if (id >= CRC_ID_COUNT) {
+        return 0;
+    }
+
+    const CrcAlgorithm_t* alg = &algorithms[id];
+    return alg->reflect ? CRC_Reflect(alg->init, alg->width) : alg->init;
+}
+
+uint32_t CRC_Handler_Update(CrcID_t id, uint32_t crc, const void* data, uint32_t len)
+{
+    if (id >= CRC_ID_COUNT || data == NULL || len == 0) {
+        return crc;
+    }
+
+#if CRC_HW_ENABLED
+    if (backend == CRC_BACKEND_HARDWARE && len >= CRC_HW_MIN_LEN) {
+        return CRC_HwUpdate(id, crc, (const uint8_t*)data, len);
+    }
+#endif
+
+    return CRC_SoftUpdate(id, crc, (const uint8_t*)data, len);
+}
+
+uint32_t CRC_Handler_Finish(CrcID_t id, uint32_t crc)
+{
+    if (id >= CRC_ID_COUNT) {
+        return 0;
+    }
+
+    const CrcAlgorithm_t* alg = &algorithms[id];
+    uint32_t mask = (alg->width == 32) ? 0xFFFFFFFFUL : ((1UL << alg->width) - 1);
+    return (crc ^ alg->xor_out) & mask;
+}
+
+CrcBackend_t CRC_Handler_GetBackend(void)
+{
+    return backend;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Build the slice-by-4 tables of one algorithm
+ *
+ * Table n advances a byte through n further zero bytes.
+ */
+static void CRC_BuildTables(CrcID_t id)
+{
+    const CrcAlgorithm_t* alg = &algorithms[id];
+    uint32_t (*table)[256] = crc_tables[id];
+
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t r;
+        if (alg->reflect) {
+            uint32_t poly = CRC_Reflect(alg->poly, alg->width);
+            r = i;
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                r = (r & 1UL) ? (r >> 1) ^ poly : (r >> 1);
+            }
+        } else {
+            uint32_t poly = alg->poly << (32 - alg->width);
+            r = i << 24;
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                r = (r & 0x80000000UL) ? (r << 1) ^ poly : (r << 1);
+            }
+        }
+        table[0][i] = r;
+    }
+
+    for (uint8_t n = 1; n < 4; n++) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t prev = table[n - 1][i];
+            table[n][i] = alg->reflect ? (prev >> 8) ^ table[0][prev & 0xFF]
+                                       : (prev << 8) ^ table[0][prev >> 24];
+        }
+    }
+}
+
+/**
+ * @brief Reverse the low width bits of value
+ */
+static uint32_t CRC_Reflect(uint32_t value, uint8_t width)
+{
+    uint32_t result = 0;
+
+    for (uint8_t bit = 0; bit < width; bit++) {
+        result = (result << 1) | (value & 1UL);
+        value >>= 1;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Table backend: four bytes per step, then single bytes
+ */
+static uint32_t CRC_SoftUpdate(CrcID_t id, uint32_t crc, const uint8_t* data, uint32_t len)
+{
+    const CrcAlgorithm_t* alg = &algorithms[id];
+    const uint32_t (*table)[256] = (const uint32_t (*)[256])crc_tables[id];
+
+    if (alg->reflect) {
+        while (len >= 4) {
+            crc ^= (uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+                   ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+            crc = table[3][crc & 0xFF] ^ table[2][(crc >> 8) & 0xFF] ^
+                  table[1][(crc >> 16) & 0xFF] ^ table[0][crc >> 24];
+            data += 4;
+            len -= 4;
+        }
+        while (len-- > 0) {
+            crc = (crc >> 8) ^ table[0][(crc ^ *data++) & 0xFF];
+        }
+        return crc;
+    }
+
+    /* Left-align so the top byte is always the next one out */
+    uint8_t shift = 32 - alg->width;
+    crc <<= shift;
+
+    while (len >= 4) {
+        crc ^= ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) |
+               ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+        crc = table[3][crc >> 24] ^ table[2][(crc >> 16) & 0xFF] ^
+              table[1][(crc >> 8) & 0xFF] ^ table[0][crc & 0xFF];
+        data += 4;
+        len -= 4;
+    }
+    while (len-- > 0) {
+        crc = (crc << 8) ^ table[0][(crc >> 24) ^ *data++];
+    }
+
+    return crc >> shift;
+}
+
+#if CRC_HW_ENABLED
+/**
+ * @brief Compare the peripheral with the catalogue and the tables
+ *
+ * The fixed check vector must give each algorithm's check value through
+ * the peripheral alone; an odd-length, unaligned buffer must then give
+ * the same CRC as the tables, whole and resumed from a running CRC.
+ */
+static bool CRC_HwSelfCheck(void)
+{
+    uint8_t pattern[CRC_HW_MIN_LEN * 4 + 4];
+
+    for (uint16_t i = 0; i < sizeof(pattern); i++) {
+        pattern[i] = (uint8_t)(i * 7 + 13);
+    }
+
+    for (uint8_t id = 0; id < CRC_ID_COUNT; id++) {
+        uint32_t start = CRC_Handler_Start((CrcID_t)id);
+        uint32_t check = CRC_Handler_Finish((CrcID_t)id,
+                                            CRC_HwUpdate((CrcID_t)id, start, check_data, sizeof(check_data)));
+        uint32_t soft = CRC_SoftUpdate((CrcID_t)id, start, &pattern[1], sizeof(pattern) - 2);
+        uint32_t hard = CRC_HwUpdate((CrcID_t)id, start, &pattern[1], sizeof(pattern) - 2);
+
+        /* A running CRC must also carry over from the tables to the peripheral */
+        uint32_t mixed = CRC_SoftUpdate((CrcID_t)id, start, &pattern[1], 3);
+        mixed = CRC_HwUpdate((CrcID_t)id, mixed, &pattern[4], sizeof(pattern) - 5);
+
+        if (check != algorithms[id].check || hard != soft || mixed != soft) {
+            hw_id = CRC_ID_COUNT;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Peripheral backend, resuming from a running CRC
+ */
+static uint32_t CRC_HwUpdate(CrcID_t id, uint32_t crc, const uint8_t* data, uint32_t len)
+{
+    const CrcAlgorithm_t* alg = &algorithms[id];
+
+    if (hw_id != id) {
+        crc_handle.Instance = CRC;
+        crc_handle.Init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_DISABLE;
+        crc_handle.Init.DefaultInitValueUse = DEFAULT_INIT_VALUE_DISABLE;
+        crc_handle.Init.GeneratingPolynomial = alg->poly;
+        crc_handle.Init.CRCLength = (alg->width == 8) ? CRC_POLYLENGTH_8B :
+                                    (alg->width == 16) ? CRC_POLYLENGTH_16B : CRC_POLYLENGTH_32B;
+        crc_handle.Init.InitValue = 0;
+        crc_handle.Init.InputDataInversionMode = alg->reflect ? CRC_INPUTDATA_INVERSION_BYTE
+                                                              : CRC_INPUTDATA_INVERSION_NONE;
+        crc_handle.Init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_DISABLE;
+        crc_handle.InputDataFormat = CRC_INPUTDATA_FORMAT_BYTES;
+        if (HAL_CRC_Init(&crc_handle) != HAL_OK) {
+            hw_id = CRC_ID_COUNT;
+            return CRC_SoftUpdate(id, crc, data, len);
+        }
+        hw_id = id;
+    }
+
+    uint8_t shift = 32 - alg->width;
+    __HAL_CRC_INITIALCRCVALUE_CONFIG(&crc_handle, alg->reflect ? (__RBIT(crc) >> shift) : crc);
+
+    uint32_t result = HAL_CRC_Calculate(&crc_handle, (uint32_t*)(uintptr_t)data, len);
+    result &= 0xFFFFFFFFUL >> shift;
+
+    return alg->reflect ? (__RBIT(result) >> shift) : result;
+}
+#endif
@@ -11,6 +11,14 @@
 /*============================================================================*/
 
 static I2C_HandleTypeDef* i2c_handles[I2C_BUS_COUNT] = {NULL};
+static volatile HAL_StatusTypeDef async_status[I2C_BUS_COUNT] = {HAL_OK};
+static uint16_t async_addr[I2C_BUS_COUNT] = {0};
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static void I2C_Handler_AsyncDone(I2C_HandleTypeDef* hi2c, HAL_StatusTypeDef status);
 
 /*============================================================================*/
 /* Public Functions                                                           */
@@ -102,3 +110,101 @@ I2C_HandleTypeDef* I2C_Handler_GetHandle(I2C_BusID_t bus_id)
     }
     return i2c_handles[bus_id];
 }
+
+HAL_StatusTypeDef I2C_Handler_Read16Async(I2C_BusID_t bus_id, uint8_t dev_addr,
+                                           uint16_t reg_addr, uint8_t* data,
+                                           uint16_t len)
+{
+    if (bus_id >= I2C_BUS_COUNT || i2c_handles[bus_id] == NULL || data == NULL) {
+        return HAL_ERROR;
+    }
+
+    uint16_t addr_8bit = (uint16_t)(dev_addr << 1);
+
+    async_addr[bus_id] = addr_8bit;
+    async_status[bus_id] = HAL_BUSY;
+    HAL_StatusTypeDef status = HAL_I2C_Mem_Read_IT(i2c_handles[bus_id], addr_8bit, reg_addr,
+                                                   I2C_MEMADD_SIZE_16BIT, data, len);
+    if (status != HAL_OK) {
+        async_status[bus_id] = HAL_ERROR;
+    }
+    return status;
+}
+
+HAL_StatusTypeDef I2C_Handler_AsyncStatus(I2C_BusID_t bus_id)
+{
+    if (bus_id >= I2C_BUS_COUNT) {
+        return HAL_ERROR;
+    }
+    return async_status[bus_id];
+}
+
+HAL_StatusTypeDef I2C_Handler_AbortAsync(I2C_BusID_t bus_id, uint32_t timeout_ms)
+{
+    if (bus_id >= I2C_BUS_COUNT || i2c_handles[bus_id] == NULL) {
+        return HAL_ERROR;
+    }
+    if (async_status[bus_id] != HAL_BUSY) {
+        return HAL_OK;
+    }
+
+    I2C_HandleTypeDef* hi2c = i2c_handles[bus_id];
+
+    if (HAL_I2C_Master_Abort_IT(hi2c, async_addr[bus_id]) == HAL_OK) {
+        uint32_t start = HAL_GetTick();
+        while (async_status[bus_id] == HAL_BUSY && (HAL_GetTick() - start) < timeout_ms) {
+        }
+        if (async_status[bus_id] != HAL_BUSY) {
+            return HAL_OK;
+        }
+    }
+
+    /* Stuck bus or abort refused: mask the transfer IRQs and reset the peripheral (PE low >= 3 APB cycles) */
+    __HAL_I2C_DISABLE_IT(hi2c, I2C_IT_ERRI | I2C_IT_TCI | I2C_IT_STOPI | I2C_IT_NACKI |
+                               I2C_IT_ADDRI | I2C_IT_RXI | I2C_IT_TXI);
+    __HAL_I2C_DISABLE(hi2c);
+    for (uint8_t i = 0; i < 3; i++) {
+        (void)READ_REG(hi2c->Instance->CR1);
+    }
+    __HAL_I2C_ENABLE(hi2c);
+
+    hi2c->State = HAL_I2C_STATE_READY;
+    hi2c->Mode = HAL_I2C_MODE_NONE;
+    hi2c->XferCount = 0;
+    __HAL_UNLOCK(hi2c);
+
+    async_status[bus_id] = HAL_ERROR;
+    return HAL_TIMEOUT;
+}
+
+/*============================================================================*/
+/* HAL Callbacks                                                              */
+/*============================================================================*/
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef* hi2c)
+{
+    I2C_Handler_AsyncDone(hi2c, HAL_OK);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c)
+{
+    I2C_Handler_AsyncDone(hi2c, HAL_ERROR);
+}
+
+void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef* hi2c)
+{
+    I2C_Handler_AsyncDone(hi2c, HAL_ERROR);
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+static void I2C_Handler_AsyncDone(I2C_HandleTypeDef* hi2c, HAL_StatusTypeDef status)
+{
+    for (uint8_t i = 0; i < I2C_BUS_COUNT; i++) {
+        if (i2c_handles[i] == hi2c) {
+            async_status[i] = status;
+        }
+    }
+}
@@ -2,8 +2,9 @@
  * @file main.cpp
  * @brief PSA Sensor Test Firmware - Standalone Sensor Reading
  *
- * Simple firmware that initializes VL53L0X and MLX90640 sensors
- * and periodically reads data, outputting via RTT.
+ * Brings up UART and the protocol first, then powers and initializes the
+ * VL53L0X and MLX90640 sensors in the background (see app/boot.h) while
+ * commands are already being served.
  *
  * Hardware Configuration:
  *   - MCU: STM32H723VGT6 @ 384MHz
@@ -15,22 +16,24 @@
 extern "C" {
 #include "main.h"
 #include "config.h"
+#include "hal/crc_handler.h"
 #include "hal/i2c_handler.h"
 #include "hal/uart_handler.h"
 #include "protocol/protocol.h"
 #include "sensors/sensor_manager.h"
 #include "sensors/vl53l0x.h"
 #include "sensors/mlx90640.h"
+#include "sensors/thermal_golden.h"
+#include "sensors/thermal_classifier.h"
+#include "test/test_journal.h"
+#include "app/boot.h"
+#include "app/mem_info.h"
+#include "sensors/sensor_arena.h"
 #include "MLX90640_API.h"
 #include "vl53l0x_simple.h"
 
 /* VL53L0X device handle from vl53l0x.c */
 extern VL53L0X_Dev_Simple_t vl53l0x_dev;
-
-/* MLX90640 data buffers from mlx90640.c */
-extern paramsMLX90640 mlx_params;
-extern uint16_t frameData[834];
-extern float mlxTemperatures[768];
 }
 
 #include <stdio.h>
@@ -71,13 +74,6 @@ static void MPU_Config(void);
 static void MX_IWDG_Init(void);
 #endif
 
-/*============================================================================*/
-/* Sensor Reading State                                                       */
-/*============================================================================*/
-
-static bool vl53l0x_ready = false;
-static bool mlx90640_ready = false;
-
 /*============================================================================*/
 /* Error Handler                                                              */
 /*============================================================================*/
@@ -104,6 +100,9 @@ extern "C" void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
 
 int main(void)
 {
+    /* Stack watermark paint before anything else uses the stack */
+    MemInfo_PaintStack();
+
     /* MPU Configuration */
     MPU_Config();
 
@@ -126,12 +125,6 @@ int main(void)
     MX_GPIO_Init();
     SEGGER_RTT_printf(0, "[BOOT] GPIO initialized (12V OFF, XSHUT LOW)\r\n");
 
-    /* Ensure 12V is OFF and wait 1 second for power discharge */
-    HAL_GPIO_WritePin(DO_12VA_EN_GPIO_Port, DO_12VA_EN_Pin, GPIO_PIN_RESET);
-    HAL_GPIO_WritePin(DO_TOF1_SHUT_GPIO_Port, DO_TOF1_SHUT_Pin, GPIO_PIN_RESET);
-    SEGGER_RTT_printf(0, "[BOOT] 12V OFF, waiting 1s...\r\n");
-    HAL_Delay(1000);
-
     /* Initialize I2C buses (while sensors are powered off) */
     MX_I2C1_Init();
     SEGGER_RTT_printf(0, "[BOOT] I2C1 initialized (VL53L0X)\r\n");
@@ -142,21 +135,18 @@ int main(void)
     MX_UART4_Init();
     SEGGER_RTT_printf(0, "[BOOT] UART4 initialized (115200-8-N-1)\r\n");
 
-    /* === Power-up sequence === */
-    /* Step 1: Enable 12V power rail */
-    HAL_GPIO_WritePin(DO_12VA_EN_GPIO_Port, DO_12VA_EN_Pin, GPIO_PIN_SET);
-    SEGGER_RTT_printf(0, "[BOOT] 12V ON, waiting 100ms...\r\n");
-    HAL_Delay(100);
-
-    /* Step 2: Release VL53L0X from reset (XSHUT HIGH) */
-    HAL_GPIO_WritePin(DO_TOF1_SHUT_GPIO_Port, DO_TOF1_SHUT_Pin, GPIO_PIN_SET);
-    SEGGER_RTT_printf(0, "[BOOT] VL53L0X XSHUT HIGH, waiting 100ms...\r\n");
-    HAL_Delay(100);
-
-    /* Initialize application */
+    /* Initialize application (protocol first, sensors power up in the background) */
     App_Init();
 
-    SEGGER_RTT_printf(0, "\r\n[BOOT] Entering main loop - sensor data every 1 second\r\n\r\n");
+    MemInfo_t mem;
+    MemInfo_GetInfo(&mem);
+    SEGGER_RTT_printf(0, "[BOOT] DTCM: data %u + bss %u of %u B, stack peak %u B, AXI %u/%u B, flash %u/%u B\r\n",
+                      (unsigned)mem.data, (unsigned)mem.bss, (unsigned)mem.dtcm_size,
+                      (unsigned)mem.stack_peak, (unsigned)mem.axi_used, (unsigned)mem.axi_size,
+                      (unsigned)mem.flash_used, (unsigned)mem.flash_size);
+
+    SEGGER_RTT_printf(0, "\r\n[BOOT] Entering main loop - protocol ready at %u ms\r\n\r\n",
+                      (unsigned)HAL_GetTick());
 
 #if WATCHDOG_ENABLED
     MX_IWDG_Init();
@@ -181,6 +171,10 @@ int main(void)
  */
 static void App_Init(void)
 {
+    /* CRC service first: frames and flash records depend on it */
+    CrcBackend_t crc = CRC_Handler_Init();
+    SEGGER_RTT_printf(0, "[App] CRC: %s\r\n", (crc == CRC_BACKEND_HARDWARE) ? "hardware" : "software");
+
     /* Initialize I2C handler */
     I2C_Handler_Init(I2C_BUS_1, &hi2c1);
     I2C_Handler_Init(I2C_BUS_4, &hi2c4);
@@ -188,7 +182,7 @@ static void App_Init(void)
     /* Initialize UART handler and protocol */
     UART_Handler_Init(&huart4);
     Protocol_Init();
-    SEGGER_RTT_printf(0, "[App] Protocol initialized\r\n");
+    SEGGER_RTT_printf(0, "[App] Protocol initialized (UART4, RTT buffer %d)\r\n", PROTOCOL_RTT_CHANNEL);
 
     /* Initialize sensor manager (registers VL53L0X, MLX90640 drivers) */
     SensorManager_Init();
@@ -196,6 +190,30 @@ static void App_Init(void)
     uint8_t count = SensorManager_GetCount();
     SEGGER_RTT_printf(0, "[App] Registered sensors: %d\r\n", count);
 
+    /* Load golden reference image from flash */
+    ThermalGolden_Init();
+    ThermalGoldenInfo_t golden;
+    ThermalGolden_GetInfo(&golden);
+    SEGGER_RTT_printf(0, "[App] Golden image: %s\r\n", golden.valid ? "loaded" : "none");
+
+#if THERMAL_CLASSIFIER_ENABLED
+    /* Defect classifier (cycle counter for the per-inference figure) */
+    ThermalClassifier_Init();
+    ThermalClassifierStats_t classifier;
+    ThermalClassifier_GetStats(&classifier);
+    SEGGER_RTT_printf(0, "[App] Defect classifier: %s (%u MACs, %u B RAM, %u B weights)\r\n",
+                      classifier.model_loaded ? "loaded" : "no model",
+                      (unsigned)classifier.macs, (unsigned)classifier.ram_bytes,
+                      (unsigned)classifier.flash_bytes);
+#endif
+
+    /* Recover test result journal from flash */
+    TestJournal_Init();
+    TestJournalInfo_t journal;
+    TestJournal_GetInfo(&journal);
+    SEGGER_RTT_printf(0, "[App] Test journal: next seq %u, %u in flash\r\n",
+                      (unsigned)journal.next_seq, (unsigned)journal.flash_count);
+
     for (uint8_t i = 0; i < count; i++) {
         const SensorDriver_t* drv = SensorManager_GetByIndex(i);
         if (drv) {
@@ -203,46 +221,38 @@ static void App_Init(void)
         }
     }
 
-    /* Initialize VL53L0X */
-    SEGGER_RTT_printf(0, "\r\n[App] Initializing VL53L0X...\r\n");
-    const SensorDriver_t* vl53l0x = SensorManager_GetByID(SENSOR_ID_VL53L0X);
-    if (vl53l0x && vl53l0x->init) {
-        if (vl53l0x->init() == HAL_OK) {
-            vl53l0x_ready = true;
-            SEGGER_RTT_printf(0, "[App] VL53L0X initialized OK\r\n");
-        } else {
-            SEGGER_RTT_printf(0, "[App] VL53L0X init FAILED\r\n");
-        }
-    }
-
-    /* Initialize MLX90640 */
-    SEGGER_RTT_printf(0, "\r\n[App] Initializing MLX90640...\r\n");
-    const SensorDriver_t* mlx90640 = SensorManager_GetByID(SENSOR_ID_MLX90640);
-    if (mlx90640 && mlx90640->init) {
-        if (mlx90640->init() == HAL_OK) {
-            mlx90640_ready = true;
-            SEGGER_RTT_printf(0, "[App] MLX90640 initialized OK\r\n");
-        } else {
-            SEGGER_RTT_printf(0, "[App] MLX90640 init FAILED\r\n");
-        }
-    }
+    /* Power up and initialize sensors from the main loop */
+    Boot_Start();
 }
 
 /**
- * @brief Main application loop - protocol processing with RTT input support
+ * @brief Main application loop - boot sequencing and protocol processing
  */
 static void App_MainLoop(void)
 {
-    /* Check for RTT input and feed to protocol */
-    uint8_t rtt_buf[64];
-    unsigned int rtt_len = SEGGER_RTT_Read(0, rtt_buf, sizeof(rtt_buf));
-    if (rtt_len > 0) {
-        Protocol_FeedData(rtt_buf, rtt_len);
-        SEGGER_RTT_printf(0, "[RTT-RX] %u bytes\r\n", rtt_len);
+    /* Advance sensor power-up and init */
+    if (Boot_Process()) {
+        BootInfo_t boot;
+        Boot_GetInfo(&boot);
+        SEGGER_RTT_printf(0, "[BOOT] Sensors ready at %u ms (VL53L0X %s, MLX90640 %s)\r\n",
+                          (unsigned)boot.phase_ms[BOOT_PHASE_READY],
+                          (boot.flags & BOOT_FLAG_VL53L0X_OK) ? "OK" : "FAILED",
+                          (boot.flags & BOOT_FLAG_MLX90640_OK) ? "OK" : "FAILED");
+
+        SensorArenaInfo_t arena;
+        SensorArena_GetInfo(&arena);
+        SEGGER_RTT_printf(0, "[BOOT] Sensor arena: %u of %u B persistent, scratch %u B (peak %u B)\r\n",
+                          (unsigned)arena.persistent_used, (unsigned)(arena.size - arena.scratch_size),
+                          (unsigned)arena.scratch_size, (unsigned)arena.scratch_peak);
     }
 
-    /* Process protocol commands from UART and RTT */
+    /* Process protocol commands from UART4 and RTT (each answered on its own link) */
     Protocol_Process();
+
+    /* Erase the journal's spare flash sector between tests, never inside one */
+    if (!TestRunner_IsBusy()) {
+        TestJournal_Process();
+    }
 }
 
 /*============================================================================*/
@@ -10,6 +10,17 @@
 #include "protocol/protocol.h"
 #include "sensors/sensor_manager.h"
 #include "test/test_runner.h"
+#include "test/test_journal.h"
+#include "app/boot.h"
+#include "app/mem_info.h"
+#include "sensors/mlx90640.h"
+#include "sensors/thermal_blob.h"
+#include "sensors/thermal_stats.h"
+#include "sensors/thermal_zone.h"
+#include "sensors/thermal_golden.h"
+#include "sensors/thermal_noise.h"
+#include "sensors/thermal_filter.h"
+#include "sensors/thermal_recorder.h"
 #include <string.h>
 
 /*============================================================================*/
@@ -23,6 +34,27 @@ static void Handle_GetSensorList(const Frame_t* request, Frame_t* response);
 static void Handle_ReadSensor(const Frame_t* request, Frame_t* response);
 static void Handle_SetSpec(const Frame_t* request, Frame_t* response);
 static void Handle_GetSpec(const Frame_t* request, Frame_t* response);
+static void Handle_ThermalBlobs(const Frame_t* request, Frame_t* response);
+static void Handle_ThermalStats(const Frame_t* request, Frame_t* response);
+static void Handle_SetZones(const Frame_t* request, Frame_t* response);
+static void Handle_TestZones(const Frame_t* request, Frame_t* response);
+static void Handle_GoldenCapture(const Frame_t* request, Frame_t* response);
+static void Handle_GoldenTolerance(const Frame_t* request, Frame_t* response);
+static void Handle_GoldenSave(const Frame_t* request, Frame_t* response);
+static void Handle_GoldenCompare(const Frame_t* request, Frame_t* response);
+static void Handle_ThermalNoise(const Frame_t* request, Frame_t* response);
+static void Handle_ThermalFilter(const Frame_t* request, Frame_t* response);
+static void Handle_ThermalAcqMode(const Frame_t* request, Frame_t* response);
+static void Handle_RecorderInfo(const Frame_t* request, Frame_t* response);
+static void Handle_RecorderRead(const Frame_t* request, Frame_t* response);
+static void Handle_JournalInfo(const Frame_t* request, Frame_t* response);
+static void Handle_JournalRead(const Frame_t* request, Frame_t* response);
+static void Handle_BootInfo(const Frame_t* request, Frame_t* response);
+static void Handle_DutPowerCycle(const Frame_t* request, Frame_t* response);
+static void Handle_MemInfo(const Frame_t* request, Frame_t* response);
+static void Build_BootInfo(Frame_t* response);
+static bool Command_NeedsSensors(const Frame_t* request);
+static void Build_GoldenInfo(Frame_t* response, TestStatus_t status);
 
 /*============================================================================*/
 /* Public Functions                                                           */
@@ -39,6 +71,12 @@ bool Commands_Process(const Frame_t* request, Frame_t* response)
         return false;
     }
 
+    /* Sensors are still being powered up and initialized in the background */
+    if (!Boot_IsComplete() && Command_NeedsSensors(request)) {
+        Commands_BuildNAK(response, ERR_BUSY);
+        return true;
+    }
+
     /* Dispatch based on command code */
     switch (request->cmd) {
         case CMD_PING:
@@ -69,6 +107,78 @@ bool Commands_Process(const Frame_t* request, Frame_t* response)
             Handle_GetSpec(request, response);
             return true;
 
+        case CMD_THERMAL_BLOBS:
+            Handle_ThermalBlobs(request, response);
+            return true;
+
+        case CMD_THERMAL_STATS:
+            Handle_ThermalStats(request, response);
+            return true;
+
+        case CMD_SET_ZONES:
+            Handle_SetZones(request, response);
+            return true;
+
+        case CMD_TEST_ZONES:
+            Handle_TestZones(request, response);
+            return true;
+
+        case CMD_GOLDEN_CAPTURE:
+            Handle_GoldenCapture(request, response);
+            return true;
+
+        case CMD_GOLDEN_TOLERANCE:
+            Handle_GoldenTolerance(request, response);
+            return true;
+
+        case CMD_GOLDEN_SAVE:
+            Handle_GoldenSave(request, response);
+            return true;
+
+        case CMD_GOLDEN_COMPARE:
+            Handle_GoldenCompare(request, response);
+            return true;
+
+        case CMD_THERMAL_NOISE:
+            Handle_ThermalNoise(request, response);
+            return true;
+
+        case CMD_THERMAL_FILTER:
+            Handle_ThermalFilter(request, response);
+            return true;
+
+        case CMD_THERMAL_ACQ_MODE:
+            Handle_ThermalAcqMode(request, response);
+            return true;
+
+        case CMD_RECORDER_INFO:
+            Handle_RecorderInfo(request, response);
+            return true;
+
+        case CMD_RECORDER_READ:
+            Handle_RecorderRead(request, response);
+            return true;
+
+        case CMD_JOURNAL_INFO:
+            Handle_JournalInfo(request, response);
+            return true;
+
+        case CMD_JOURNAL_READ:
+            Handle_JournalRead(request, response);
+            return true;
+
+        case CMD_BOOT_INFO:
+            Handle_BootInfo(request, response);
+            return true;
+
+        case CMD_DUT_POWER_CYCLE:
+            Handle_DutPowerCycle(request, response);
+            return true;
+
+        case CMD_MEM_INFO:
+            Handle_MemInfo(request, response);
+            return true;
+
         default:
             Commands_BuildNAK(response, ERR_UNKNOWN_CMD);
             return true;
@@ -230,7 +340,7 @@ static void Handle_ReadSensor(const Frame_t* request, Frame_t* response)
 
     /* Serialize raw result data */
     if (driver->serialize_result != NULL) {
-        uint8_t result_buffer[16];  /* MLX90640 needs 14 bytes */
+        uint8_t result_buffer[16];  /* MLX90640 needs 14 bytes (16 with the classifier) */
         uint8_t result_len = driver->serialize_result(&result, result_buffer);
         Frame_AddBytes(response, result_buffer, result_len);
     }
@@ -253,10 +363,17 @@ static void Handle_SetSpec(const Frame_t* request, Frame_t* response)
         return;
     }
 
+    /* Omitted trailing spec fields read as 0xFF (sensor default) */
+    uint8_t spec_data[sizeof(SensorSpec_t)];
+    uint8_t spec_len = request->payload_len - 1;
+    if (spec_len > sizeof(spec_data)) spec_len = sizeof(spec_data);
+    memset(spec_data, 0xFF, sizeof(spec_data));
+    memcpy(spec_data, &request->payload[1], spec_len);
+
     /* Parse specification */
     SensorSpec_t spec;
     if (driver->parse_spec != NULL) {
-        uint8_t parsed = driver->parse_spec(&request->payload[1], &spec);
+        uint8_t parsed = driver->parse_spec(spec_data, &spec);
         if (parsed == 0) {
             Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
             return;
@@ -321,3 +438,584 @@ static void Handle_GetSpec(const Frame_t* request, Frame_t* response)
         Frame_AddBytes(response, spec.raw, 4);
     }
 }
+
+static void Handle_ThermalBlobs(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: [threshold_hi][threshold_lo][flags][min_area]
+     * threshold in 0.1°C units, flags bit0 = 8-connected */
+    if (request->payload_len < 4) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    if (!SensorManager_IsValidID(SENSOR_ID_MLX90640)) {
+        Commands_BuildNAK(response, ERR_INVALID_SENSOR_ID);
+        return;
+    }
+
+    if (TestRunner_IsBusy()) {
+        Commands_BuildNAK(response, ERR_BUSY);
+        return;
+    }
+
+    int16_t threshold = (int16_t)((request->payload[0] << 8) | request->payload[1]);
+    bool eight_connected = (request->payload[2] & 0x01) != 0;
+    uint8_t min_area = request->payload[3];
+
+    /* Acquire frame and analyze */
+    static ThermalBlobResult_t blobs;
+    TestStatus_t status = MLX90640_AcquireFrame(NULL);
+    if (status == STATUS_PASS) {
+        ThermalBlob_Analyze(MLX90640_GetTemperatures(), threshold / 10.0f,
+                            eight_connected, min_area, &blobs);
+    } else {
+        memset(&blobs, 0, sizeof(blobs));
+    }
+
+    /* Response: [status][total_hi][total_lo][count][blob x count] */
+    Frame_Init(response, CMD_BLOB_DATA);
+    Frame_AddByte(response, (uint8_t)status);
+    Frame_AddU16(response, blobs.blob_total);
+    Frame_AddByte(response, blobs.count);
+
+    for (uint8_t i = 0; i < blobs.count; i++) {
+        uint8_t blob_buffer[THERMAL_BLOB_SERIALIZED_SIZE];
+        uint8_t blob_len = ThermalBlob_Serialize(&blobs.blobs[i], blob_buffer);
+        Frame_AddBytes(response, blob_buffer, blob_len);
+    }
+}
+
+static void Handle_ThermalStats(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: empty (full frame) or [x_min][y_min][x_max][y_max] */
+    ThermalRoi_t roi;
+    if (request->payload_len >= 4) {
+        roi.x_min = request->payload[0];
+        roi.y_min = request->payload[1];
+        roi.x_max = request->payload[2];
+        roi.y_max = request->payload[3];
+    } else if (request->payload_len == 0) {
+        ThermalRoi_SetFull(&roi);
+    } else {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    if (!ThermalRoi_IsValid(&roi)) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    if (!SensorManager_IsValidID(SENSOR_ID_MLX90640)) {
+        Commands_BuildNAK(response, ERR_INVALID_SENSOR_ID);
+        return;
+    }
+
+    if (TestRunner_IsBusy()) {
+        Commands_BuildNAK(response, ERR_BUSY);
+        return;
+    }
+
+    /* Acquire frame and compute */
+    ThermalStats_t stats;
+    TestStatus_t status = MLX90640_AcquireFrame(NULL);
+    if (status == STATUS_PASS) {
+        ThermalStats_Compute(MLX90640_GetTemperatures(), &roi, &stats);
+    } else {
+        memset(&stats, 0, sizeof(stats));
+    }
+
+    /* Response: [status][stats] */
+    uint8_t stats_buffer[THERMAL_STATS_SERIALIZED_SIZE];
+    uint8_t stats_len = ThermalStats_Serialize(&stats, stats_buffer);
+
+    Frame_Init(response, CMD_STATS_DATA);
+    Frame_AddByte(response, (uint8_t)status);
+    Frame_AddBytes(response, stats_buffer, stats_len);
+}
+
+static void Handle_SetZones(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: [start_index][zone x n] - start_index 0 replaces the list,
+     * otherwise appends; [0] alone clears all zones */
+    if (request->payload_len < 1 ||
+        (request->payload_len - 1) % THERMAL_ZONE_SERIALIZED_SIZE != 0) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    uint8_t start_index = request->payload[0];
+    uint8_t count = (request->payload_len - 1) / THERMAL_ZONE_SERIALIZED_SIZE;
+
+    if (count == 0 && start_index == 0) {
+        ThermalZone_Clear();
+    } else if (!ThermalZone_Set(start_index, &request->payload[1], count)) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    /* ACK response: [zone_count] */
+    Frame_Init(response, CMD_ZONE_ACK);
+    Frame_AddByte(response, ThermalZone_GetCount());
+}
+
+static void Handle_TestZones(const Frame_t* request, Frame_t* response)
+{
+    (void)request;
+
+    if (ThermalZone_GetCount() == 0) {
+        Commands_BuildNAK(response, ERR_NO_SPEC);
+        return;
+    }
+
+    if (!SensorManager_IsValidID(SENSOR_ID_MLX90640)) {
+        Commands_BuildNAK(response, ERR_INVALID_SENSOR_ID);
+        return;
+    }
+
+    if (TestRunner_IsBusy()) {
+        Commands_BuildNAK(response, ERR_BUSY);
+        return;
+    }
+
+    /* Acquire one frame and evaluate every zone on it */
+    ThermalZoneResult_t results[THERMAL_ZONE_MAX];
+    float ta = 0.0f;
+    uint8_t count = 0;
+    TestStatus_t overall;
+
+    TestStatus_t status = MLX90640_AcquireFrame(&ta);
+    if (status == STATUS_PASS) {
+        overall = ThermalZone_Evaluate(MLX90640_GetTemperatures(), ta, results);
+        count = ThermalZone_GetCount();
+    } else {
+        overall = status;
+    }
+
+    /* Response: [status][overall][count][result x count] */
+    Frame_Init(response, CMD_ZONE_RESULT);
+    Frame_AddByte(response, (uint8_t)status);
+    Frame_AddByte(response, (uint8_t)overall);
+    Frame_AddByte(response, count);
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t result_buffer[THERMAL_ZONE_RESULT_SIZE];
+        uint8_t result_len = ThermalZone_SerializeResult(&results[i], result_buffer);
+        Frame_AddBytes(response, result_buffer, result_len);
+    }
+}
+
+static void Handle_GoldenCapture(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: [frames][default_tolerance] - frames 0 only queries state */
+    if (request->payload_len < 2) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    uint8_t frames = request->payload[0];
+    uint8_t default_tolerance = request->payload[1];
+
+    if (frames == 0) {
+        Build_GoldenInfo(response, STATUS_PASS);
+        return;
+    }
+
+    if (frames > GOLDEN_MAX_FRAMES) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    if (!SensorManager_IsValidID(SENSOR_ID_MLX90640)) {
+        Commands_BuildNAK(response, ERR_INVALID_SENSOR_ID);
+        return;
+    }
+
+    if (TestRunner_IsBusy()) {
+        Commands_BuildNAK(response, ERR_BUSY);
+        return;
+    }
+
+    TestStatus_t status = ThermalGolden_Capture(frames, default_tolerance);
+    Build_GoldenInfo(response, status);
+}
+
+static void Handle_GoldenTolerance(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: [offset_hi][offset_lo][tolerance x n] - 0.1°C units per pixel */
+    if (request->payload_len < 3) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    uint16_t offset = (uint16_t)((request->payload[0] << 8) | request->payload[1]);
+    uint8_t count = request->payload_len - 2;
+
+    ThermalGoldenInfo_t info;
+    ThermalGolden_GetInfo(&info);
+    if (!info.valid) {
+        Commands_BuildNAK(response, ERR_NO_SPEC);
+        return;
+    }
+
+    if (!ThermalGolden_SetTolerance(offset, &request->payload[2], count)) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    Build_GoldenInfo(response, STATUS_PASS);
+}
+
+static void Handle_GoldenSave(const Frame_t* request, Frame_t* response)
+{
+    (void)request;
+
+    ThermalGoldenInfo_t info;
+    ThermalGolden_GetInfo(&info);
+    if (!info.valid) {
+        Commands_BuildNAK(response, ERR_NO_SPEC);
+        return;
+    }
+
+    if (TestRunner_IsBusy()) {
+        Commands_BuildNAK(response, ERR_BUSY);
+        return;
+    }
+
+    if (ThermalGolden_Save() != HAL_OK) {
+        Commands_BuildNAK(response, ERR_FLASH);
+        return;
+    }
+
+    Build_GoldenInfo(response, STATUS_PASS);
+}
+
+static void Handle_GoldenCompare(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: [max_out_hi][max_out_lo] (optional, default 0) */
+    uint16_t max_out = 0;
+    if (request->payload_len >= 2) {
+        max_out = (uint16_t)((request->payload[0] << 8) | request->payload[1]);
+    }
+
+    ThermalGoldenInfo_t info;
+    ThermalGolden_GetInfo(&info);
+    if (!info.valid) {
+        Commands_BuildNAK(response, ERR_NO_SPEC);
+        return;
+    }
+
+    if (!SensorManager_IsValidID(SENSOR_ID_MLX90640)) {
+        Commands_BuildNAK(response, ERR_INVALID_SENSOR_ID);
+        return;
+    }
+
+    if (TestRunner_IsBusy()) {
+        Commands_BuildNAK(response, ERR_BUSY);
+        return;
+    }
+
+    ThermalGoldenResult_t result;
+    ThermalGolden_Compare(max_out, &result);
+
+    /* Response: [status][verdict][metrics] */
+    uint8_t result_buffer[THERMAL_GOLDEN_RESULT_SIZE];
+    uint8_t result_len = ThermalGolden_SerializeResult(&result, result_buffer);
+
+    Frame_Init(response, CMD_GOLDEN_RESULT);
+    Frame_AddBytes(response, result_buffer, result_len);
+}
+
+/**
+ * @brief Build GOLDEN_INFO response: [status][info]
+ */
+static void Build_GoldenInfo(Frame_t* response, TestStatus_t status)
+{
+    ThermalGoldenInfo_t info;
+    uint8_t info_buffer[THERMAL_GOLDEN_INFO_SIZE];
+
+    ThermalGolden_GetInfo(&info);
+    uint8_t info_len = ThermalGolden_SerializeInfo(&info, info_buffer);
+
+    Frame_Init(response, CMD_GOLDEN_INFO);
+    Frame_AddByte(response, (uint8_t)status);
+    Frame_AddBytes(response, info_buffer, info_len);
+}
+
+static void Handle_ThermalNoise(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: [frames_hi][frames_lo] */
+    if (request->payload_len < 2) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    uint16_t frames = (uint16_t)((request->payload[0] << 8) | request->payload[1]);
+    if (frames < 2 || frames > THERMAL_NOISE_MAX_FRAMES) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    if (!SensorManager_IsValidID(SENSOR_ID_MLX90640)) {
+        Commands_BuildNAK(response, ERR_INVALID_SENSOR_ID);
+        return;
+    }
+
+    if (TestRunner_IsBusy()) {
+        Commands_BuildNAK(response, ERR_BUSY);
+        return;
+    }
+
+    ThermalNoiseResult_t result;
+    ThermalNoise_Measure(frames, &result);
+
+    /* Response: [status][report] */
+    uint8_t noise_buffer[THERMAL_NOISE_SERIALIZED_SIZE];
+    uint8_t noise_len = ThermalNoise_Serialize(&result, noise_buffer);
+
+    Frame_Init(response, CMD_NOISE_DATA);
+    Frame_AddBytes(response, noise_buffer, noise_len);
+}
+
+static void Handle_ThermalFilter(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: empty (query) or [mode][param] (configure and reset) */
+    if (request->payload_len >= 2) {
+        if (TestRunner_IsBusy()) {
+            Commands_BuildNAK(response, ERR_BUSY);
+            return;
+        }
+        if (!ThermalFilter_Configure(request->payload[0], request->payload[1])) {
+            Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+            return;
+        }
+    } else if (request->payload_len != 0) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    ThermalFilterInfo_t info;
+    uint8_t info_buffer[THERMAL_FILTER_INFO_SIZE];
+
+    ThermalFilter_GetInfo(&info);
+    uint8_t info_len = ThermalFilter_SerializeInfo(&info, info_buffer);
+
+    Frame_Init(response, CMD_FILTER_INFO);
+    Frame_AddBytes(response, info_buffer, info_len);
+}
+
+static void Handle_ThermalAcqMode(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: empty (query) or [mode] */
+    if (request->payload_len == 1) {
+        if (TestRunner_IsBusy()) {
+            Commands_BuildNAK(response, ERR_BUSY);
+            return;
+        }
+        if (!MLX90640_SetAcqMode(request->payload[0])) {
+            Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+            return;
+        }
+    } else if (request->payload_len != 0) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    Frame_Init(response, CMD_ACQ_MODE);
+    Frame_AddByte(response, MLX90640_GetAcqMode());
+}
+
+static void Handle_RecorderInfo(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: empty (query) or [0x01] (clear, then query) */
+    if (request->payload_len == 1 && request->payload[0] == 0x01) {
+        if (TestRunner_IsBusy()) {
+            Commands_BuildNAK(response, ERR_BUSY);
+            return;
+        }
+        ThermalRecorder_Clear();
+    } else if (request->payload_len != 0) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    ThermalRecorderInfo_t info;
+    uint8_t info_buffer[THERMAL_RECORDER_INFO_SIZE];
+
+    ThermalRecorder_GetInfo(&info);
+    uint8_t info_len = ThermalRecorder_SerializeInfo(&info, info_buffer);
+
+    Frame_Init(response, CMD_RECORDER_STATE);
+    Frame_AddBytes(response, info_buffer, info_len);
+}
+
+static void Handle_RecorderRead(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: [seq(4)][offset(2)] - big-endian */
+    if (request->payload_len != 6) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    const uint8_t* p = request->payload;
+    uint32_t seq = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    uint16_t offset = (uint16_t)((p[4] << 8) | p[5]);
+
+    uint8_t chunk[THERMAL_RECORDER_CHUNK];
+    uint8_t chunk_len;
+    if (!ThermalRecorder_ReadChunk(seq, offset, chunk, &chunk_len)) {
+        Commands_BuildNAK(response, ERR_NO_RECORD);
+        return;
+    }
+
+    /* Response: [seq(4)][offset(2)][data] - echoes the request so chunks are self-describing */
+    Frame_Init(response, CMD_RECORDER_DATA);
+    Frame_AddBytes(response, p, 6);
+    Frame_AddBytes(response, chunk, chunk_len);
+}
+
+static void Handle_JournalInfo(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: empty (query) or [0x01] (clear, then query) */
+    if (request->payload_len == 1 && request->payload[0] == 0x01) {
+        if (TestRunner_IsBusy()) {
+            Commands_BuildNAK(response, ERR_BUSY);
+            return;
+        }
+        if (TestJournal_Clear() != HAL_OK) {
+            Commands_BuildNAK(response, ERR_FLASH);
+            return;
+        }
+    } else if (request->payload_len != 0) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    TestJournalInfo_t info;
+    uint8_t info_buffer[TEST_JOURNAL_INFO_SIZE];
+
+    TestJournal_GetInfo(&info);
+    uint8_t info_len = TestJournal_SerializeInfo(&info, info_buffer);
+
+    Frame_Init(response, CMD_JOURNAL_STATE);
+    Frame_AddBytes(response, info_buffer, info_len);
+}
+
+static void Handle_JournalRead(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: [seq(4)] - big-endian, first entry wanted */
+    if (request->payload_len != 4) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    const uint8_t* p = request->payload;
+    uint32_t seq = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+
+    uint8_t entries[PROTOCOL_MAX_PAYLOAD - 5];
+    uint8_t count;
+    uint8_t entries_len = TestJournal_Read(&seq, entries, sizeof(entries), &count);
+
+    /* Response: [next_seq(4)][count][entries] - count 0 means caught up */
+    Frame_Init(response, CMD_JOURNAL_DATA);
+    Frame_AddByte(response, (uint8_t)(seq >> 24));
+    Frame_AddByte(response, (uint8_t)(seq >> 16));
+    Frame_AddByte(response, (uint8_t)(seq >> 8));
+    Frame_AddByte(response, (uint8_t)(seq & 0xFF));
+    Frame_AddByte(response, count);
+    Frame_AddBytes(response, entries, entries_len);
+}
+
+static void Handle_BootInfo(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: empty */
+    if (request->payload_len != 0) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    Build_BootInfo(response);
+}
+
+static void Handle_DutPowerCycle(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: empty or [off_ms(2)] - big-endian, time the rail stays off */
+    uint32_t off_ms = BOOT_RAIL_DISCHARGE_MS;
+
+    if (request->payload_len == 2) {
+        off_ms = ((uint32_t)request->payload[0] << 8) | request->payload[1];
+        if (off_ms < BOOT_RAIL_DISCHARGE_MS) {
+            Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+            return;
+        }
+    } else if (request->payload_len != 0) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    if (TestRunner_IsBusy() || !Boot_PowerCycle(off_ms)) {
+        Commands_BuildNAK(response, ERR_BUSY);
+        return;
+    }
+
+    /* Sequence just started: host polls BOOT_INFO for each sensor's result */
+    Build_BootInfo(response);
+}
+
+static void Handle_MemInfo(const Frame_t* request, Frame_t* response)
+{
+    /* Payload: empty */
+    if (request->payload_len != 0) {
+        Commands_BuildNAK(response, ERR_INVALID_PAYLOAD);
+        return;
+    }
+
+    MemInfo_t info;
+    uint8_t info_buffer[MEM_INFO_SIZE];
+
+    MemInfo_GetInfo(&info);
+    uint8_t info_len = MemInfo_Serialize(&info, info_buffer);
+
+    Frame_Init(response, CMD_MEM_USAGE);
+    Frame_AddBytes(response, info_buffer, info_len);
+}
+
+/**
+ * @brief Build BOOT_TIMING response from the current boot state
+ */
+static void Build_BootInfo(Frame_t* response)
+{
+    BootInfo_t info;
+    uint8_t info_buffer[BOOT_INFO_SIZE];
+
+    Boot_GetInfo(&info);
+    uint8_t info_len = Boot_SerializeInfo(&info, info_buffer);
+
+    Frame_Init(response, CMD_BOOT_TIMING);
+    Frame_AddBytes(response, info_buffer, info_len);
+}
+
+/**
+ * @brief Check whether a request talks to the sensors (refused until boot completes)
+ */
+static bool Command_NeedsSensors(const Frame_t* request)
+{
+    switch (request->cmd) {
+        case CMD_GOLDEN_CAPTURE:
+            /* frames=0 only reports the stored golden image */
+            return request->payload_len == 0 || request->payload[0] != 0;
+
+        case CMD_TEST_ALL:
+        case CMD_TEST_SINGLE:
+        case CMD_READ_SENSOR:
+        case CMD_THERMAL_BLOBS:
+        case CMD_THERMAL_STATS:
+        case CMD_TEST_ZONES:
+        case CMD_GOLDEN_COMPARE:
+        case CMD_THERMAL_NOISE:
+            return true;
+
+        default:
+            return false;
+    }
+}
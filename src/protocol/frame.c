@@ -2,10 +2,18 @@
  * @file frame.c
  * @brief Frame parsing and building implementation
  *
- * Uses CRC-8 CCITT (polynomial 0x07) for improved error detection.
+ * Uses CRC-8 CCITT (polynomial 0x07) for improved error detection,
+ * computed by the CRC service (CRC_ID_FRAME).
+ *
+ * COBS mode encodes the classic frame minus STX/ETX with Consistent
+ * Overhead Byte Stuffing: each zero is replaced by the distance to the
+ * next one, so the encoded block has no zeros and 0x00 ends the frame.
+ * A block of up to 254 bytes costs exactly one extra byte, which covers
+ * every frame of this protocol.
  */
 
 #include "protocol/frame.h"
+#include "hal/crc_handler.h"
 #include <string.h>
 
 /*============================================================================*/
@@ -14,55 +22,15 @@
 
 #define FRAME_OVERHEAD      4   /* STX + LEN + CRC + ETX */
 #define FRAME_MIN_SIZE      4   /* Minimum valid frame: STX + LEN(0) + CRC + ETX */
+#define FRAME_BLOCK_MAX     (PROTOCOL_MAX_PAYLOAD + 3)  /* LEN + CMD + PAYLOAD + CRC */
+#define COBS_MAX_RUN        0xFF    /* Code byte of a zero-less 254-byte run */
 
 /*============================================================================*/
-/* CRC-8 CCITT Lookup Table (Polynomial 0x07)                                 */
+/* Private Function Prototypes                                                */
 /*============================================================================*/
 
-/**
- * @brief CRC-8 CCITT lookup table
- *
- * Generated with polynomial 0x07 (x^8 + x^2 + x + 1)
- * Initial value: 0x00
- * This provides much better error detection than XOR checksum:
- * - Detects all single-bit errors
- * - Detects all burst errors up to 8 bits
- * - Detects most multi-bit errors
- */
-static const uint8_t crc8_table[256] = {
-    0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15,
-    0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D,
-    0x70, 0x77, 0x7E, 0x79, 0x6C, 0x6B, 0x62, 0x65,
-    0x48, 0x4F, 0x46, 0x41, 0x54, 0x53, 0x5A, 0x5D,
-    0xE0, 0xE7, 0xEE, 0xE9, 0xFC, 0xFB, 0xF2, 0xF5,
-    0xD8, 0xDF, 0xD6, 0xD1, 0xC4, 0xC3, 0xCA, 0xCD,
-    0x90, 0x97, 0x9E, 0x99, 0x8C, 0x8B, 0x82, 0x85,
-    0xA8, 0xAF, 0xA6, 0xA1, 0xB4, 0xB3, 0xBA, 0xBD,
-    0xC7, 0xC0, 0xC9, 0xCE, 0xDB, 0xDC, 0xD5, 0xD2,
-    0xFF, 0xF8, 0xF1, 0xF6, 0xE3, 0xE4, 0xED, 0xEA,
-    0xB7, 0xB0, 0xB9, 0xBE, 0xAB, 0xAC, 0xA5, 0xA2,
-    0x8F, 0x88, 0x81, 0x86, 0x93, 0x94, 0x9D, 0x9A,
-    0x27, 0x20, 0x29, 0x2E, 0x3B, 0x3C, 0x35, 0x32,
-    0x1F, 0x18, 0x11, 0x16, 0x03, 0x04, 0x0D, 0x0A,
-    0x57, 0x50, 0x59, 0x5E, 0x4B, 0x4C, 0x45, 0x42,
-    0x6F, 0x68, 0x61, 0x66, 0x73, 0x74, 0x7D, 0x7A,
-    0x89, 0x8E, 0x87, 0x80, 0x95, 0x92, 0x9B, 0x9C,
-    0xB1, 0xB6, 0xBF, 0xB8, 0xAD, 0xAA, 0xA3, 0xA4,
-    0xF9, 0xFE, 0xF7, 0xF0, 0xE5, 0xE2, 0xEB, 0xEC,
-    0xC1, 0xC6, 0xCF, 0xC8, 0xDD, 0xDA, 0xD3, 0xD4,
-    0x69, 0x6E, 0x67, 0x60, 0x75, 0x72, 0x7B, 0x7C,
-    0x51, 0x56, 0x5F, 0x58, 0x4D, 0x4A, 0x43, 0x44,
-    0x19, 0x1E, 0x17, 0x10, 0x05, 0x02, 0x0B, 0x0C,
-    0x21, 0x26, 0x2F, 0x28, 0x3D, 0x3A, 0x33, 0x34,
-    0x4E, 0x49, 0x40, 0x47, 0x52, 0x55, 0x5C, 0x5B,
-    0x76, 0x71, 0x78, 0x7F, 0x6A, 0x6D, 0x64, 0x63,
-    0x3E, 0x39, 0x30, 0x37, 0x22, 0x25, 0x2C, 0x2B,
-    0x06, 0x01, 0x08, 0x0F, 0x1A, 0x1D, 0x14, 0x13,
-    0xAE, 0xA9, 0xA0, 0xA7, 0xB2, 0xB5, 0xBC, 0xBB,
-    0x96, 0x91, 0x98, 0x9F, 0x8A, 0x8D, 0x84, 0x83,
-    0xDE, 0xD9, 0xD0, 0xD7, 0xC2, 0xC5, 0xCC, 0xCB,
-    0xE6, 0xE1, 0xE8, 0xEF, 0xFA, 0xFD, 0xF4, 0xF3
-};
+static uint16_t COBS_Encode(const uint8_t* src, uint16_t len, uint8_t* dst);
+static uint16_t COBS_Decode(const uint8_t* src, uint16_t len, uint8_t* dst, uint16_t dst_size);
 
 /*============================================================================*/
 /* Public Functions                                                           */
@@ -179,17 +147,84 @@ uint16_t Frame_Build(const Frame_t* frame, uint8_t* buffer)
     return idx;
 }
 
-uint8_t Frame_CalculateCRC(const uint8_t* data, uint8_t len)
+FrameParseResult_t Frame_ParseCOBS(const uint8_t* buffer, uint16_t len,
+                                    Frame_t* frame, uint16_t* consumed)
+{
+    if (buffer == NULL || frame == NULL || consumed == NULL) {
+        return FRAME_PARSE_FORMAT_ERR;
+    }
+
+    *consumed = 0;
+
+    /* Find the delimiter */
+    uint16_t end_idx = 0;
+    while (end_idx < len && buffer[end_idx] != FRAME_COBS_DELIMITER) {
+        end_idx++;
+    }
+
+    if (end_idx >= len) {
+        if (len > FRAME_MAX_SIZE) {
+            /* No frame is this long: drop the garbage, resync at the next delimiter */
+            *consumed = len;
+            return FRAME_PARSE_FORMAT_ERR;
+        }
+        return FRAME_PARSE_INCOMPLETE;
+    }
+
+    /* Whatever happens, this frame ends here */
+    *consumed = end_idx + 1;
+
+    uint8_t block[FRAME_BLOCK_MAX];
+    uint16_t block_len = COBS_Decode(buffer, end_idx, block, sizeof(block));
+
+    /* Empty (back-to-back delimiters), undecodable or length mismatch */
+    if (block_len < 3 || block[0] > PROTOCOL_MAX_PAYLOAD || block_len != block[0] + 3u) {
+        return FRAME_PARSE_FORMAT_ERR;
+    }
+
+    /* CRC covers: LEN + CMD + PAYLOAD */
+    uint8_t payload_len = block[0];
+    if (Frame_CalculateCRC(block, payload_len + 2) != block[payload_len + 2]) {
+        return FRAME_PARSE_CRC_ERROR;
+    }
+
+    frame->cmd = block[1];
+    frame->payload_len = payload_len;
+    if (payload_len > 0) {
+        memcpy(frame->payload, &block[2], payload_len);
+    }
+
+    return FRAME_PARSE_OK;
+}
+
+uint16_t Frame_BuildCOBS(const Frame_t* frame, uint8_t* buffer)
 {
-    if (data == NULL || len == 0) {
+    if (frame == NULL || buffer == NULL || frame->payload_len > PROTOCOL_MAX_PAYLOAD) {
         return 0;
     }
 
-    uint8_t crc = 0x00;  /* CRC-8 CCITT initial value */
-    for (uint8_t i = 0; i < len; i++) {
-        crc = crc8_table[crc ^ data[i]];
+    /* Same block as a classic frame without STX/ETX */
+    uint8_t block[FRAME_BLOCK_MAX];
+    uint16_t block_len = 0;
+
+    block[block_len++] = frame->payload_len;
+    block[block_len++] = frame->cmd;
+    if (frame->payload_len > 0) {
+        memcpy(&block[block_len], frame->payload, frame->payload_len);
+        block_len += frame->payload_len;
     }
-    return crc;
+    block[block_len] = Frame_CalculateCRC(block, (uint8_t)block_len);
+    block_len++;
+
+    uint16_t idx = COBS_Encode(block, block_len, buffer);
+    buffer[idx++] = FRAME_COBS_DELIMITER;
+
+    return idx;
+}
+
+uint8_t Frame_CalculateCRC(const uint8_t* data, uint8_t len)
+{
+    return (uint8_t)CRC_Handler_Calculate(CRC_ID_FRAME, data, len);
 }
 
 void Frame_Init(Frame_t* frame, uint8_t cmd)
@@ -242,3 +277,70 @@ bool Frame_AddBytes(Frame_t* frame, const uint8_t* data, uint8_t len)
     frame->payload_len += len;
     return true;
 }
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief COBS-encode in one pass (no delimiter appended)
+ * @param dst Output, at least len + len / 254 + 1 bytes
+ * @return Encoded length
+ */
+static uint16_t COBS_Encode(const uint8_t* src, uint16_t len, uint8_t* dst)
+{
+    uint16_t code_idx = 0;      /* Where the current run's code byte goes */
+    uint16_t out = 1;
+    uint8_t code = 1;
+
+    for (uint16_t i = 0; i < len; i++) {
+        if (src[i] == 0) {
+            dst[code_idx] = code;
+            code_idx = out++;
+            code = 1;
+            continue;
+        }
+
+        dst[out++] = src[i];
+        code++;
+        if (code == COBS_MAX_RUN) {
+            dst[code_idx] = code;
+            code_idx = out++;
+            code = 1;
+        }
+    }
+
+    dst[code_idx] = code;
+    return out;
+}
+
+/**
+ * @brief Decode one COBS block (delimiter already stripped) in one pass
+ * @return Decoded length, 0 if the block is malformed or does not fit
+ */
+static uint16_t COBS_Decode(const uint8_t* src, uint16_t len, uint8_t* dst, uint16_t dst_size)
+{
+    uint16_t in = 0;
+    uint16_t out = 0;
+
+    while (in < len) {
+        uint8_t code = src[in++];
+        if (code == 0 || (uint16_t)(in + code - 1) > len || (uint16_t)(out + code - 1) > dst_size) {
+            return 0;
+        }
+
+        for (uint8_t i = 1; i < code; i++) {
+            dst[out++] = src[in++];
+        }
+
+        /* A short run stands for a zero, except at the very end */
+        if (code != COBS_MAX_RUN && in < len) {
+            if (out >= dst_size) {
+                return 0;
+            }
+            dst[out++] = 0;
+        }
+    }
+
+    return out;
+}
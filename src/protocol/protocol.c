@@ -1,28 +1,52 @@
 /**
  * @file protocol.c
  * @brief Protocol module main implementation
+ *
+ * Every registered transport has its own receive buffer, so a partial
+ * frame on one link is never completed with bytes from another. Frames
+ * are answered on the transport they arrived on, in that transport's
+ * framing mode.
+ *
+ * CMD_SET_FRAMING is handled here rather than in commands.c because it
+ * changes the state of the channel it arrived on. The reply still goes
+ * out in the old framing; the channel switches right after it.
+ *
+ * Nothing here touches a particular link, so tools/protocol/session_test.c
+ * runs this file on the host with memory-backed channels in place of
+ * UART4 and RTT.
  */
 
 #include "protocol/protocol.h"
 #include "protocol/frame.h"
 #include "protocol/commands.h"
-#include "hal/uart_handler.h"
-#include "SEGGER_RTT.h"
 #include <string.h>
 
+/*============================================================================*/
+/* Private Types                                                              */
+/*============================================================================*/
+
+typedef struct {
+    const Transport_t*  transport;
+    uint8_t             rx_buffer[PROTOCOL_RX_BUFFER_SIZE];
+    uint16_t            rx_buffer_len;
+    FrameMode_t         framing;
+} ProtocolChannel_t;
+
 /*============================================================================*/
 /* Private Variables                                                          */
 /*============================================================================*/
 
-static uint8_t rx_buffer[PROTOCOL_RX_BUFFER_SIZE];
-static uint16_t rx_buffer_len = 0;
+static ProtocolChannel_t channels[PROTOCOL_MAX_TRANSPORTS];
+static uint8_t channel_count = 0;
 static volatile bool busy = false;
 
 /*============================================================================*/
 /* Private Function Prototypes                                                */
 /*============================================================================*/
 
-static void Protocol_RxCallback(const uint8_t* data, uint16_t len);
+static void Protocol_ProcessChannel(ProtocolChannel_t* channel);
+static void Protocol_HandleSetFraming(ProtocolChannel_t* channel, const Frame_t* request);
+static void Protocol_Send(const ProtocolChannel_t* channel, const Frame_t* response);
 
 /*============================================================================*/
 /* Public Functions                                                           */
@@ -30,28 +54,77 @@ static void Protocol_RxCallback(const uint8_t* data, uint16_t len);
 
 void Protocol_Init(void)
 {
-    rx_buffer_len = 0;
+    channel_count = 0;
+    memset(channels, 0, sizeof(channels));
     busy = false;
     
     /* Initialize command handlers */
     Commands_Init();
     
-    /* Set UART receive callback */
-    UART_Handler_SetRxCallback(Protocol_RxCallback);
+    /* Register built-in transports */
+    Protocol_AddTransport(&UART_Transport);
+    Protocol_AddTransport(&RTT_Transport);
+}
+
+bool Protocol_AddTransport(const Transport_t* transport)
+{
+    if (transport == NULL || transport->read == NULL || transport->write == NULL) {
+        return false;
+    }
+
+    if (channel_count >= PROTOCOL_MAX_TRANSPORTS) {
+        return false;
+    }
+
+    if (transport->init != NULL) {
+        transport->init();
+    }
+
+    channels[channel_count].transport = transport;
+    channels[channel_count].rx_buffer_len = 0;
+    channels[channel_count].framing = FRAME_MODE_CLASSIC;
+    channel_count++;
+    return true;
 }
 
 void Protocol_Process(void)
 {
-    /* Process any pending UART data */
-    UART_Handler_Process();
-    
+    for (uint8_t i = 0; i < channel_count; i++) {
+        Protocol_ProcessChannel(&channels[i]);
+    }
+}
+
+bool Protocol_IsBusy(void)
+{
+    return busy;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Pull new bytes from one transport and answer every complete frame
+ */
+static void Protocol_ProcessChannel(ProtocolChannel_t* channel)
+{
+    /* Take only what fits; the rest waits in the transport */
+    uint16_t space = PROTOCOL_RX_BUFFER_SIZE - channel->rx_buffer_len;
+    if (space > 0) {
+        channel->rx_buffer_len += channel->transport->read(&channel->rx_buffer[channel->rx_buffer_len], space);
+    }
+
     /* Try to parse frames from buffer */
-    while (rx_buffer_len > 0) {
+    while (channel->rx_buffer_len > 0) {
         Frame_t request;
         uint16_t consumed = 0;
         
-        FrameParseResult_t result = Frame_Parse(rx_buffer, rx_buffer_len,
-                                                 &request, &consumed);
+        FrameParseResult_t result;
+        if (channel->framing == FRAME_MODE_COBS) {
+            result = Frame_ParseCOBS(channel->rx_buffer, channel->rx_buffer_len, &request, &consumed);
+        } else {
+            result = Frame_Parse(channel->rx_buffer, channel->rx_buffer_len, &request, &consumed);
+        }
         
         if (result == FRAME_PARSE_INCOMPLETE) {
             /* Need more data */
@@ -60,83 +133,75 @@ void Protocol_Process(void)
         
         /* Remove consumed bytes from buffer */
         if (consumed > 0) {
-            if (consumed < rx_buffer_len) {
-                memmove(rx_buffer, &rx_buffer[consumed], rx_buffer_len - consumed);
+            if (consumed < channel->rx_buffer_len) {
+                memmove(channel->rx_buffer, &channel->rx_buffer[consumed],
+                        channel->rx_buffer_len - consumed);
             }
-            rx_buffer_len -= consumed;
+            channel->rx_buffer_len -= consumed;
         }
         
-        if (result == FRAME_PARSE_OK) {
+        if (result == FRAME_PARSE_OK && request.cmd == CMD_SET_FRAMING) {
+            Protocol_HandleSetFraming(channel, &request);
+        } else if (result == FRAME_PARSE_OK) {
             /* Process command and send response */
             Frame_t response;
-            bool send_response = Commands_Process(&request, &response);
-
-            if (send_response) {
-                uint8_t tx_buffer[PROTOCOL_MAX_PAYLOAD + 5];
-                uint16_t tx_len = Frame_Build(&response, tx_buffer);
-
-                if (tx_len > 0) {
-                    /* Send via UART */
-                    UART_Handler_Send(tx_buffer, tx_len, TIMEOUT_UART_TX_MS);
-                    /* Also send via RTT channel 0 for debugging */
-                    SEGGER_RTT_printf(0, "[RTT-TX] ");
-                    for (uint16_t i = 0; i < tx_len; i++) {
-                        SEGGER_RTT_printf(0, "%02X ", tx_buffer[i]);
-                    }
-                    SEGGER_RTT_printf(0, "\r\n");
-                }
+            if (Commands_Process(&request, &response)) {
+                Protocol_Send(channel, &response);
             }
         } else if (result == FRAME_PARSE_CRC_ERROR) {
             /* Send NAK for CRC error */
             Frame_t response;
             Commands_BuildNAK(&response, ERR_CRC_FAIL);
-
-            uint8_t tx_buffer[PROTOCOL_MAX_PAYLOAD + 5];
-            uint16_t tx_len = Frame_Build(&response, tx_buffer);
-
-            if (tx_len > 0) {
-                UART_Handler_Send(tx_buffer, tx_len, TIMEOUT_UART_TX_MS);
-                /* Also send via RTT channel 0 */
-                SEGGER_RTT_printf(0, "[RTT-TX NAK] ");
-                for (uint16_t i = 0; i < tx_len; i++) {
-                    SEGGER_RTT_printf(0, "%02X ", tx_buffer[i]);
-                }
-                SEGGER_RTT_printf(0, "\r\n");
-            }
+            Protocol_Send(channel, &response);
         }
         /* FRAME_PARSE_FORMAT_ERR: silently discard and continue */
     }
 }
 
-bool Protocol_IsBusy(void)
+/**
+ * @brief CMD_SET_FRAMING: acknowledge in the current framing, then switch
+ *
+ * Payload: [] query, or [mode] with mode = FrameMode_t.
+ * Response: CMD_FRAMING [mode]
+ */
+static void Protocol_HandleSetFraming(ProtocolChannel_t* channel, const Frame_t* request)
 {
-    return busy;
+    Frame_t response;
+    FrameMode_t mode = channel->framing;
+
+    if (request->payload_len > 1 ||
+        (request->payload_len == 1 && request->payload[0] >= FRAME_MODE_COUNT)) {
+        Commands_BuildNAK(&response, ERR_INVALID_PAYLOAD);
+        Protocol_Send(channel, &response);
+        return;
+    }
+
+    if (request->payload_len == 1) {
+        mode = (FrameMode_t)request->payload[0];
+    }
+
+    Frame_Init(&response, CMD_FRAMING);
+    Frame_AddByte(&response, (uint8_t)mode);
+    Protocol_Send(channel, &response);
+
+    channel->framing = mode;
 }
 
-void Protocol_FeedData(const uint8_t* data, uint16_t len)
+/**
+ * @brief Send a response on the transport the request came from
+ */
+static void Protocol_Send(const ProtocolChannel_t* channel, const Frame_t* response)
 {
-    /* Same as RxCallback - append data to buffer */
-    uint16_t space = PROTOCOL_RX_BUFFER_SIZE - rx_buffer_len;
-    uint16_t copy_len = (len > space) ? space : len;
+    uint8_t tx_buffer[FRAME_MAX_SIZE];
+    uint16_t tx_len;
 
-    if (copy_len > 0) {
-        memcpy(&rx_buffer[rx_buffer_len], data, copy_len);
-        rx_buffer_len += copy_len;
+    if (channel->framing == FRAME_MODE_COBS) {
+        tx_len = Frame_BuildCOBS(response, tx_buffer);
+    } else {
+        tx_len = Frame_Build(response, tx_buffer);
     }
-}
 
-/*============================================================================*/
-/* Private Functions                                                          */
-/*============================================================================*/
-
-static void Protocol_RxCallback(const uint8_t* data, uint16_t len)
-{
-    /* Append received data to buffer */
-    uint16_t space = PROTOCOL_RX_BUFFER_SIZE - rx_buffer_len;
-    uint16_t copy_len = (len > space) ? space : len;
-    
-    if (copy_len > 0) {
-        memcpy(&rx_buffer[rx_buffer_len], data, copy_len);
-        rx_buffer_len += copy_len;
+    if (tx_len > 0) {
+        channel->transport->write(tx_buffer, tx_len);
     }
 }
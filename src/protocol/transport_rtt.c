@@ -0,0 +1,61 @@
+/**
+ * @file transport_rtt.c
+ * @brief SEGGER RTT protocol transport
+ *
+ * Uses its own up/down buffer pair (PROTOCOL_RTT_CHANNEL) so binary frames
+ * never mix with the debug text on RTT terminal 0. Over SWD this is much
+ * faster than UART4 at 115200 baud, which makes bulk reads practical in
+ * the lab. The up buffer never blocks: a frame that does not fit while
+ * no debugger is draining it is dropped whole rather than truncated.
+ */
+
+#include "protocol/transport.h"
+#include "SEGGER_RTT.h"
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static uint8_t rtt_up_buffer[PROTOCOL_RTT_UP_SIZE];
+static uint8_t rtt_down_buffer[PROTOCOL_RTT_DOWN_SIZE];
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static void RTT_Transport_Init(void);
+static uint16_t RTT_Transport_Read(uint8_t* buffer, uint16_t max_len);
+static void RTT_Transport_Write(const uint8_t* data, uint16_t len);
+
+/*============================================================================*/
+/* Transport Instance                                                         */
+/*============================================================================*/
+
+const Transport_t RTT_Transport = {
+    .name   = "RTT",
+    .init   = RTT_Transport_Init,
+    .read   = RTT_Transport_Read,
+    .write  = RTT_Transport_Write,
+};
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+static void RTT_Transport_Init(void)
+{
+    SEGGER_RTT_ConfigUpBuffer(PROTOCOL_RTT_CHANNEL, "Protocol", rtt_up_buffer,
+                              sizeof(rtt_up_buffer), SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+    SEGGER_RTT_ConfigDownBuffer(PROTOCOL_RTT_CHANNEL, "Protocol", rtt_down_buffer,
+                                sizeof(rtt_down_buffer), SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+}
+
+static uint16_t RTT_Transport_Read(uint8_t* buffer, uint16_t max_len)
+{
+    return (uint16_t)SEGGER_RTT_Read(PROTOCOL_RTT_CHANNEL, buffer, max_len);
+}
+
+static void RTT_Transport_Write(const uint8_t* data, uint16_t len)
+{
+    SEGGER_RTT_Write(PROTOCOL_RTT_CHANNEL, data, len);
+}
@@ -0,0 +1,42 @@
+/**
+ * @file transport_uart.c
+ * @brief UART4 protocol transport
+ *
+ * UART4 itself is set up by main() and UART_Handler_Init; this only
+ * adapts the handler's receive ring and blocking send.
+ */
+
+#include "protocol/transport.h"
+#include "hal/uart_handler.h"
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static uint16_t UART_Transport_Read(uint8_t* buffer, uint16_t max_len);
+static void UART_Transport_Write(const uint8_t* data, uint16_t len);
+
+/*============================================================================*/
+/* Transport Instance                                                         */
+/*============================================================================*/
+
+const Transport_t UART_Transport = {
+    .name   = "UART4",
+    .init   = NULL,
+    .read   = UART_Transport_Read,
+    .write  = UART_Transport_Write,
+};
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+static uint16_t UART_Transport_Read(uint8_t* buffer, uint16_t max_len)
+{
+    return UART_Handler_Read(buffer, max_len);
+}
+
+static void UART_Transport_Write(const uint8_t* data, uint16_t len)
+{
+    UART_Handler_Send(data, len, TIMEOUT_UART_TX_MS);
+}
@@ -4,6 +4,11 @@
  */
 
 #include "sensors/mlx90640.h"
+#include "sensors/thermal_stats.h"
+#include "sensors/thermal_filter.h"
+#include "sensors/thermal_recorder.h"
+#include "sensors/thermal_classifier.h"
+#include "sensors/sensor_arena.h"
 #include "MLX90640_API.h"
 #include "MLX90640_I2C_Driver.h"
 #include "hal/i2c_handler.h"
@@ -24,6 +29,29 @@
  */
 #define MLX90640_DEBUG_ENABLE   1
 
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define MLX90640_EE_ADDR        0x2400      /* EEPROM start (832 words) */
+
+/* Sensor arena budgets (config.h) */
+_Static_assert(SENSOR_ARENA_ROUND(sizeof(MLX90640_Instance_t)) <= MLX90640_INSTANCE_BYTES,
+               "MLX90640_INSTANCE_BYTES must hold MLX90640_Instance_t");
+_Static_assert(sizeof(MLX90640_Scratch_t) <= MLX90640_SCRATCH_BYTES,
+               "MLX90640_SCRATCH_BYTES must hold MLX90640_Scratch_t");
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/* Per-frame pixel routing: temporal filter, then the caller's sink */
+typedef struct {
+    MLX90640_PixelSink_t    sink;
+    void*                   ctx;
+    bool                    filter;
+} FramePipe_t;
+
 /*============================================================================*/
 /* Private Variables                                                          */
 /*============================================================================*/
@@ -33,11 +61,13 @@ static bool spec_set = false;
 static bool initialized = false;
 static uint32_t init_tick = 0;  /* Tick when init completed, for warmup tracking */
 
-/* MLX90640 data buffers (non-static for external access in debug functions) */
-paramsMLX90640 mlx_params;
-uint16_t eeData[832];
-uint16_t frameData[834];
-float mlxTemperatures[768];
+/* Sensor state (sensor arena): persistent once bound, scratch only while claimed */
+static MLX90640_Instance_t* mlx = NULL;
+static MLX90640_Scratch_t* scratch = NULL;
+
+/* Test acquisition (MLX90640_SetAcqMode) */
+static uint8_t acq_mode = MLX90640_ACQ_FULL;
+static int repeat_subpage = -1;             /* Subpage the sensor repeats, -1 = alternating */
 
 /*============================================================================*/
 /* Debug Functions (conditionally compiled)                                   */
@@ -147,12 +177,35 @@ static void Debug_PrintCalibration(const uint16_t* ee, const paramsMLX90640* par
 /*============================================================================*/
 
 static HAL_StatusTypeDef MLX90640_Init_Driver(void);
+static bool MLX90640_Bind(void);
+static bool MLX90640_ClaimScratch(void);
+static void MLX90640_ReleaseScratch(void);
+static TestStatus_t MLX90640_ReadFrames(uint16_t frames, float* ta_out, MLX90640_PixelSink_t sink, void* ctx);
+static HAL_StatusTypeDef MLX90640_Configure(void);
+static HAL_StatusTypeDef MLX90640_Calibrate(void);
 static void MLX90640_Deinit(void);
 static void MLX90640_SetSpec(const SensorSpec_t* spec);
 static void MLX90640_GetSpec(SensorSpec_t* spec);
 static bool MLX90640_HasSpec(void);
 static TestStatus_t MLX90640_RunTest(SensorResult_t* result);
+static TestStatus_t MLX90640_ExecuteTest(SensorResult_t* result);
 static TestStatus_t MLX90640_ReadSensor(SensorResult_t* result);
+static int MLX90640_ReadCompleteFrame(float* ta_out, float* tr_out,
+                                      MLX90640_PixelSink_t sink, void* ctx);
+static int MLX90640_ReadSubpage(void);
+static int MLX90640_ReadSinglePage(int subpage, float* ta_out);
+static int MLX90640_SelectSubpage(int subpage);
+static int MLX90640_SpecSubpage(void);
+static int MLX90640_PixelSubpage(int pixel);
+static void MLX90640_ComputeSubpage(float tr, const FramePipe_t* pipe);
+static void MLX90640_PipePixel(int pixelNumber, float to, void* ctx);
+static void MLX90640_PrepareBadPixels(int mode);
+static float MLX90640_EvaluateStatistic(float min_temp, float max_temp, float avg_temp);
+static float MLX90640_EvaluateSubpageStatistic(int subpage, float min_temp, float max_temp, float avg_temp);
+#if MLX90640_RAW_FAST_PATH && (MLX90640_VALID_READINGS == 1)
+static int MLX90640_RawFastPathPixel(void);
+static TestStatus_t MLX90640_RunPixelTest(int pixel, SensorResult_t* result);
+#endif
 static uint8_t MLX90640_SerializeSpec(const SensorSpec_t* spec, uint8_t* buffer);
 static uint8_t MLX90640_ParseSpec(const uint8_t* buffer, SensorSpec_t* spec);
 static uint8_t MLX90640_SerializeResult(const SensorResult_t* result, uint8_t* buffer);
@@ -176,13 +229,108 @@ const SensorDriver_t MLX90640_Driver = {
     .serialize_result = MLX90640_SerializeResult,
 };
 
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+TestStatus_t MLX90640_AcquireFrame(float* ta_out)
+{
+    return MLX90640_AcquireFrameStream(ta_out, NULL, NULL);
+}
+
+TestStatus_t MLX90640_AcquireFrameStream(float* ta_out, MLX90640_PixelSink_t sink, void* ctx)
+{
+    return MLX90640_StreamFrames(1, ta_out, sink, ctx);
+}
+
+TestStatus_t MLX90640_StreamFrames(uint16_t frames, float* ta_out, MLX90640_PixelSink_t sink, void* ctx)
+{
+    if (!MLX90640_ClaimScratch()) {
+        DBG_PRINT("[MLX90640] Scratch busy\r\n");
+        return STATUS_FAIL_INIT;
+    }
+
+    TestStatus_t status = MLX90640_ReadFrames(frames, ta_out, sink, ctx);
+    MLX90640_ReleaseScratch();
+    return status;
+}
+
+const float* MLX90640_GetTemperatures(void)
+{
+    return MLX90640_Bind() ? mlx->temperatures : NULL;
+}
+
+bool MLX90640_SetAcqMode(uint8_t mode)
+{
+    if (mode != MLX90640_ACQ_FULL && mode != MLX90640_ACQ_SUBPAGE) {
+        return false;
+    }
+
+    acq_mode = mode;
+    return true;
+}
+
+uint8_t MLX90640_GetAcqMode(void)
+{
+    return acq_mode;
+}
+
+HAL_StatusTypeDef MLX90640_StartInit(void)
+{
+    if (initialized) {
+        return HAL_OK;
+    }
+
+    /* EEPROM image lives in the scratch until MLX90640_PollInit extracts it */
+    if (!MLX90640_ClaimScratch()) {
+        return HAL_ERROR;
+    }
+
+    if (MLX90640_Configure() != HAL_OK) {
+        MLX90640_ReleaseScratch();
+        return HAL_ERROR;
+    }
+
+    /* EEPROM dump runs on the I2C4 interrupt; MLX90640_PollInit finishes the init */
+    DBG_PRINT("[MLX90640] Dump EEPROM (background)...\r\n");
+    HAL_StatusTypeDef status = I2C_Handler_Read16Async(MLX90640_I2C_BUS, MLX90640_I2C_ADDR, MLX90640_EE_ADDR,
+                                                       (uint8_t*)scratch->ee, MLX90640_EE_WORDS * 2);
+    if (status != HAL_OK) {
+        MLX90640_ReleaseScratch();
+    }
+    return status;
+}
+
+HAL_StatusTypeDef MLX90640_PollInit(void)
+{
+    if (initialized) {
+        return HAL_OK;
+    }
+
+    HAL_StatusTypeDef status = I2C_Handler_AsyncStatus(MLX90640_I2C_BUS);
+    if (status == HAL_BUSY) {
+        return status;      /* Still dumping: the scratch stays claimed */
+    }
+
+    if (status == HAL_OK) {
+        /* Words arrive MSB first */
+        for (uint16_t i = 0; i < MLX90640_EE_WORDS; i++) {
+            scratch->ee[i] = (uint16_t)((scratch->ee[i] << 8) | (scratch->ee[i] >> 8));
+        }
+        status = MLX90640_Calibrate();
+    }
+
+    MLX90640_ReleaseScratch();
+    return status;
+}
+
 /*============================================================================*/
 /* Private Functions                                                          */
 /*============================================================================*/
 
 static HAL_StatusTypeDef MLX90640_Init_Driver(void)
 {
-    HAL_StatusTypeDef hal_status;
+    HAL_StatusTypeDef status;
     int mlx_status;
 
     DBG_PRINT("\r\n[MLX90640] Init start\r\n");
@@ -192,6 +340,115 @@ static HAL_StatusTypeDef MLX90640_Init_Driver(void)
         return HAL_OK;
     }
 
+    if (!MLX90640_ClaimScratch()) {
+        DBG_PRINT("[MLX90640] Scratch busy\r\n");
+        return HAL_ERROR;
+    }
+
+    status = MLX90640_Configure();
+    if (status == HAL_OK) {
+        /* Read EEPROM */
+        DBG_PRINT("[MLX90640] Dump EEPROM...");
+        mlx_status = MLX90640_DumpEE(MLX90640_I2C_ADDR, scratch->ee);
+        if (mlx_status != 0) {
+            DBG_PRINTF("FAIL (err=%d)\r\n", mlx_status);
+            status = HAL_ERROR;
+        } else {
+            DBG_PRINT("OK\r\n");
+            status = MLX90640_Calibrate();
+        }
+    }
+
+    MLX90640_ReleaseScratch();
+    return status;
+}
+
+/**
+ * @brief Allocate the instance state from the sensor arena on first use
+ */
+static bool MLX90640_Bind(void)
+{
+    if (mlx == NULL) {
+        mlx = (MLX90640_Instance_t*)SensorArena_Alloc(sizeof(MLX90640_Instance_t));
+        if (mlx == NULL) {
+            return false;
+        }
+        mlx->bad_pixel_mode = -1;
+    }
+    return true;
+}
+
+/**
+ * @brief Claim the shared scratch for this instance
+ *
+ * Claims nest: an init inside an acquisition reuses the acquisition's
+ * claim (the EEPROM image is dead before the first frame is read).
+ */
+static bool MLX90640_ClaimScratch(void)
+{
+    if (!MLX90640_Bind()) {
+        return false;
+    }
+
+    scratch = (MLX90640_Scratch_t*)SensorArena_Claim(mlx, sizeof(MLX90640_Scratch_t));
+    return scratch != NULL;
+}
+
+/**
+ * @brief Release one scratch claim (scratch contents are dead afterwards)
+ */
+static void MLX90640_ReleaseScratch(void)
+{
+    SensorArena_Release(mlx);
+}
+
+/**
+ * @brief Initialize if needed, discard stabilization frames, read frames (scratch claimed)
+ */
+static TestStatus_t MLX90640_ReadFrames(uint16_t frames, float* ta_out, MLX90640_PixelSink_t sink, void* ctx)
+{
+    int mlx_status;
+    float ta = 0.0f, tr;
+
+    if (!initialized) {
+        DBG_PRINT("[MLX90640] Not initialized, calling init...\r\n");
+        if (MLX90640_Init_Driver() != HAL_OK) {
+            DBG_PRINT("[MLX90640] Init failed!\r\n");
+            return STATUS_FAIL_INIT;
+        }
+    }
+
+    /* Discard initial readings for sensor stabilization */
+    DBG_PRINTF("[MLX90640] Discarding %d readings for stabilization...\r\n", MLX90640_DISCARD_READINGS);
+    for (int i = 0; i < MLX90640_DISCARD_READINGS; i++) {
+        mlx_status = MLX90640_ReadCompleteFrame(NULL, NULL, NULL, NULL);
+        if (mlx_status < 0) {
+            DBG_PRINTF("[MLX90640] Discard read %d failed (err=%d)\r\n", i, mlx_status);
+            return STATUS_FAIL_TIMEOUT;
+        }
+    }
+
+    /* Read valid frames back to back */
+    for (uint16_t i = 0; i < frames; i++) {
+        mlx_status = MLX90640_ReadCompleteFrame(&ta, &tr, sink, ctx);
+        if (mlx_status < 0) {
+            DBG_PRINTF("[MLX90640] Read %d failed (err=%d)\r\n", i, mlx_status);
+            return STATUS_FAIL_TIMEOUT;
+        }
+    }
+
+    if (ta_out) *ta_out = ta;
+    return STATUS_PASS;
+}
+
+/**
+ * @brief Check presence and set refresh rate and resolution (before the EEPROM dump)
+ */
+static HAL_StatusTypeDef MLX90640_Configure(void)
+{
+    HAL_StatusTypeDef hal_status;
+    int mlx_status;
+
     /* Check device presence */
     DBG_PRINTF("[MLX90640] I2C check addr=0x%02X...", MLX90640_I2C_ADDR);
     hal_status = I2C_Handler_IsDeviceReady(MLX90640_I2C_BUS, MLX90640_I2C_ADDR, TIMEOUT_I2C_MS);
@@ -222,18 +479,19 @@ static HAL_StatusTypeDef MLX90640_Init_Driver(void)
     }
     DBG_PRINT("OK\r\n");
 
-    /* Read EEPROM */
-    DBG_PRINT("[MLX90640] Dump EEPROM...");
-    mlx_status = MLX90640_DumpEE(MLX90640_I2C_ADDR, eeData);
-    if (mlx_status != 0) {
-        DBG_PRINTF("FAIL (err=%d)\r\n", mlx_status);
-        return HAL_ERROR;
-    }
-    DBG_PRINT("OK\r\n");
+    return HAL_OK;
+}
+
+/**
+ * @brief Extract parameters from the EEPROM image in the scratch and finish the init
+ */
+static HAL_StatusTypeDef MLX90640_Calibrate(void)
+{
+    int mlx_status;
 
     /* Extract calibration parameters */
     DBG_PRINT("[MLX90640] Extract params...");
-    mlx_status = MLX90640_ExtractParameters(eeData, &mlx_params);
+    mlx_status = MLX90640_ExtractParameters(scratch->ee, &mlx->params);
     if (mlx_status != 0) {
         DBG_PRINTF("FAIL (err=%d)\r\n", mlx_status);
         return HAL_ERROR;
@@ -241,11 +499,11 @@ static HAL_StatusTypeDef MLX90640_Init_Driver(void)
     DBG_PRINT("OK\r\n");
 
     /* Debug: Print EEPROM and calibration info */
-    DBG_CALIBRATION(eeData, &mlx_params);
+    DBG_CALIBRATION(scratch->ee, &mlx->params);
 
     /* CRITICAL: Set sensor resolution to match EEPROM calibration resolution */
     /* resolutionEE: 0=16bit, 1=17bit, 2=18bit, 3=19bit */
-    uint8_t calibResolution = mlx_params.resolutionEE + 16;
+    uint8_t calibResolution = mlx->params.resolutionEE + 16;
     DBG_PRINTF("[MLX90640] Setting resolution to %d (from EEPROM)\r\n", calibResolution);
     mlx_status = MLX90640_SetResolution(MLX90640_I2C_ADDR, calibResolution);
     if (mlx_status != 0) {
@@ -253,8 +511,25 @@ static HAL_StatusTypeDef MLX90640_Init_Driver(void)
         return HAL_ERROR;
     }
 
+    /* Alternate subpages (subpage repeat survives an MCU reset) */
+    mlx_status = MLX90640_SetSubPageRepeat(MLX90640_I2C_ADDR, -1);
+    if (mlx_status != 0) {
+        DBG_PRINTF("[MLX90640] SetSubPageRepeat FAIL (err=%d)\r\n", mlx_status);
+        return HAL_ERROR;
+    }
+    repeat_subpage = -1;
+
+    /* Compile bad-pixel correction for the active readout mode */
+    mlx_status = MLX90640_GetCurMode(MLX90640_I2C_ADDR);
+    if (mlx_status < 0) {
+        DBG_PRINTF("[MLX90640] GetCurMode FAIL (err=%d)\r\n", mlx_status);
+        return HAL_ERROR;
+    }
+    MLX90640_PrepareBadPixels(mlx_status);
+
     initialized = true;
     init_tick = HAL_GetTick();  /* Record init time for warmup tracking */
+    ThermalFilter_Reset();      /* Filtered image restarts with the sensor */
     DBG_PRINT("[MLX90640] Init complete!\r\n");
     return HAL_OK;
 }
@@ -288,49 +563,273 @@ static bool MLX90640_HasSpec(void)
  * @brief Read one complete frame (2 subpages) and calculate temperatures
  * @return 0 on success, negative on error
  */
-static int MLX90640_ReadCompleteFrame(float* ta_out, float* tr_out)
+static int MLX90640_ReadCompleteFrame(float* ta_out, float* tr_out,
+                                      MLX90640_PixelSink_t sink, void* ctx)
 {
     int mlx_status;
     float ta, tr;
+    FramePipe_t pipe = { sink, ctx, ThermalFilter_IsEnabled() };
+    bool compute = (ta_out != NULL);    /* Discarded frames are only read */
 
-    /* Get first subpage (with retry) */
-    for (int retry = 0; retry < 10; retry++) {
-        mlx_status = MLX90640_GetFrameData(MLX90640_I2C_ADDR, frameData);
-        if (mlx_status >= 0) break;
-        HAL_Delay(50);  /* Wait and retry */
+    /* Complete frames need alternating subpages */
+    if (MLX90640_SelectSubpage(-1) != 0) {
+        return MLX90640_I2C_ERROR;
     }
+
+    /* Get first subpage (with retry) */
+    mlx_status = MLX90640_ReadSubpage();
     if (mlx_status < 0) {
         return mlx_status;
     }
 
-    ta = MLX90640_GetTa(frameData, &mlx_params);
-    tr = ta - 8.0f;  /* Reflected temperature approximation */
+    ta = MLX90640_GetTa(scratch->frame.data, &mlx->params);
+    tr = ta - MLX90640_TR_OFFSET;  /* Reflected temperature approximation */
 
     /* Calculate first subpage temperatures */
-    MLX90640_CalculateTo(frameData, &mlx_params, MLX90640_EMISSIVITY, tr, mlxTemperatures);
+    if (compute) {
+        MLX90640_ComputeSubpage(tr, &pipe);
+    }
 
     /* Wait for next subpage */
     HAL_Delay(MLX90640_FRAME_INTERVAL_MS);
 
     /* Get second subpage (with retry) */
+    mlx_status = MLX90640_ReadSubpage();
+
+    if (mlx_status >= 0 && compute) {
+        /* Calculate second subpage for complete frame */
+        MLX90640_ComputeSubpage(tr, &pipe);
+    }
+
+    if (compute && pipe.filter) {
+        ThermalFilter_EndFrame();
+    }
+
+    if (ta_out) *ta_out = ta;
+    if (tr_out) *tr_out = tr;
+
+    return 0;
+}
+
+/**
+ * @brief Read the next subpage into the frame scratch, retrying on I2C errors
+ *
+ * Every subpage read is also appended to the flight recorder.
+ * @return 0 on success, negative on error
+ */
+static int MLX90640_ReadSubpage(void)
+{
+    int mlx_status = -1;
+
     for (int retry = 0; retry < 10; retry++) {
-        mlx_status = MLX90640_GetFrameData(MLX90640_I2C_ADDR, frameData);
+        mlx_status = MLX90640_GetFrameData(MLX90640_I2C_ADDR, scratch->frame.data);
         if (mlx_status >= 0) break;
-        HAL_Delay(50);
+        HAL_Delay(50);  /* Wait and retry */
     }
 
     if (mlx_status >= 0) {
-        /* Calculate second subpage for complete frame */
-        MLX90640_CalculateTo(frameData, &mlx_params, MLX90640_EMISSIVITY, tr, mlxTemperatures);
+        ThermalRecorder_Record(scratch->frame.data);
     }
 
-    if (ta_out) *ta_out = ta;
-    if (tr_out) *tr_out = tr;
+    return mlx_status;
+}
+
+/**
+ * @brief Read and compute one subpage while the sensor repeats it
+ *
+ * A measurement already running when repeat was switched on still
+ * delivers the other subpage, so one extra read is allowed.
+ *
+ * @return 0 on success, negative on error
+ */
+static int MLX90640_ReadSinglePage(int subpage, float* ta_out)
+{
+    FramePipe_t pipe = { NULL, NULL, false };
+
+    int mlx_status = MLX90640_ReadSubpage();
+    if (mlx_status >= 0 && MLX90640_GetSubPageNumber(scratch->frame.data) != subpage) {
+        HAL_Delay(MLX90640_FRAME_INTERVAL_MS);
+        mlx_status = MLX90640_ReadSubpage();
+    }
+    if (mlx_status < 0) {
+        return mlx_status;
+    }
+    if (MLX90640_GetSubPageNumber(scratch->frame.data) != subpage) {
+        return MLX90640_I2C_ERROR;
+    }
+
+    float ta = MLX90640_GetTa(scratch->frame.data, &mlx->params);
+    MLX90640_ComputeSubpage(ta - MLX90640_TR_OFFSET, &pipe);
 
+    *ta_out = ta;
     return 0;
 }
 
+/**
+ * @brief Program subpage repeat, skipping the I2C write if already set
+ * @param subpage Subpage to repeat, -1 to alternate
+ * @return 0 on success
+ */
+static int MLX90640_SelectSubpage(int subpage)
+{
+    if (subpage == repeat_subpage) {
+        return 0;
+    }
+
+    int mlx_status = MLX90640_SetSubPageRepeat(MLX90640_I2C_ADDR, subpage);
+    if (mlx_status == 0) {
+        repeat_subpage = subpage;
+        DBG_PRINTF("[MLX90640] Subpage repeat: %d\r\n", subpage);
+    }
+    return mlx_status;
+}
+
+/**
+ * @brief Subpage that answers the current spec on its own
+ * @return 0/1, or -1 if the test needs complete frames
+ */
+static int MLX90640_SpecSubpage(void)
+{
+    if (acq_mode != MLX90640_ACQ_SUBPAGE || ThermalFilter_IsEnabled()) {
+        return -1;
+    }
+
+    switch (current_spec.mlx90640.statistic) {
+        case MLX_STAT_MEAN:
+        case MLX_STAT_PERCENTILE:
+        case MLX_STAT_TRIMMED_MEAN:
+            return 0;       /* Sampling statistics: half the pixels, evenly spread */
+
+        case MLX_STAT_MAX:
+        case MLX_STAT_MIN:
+            return -1;      /* The extreme may lie in either subpage */
+
+        case MLX_STAT_PIXEL:
+        default:
+            if (current_spec.mlx90640.pixel_x >= MLX90640_COLS ||
+                current_spec.mlx90640.pixel_y >= MLX90640_ROWS) {
+                return -1;  /* Legacy frame max */
+            }
+            return MLX90640_PixelSubpage(current_spec.mlx90640.pixel_y * MLX90640_COLS +
+                                         current_spec.mlx90640.pixel_x);
+    }
+}
+
+/**
+ * @brief Subpage measuring a pixel in the current readout mode
+ *
+ * Interleaved mode splits by row, chess mode by (row + column) parity.
+ * The instance's bad_pixel_mode always holds the active readout mode.
+ */
+static int MLX90640_PixelSubpage(int pixel)
+{
+    int row = pixel / MLX90640_COLS;
+    int col = pixel % MLX90640_COLS;
+
+    return (mlx->bad_pixel_mode == 1) ? ((row ^ col) & 1) : (row & 1);
+}
+
+/**
+ * @brief Compute one subpage into the temperature buffer and fix its bad pixels
+ *
+ * Without filter or sink the vendor code writes the buffer directly.
+ * Otherwise every pixel is routed through MLX90640_PipePixel, which holds
+ * bad pixels back; they reach the sink once corrected. With the filter
+ * on, corrections are taken from the filtered neighbours.
+ */
+static void MLX90640_ComputeSubpage(float tr, const FramePipe_t* pipe)
+{
+    int mode = (scratch->frame.data[832] & 0x1000) >> 12;
+    if (mode != mlx->bad_pixel_mode) {
+        MLX90640_PrepareBadPixels(mode);
+    }
+
+    if (pipe->sink == NULL && !pipe->filter) {
+        MLX90640_CalculateTo(scratch->frame.data, &mlx->params, MLX90640_EMISSIVITY, tr, mlx->temperatures);
+    } else {
+        MLX90640_CalculateToStream(scratch->frame.data, &mlx->params, MLX90640_EMISSIVITY, tr, NULL,
+                                   MLX90640_PipePixel, (void*)pipe);
+    }
+
+    /* Neighbours are in this subpage, so they are already up to date */
+    int subpage = MLX90640_GetSubPageNumber(scratch->frame.data);
+    MLX90640_BadPixelsCorrection(mlx->bad_pixels, mlx->bad_pixel_count, subpage, mlx->temperatures);
+
+    if (pipe->sink != NULL) {
+        for (int i = 0; i < mlx->bad_pixel_count; i++) {
+            if (mlx->bad_pixels[i].subPage == subpage) {
+                uint16_t pix = mlx->bad_pixels[i].pixel;
+                pipe->sink(pix, mlx->temperatures[pix], pipe->ctx);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Pixel sink feeding the temporal filter, then the caller's sink
+ *
+ * Downstream sinks receive the raw sample so per-frame consumers (noise,
+ * golden comparison) are not biased by the filter.
+ */
+static void MLX90640_PipePixel(int pixelNumber, float to, void* ctx)
+{
+    const FramePipe_t* pipe = (const FramePipe_t*)ctx;
+
+    if (mlx->bad_pixel_mask[pixelNumber >> 3] & (1u << (pixelNumber & 7))) {
+        return;     /* Emitted after correction */
+    }
+
+    if (pipe->filter) {
+        ThermalFilter_Pixel(mlx->temperatures, pixelNumber, to);
+    } else {
+        mlx->temperatures[pixelNumber] = to;
+    }
+    if (pipe->sink != NULL) {
+        pipe->sink(pixelNumber, to, pipe->ctx);
+    }
+}
+
+/**
+ * @brief Compile the bad-pixel table and mask for a readout mode
+ */
+static void MLX90640_PrepareBadPixels(int mode)
+{
+    mlx->bad_pixel_count = MLX90640_BuildBadPixelTable(&mlx->params, mode, mlx->bad_pixels);
+    mlx->bad_pixel_mode = mode;
+
+    memset(mlx->bad_pixel_mask, 0, sizeof(mlx->bad_pixel_mask));
+    for (int i = 0; i < mlx->bad_pixel_count; i++) {
+        uint16_t pix = mlx->bad_pixels[i].pixel;
+        mlx->bad_pixel_mask[pix >> 3] |= (uint8_t)(1u << (pix & 7));
+    }
+
+    DBG_PRINTF("[MLX90640] Bad pixels: %d (%s mode)\r\n",
+               mlx->bad_pixel_count, mode ? "chess" : "interleaved");
+}
+
+/**
+ * @brief Run the spec test, tagging the subpages it reads in the flight recorder
+ */
 static TestStatus_t MLX90640_RunTest(SensorResult_t* result)
+{
+    if (result != NULL) {
+        result->mlx90640.defect_class = THERMAL_CLASS_NONE;
+        result->mlx90640.defect_conf = 0;
+    }
+
+    if (!MLX90640_ClaimScratch()) {
+        DBG_PRINT("[MLX90640] Scratch busy\r\n");
+        return STATUS_FAIL_INIT;
+    }
+
+    ThermalRecorder_BeginTest();
+    TestStatus_t status = MLX90640_ExecuteTest(result);
+    ThermalRecorder_EndTest(status);
+    MLX90640_ReleaseScratch();
+    return status;
+}
+
+static TestStatus_t MLX90640_ExecuteTest(SensorResult_t* result)
 {
     int mlx_status;
     float ta, tr;
@@ -366,10 +865,21 @@ static TestStatus_t MLX90640_RunTest(SensorResult_t* result)
         }
     }
 
+    /* ===== Single subpage if the spec allows it (MLX90640_ACQ_SUBPAGE) ===== */
+    int subpage = MLX90640_SpecSubpage();
+    if (MLX90640_SelectSubpage(subpage) != 0) {
+        DBG_PRINT("[MLX90640] Subpage select failed\r\n");
+        return STATUS_FAIL_TIMEOUT;
+    }
+
     /* ===== Discard initial readings for sensor stabilization ===== */
     DBG_PRINTF("[MLX90640] Discarding %d readings for stabilization...\r\n", MLX90640_DISCARD_READINGS);
     for (int i = 0; i < MLX90640_DISCARD_READINGS; i++) {
-        mlx_status = MLX90640_ReadCompleteFrame(NULL, NULL);
+        if (subpage >= 0) {
+            mlx_status = MLX90640_ReadSubpage();
+        } else {
+            mlx_status = MLX90640_ReadCompleteFrame(NULL, NULL, NULL, NULL);
+        }
         if (mlx_status < 0) {
             DBG_PRINTF("[MLX90640] Discard read %d failed (err=%d)\r\n", i, mlx_status);
             return STATUS_FAIL_TIMEOUT;
@@ -377,32 +887,46 @@ static TestStatus_t MLX90640_RunTest(SensorResult_t* result)
         DBG_PRINTF("[MLX90640] Discarded reading %d/%d\r\n", i + 1, MLX90640_DISCARD_READINGS);
     }
 
+#if MLX90640_RAW_FAST_PATH && (MLX90640_VALID_READINGS == 1)
+    /* ===== Single-pixel spec: compute only the spec pixel ===== */
+    int fast_pixel = MLX90640_RawFastPathPixel();
+    if (fast_pixel >= 0) {
+        return MLX90640_RunPixelTest(fast_pixel, result);
+    }
+#endif
+
     /* ===== Take valid readings and average ===== */
     DBG_PRINTF("[MLX90640] Taking %d valid readings...\r\n", MLX90640_VALID_READINGS);
     for (int i = 0; i < MLX90640_VALID_READINGS; i++) {
-        mlx_status = MLX90640_ReadCompleteFrame(&ta, &tr);
+        if (subpage >= 0) {
+            mlx_status = MLX90640_ReadSinglePage(subpage, &ta);
+        } else {
+            mlx_status = MLX90640_ReadCompleteFrame(&ta, &tr, NULL, NULL);
+        }
         if (mlx_status < 0) {
             DBG_PRINTF("[MLX90640] Valid read %d failed (err=%d)\r\n", i, mlx_status);
             return STATUS_FAIL_TIMEOUT;
         }
 
-        /* Find min/max/avg for this frame */
-        min_temp = mlxTemperatures[0];
-        max_temp = mlxTemperatures[0];
+        /* Find min/max/avg over the pixels read for this frame */
+        int count = 0;
+        min_temp = INFINITY;
+        max_temp = -INFINITY;
         avg_temp = 0;
         for (int j = 0; j < 768; j++) {
-            if (mlxTemperatures[j] < min_temp) min_temp = mlxTemperatures[j];
-            if (mlxTemperatures[j] > max_temp) max_temp = mlxTemperatures[j];
-            avg_temp += mlxTemperatures[j];
+            if (subpage >= 0 && MLX90640_PixelSubpage(j) != subpage) continue;
+            if (mlx->temperatures[j] < min_temp) min_temp = mlx->temperatures[j];
+            if (mlx->temperatures[j] > max_temp) max_temp = mlx->temperatures[j];
+            avg_temp += mlx->temperatures[j];
+            count++;
         }
-        avg_temp /= 768.0f;
+        avg_temp /= count;
 
         /* Get measured temperature based on spec */
-        if (current_spec.mlx90640.pixel_x == 0xFF || current_spec.mlx90640.pixel_y == 0xFF) {
-            measured_temp = max_temp;
+        if (subpage >= 0) {
+            measured_temp = MLX90640_EvaluateSubpageStatistic(subpage, min_temp, max_temp, avg_temp);
         } else {
-            int idx = current_spec.mlx90640.pixel_y * 32 + current_spec.mlx90640.pixel_x;
-            measured_temp = (idx >= 0 && idx < 768) ? mlxTemperatures[idx] : max_temp;
+            measured_temp = MLX90640_EvaluateStatistic(min_temp, max_temp, avg_temp);
         }
 
         measured_sum += measured_temp;
@@ -420,7 +944,7 @@ static TestStatus_t MLX90640_RunTest(SensorResult_t* result)
                MLX90640_VALID_READINGS);
 
     /* Debug: Print thermal image of last frame */
-    DBG_THERMAL_IMAGE(mlxTemperatures, min_temp, max_temp, avg_temp);
+    DBG_THERMAL_IMAGE(mlx->temperatures, min_temp, max_temp, avg_temp);
 
     /* Fill result structure (in 0.1°C units) */
     result->mlx90640.measured = (int16_t)(measured_temp * 10);
@@ -430,6 +954,12 @@ static TestStatus_t MLX90640_RunTest(SensorResult_t* result)
     result->mlx90640.min_temp = (int16_t)(min_temp * 10);
     result->mlx90640.max_temp = (int16_t)(max_temp * 10);
 
+    /* Defect class of the last full frame (reported only, does not gate the verdict) */
+    if (subpage < 0) {
+        result->mlx90640.defect_class = (uint8_t)ThermalClassifier_Classify(mlx->temperatures, ta,
+                                                                            &result->mlx90640.defect_conf);
+    }
+
     /* Calculate difference */
     int16_t diff = result->mlx90640.measured - result->mlx90640.target;
     if (diff < 0) diff = -diff;
@@ -450,54 +980,191 @@ static TestStatus_t MLX90640_RunTest(SensorResult_t* result)
 }
 
 /**
- * @brief Read sensor data without spec validation (for READ_SENSOR command)
+ * @brief Reduce the current frame to the statistic selected by the spec
  */
-static TestStatus_t MLX90640_ReadSensor(SensorResult_t* result)
+static float MLX90640_EvaluateStatistic(float min_temp, float max_temp, float avg_temp)
 {
-    int mlx_status;
-    float ta, tr;
-    float min_temp, max_temp, avg_temp;
+    switch (current_spec.mlx90640.statistic) {
+        case MLX_STAT_MEAN:
+            return avg_temp;
+
+        case MLX_STAT_PERCENTILE:
+            return ThermalStats_Percentile(mlx->temperatures, NULL, current_spec.mlx90640.percentile);
+
+        case MLX_STAT_TRIMMED_MEAN:
+            return ThermalStats_TrimmedMean(mlx->temperatures, NULL);
+
+        case MLX_STAT_MAX:
+            return max_temp;
+
+        case MLX_STAT_MIN:
+            return min_temp;
+
+        case MLX_STAT_PIXEL:
+        default:
+            /* Legacy: single pixel, or max when pixel is 0xFF */
+            if (current_spec.mlx90640.pixel_x == 0xFF || current_spec.mlx90640.pixel_y == 0xFF) {
+                return max_temp;
+            } else {
+                int idx = current_spec.mlx90640.pixel_y * 32 + current_spec.mlx90640.pixel_x;
+                return (idx >= 0 && idx < 768) ? mlx->temperatures[idx] : max_temp;
+            }
+    }
+}
 
-    DBG_PRINT("\r\n[MLX90640] ReadSensor start (no spec check)\r\n");
+/**
+ * @brief Reduce one subpage to the statistic selected by the spec
+ *
+ * Order statistics run on a copy of the subpage's pixels; min/max/avg
+ * were already taken over the subpage only.
+ */
+static float MLX90640_EvaluateSubpageStatistic(int subpage, float min_temp, float max_temp, float avg_temp)
+{
+    uint8_t stat = current_spec.mlx90640.statistic;
 
-    if (result == NULL) {
-        DBG_PRINT("[MLX90640] ERROR: result=NULL\r\n");
-        return STATUS_FAIL_INVALID;
+    if (stat != MLX_STAT_PERCENTILE && stat != MLX_STAT_TRIMMED_MEAN) {
+        return MLX90640_EvaluateStatistic(min_temp, max_temp, avg_temp);
     }
 
-    if (!initialized) {
-        DBG_PRINT("[MLX90640] Not initialized, calling init...\r\n");
-        if (MLX90640_Init_Driver() != HAL_OK) {
-            DBG_PRINT("[MLX90640] Init failed!\r\n");
-            return STATUS_FAIL_INIT;
+    uint16_t n = 0;
+    for (int j = 0; j < MLX90640_PIXEL_COUNT; j++) {
+        if (MLX90640_PixelSubpage(j) == subpage) {
+            scratch->frame.subpage_values[n++] = mlx->temperatures[j];
         }
     }
 
-    /* Discard initial readings for sensor stabilization */
-    DBG_PRINTF("[MLX90640] Discarding %d readings for stabilization...\r\n", MLX90640_DISCARD_READINGS);
-    for (int i = 0; i < MLX90640_DISCARD_READINGS; i++) {
-        mlx_status = MLX90640_ReadCompleteFrame(NULL, NULL);
+    if (stat == MLX_STAT_PERCENTILE) {
+        return ThermalStats_PercentileOf(scratch->frame.subpage_values, n, current_spec.mlx90640.percentile);
+    }
+    return ThermalStats_TrimmedMeanOf(scratch->frame.subpage_values, n);
+}
+
+#if MLX90640_RAW_FAST_PATH && (MLX90640_VALID_READINGS == 1)
+/**
+ * @brief Check whether the spec can be decided on its pixel alone
+ *
+ * Applies to a single-pixel spec on a good pixel with the temporal
+ * filter off (a filtered or corrected pixel depends on other frames or
+ * pixels).
+ *
+ * @return Spec pixel index, or -1 to use the float path
+ */
+static int MLX90640_RawFastPathPixel(void)
+{
+    uint8_t stat = current_spec.mlx90640.statistic;
+    uint8_t x = current_spec.mlx90640.pixel_x;
+    uint8_t y = current_spec.mlx90640.pixel_y;
+
+    if ((stat != MLX_STAT_PIXEL && stat != 0xFF) || x >= MLX90640_COLS || y >= MLX90640_ROWS) {
+        return -1;
+    }
+
+    int pixel = y * MLX90640_COLS + x;
+    if (ThermalFilter_IsEnabled() || (mlx->bad_pixel_mask[pixel >> 3] & (1u << (pixel & 7)))) {
+        return -1;
+    }
+
+    return pixel;
+}
+
+/**
+ * @brief Decide a single-pixel spec without computing the frame
+ *
+ * Reads subpages until the one measuring the pixel arrives (at most two)
+ * and converts only that pixel, with the same equations and reflected
+ * temperature as MLX90640_CalculateTo, so measured and verdict are the
+ * float path's. The other 767 pixels are never computed: min/max are
+ * reported as MLX90640_TEMP_NOT_MEASURED and the temperature buffer is
+ * left untouched.
+ */
+static TestStatus_t MLX90640_RunPixelTest(int pixel, SensorResult_t* result)
+{
+    MLX90640_FrameTerms_t terms;
+    float irData = 0.0f;
+    float alphaCompensated = 1.0f;
+    float ta = 0.0f, tr = 0.0f;
+    int signal = 0;
+
+    for (int page = 0; page < 2 && signal == 0; page++) {
+        if (page > 0) {
+            HAL_Delay(MLX90640_FRAME_INTERVAL_MS);
+        }
+
+        int mlx_status = MLX90640_ReadSubpage();
         if (mlx_status < 0) {
-            DBG_PRINTF("[MLX90640] Discard read %d failed (err=%d)\r\n", i, mlx_status);
+            DBG_PRINTF("[MLX90640] Subpage read failed (err=%d)\r\n", mlx_status);
             return STATUS_FAIL_TIMEOUT;
         }
+
+        /* Same reflected temperature as a complete frame: Ta of its first subpage */
+        if (page == 0) {
+            ta = MLX90640_GetTa(scratch->frame.data, &mlx->params);
+            tr = ta - MLX90640_TR_OFFSET;
+        }
+
+        MLX90640_GetFrameTerms(scratch->frame.data, &mlx->params, MLX90640_EMISSIVITY, tr, &terms);
+        signal = MLX90640_GetPixelSignal(scratch->frame.data, &mlx->params, &terms, pixel,
+                                         &irData, &alphaCompensated);
     }
 
-    /* Read one valid frame */
-    mlx_status = MLX90640_ReadCompleteFrame(&ta, &tr);
-    if (mlx_status < 0) {
-        DBG_PRINTF("[MLX90640] Read failed (err=%d)\r\n", mlx_status);
-        return STATUS_FAIL_TIMEOUT;
+    if (signal <= 0) {
+        DBG_PRINT("[MLX90640] Spec pixel not measured\r\n");
+        return STATUS_FAIL_INVALID;
+    }
+
+    float measured_temp = MLX90640_SignalToTemperature(&mlx->params, &terms, irData, alphaCompensated);
+
+    result->mlx90640.measured = (int16_t)(measured_temp * 10);
+    result->mlx90640.target = current_spec.mlx90640.target_temp;
+    result->mlx90640.tolerance = current_spec.mlx90640.tolerance;
+    result->mlx90640.ambient = (int16_t)(ta * 10);
+    result->mlx90640.min_temp = MLX90640_TEMP_NOT_MEASURED;
+    result->mlx90640.max_temp = MLX90640_TEMP_NOT_MEASURED;
+
+    int16_t diff = result->mlx90640.measured - result->mlx90640.target;
+    if (diff < 0) diff = -diff;
+    result->mlx90640.diff = diff;
+
+    bool pass = diff <= result->mlx90640.tolerance;
+
+    DBG_PRINTF("[MLX90640] Pixel path: pixel %d, %d.%dC -> %s\r\n",
+               pixel, (int)measured_temp, ((int)(measured_temp * 10) % 10 + 10) % 10,
+               pass ? "PASS" : "FAIL");
+
+    return pass ? STATUS_PASS : STATUS_FAIL_INVALID;
+}
+#endif /* MLX90640_RAW_FAST_PATH */
+
+/**
+ * @brief Read sensor data without spec validation (for READ_SENSOR command)
+ */
+static TestStatus_t MLX90640_ReadSensor(SensorResult_t* result)
+{
+    TestStatus_t status;
+    float ta;
+    float min_temp, max_temp, avg_temp;
+
+    DBG_PRINT("\r\n[MLX90640] ReadSensor start (no spec check)\r\n");
+
+    if (result == NULL) {
+        DBG_PRINT("[MLX90640] ERROR: result=NULL\r\n");
+        return STATUS_FAIL_INVALID;
+    }
+
+    /* Initialize if needed, discard stabilization frames, read one frame */
+    status = MLX90640_AcquireFrame(&ta);
+    if (status != STATUS_PASS) {
+        return status;
     }
 
     /* Calculate min/max/avg */
-    min_temp = mlxTemperatures[0];
-    max_temp = mlxTemperatures[0];
+    min_temp = mlx->temperatures[0];
+    max_temp = mlx->temperatures[0];
     avg_temp = 0;
     for (int j = 0; j < 768; j++) {
-        if (mlxTemperatures[j] < min_temp) min_temp = mlxTemperatures[j];
-        if (mlxTemperatures[j] > max_temp) max_temp = mlxTemperatures[j];
-        avg_temp += mlxTemperatures[j];
+        if (mlx->temperatures[j] < min_temp) min_temp = mlx->temperatures[j];
+        if (mlx->temperatures[j] > max_temp) max_temp = mlx->temperatures[j];
+        avg_temp += mlx->temperatures[j];
     }
     avg_temp /= 768.0f;
 
@@ -509,6 +1176,8 @@ static TestStatus_t MLX90640_ReadSensor(SensorResult_t* result)
     result->mlx90640.ambient = (int16_t)(ta * 10);
     result->mlx90640.min_temp = (int16_t)(min_temp * 10);
     result->mlx90640.max_temp = (int16_t)(max_temp * 10);
+    result->mlx90640.defect_class = (uint8_t)ThermalClassifier_Classify(mlx->temperatures, ta,
+                                                                        &result->mlx90640.defect_conf);
 
     DBG_PRINTF("[MLX90640] ReadSensor: max=%d.%dC, min=%d.%dC, ambient=%d.%dC\r\n",
                (int)max_temp, ((int)(max_temp * 10) % 10 + 10) % 10,
@@ -516,7 +1185,7 @@ static TestStatus_t MLX90640_ReadSensor(SensorResult_t* result)
                (int)ta, ((int)(ta * 10) % 10 + 10) % 10);
 
     /* Debug: Print thermal image */
-    DBG_THERMAL_IMAGE(mlxTemperatures, min_temp, max_temp, avg_temp);
+    DBG_THERMAL_IMAGE(mlx->temperatures, min_temp, max_temp, avg_temp);
 
     return STATUS_PASS;
 }
@@ -527,15 +1196,18 @@ static uint8_t MLX90640_SerializeSpec(const SensorSpec_t* spec, uint8_t* buffer)
         return 0;
     }
 
-    /* Format: [target_temp_hi][target_temp_lo][tolerance_hi][tolerance_lo][pixel_x][pixel_y] */
+    /* Format: [target_temp_hi][target_temp_lo][tolerance_hi][tolerance_lo][pixel_x][pixel_y]
+     *         [statistic][percentile] */
     buffer[0] = (uint8_t)(spec->mlx90640.target_temp >> 8);
     buffer[1] = (uint8_t)(spec->mlx90640.target_temp & 0xFF);
     buffer[2] = (uint8_t)(spec->mlx90640.tolerance >> 8);
     buffer[3] = (uint8_t)(spec->mlx90640.tolerance & 0xFF);
     buffer[4] = spec->mlx90640.pixel_x;
     buffer[5] = spec->mlx90640.pixel_y;
+    buffer[6] = spec->mlx90640.statistic;
+    buffer[7] = spec->mlx90640.percentile;
 
-    return 6;
+    return 8;
 }
 
 static uint8_t MLX90640_ParseSpec(const uint8_t* buffer, SensorSpec_t* spec)
@@ -549,8 +1221,14 @@ static uint8_t MLX90640_ParseSpec(const uint8_t* buffer, SensorSpec_t* spec)
     spec->mlx90640.tolerance = (int16_t)((buffer[2] << 8) | buffer[3]);
     spec->mlx90640.pixel_x = buffer[4];
     spec->mlx90640.pixel_y = buffer[5];
+    spec->mlx90640.statistic = buffer[6];    /* 0xFF when omitted = legacy pixel mode */
+    spec->mlx90640.percentile = buffer[7];
+
+    if (spec->mlx90640.statistic == MLX_STAT_PERCENTILE && spec->mlx90640.percentile > 100) {
+        return 0;
+    }
 
-    return 6;
+    return 8;
 }
 
 static uint8_t MLX90640_SerializeResult(const SensorResult_t* result, uint8_t* buffer)
@@ -559,7 +1237,8 @@ static uint8_t MLX90640_SerializeResult(const SensorResult_t* result, uint8_t* b
         return 0;
     }
 
-    /* Format: [measured][target][tolerance][diff][ambient][min][max] - all 16-bit big-endian */
+    /* Format: [measured][target][tolerance][diff][ambient][min][max] - 16-bit big-endian,
+     * then [defect_class][defect_conf] only in classifier builds (hosts accept both lengths) */
     buffer[0] = (uint8_t)(result->mlx90640.measured >> 8);
     buffer[1] = (uint8_t)(result->mlx90640.measured & 0xFF);
     buffer[2] = (uint8_t)(result->mlx90640.target >> 8);
@@ -574,6 +1253,12 @@ static uint8_t MLX90640_SerializeResult(const SensorResult_t* result, uint8_t* b
     buffer[11] = (uint8_t)(result->mlx90640.min_temp & 0xFF);
     buffer[12] = (uint8_t)(result->mlx90640.max_temp >> 8);
     buffer[13] = (uint8_t)(result->mlx90640.max_temp & 0xFF);
+#if THERMAL_CLASSIFIER_ENABLED
+    buffer[14] = result->mlx90640.defect_class;
+    buffer[15] = result->mlx90640.defect_conf;
 
+    return 16;
+#else
     return 14;
+#endif
 }
@@ -0,0 +1,81 @@
+/**
+ * @file sensor_arena.c
+ * @brief Sensor buffer arena implementation
+ *
+ * Persistent allocations bump up from the bottom of the arena; the scratch
+ * region is the fixed top SENSOR_ARENA_SCRATCH bytes. Nothing here is
+ * called from interrupts: a claim spans the interrupt-driven transfer
+ * that fills it, not the other way round.
+ */
+
+#include "sensors/sensor_arena.h"
+#include <stddef.h>
+#include <string.h>
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static uint8_t arena[SENSOR_ARENA_SIZE] __attribute__((aligned(SENSOR_ARENA_ALIGN)));
+static uint32_t persistent_used = 0;
+
+static const void* scratch_owner = NULL;
+static uint8_t scratch_depth = 0;       /* Nested claims by scratch_owner */
+static uint32_t scratch_peak = 0;
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+void* SensorArena_Alloc(uint32_t size)
+{
+    size = SENSOR_ARENA_ROUND(size);
+    if (size > SENSOR_ARENA_PERSISTENT - persistent_used) {
+        return NULL;
+    }
+
+    void* p = &arena[persistent_used];
+    persistent_used += size;
+    memset(p, 0, size);
+    return p;
+}
+
+void* SensorArena_Claim(const void* owner, uint32_t size)
+{
+    if (owner == NULL || size > SENSOR_ARENA_SCRATCH) {
+        return NULL;
+    }
+    if (scratch_owner != NULL && scratch_owner != owner) {
+        return NULL;
+    }
+
+    scratch_owner = owner;
+    scratch_depth++;
+    if (size > scratch_peak) {
+        scratch_peak = size;
+    }
+    return &arena[SENSOR_ARENA_PERSISTENT];
+}
+
+void SensorArena_Release(const void* owner)
+{
+    if (owner == NULL || owner != scratch_owner || scratch_depth == 0) {
+        return;
+    }
+
+    if (--scratch_depth == 0) {
+        scratch_owner = NULL;
+    }
+}
+
+void SensorArena_GetInfo(SensorArenaInfo_t* info)
+{
+    if (info == NULL) {
+        return;
+    }
+
+    info->size = SENSOR_ARENA_SIZE;
+    info->persistent_used = persistent_used;
+    info->scratch_size = SENSOR_ARENA_SCRATCH;
+    info->scratch_peak = scratch_peak;
+}
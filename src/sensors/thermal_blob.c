@@ -0,0 +1,183 @@
+/**
+ * @file thermal_blob.c
+ * @brief Hotspot / blob analytics implementation
+ *
+ * Single scan over the frame; each unvisited foreground pixel seeds an
+ * iterative flood fill that accumulates the region statistics directly,
+ * so no label image or second pass is needed. The explicit stack can hold
+ * every pixel, as each pixel is pushed at most once.
+ */
+
+#include "sensors/thermal_blob.h"
+#include "sensors/mlx90640.h"
+#include <string.h>
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static uint8_t visited[MLX90640_PIXEL_COUNT / 8];       /* 1 bit per pixel */
+static uint16_t fill_stack[MLX90640_PIXEL_COUNT];
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static void Blob_Fill(const float* temps, float threshold, bool eight_connected,
+                      uint16_t seed, ThermalBlob_t* blob);
+static void Blob_Insert(ThermalBlobResult_t* result, const ThermalBlob_t* blob);
+
+static inline bool Visited_Test(uint16_t idx)
+{
+    return (visited[idx >> 3] & (1u << (idx & 7))) != 0;
+}
+
+static inline void Visited_Set(uint16_t idx)
+{
+    visited[idx >> 3] |= (uint8_t)(1u << (idx & 7));
+}
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+void ThermalBlob_Analyze(const float* temps, float threshold, bool eight_connected,
+                         uint16_t min_area, ThermalBlobResult_t* result)
+{
+    if (temps == NULL || result == NULL) {
+        return;
+    }
+
+    memset(result, 0, sizeof(*result));
+    memset(visited, 0, sizeof(visited));
+
+    for (uint16_t idx = 0; idx < MLX90640_PIXEL_COUNT; idx++) {
+        if (Visited_Test(idx) || temps[idx] < threshold) {
+            continue;
+        }
+
+        ThermalBlob_t blob;
+        Blob_Fill(temps, threshold, eight_connected, idx, &blob);
+
+        if (blob.area >= min_area) {
+            result->blob_total++;
+            Blob_Insert(result, &blob);
+        }
+    }
+}
+
+uint8_t ThermalBlob_Serialize(const ThermalBlob_t* blob, uint8_t* buffer)
+{
+    if (blob == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    /* Format: [area(2)][cx][cy][x0][y0][x1][y1][peak(2)][mean(2)] - big-endian */
+    buffer[0] = (uint8_t)(blob->area >> 8);
+    buffer[1] = (uint8_t)(blob->area & 0xFF);
+    buffer[2] = blob->centroid_x_q3;
+    buffer[3] = blob->centroid_y_q3;
+    buffer[4] = blob->x_min;
+    buffer[5] = blob->y_min;
+    buffer[6] = blob->x_max;
+    buffer[7] = blob->y_max;
+    buffer[8] = (uint8_t)(blob->peak_temp >> 8);
+    buffer[9] = (uint8_t)(blob->peak_temp & 0xFF);
+    buffer[10] = (uint8_t)(blob->mean_temp >> 8);
+    buffer[11] = (uint8_t)(blob->mean_temp & 0xFF);
+
+    return THERMAL_BLOB_SERIALIZED_SIZE;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Flood fill one region from seed and accumulate its statistics
+ */
+static void Blob_Fill(const float* temps, float threshold, bool eight_connected,
+                      uint16_t seed, ThermalBlob_t* blob)
+{
+    uint16_t top = 0;
+    uint32_t sum_x = 0, sum_y = 0;
+    float sum_t = 0.0f;
+    float peak = temps[seed];
+    uint8_t x_min = MLX90640_COLS, y_min = MLX90640_ROWS, x_max = 0, y_max = 0;
+    uint16_t area = 0;
+
+    Visited_Set(seed);
+    fill_stack[top++] = seed;
+
+    while (top > 0) {
+        uint16_t idx = fill_stack[--top];
+        uint8_t x = (uint8_t)(idx % MLX90640_COLS);
+        uint8_t y = (uint8_t)(idx / MLX90640_COLS);
+        float t = temps[idx];
+
+        area++;
+        sum_x += x;
+        sum_y += y;
+        sum_t += t;
+        if (t > peak) peak = t;
+        if (x < x_min) x_min = x;
+        if (x > x_max) x_max = x;
+        if (y < y_min) y_min = y;
+        if (y > y_max) y_max = y;
+
+        /* Visit neighbours; diagonals only when 8-connected */
+        for (int8_t dy = -1; dy <= 1; dy++) {
+            int8_t ny = (int8_t)y + dy;
+            if (ny < 0 || ny >= MLX90640_ROWS) continue;
+
+            for (int8_t dx = -1; dx <= 1; dx++) {
+                if (dx == 0 && dy == 0) continue;
+                if (!eight_connected && dx != 0 && dy != 0) continue;
+
+                int8_t nx = (int8_t)x + dx;
+                if (nx < 0 || nx >= MLX90640_COLS) continue;
+
+                uint16_t n = (uint16_t)(ny * MLX90640_COLS + nx);
+                if (!Visited_Test(n) && temps[n] >= threshold) {
+                    Visited_Set(n);
+                    fill_stack[top++] = n;
+                }
+            }
+        }
+    }
+
+    blob->area = area;
+    blob->centroid_x_q3 = (uint8_t)((sum_x * 8 + area / 2) / area);
+    blob->centroid_y_q3 = (uint8_t)((sum_y * 8 + area / 2) / area);
+    blob->x_min = x_min;
+    blob->y_min = y_min;
+    blob->x_max = x_max;
+    blob->y_max = y_max;
+    blob->peak_temp = (int16_t)(peak * 10);
+    blob->mean_temp = (int16_t)((sum_t / area) * 10);
+}
+
+/**
+ * @brief Keep the THERMAL_BLOB_MAX_REPORT largest blobs, ordered by area
+ */
+static void Blob_Insert(ThermalBlobResult_t* result, const ThermalBlob_t* blob)
+{
+    uint8_t pos = result->count;
+
+    while (pos > 0 && result->blobs[pos - 1].area < blob->area) {
+        pos--;
+    }
+    if (pos >= THERMAL_BLOB_MAX_REPORT) {
+        return;
+    }
+
+    uint8_t last = (result->count < THERMAL_BLOB_MAX_REPORT) ? result->count : THERMAL_BLOB_MAX_REPORT - 1;
+    for (uint8_t i = last; i > pos; i--) {
+        result->blobs[i] = result->blobs[i - 1];
+    }
+    result->blobs[pos] = *blob;
+
+    if (result->count < THERMAL_BLOB_MAX_REPORT) {
+        result->count++;
+    }
+}
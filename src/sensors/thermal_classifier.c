@@ -0,0 +1,218 @@
+/**
+ * @file thermal_classifier.c
+ * @brief Quantised thermal defect classifier implementation
+ *
+ * The frame is quantised once to q7 relative to ambient, then ping-pongs
+ * between two static activation buffers through the CMSIS-NN kernels.
+ * Only the basic (reference-layout) convolution is used: the fast variants
+ * expect a reordered weight layout on the DSP path but not in the plain C
+ * fallback, so the host reference build would otherwise disagree with the
+ * target. The pure-C kernels the host build runs are bit-exact with the
+ * DSP ones for this kernel, so host and target classify identically.
+ *
+ * The softmax works in base-2 logits (the export tool folds log2(e) into
+ * the FC layer): the class is the argmax of the FC output at full
+ * precision, the confidence comes from arm_softmax_q7 on the integer
+ * logits.
+ */
+
+#include "sensors/thermal_classifier.h"
+#include "sensors/thermal_classifier_model.h"
+#if THERMAL_CLASSIFIER_ENABLED
+/* arm_nnsupportfunctions.h compares q31_t with Q31_MIN (0x80000000L, unsigned long on ILP32) */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#include "arm_nnfunctions.h"
+#pragma GCC diagnostic pop
+#endif
+#if defined(__arm__)
+#include "main.h"
+#endif
+#include <string.h>
+#include <math.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define TC_IN_SIZE          (TC_IN_W * TC_IN_H)
+#define TC_CONV1_SIZE       (TC_CONV1_W * TC_CONV1_H * TC_CONV1_CH)
+#define TC_CONV2_SIZE       (TC_CONV2_W * TC_CONV2_H * TC_CONV2_CH)
+#define TC_CONV3_SIZE       TC_FC_IN
+
+/* Ping-pong buffers: input -> B -> A -> B -> logits */
+#define TC_BUF_A_SIZE       TC_IN_SIZE
+#define TC_BUF_B_SIZE       TC_CONV1_SIZE
+
+/* im2col columns of the widest convolution (two at a time) or the FC input */
+#define TC_SCRATCH_Q15      (2 * TC_CONV2_CH * TC_KERNEL * TC_KERNEL)
+
+#define TC_MACS             ((uint32_t)TC_CONV1_W * TC_CONV1_H * TC_CONV1_WEIGHTS + \
+                             (uint32_t)TC_CONV2_W * TC_CONV2_H * TC_CONV2_WEIGHTS + \
+                             (uint32_t)TC_CONV3_W * TC_CONV3_H * TC_CONV3_WEIGHTS + \
+                             (uint32_t)TC_FC_WEIGHTS)
+
+#define TC_FLASH_BYTES      (TC_CONV1_WEIGHTS + TC_CONV2_WEIGHTS + TC_CONV3_WEIGHTS + TC_FC_WEIGHTS + \
+                             TC_CONV1_CH + TC_CONV2_CH + TC_CONV3_CH + TC_FC_OUT)
+
+_Static_assert(TC_FC_OUT == THERMAL_CLASS_COUNT, "FC outputs must match the defect classes");
+_Static_assert(TC_CONV2_SIZE <= TC_BUF_A_SIZE, "conv2 output must fit buffer A");
+_Static_assert(TC_CONV3_SIZE <= TC_BUF_B_SIZE, "conv3 output must fit buffer B");
+_Static_assert(TC_FC_IN <= TC_SCRATCH_Q15, "FC input must fit the scratch buffer");
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+#if THERMAL_CLASSIFIER_ENABLED
+static int8_t tc_buf_a[TC_BUF_A_SIZE];
+static int8_t tc_buf_b[TC_BUF_B_SIZE];
+static int16_t tc_scratch[TC_SCRATCH_Q15];
+static int8_t tc_logits[TC_FC_OUT];
+static int8_t tc_probs[TC_FC_OUT];
+#endif
+
+static uint32_t tc_cycles = 0;
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static uint32_t TC_CycleCount(void);
+#if THERMAL_CLASSIFIER_ENABLED
+static void TC_Quantise(const float* temperatures, float ta, int8_t* out);
+static void TC_Convolve(const ThermalLayer_t* layer, const int8_t* in, uint16_t in_w, uint16_t in_h,
+                        uint16_t in_ch, uint16_t out_ch, int8_t* out, uint16_t out_w, uint16_t out_h);
+#endif
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+void ThermalClassifier_Init(void)
+{
+#if THERMAL_CLASSIFIER_ENABLED && defined(__arm__)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55;                  /* Unlock DWT (Cortex-M7) */
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+ThermalClass_t ThermalClassifier_Classify(const float* temperatures, float ta, uint8_t* confidence)
+{
+    if (confidence) *confidence = 0;
+
+#if THERMAL_CLASSIFIER_ENABLED
+    const ThermalClassifierModel_t* model = &ThermalClassifier_Model;
+
+    if (temperatures == NULL || model->version == 0) {
+        return THERMAL_CLASS_NONE;
+    }
+
+    uint32_t start = TC_CycleCount();
+
+    TC_Quantise(temperatures, ta, tc_buf_a);
+
+    TC_Convolve(&model->conv1, tc_buf_a, TC_IN_W, TC_IN_H, 1,
+                TC_CONV1_CH, tc_buf_b, TC_CONV1_W, TC_CONV1_H);
+    TC_Convolve(&model->conv2, tc_buf_b, TC_CONV1_W, TC_CONV1_H, TC_CONV1_CH,
+                TC_CONV2_CH, tc_buf_a, TC_CONV2_W, TC_CONV2_H);
+    TC_Convolve(&model->conv3, tc_buf_a, TC_CONV2_W, TC_CONV2_H, TC_CONV2_CH,
+                TC_CONV3_CH, tc_buf_b, TC_CONV3_W, TC_CONV3_H);
+
+    arm_fully_connected_q7(tc_buf_b, model->fc.weights, TC_FC_IN, TC_FC_OUT,
+                           model->fc.bias_shift, model->fc.out_shift, model->fc.bias,
+                           tc_logits, tc_scratch);
+
+    /* Class from the full-precision logits */
+    uint8_t best = 0;
+    for (uint8_t i = 1; i < TC_FC_OUT; i++) {
+        if (tc_logits[i] > tc_logits[best]) best = i;
+    }
+
+    /* Softmax on integer base-2 logits (rounded) */
+    int8_t shift = model->logit_frac;
+    for (uint8_t i = 0; i < TC_FC_OUT; i++) {
+        int16_t v = tc_logits[i];
+        tc_logits[i] = (shift > 0) ? (int8_t)((v + (1 << (shift - 1))) >> shift) : (int8_t)v;
+    }
+    arm_softmax_q7(tc_logits, TC_FC_OUT, tc_probs);
+
+    tc_cycles = TC_CycleCount() - start;
+
+    if (confidence) {
+        uint16_t pct = (uint16_t)((tc_probs[best] * 100 + 63) / 127);
+        *confidence = (uint8_t)((pct > 100) ? 100 : pct);
+    }
+    return (ThermalClass_t)best;
+#else
+    (void)temperatures;
+    (void)ta;
+    return THERMAL_CLASS_NONE;
+#endif
+}
+
+void ThermalClassifier_GetStats(ThermalClassifierStats_t* stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+#if THERMAL_CLASSIFIER_ENABLED
+    stats->cycles = tc_cycles;
+    stats->macs = TC_MACS;
+    stats->ram_bytes = sizeof(tc_buf_a) + sizeof(tc_buf_b) + sizeof(tc_scratch) +
+                       sizeof(tc_logits) + sizeof(tc_probs);
+    stats->flash_bytes = TC_FLASH_BYTES;
+    stats->model_loaded = (ThermalClassifier_Model.version != 0);
+#endif
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Free-running CPU cycle counter (0 on host builds)
+ */
+static uint32_t TC_CycleCount(void)
+{
+#if defined(__arm__)
+    return DWT->CYCCNT;
+#else
+    return 0;
+#endif
+}
+
+#if THERMAL_CLASSIFIER_ENABLED
+/**
+ * @brief Quantise (To - Ta) to q7 with the model's input format, saturating
+ */
+static void TC_Quantise(const float* temperatures, float ta, int8_t* out)
+{
+    float scale = ldexpf(1.0f, ThermalClassifier_Model.input_frac);
+
+    for (int i = 0; i < TC_IN_SIZE; i++) {
+        float v = roundf((temperatures[i] - ta) * scale);
+        if (v > 127.0f) v = 127.0f;
+        if (v < -128.0f) v = -128.0f;
+        out[i] = (int8_t)v;
+    }
+}
+
+/**
+ * @brief 3x3 / stride 2 / pad 1 convolution followed by ReLU
+ */
+static void TC_Convolve(const ThermalLayer_t* layer, const int8_t* in, uint16_t in_w, uint16_t in_h,
+                        uint16_t in_ch, uint16_t out_ch, int8_t* out, uint16_t out_w, uint16_t out_h)
+{
+    arm_convolve_HWC_q7_basic_nonsquare(in, in_w, in_h, in_ch, layer->weights, out_ch,
+                                        TC_KERNEL, TC_KERNEL, TC_PAD, TC_PAD, TC_STRIDE, TC_STRIDE,
+                                        layer->bias, layer->bias_shift, layer->out_shift,
+                                        out, out_w, out_h, tc_scratch, NULL);
+    arm_relu_q7(out, (uint16_t)(out_w * out_h * out_ch));
+}
+#endif
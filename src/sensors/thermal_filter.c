@@ -0,0 +1,178 @@
+/**
+ * @file thermal_filter.c
+ * @brief Per-pixel temporal filter implementation
+ *
+ * EMA keeps its state in the temperature buffer itself, so it needs no
+ * extra memory and costs one multiply-add per pixel. The moving window
+ * keeps the last N samples per pixel in 0.01°C units plus an integer
+ * running sum, so each pixel costs one subtract/add and a scale, and the
+ * sum never drifts. Until N frames have arrived the window mean is taken
+ * over the frames seen so far.
+ */
+
+#include "sensors/thermal_filter.h"
+#include "sensors/mlx90640.h"
+#include <string.h>
+#include <math.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define FILTER_SETTLE_RESIDUAL  0.05f       /* EMA settled when initial weight < 5% */
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static uint8_t filter_mode = THERMAL_FILTER_OFF;
+static uint8_t filter_param = 0;
+static float filter_alpha = 1.0f;
+static uint16_t filter_frames = 0;
+static uint16_t filter_settle = 0;
+static float filter_scale = 0.01f;          /* Window: 0.01 / samples in window */
+static uint8_t window_slot = 0;             /* Window: slot written by the current frame */
+
+static int16_t window_samples[THERMAL_FILTER_MAX_WINDOW][MLX90640_PIXEL_COUNT];
+static int32_t window_sum[MLX90640_PIXEL_COUNT];
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+bool ThermalFilter_Configure(uint8_t mode, uint8_t param)
+{
+    switch (mode) {
+        case THERMAL_FILTER_OFF:
+            param = 0;
+            filter_settle = 0;
+            break;
+
+        case THERMAL_FILTER_EMA: {
+            if (param < 1 || param > 100) {
+                return false;
+            }
+            filter_alpha = param / 100.0f;
+
+            /* Frames until the first frame's weight (1 - alpha)^n drops below the residual */
+            float residual = 1.0f;
+            filter_settle = 1;
+            while (residual * (1.0f - filter_alpha) > FILTER_SETTLE_RESIDUAL) {
+                residual *= 1.0f - filter_alpha;
+                filter_settle++;
+            }
+            break;
+        }
+
+        case THERMAL_FILTER_WINDOW:
+            if (param < 2 || param > THERMAL_FILTER_MAX_WINDOW) {
+                return false;
+            }
+            filter_settle = param;
+            break;
+
+        default:
+            return false;
+    }
+
+    filter_mode = mode;
+    filter_param = param;
+    ThermalFilter_Reset();
+    return true;
+}
+
+void ThermalFilter_Reset(void)
+{
+    filter_frames = 0;
+    filter_scale = 0.01f;
+    window_slot = 0;
+
+    if (filter_mode == THERMAL_FILTER_WINDOW) {
+        memset(window_samples, 0, sizeof(window_samples));
+        memset(window_sum, 0, sizeof(window_sum));
+    }
+}
+
+bool ThermalFilter_IsEnabled(void)
+{
+    return filter_mode != THERMAL_FILTER_OFF;
+}
+
+void ThermalFilter_Pixel(float* image, int pixel, float to)
+{
+    switch (filter_mode) {
+        case THERMAL_FILTER_EMA:
+            if (filter_frames == 0) {
+                image[pixel] = to;
+            } else {
+                image[pixel] += filter_alpha * (to - image[pixel]);
+            }
+            break;
+
+        case THERMAL_FILTER_WINDOW: {
+            float centi = to * 100.0f;
+            if (centi > 32767.0f) centi = 32767.0f;
+            if (centi < -32768.0f) centi = -32768.0f;
+
+            int16_t sample = (int16_t)lrintf(centi);
+            int16_t* slot = &window_samples[window_slot][pixel];
+            window_sum[pixel] += sample - *slot;
+            *slot = sample;
+            image[pixel] = window_sum[pixel] * filter_scale;
+            break;
+        }
+
+        case THERMAL_FILTER_OFF:
+        default:
+            image[pixel] = to;
+            break;
+    }
+}
+
+void ThermalFilter_EndFrame(void)
+{
+    if (filter_mode == THERMAL_FILTER_OFF) {
+        return;
+    }
+
+    if (filter_frames < UINT16_MAX) {
+        filter_frames++;
+    }
+
+    if (filter_mode == THERMAL_FILTER_WINDOW) {
+        window_slot = (uint8_t)((window_slot + 1) % filter_param);
+        uint16_t samples = (filter_frames < filter_param) ? (uint16_t)(filter_frames + 1) : filter_param;
+        filter_scale = 0.01f / samples;
+    }
+}
+
+void ThermalFilter_GetInfo(ThermalFilterInfo_t* info)
+{
+    if (info == NULL) {
+        return;
+    }
+
+    info->mode = filter_mode;
+    info->param = filter_param;
+    info->frames = filter_frames;
+    info->settle_frames = filter_settle;
+    info->settled = (filter_mode != THERMAL_FILTER_OFF) && filter_frames >= filter_settle;
+}
+
+uint8_t ThermalFilter_SerializeInfo(const ThermalFilterInfo_t* info, uint8_t* buffer)
+{
+    if (info == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    /* Format: [mode][param][frames(2)][settle_frames(2)][settled] - big-endian */
+    buffer[0] = info->mode;
+    buffer[1] = info->param;
+    buffer[2] = (uint8_t)(info->frames >> 8);
+    buffer[3] = (uint8_t)(info->frames & 0xFF);
+    buffer[4] = (uint8_t)(info->settle_frames >> 8);
+    buffer[5] = (uint8_t)(info->settle_frames & 0xFF);
+    buffer[6] = info->settled ? 1 : 0;
+
+    return THERMAL_FILTER_INFO_SIZE;
+}
@@ -0,0 +1,358 @@
+/**
+ * @file thermal_golden.c
+ * @brief Golden reference image comparison implementation
+ *
+ * The image (golden frame in 0.01°C, tolerance map in 0.1°C) is laid
+ * out as a whole number of 256-bit flash words and programmed into
+ * GOLDEN_FLASH_SECTOR. A magic, version and CRC-32 (CRC_ID_STORAGE)
+ * guard the copy loaded at boot.
+ *
+ * Comparison runs as a pixel sink of MLX90640_CalculateToStream: each
+ * pixel is checked against its tolerance and folded into running sums
+ * as soon as it is computed. Sums are centred on the golden mean so the
+ * float correlation does not lose precision on near-uniform frames.
+ */
+
+#include "sensors/thermal_golden.h"
+#include "sensors/mlx90640.h"
+#include "hal/crc_handler.h"
+#include <string.h>
+#include <math.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define GOLDEN_MAGIC            0x444C4F47UL    /* "GOLD" */
+#define GOLDEN_VERSION          2               /* 2: CRC-32 checksum (was FNV-1a) */
+#define GOLDEN_HEADER_SIZE      12
+#define GOLDEN_DATA_SIZE        (MLX90640_PIXEL_COUNT * 3)
+#define GOLDEN_FLASH_WORD       (FLASH_NB_32BITWORD_IN_FLASHWORD * 4)
+#define GOLDEN_PAD_SIZE         ((GOLDEN_FLASH_WORD - (GOLDEN_HEADER_SIZE + GOLDEN_DATA_SIZE) % GOLDEN_FLASH_WORD) % GOLDEN_FLASH_WORD)
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+typedef struct {
+    uint32_t    magic;
+    uint16_t    version;
+    uint8_t     frames;
+    uint8_t     reserved;
+    uint32_t    checksum;                           /* CRC-32 over frames, golden, tolerance */
+    int16_t     golden[MLX90640_PIXEL_COUNT];       /* 0.01°C units */
+    uint8_t     tolerance[MLX90640_PIXEL_COUNT];    /* 0.1°C units */
+    uint8_t     pad[GOLDEN_PAD_SIZE];
+} GoldenImage_t;
+
+typedef struct {
+    uint8_t     seen[MLX90640_PIXEL_COUNT / 8];     /* 1 bit per pixel */
+    uint16_t    compared;
+    uint16_t    out_count;
+    uint16_t    worst_index;
+    float       worst_dev;
+    float       sum_d;          /* d = t - g */
+    float       sum_dd;
+    float       sum_t;          /* Centred on golden mean */
+    float       sum_g;
+    float       sum_tt;
+    float       sum_gg;
+    float       sum_tg;
+} GoldenAcc_t;
+
+_Static_assert(sizeof(GoldenImage_t) % GOLDEN_FLASH_WORD == 0, "Golden image must be whole flash words");
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static GoldenImage_t image __attribute__((aligned(32)));
+static bool image_valid = false;
+static bool image_saved = false;
+static float golden_mean = 0.0f;
+static int32_t capture_sum[MLX90640_PIXEL_COUNT];
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static uint32_t Golden_Checksum(const GoldenImage_t* img);
+static void Golden_UpdateMean(void);
+static void Golden_ComparePixel(int pixelNumber, float to, void* ctx);
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+void ThermalGolden_Init(void)
+{
+    const GoldenImage_t* stored = (const GoldenImage_t*)GOLDEN_FLASH_ADDR;
+
+    image_valid = false;
+    image_saved = false;
+
+    if (stored->magic != GOLDEN_MAGIC || stored->version != GOLDEN_VERSION) {
+        return;
+    }
+    if (stored->checksum != Golden_Checksum(stored)) {
+        return;
+    }
+
+    memcpy(&image, stored, sizeof(image));
+    Golden_UpdateMean();
+    image_valid = true;
+    image_saved = true;
+}
+
+TestStatus_t ThermalGolden_Capture(uint8_t frames, uint8_t default_tolerance)
+{
+    if (frames == 0 || frames > GOLDEN_MAX_FRAMES) {
+        return STATUS_FAIL_INVALID;
+    }
+
+    memset(capture_sum, 0, sizeof(capture_sum));
+
+    for (uint8_t f = 0; f < frames; f++) {
+        TestStatus_t status = MLX90640_AcquireFrame(NULL);
+        if (status != STATUS_PASS) {
+            return status;
+        }
+
+        const float* temps = MLX90640_GetTemperatures();
+        for (uint16_t i = 0; i < MLX90640_PIXEL_COUNT; i++) {
+            capture_sum[i] += (int32_t)lroundf(temps[i] * 100.0f);
+        }
+    }
+
+    memset(&image, 0, sizeof(image));
+    image.magic = GOLDEN_MAGIC;
+    image.version = GOLDEN_VERSION;
+    image.frames = frames;
+
+    for (uint16_t i = 0; i < MLX90640_PIXEL_COUNT; i++) {
+        image.golden[i] = (int16_t)lroundf((float)capture_sum[i] / frames);
+    }
+    memset(image.tolerance, default_tolerance, sizeof(image.tolerance));
+
+    image.checksum = Golden_Checksum(&image);
+    Golden_UpdateMean();
+    image_valid = true;
+    image_saved = false;
+
+    return STATUS_PASS;
+}
+
+bool ThermalGolden_SetTolerance(uint16_t offset, const uint8_t* tolerances, uint8_t count)
+{
+    if (!image_valid || tolerances == NULL) {
+        return false;
+    }
+    if ((uint32_t)offset + count > MLX90640_PIXEL_COUNT) {
+        return false;
+    }
+
+    memcpy(&image.tolerance[offset], tolerances, count);
+    image.checksum = Golden_Checksum(&image);
+    image_saved = false;
+    return true;
+}
+
+HAL_StatusTypeDef ThermalGolden_Save(void)
+{
+    FLASH_EraseInitTypeDef erase;
+    uint32_t sector_error = 0;
+    HAL_StatusTypeDef status;
+
+    if (!image_valid) {
+        return HAL_ERROR;
+    }
+
+    erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    erase.Banks = FLASH_BANK_1;
+    erase.Sector = GOLDEN_FLASH_SECTOR;
+    erase.NbSectors = 1;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+    HAL_FLASH_Unlock();
+
+    status = HAL_FLASHEx_Erase(&erase, &sector_error);
+
+    const uint8_t* src = (const uint8_t*)&image;
+    for (uint32_t offset = 0; status == HAL_OK && offset < sizeof(image); offset += GOLDEN_FLASH_WORD) {
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_FLASHWORD,
+                                   GOLDEN_FLASH_ADDR + offset,
+                                   (uint32_t)(uintptr_t)&src[offset]);
+    }
+
+    HAL_FLASH_Lock();
+
+    if (status == HAL_OK && memcmp((const void*)GOLDEN_FLASH_ADDR, &image, sizeof(image)) != 0) {
+        status = HAL_ERROR;
+    }
+
+    image_saved = (status == HAL_OK);
+    return status;
+}
+
+void ThermalGolden_GetInfo(ThermalGoldenInfo_t* info)
+{
+    if (info == NULL) {
+        return;
+    }
+
+    info->valid = image_valid;
+    info->saved = image_saved;
+    info->frames = image_valid ? image.frames : 0;
+    info->mean_temp = image_valid ? (int16_t)(golden_mean * 10) : 0;
+    info->checksum = image_valid ? image.checksum : 0;
+}
+
+bool ThermalGolden_Compare(uint16_t max_out, ThermalGoldenResult_t* result)
+{
+    GoldenAcc_t acc;
+
+    if (!image_valid || result == NULL) {
+        return false;
+    }
+
+    memset(&acc, 0, sizeof(acc));
+    memset(result, 0, sizeof(*result));
+
+    /* Compare while the frame is computed */
+    result->status = MLX90640_AcquireFrameStream(NULL, Golden_ComparePixel, &acc);
+    if (result->status != STATUS_PASS || acc.compared == 0) {
+        result->verdict = (result->status != STATUS_PASS) ? result->status : STATUS_FAIL_INVALID;
+        return true;
+    }
+
+    float n = acc.compared;
+    float mean_d = acc.sum_d / n;
+    float cov = acc.sum_tg - acc.sum_t * acc.sum_g / n;
+    float var_t = acc.sum_tt - acc.sum_t * acc.sum_t / n;
+    float var_g = acc.sum_gg - acc.sum_g * acc.sum_g / n;
+    float denom = var_t * var_g;
+
+    result->compared = acc.compared;
+    result->out_count = acc.out_count;
+    result->worst_index = acc.worst_index;
+    result->worst_dev = (int16_t)lroundf(acc.worst_dev * 100.0f);
+    result->mean_dev = (int16_t)lroundf(mean_d * 100.0f);
+    result->rms_dev = (uint16_t)lroundf(sqrtf(acc.sum_dd / n) * 100.0f);
+    result->similarity = (denom > 1e-12f) ? (int16_t)lroundf(cov / sqrtf(denom) * 1000.0f) : 0;
+
+    result->verdict = (acc.compared == MLX90640_PIXEL_COUNT && acc.out_count <= max_out)
+                      ? STATUS_PASS : STATUS_FAIL_INVALID;
+    return true;
+}
+
+uint8_t ThermalGolden_SerializeInfo(const ThermalGoldenInfo_t* info, uint8_t* buffer)
+{
+    if (info == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    /* Format: [valid][saved][frames][mean(2)][checksum(4)] - big-endian */
+    buffer[0] = info->valid ? 1 : 0;
+    buffer[1] = info->saved ? 1 : 0;
+    buffer[2] = info->frames;
+    buffer[3] = (uint8_t)(info->mean_temp >> 8);
+    buffer[4] = (uint8_t)(info->mean_temp & 0xFF);
+    buffer[5] = (uint8_t)(info->checksum >> 24);
+    buffer[6] = (uint8_t)(info->checksum >> 16);
+    buffer[7] = (uint8_t)(info->checksum >> 8);
+    buffer[8] = (uint8_t)(info->checksum & 0xFF);
+
+    return THERMAL_GOLDEN_INFO_SIZE;
+}
+
+uint8_t ThermalGolden_SerializeResult(const ThermalGoldenResult_t* result, uint8_t* buffer)
+{
+    if (result == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    /* Format: [status][verdict][compared][out][worst_idx][worst_dev][mean_dev][rms][similarity]
+     *         - 16-bit fields big-endian */
+    const uint16_t fields[7] = {
+        result->compared, result->out_count, result->worst_index,
+        (uint16_t)result->worst_dev, (uint16_t)result->mean_dev,
+        result->rms_dev, (uint16_t)result->similarity,
+    };
+
+    uint8_t idx = 0;
+    buffer[idx++] = (uint8_t)result->status;
+    buffer[idx++] = (uint8_t)result->verdict;
+    for (uint8_t i = 0; i < 7; i++) {
+        buffer[idx++] = (uint8_t)(fields[i] >> 8);
+        buffer[idx++] = (uint8_t)(fields[i] & 0xFF);
+    }
+
+    return idx;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief CRC-32 over the image payload (everything after the checksum)
+ */
+static uint32_t Golden_Checksum(const GoldenImage_t* img)
+{
+    uint32_t crc = CRC_Handler_Start(CRC_ID_STORAGE);
+
+    crc = CRC_Handler_Update(CRC_ID_STORAGE, crc, &img->frames, 1);
+    crc = CRC_Handler_Update(CRC_ID_STORAGE, crc, img->golden, GOLDEN_DATA_SIZE);
+
+    return CRC_Handler_Finish(CRC_ID_STORAGE, crc);
+}
+
+static void Golden_UpdateMean(void)
+{
+    int32_t sum = 0;
+
+    for (uint16_t i = 0; i < MLX90640_PIXEL_COUNT; i++) {
+        sum += image.golden[i];
+    }
+    golden_mean = (sum / (float)MLX90640_PIXEL_COUNT) / 100.0f;
+}
+
+/**
+ * @brief Pixel sink: fold one computed pixel into the comparison
+ *
+ * A pixel reported twice (same subpage read twice) is only counted once.
+ */
+static void Golden_ComparePixel(int pixelNumber, float to, void* ctx)
+{
+    GoldenAcc_t* acc = (GoldenAcc_t*)ctx;
+    uint8_t bit = (uint8_t)(1u << (pixelNumber & 7));
+
+    if (acc->seen[pixelNumber >> 3] & bit) {
+        return;
+    }
+    acc->seen[pixelNumber >> 3] |= bit;
+
+    float g = image.golden[pixelNumber] * 0.01f;
+    float d = to - g;
+    float ad = fabsf(d);
+
+    if (ad > image.tolerance[pixelNumber] * 0.1f) {
+        acc->out_count++;
+    }
+    if (acc->compared == 0 || ad > fabsf(acc->worst_dev)) {
+        acc->worst_dev = d;
+        acc->worst_index = (uint16_t)pixelNumber;
+    }
+
+    float tc = to - golden_mean;
+    float gc = g - golden_mean;
+
+    acc->sum_d += d;
+    acc->sum_dd += d * d;
+    acc->sum_t += tc;
+    acc->sum_g += gc;
+    acc->sum_tt += tc * tc;
+    acc->sum_gg += gc * gc;
+    acc->sum_tg += tc * gc;
+    acc->compared++;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file thermal_noise.c
+ * @brief Per-pixel temporal noise measurement implementation
+ *
+ * Pixels arrive through the MLX90640 pixel sink while each frame is being
+ * computed. Every sample updates the pixel's running mean and sum of
+ * squared deviations (Welford), which stays accurate for small noise on a
+ * large mean where the naive sum-of-squares would cancel out in float.
+ * Counts are kept per pixel, so broken pixels (reported as 0.0f) and a
+ * subpage that repeats or drops simply change that pixel's sample count.
+ */
+
+#include "sensors/thermal_noise.h"
+#include "sensors/mlx90640.h"
+#include <string.h>
+#include <math.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define NOISE_NO_PIXEL      0xFFFF      /* Unused worst-pixel slot */
+#define NOISE_FRAME_MS      (4000 >> MLX90640_REFRESH_RATE)     /* Two subpages */
+
+/* A measurement runs inside one command with no transport serviced: it
+ * must end well before the host gives up and before the watchdog fires */
+#if (THERMAL_NOISE_MAX_FRAMES + MLX90640_DISCARD_READINGS) * NOISE_FRAME_MS >= WATCHDOG_TIMEOUT_MS
+#error "THERMAL_NOISE_MAX_FRAMES does not fit in one blocking command at this refresh rate"
+#endif
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static float noise_mean[MLX90640_PIXEL_COUNT];
+static float noise_m2[MLX90640_PIXEL_COUNT];
+static uint16_t noise_count[MLX90640_PIXEL_COUNT];
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static void Noise_UpdatePixel(int pixelNumber, float to, void* ctx);
+static void Noise_InsertWorst(ThermalNoiseResult_t* result, uint16_t index, uint16_t sigma);
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+TestStatus_t ThermalNoise_Measure(uint16_t frames, ThermalNoiseResult_t* result)
+{
+    if (result == NULL) {
+        return STATUS_FAIL_INVALID;
+    }
+
+    memset(result, 0, sizeof(*result));
+    for (uint8_t i = 0; i < THERMAL_NOISE_WORST; i++) {
+        result->worst[i].index = NOISE_NO_PIXEL;
+    }
+    result->frames = frames;
+
+    if (frames < 2 || frames > THERMAL_NOISE_MAX_FRAMES) {
+        result->status = STATUS_FAIL_INVALID;
+        return result->status;
+    }
+
+    memset(noise_mean, 0, sizeof(noise_mean));
+    memset(noise_m2, 0, sizeof(noise_m2));
+    memset(noise_count, 0, sizeof(noise_count));
+
+    result->status = MLX90640_StreamFrames(frames, NULL, Noise_UpdatePixel, NULL);
+    if (result->status != STATUS_PASS) {
+        return result->status;
+    }
+
+    /* Reduce per-pixel variance to sigma, NETD, worst list and histogram */
+    float sigma_sum = 0.0f;
+
+    for (uint16_t i = 0; i < MLX90640_PIXEL_COUNT; i++) {
+        uint16_t n = noise_count[i];
+        if (n < 2) {
+            continue;
+        }
+
+        float sigma = sqrtf(noise_m2[i] / (n - 1));
+        float sigma_mk = sigma * 1000.0f + 0.5f;
+        uint16_t mk = (sigma_mk < 65535.0f) ? (uint16_t)sigma_mk : 65535;
+
+        uint16_t bin = mk / THERMAL_NOISE_BIN_MK;
+        if (bin >= THERMAL_NOISE_HIST_BINS) bin = THERMAL_NOISE_HIST_BINS - 1;
+        result->histogram[bin]++;
+
+        if (mk > result->max_sigma) result->max_sigma = mk;
+        Noise_InsertWorst(result, i, mk);
+
+        sigma_sum += sigma;
+        result->pixels++;
+    }
+
+    if (result->pixels > 0) {
+        result->netd = (uint16_t)(sigma_sum / result->pixels * 1000.0f + 0.5f);
+    }
+
+    return result->status;
+}
+
+uint8_t ThermalNoise_Serialize(const ThermalNoiseResult_t* result, uint8_t* buffer)
+{
+    if (result == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    /* Format: [status][frames][pixels][netd][max_sigma][bin_width_mk]
+     *         [index, sigma x THERMAL_NOISE_WORST][histogram x THERMAL_NOISE_HIST_BINS]
+     *         - 16-bit fields big-endian */
+    const uint16_t fields[4] = {
+        result->frames, result->pixels, result->netd, result->max_sigma,
+    };
+
+    uint8_t idx = 0;
+    buffer[idx++] = (uint8_t)result->status;
+    for (uint8_t i = 0; i < 4; i++) {
+        buffer[idx++] = (uint8_t)(fields[i] >> 8);
+        buffer[idx++] = (uint8_t)(fields[i] & 0xFF);
+    }
+    buffer[idx++] = THERMAL_NOISE_BIN_MK;
+    for (uint8_t i = 0; i < THERMAL_NOISE_WORST; i++) {
+        buffer[idx++] = (uint8_t)(result->worst[i].index >> 8);
+        buffer[idx++] = (uint8_t)(result->worst[i].index & 0xFF);
+        buffer[idx++] = (uint8_t)(result->worst[i].sigma >> 8);
+        buffer[idx++] = (uint8_t)(result->worst[i].sigma & 0xFF);
+    }
+    for (uint8_t i = 0; i < THERMAL_NOISE_HIST_BINS; i++) {
+        buffer[idx++] = (uint8_t)(result->histogram[i] >> 8);
+        buffer[idx++] = (uint8_t)(result->histogram[i] & 0xFF);
+    }
+
+    return idx;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Welford update for one pixel sample (MLX90640_PixelSink_t)
+ */
+static void Noise_UpdatePixel(int pixelNumber, float to, void* ctx)
+{
+    (void)ctx;
+
+    if (to == 0.0f) {
+        return;     /* Broken pixel */
+    }
+
+    uint16_t n = ++noise_count[pixelNumber];
+    float d = to - noise_mean[pixelNumber];
+    noise_mean[pixelNumber] += d / n;
+    noise_m2[pixelNumber] += d * (to - noise_mean[pixelNumber]);
+}
+
+/**
+ * @brief Insert a pixel into the descending worst list if it qualifies
+ */
+static void Noise_InsertWorst(ThermalNoiseResult_t* result, uint16_t index, uint16_t sigma)
+{
+    ThermalNoisePixel_t* worst = result->worst;
+    int8_t pos = THERMAL_NOISE_WORST - 1;
+
+    if (worst[pos].index != NOISE_NO_PIXEL && sigma <= worst[pos].sigma) {
+        return;
+    }
+
+    while (pos > 0 && (worst[pos - 1].index == NOISE_NO_PIXEL || sigma > worst[pos - 1].sigma)) {
+        worst[pos] = worst[pos - 1];
+        pos--;
+    }
+    worst[pos].index = index;
+    worst[pos].sigma = sigma;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file thermal_recorder.c
+ * @brief MLX90640 raw subpage flight recorder implementation
+ *
+ * Records live in a NOLOAD section in RAM_D1, which nothing else uses,
+ * so the ring costs no DTCM and no startup zeroing. Validity is tracked
+ * by sequence number only: record seq sits in slot seq % SLOTS and is
+ * held while oldest_seq <= seq < next_seq. Records are stored in native
+ * layout and converted to big-endian only while a chunk is read.
+ */
+
+#include "sensors/thermal_recorder.h"
+#include "stm32h7xx_hal.h"
+#include <string.h>
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+typedef struct {
+    uint32_t    seq;
+    uint32_t    tick;
+    uint16_t    test_id;
+    uint16_t    frame[THERMAL_RECORD_WORDS];
+} ThermalRecord_t;
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static ThermalRecord_t records[THERMAL_RECORDER_SLOTS] __attribute__((section(".axi_sram")));
+
+static uint32_t next_seq = 0;
+static uint16_t record_count = 0;
+static uint16_t test_counter = 0;
+static uint16_t current_test = 0;           /* Tag for new records, 0 outside tests */
+static uint16_t last_test = 0;
+static TestStatus_t last_status = STATUS_NOT_TESTED;
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+void ThermalRecorder_Record(const uint16_t* frame)
+{
+    ThermalRecord_t* rec = &records[next_seq % THERMAL_RECORDER_SLOTS];
+
+    rec->seq = next_seq;
+    rec->tick = HAL_GetTick();
+    rec->test_id = current_test;
+    memcpy(rec->frame, frame, sizeof(rec->frame));
+
+    next_seq++;
+    if (record_count < THERMAL_RECORDER_SLOTS) {
+        record_count++;
+    }
+}
+
+uint16_t ThermalRecorder_BeginTest(void)
+{
+    if (++test_counter == 0) {
+        test_counter = 1;
+    }
+    current_test = test_counter;
+    return current_test;
+}
+
+void ThermalRecorder_EndTest(TestStatus_t status)
+{
+    last_test = current_test;
+    last_status = status;
+    current_test = 0;
+}
+
+void ThermalRecorder_Clear(void)
+{
+    record_count = 0;
+}
+
+void ThermalRecorder_GetInfo(ThermalRecorderInfo_t* info)
+{
+    if (info == NULL) {
+        return;
+    }
+
+    info->count = record_count;
+    info->capacity = THERMAL_RECORDER_SLOTS;
+    info->oldest_seq = next_seq - record_count;
+    info->next_seq = next_seq;
+    info->last_test_id = last_test;
+    info->last_status = last_status;
+}
+
+uint8_t ThermalRecorder_SerializeInfo(const ThermalRecorderInfo_t* info, uint8_t* buffer)
+{
+    if (info == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    /* Format: [count(2)][capacity(2)][oldest_seq(4)][next_seq(4)]
+     *         [record_size(2)][last_test_id(2)][last_status] - big-endian */
+    uint8_t idx = 0;
+    buffer[idx++] = (uint8_t)(info->count >> 8);
+    buffer[idx++] = (uint8_t)(info->count & 0xFF);
+    buffer[idx++] = (uint8_t)(info->capacity >> 8);
+    buffer[idx++] = (uint8_t)(info->capacity & 0xFF);
+    for (int8_t shift = 24; shift >= 0; shift -= 8) {
+        buffer[idx++] = (uint8_t)(info->oldest_seq >> shift);
+    }
+    for (int8_t shift = 24; shift >= 0; shift -= 8) {
+        buffer[idx++] = (uint8_t)(info->next_seq >> shift);
+    }
+    buffer[idx++] = (uint8_t)(THERMAL_RECORD_SIZE >> 8);
+    buffer[idx++] = (uint8_t)(THERMAL_RECORD_SIZE & 0xFF);
+    buffer[idx++] = (uint8_t)(info->last_test_id >> 8);
+    buffer[idx++] = (uint8_t)(info->last_test_id & 0xFF);
+    buffer[idx++] = (uint8_t)info->last_status;
+
+    return idx;
+}
+
+bool ThermalRecorder_ReadChunk(uint32_t seq, uint16_t offset, uint8_t* buffer, uint8_t* len)
+{
+    if (buffer == NULL || len == NULL) {
+        return false;
+    }
+
+    /* Unsigned distance from the oldest record also rejects seq < oldest */
+    if (seq - (next_seq - record_count) >= record_count || offset >= THERMAL_RECORD_SIZE) {
+        return false;
+    }
+
+    const ThermalRecord_t* rec = &records[seq % THERMAL_RECORDER_SLOTS];
+    uint8_t header[THERMAL_RECORD_HEADER_SIZE] = {
+        (uint8_t)(rec->seq >> 24), (uint8_t)(rec->seq >> 16),
+        (uint8_t)(rec->seq >> 8), (uint8_t)(rec->seq & 0xFF),
+        (uint8_t)(rec->tick >> 24), (uint8_t)(rec->tick >> 16),
+        (uint8_t)(rec->tick >> 8), (uint8_t)(rec->tick & 0xFF),
+        (uint8_t)(rec->test_id >> 8), (uint8_t)(rec->test_id & 0xFF),
+    };
+
+    uint16_t end = offset + THERMAL_RECORDER_CHUNK;
+    if (end > THERMAL_RECORD_SIZE) {
+        end = THERMAL_RECORD_SIZE;
+    }
+
+    uint8_t n = 0;
+    for (uint16_t pos = offset; pos < end; pos++) {
+        if (pos < THERMAL_RECORD_HEADER_SIZE) {
+            buffer[n++] = header[pos];
+        } else {
+            uint16_t word = rec->frame[(pos - THERMAL_RECORD_HEADER_SIZE) >> 1];
+            buffer[n++] = ((pos - THERMAL_RECORD_HEADER_SIZE) & 1) ? (uint8_t)(word & 0xFF) : (uint8_t)(word >> 8);
+        }
+    }
+
+    *len = n;
+    return true;
+}
@@ -0,0 +1,293 @@
+/**
+ * @file thermal_stats.c
+ * @brief Robust statistics implementation
+ *
+ * The ROI is copied once into a scratch array while min/max/sum are
+ * accumulated. Order statistics are then found with successive
+ * quickselects on shrinking subranges: after selecting rank k the
+ * elements above k only contain larger ranks, so the median and upper
+ * percentile are selected from [k+1, n) and the trimmed mean is simply
+ * the mean of the range between the two outer ranks.
+ */
+
+#include "sensors/thermal_stats.h"
+#include "sensors/mlx90640.h"
+#include <string.h>
+#include <math.h>
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static float scratch[MLX90640_PIXEL_COUNT];
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static uint16_t Stats_Gather(const float* temps, const ThermalRoi_t* roi,
+                             float* min_out, float* max_out, float* sum_out);
+static void Stats_Select(float* a, uint16_t lo, uint16_t hi, uint16_t k);
+static uint16_t Stats_Rank(uint16_t count, uint8_t percentile);
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+void ThermalRoi_SetFull(ThermalRoi_t* roi)
+{
+    if (roi == NULL) {
+        return;
+    }
+
+    roi->x_min = 0;
+    roi->y_min = 0;
+    roi->x_max = MLX90640_COLS - 1;
+    roi->y_max = MLX90640_ROWS - 1;
+}
+
+bool ThermalRoi_IsValid(const ThermalRoi_t* roi)
+{
+    return roi != NULL &&
+           roi->x_min <= roi->x_max && roi->x_max < MLX90640_COLS &&
+           roi->y_min <= roi->y_max && roi->y_max < MLX90640_ROWS;
+}
+
+void ThermalStats_Compute(const float* temps, const ThermalRoi_t* roi, ThermalStats_t* stats)
+{
+    float min_t, max_t, sum;
+
+    if (temps == NULL || stats == NULL) {
+        return;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+
+    uint16_t n = Stats_Gather(temps, roi, &min_t, &max_t, &sum);
+    if (n == 0) {
+        return;
+    }
+
+    float mean = sum / n;
+
+    /* Deviation and histogram pass over the gathered values */
+    float var_sum = 0.0f;
+    float range = max_t - min_t;
+    float bin_scale = (range > 0.0f) ? (THERMAL_HIST_BINS / range) : 0.0f;
+
+    for (uint16_t i = 0; i < n; i++) {
+        float d = scratch[i] - mean;
+        var_sum += d * d;
+
+        uint16_t bin = (uint16_t)((scratch[i] - min_t) * bin_scale);
+        if (bin >= THERMAL_HIST_BINS) bin = THERMAL_HIST_BINS - 1;
+        stats->histogram[bin]++;
+    }
+
+    /* Order statistics by successive selection */
+    uint16_t k_low = Stats_Rank(n, THERMAL_STATS_P_LOW);
+    uint16_t k_med = Stats_Rank(n, 50);
+    uint16_t k_high = Stats_Rank(n, THERMAL_STATS_P_HIGH);
+
+    Stats_Select(scratch, 0, n - 1, k_low);
+    if (k_med > k_low) Stats_Select(scratch, k_low + 1, n - 1, k_med);
+    if (k_high > k_med) Stats_Select(scratch, k_med + 1, n - 1, k_high);
+
+    float trimmed_sum = 0.0f;
+    for (uint16_t i = k_low; i <= k_high; i++) {
+        trimmed_sum += scratch[i];
+    }
+
+    stats->count = n;
+    stats->min_temp = (int16_t)(min_t * 10);
+    stats->max_temp = (int16_t)(max_t * 10);
+    stats->mean = (int16_t)(mean * 10);
+    stats->stddev = (int16_t)(sqrtf(var_sum / n) * 10);
+    stats->p_low = (int16_t)(scratch[k_low] * 10);
+    stats->median = (int16_t)(scratch[k_med] * 10);
+    stats->p_high = (int16_t)(scratch[k_high] * 10);
+    stats->trimmed_mean = (int16_t)((trimmed_sum / (k_high - k_low + 1)) * 10);
+}
+
+float ThermalStats_Percentile(const float* temps, const ThermalRoi_t* roi, uint8_t percentile)
+{
+    float min_t, max_t, sum;
+
+    uint16_t n = Stats_Gather(temps, roi, &min_t, &max_t, &sum);
+    if (n == 0) {
+        return 0.0f;
+    }
+    if (percentile >= 100) {
+        return max_t;
+    }
+
+    return ThermalStats_PercentileOf(scratch, n, percentile);
+}
+
+float ThermalStats_TrimmedMean(const float* temps, const ThermalRoi_t* roi)
+{
+    float min_t, max_t, sum;
+
+    uint16_t n = Stats_Gather(temps, roi, &min_t, &max_t, &sum);
+    if (n == 0) {
+        return 0.0f;
+    }
+
+    return ThermalStats_TrimmedMeanOf(scratch, n);
+}
+
+float ThermalStats_PercentileOf(float* values, uint16_t count, uint8_t percentile)
+{
+    if (values == NULL || count == 0) {
+        return 0.0f;
+    }
+
+    uint16_t k = Stats_Rank(count, percentile);
+    Stats_Select(values, 0, count - 1, k);
+    return values[k];
+}
+
+float ThermalStats_TrimmedMeanOf(float* values, uint16_t count)
+{
+    if (values == NULL || count == 0) {
+        return 0.0f;
+    }
+
+    uint16_t k_low = Stats_Rank(count, THERMAL_STATS_P_LOW);
+    uint16_t k_high = Stats_Rank(count, THERMAL_STATS_P_HIGH);
+
+    Stats_Select(values, 0, count - 1, k_low);
+    if (k_high > k_low) Stats_Select(values, k_low + 1, count - 1, k_high);
+
+    float trimmed_sum = 0.0f;
+    for (uint16_t i = k_low; i <= k_high; i++) {
+        trimmed_sum += values[i];
+    }
+    return trimmed_sum / (k_high - k_low + 1);
+}
+
+uint8_t ThermalStats_Serialize(const ThermalStats_t* stats, uint8_t* buffer)
+{
+    if (stats == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    /* Format: [count][min][max][mean][stddev][p_low][median][p_high][trimmed]
+     *         [histogram x THERMAL_HIST_BINS] - all 16-bit big-endian */
+    const uint16_t fields[9] = {
+        stats->count,
+        (uint16_t)stats->min_temp, (uint16_t)stats->max_temp,
+        (uint16_t)stats->mean, (uint16_t)stats->stddev,
+        (uint16_t)stats->p_low, (uint16_t)stats->median, (uint16_t)stats->p_high,
+        (uint16_t)stats->trimmed_mean,
+    };
+
+    uint8_t idx = 0;
+    for (uint8_t i = 0; i < 9; i++) {
+        buffer[idx++] = (uint8_t)(fields[i] >> 8);
+        buffer[idx++] = (uint8_t)(fields[i] & 0xFF);
+    }
+    for (uint8_t i = 0; i < THERMAL_HIST_BINS; i++) {
+        buffer[idx++] = (uint8_t)(stats->histogram[i] >> 8);
+        buffer[idx++] = (uint8_t)(stats->histogram[i] & 0xFF);
+    }
+
+    return idx;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Copy ROI pixels to scratch, accumulating min/max/sum
+ * @return Number of pixels copied (0 if ROI invalid)
+ */
+static uint16_t Stats_Gather(const float* temps, const ThermalRoi_t* roi,
+                             float* min_out, float* max_out, float* sum_out)
+{
+    ThermalRoi_t full;
+
+    if (temps == NULL) {
+        return 0;
+    }
+    if (roi == NULL) {
+        ThermalRoi_SetFull(&full);
+        roi = &full;
+    }
+    if (!ThermalRoi_IsValid(roi)) {
+        return 0;
+    }
+
+    uint16_t n = 0;
+    float min_t = temps[roi->y_min * MLX90640_COLS + roi->x_min];
+    float max_t = min_t;
+    float sum = 0.0f;
+
+    for (uint8_t y = roi->y_min; y <= roi->y_max; y++) {
+        const float* row = &temps[y * MLX90640_COLS];
+        for (uint8_t x = roi->x_min; x <= roi->x_max; x++) {
+            float t = row[x];
+            if (t < min_t) min_t = t;
+            if (t > max_t) max_t = t;
+            sum += t;
+            scratch[n++] = t;
+        }
+    }
+
+    *min_out = min_t;
+    *max_out = max_t;
+    *sum_out = sum;
+    return n;
+}
+
+/**
+ * @brief Nearest-rank index of a percentile among count values
+ */
+static uint16_t Stats_Rank(uint16_t count, uint8_t percentile)
+{
+    if (percentile > 100) percentile = 100;
+    return (uint16_t)(((uint32_t)percentile * (count - 1) + 50) / 100);
+}
+
+/**
+ * @brief Partially order a[lo..hi] so that a[k] holds rank k
+ *
+ * Iterative Hoare-partition quickselect with median-of-three pivot.
+ * Afterwards a[lo..k-1] <= a[k] <= a[k+1..hi].
+ */
+static void Stats_Select(float* a, uint16_t lo, uint16_t hi, uint16_t k)
+{
+    while (hi > lo) {
+        uint16_t mid = lo + (hi - lo) / 2;
+        float t;
+
+        /* Median of three into a[mid] */
+        if (a[mid] < a[lo]) { t = a[mid]; a[mid] = a[lo]; a[lo] = t; }
+        if (a[hi] < a[lo])  { t = a[hi];  a[hi] = a[lo];  a[lo] = t; }
+        if (a[hi] < a[mid]) { t = a[hi];  a[hi] = a[mid]; a[mid] = t; }
+
+        float pivot = a[mid];
+        int32_t i = lo;
+        int32_t j = hi;
+
+        while (i <= j) {
+            while (a[i] < pivot) i++;
+            while (a[j] > pivot) j--;
+            if (i <= j) {
+                t = a[i]; a[i] = a[j]; a[j] = t;
+                i++;
+                j--;
+            }
+        }
+
+        /* Now a[lo..j] <= pivot <= a[i..hi], and j < i */
+        if (k <= j) {
+            hi = (uint16_t)j;
+        } else if (k >= i) {
+            lo = (uint16_t)i;
+        } else {
+            return;     /* k lies between j and i: a[k] == pivot */
+        }
+    }
+}
@@ -0,0 +1,299 @@
+/**
+ * @file thermal_zone.c
+ * @brief Multi-ROI thermal spec evaluation implementation
+ *
+ * One scan over the frame feeds every zone that contains the pixel:
+ * min/max/sum are accumulated directly, and zones needing an order
+ * statistic also copy their pixels into a private slice of a shared
+ * value buffer, reduced afterwards by quickselect. Slice sizes are
+ * checked when zones are set, so evaluation cannot overflow.
+ *
+ * Emissivity: the frame is computed at MLX90640_EMISSIVITY. For a zone
+ * emissivity e1 the vendor model gives, per pixel (Kelvin),
+ *     To1^4 = (e0 / e1) * (To0^4 - taTr(e0)) + taTr(e1)
+ *     taTr(e) = Tr^4 - (Tr^4 - Ta^4) / e
+ * which is one multiply-add and two square roots per pixel.
+ */
+
+#include "sensors/thermal_zone.h"
+#include "sensors/mlx90640.h"
+#include <string.h>
+#include <math.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define KELVIN_OFFSET       273.15f
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+typedef struct {
+    float       sum;
+    float       min;
+    float       max;
+    uint16_t    n;
+    uint16_t    offset;         /* Slice start in zone_values (order statistics only) */
+    bool        keep_values;
+    bool        corrected;
+    float       k;              /* Emissivity correction: To1^4 = k * To0^4 + c */
+    float       c;
+} ZoneAcc_t;
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static ThermalZone_t zones[THERMAL_ZONE_MAX];
+static uint8_t zone_count = 0;
+static float zone_values[MLX90640_PIXEL_COUNT];
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static bool Zone_Parse(const uint8_t* buffer, ThermalZone_t* zone);
+static bool Zone_NeedsValues(const ThermalZone_t* zone);
+static uint16_t Zone_Area(const ThermalZone_t* zone);
+static float Zone_TaTr(float ta_k, float tr_k, float emissivity);
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+bool ThermalZone_Set(uint8_t start_index, const uint8_t* buffer, uint8_t count)
+{
+    ThermalZone_t staged[THERMAL_ZONE_MAX];
+
+    if (buffer == NULL || count == 0) {
+        return false;
+    }
+    if (start_index != 0 && start_index != zone_count) {
+        return false;
+    }
+    if (start_index + count > THERMAL_ZONE_MAX) {
+        return false;
+    }
+
+    memcpy(staged, zones, sizeof(staged));
+    for (uint8_t i = 0; i < count; i++) {
+        if (!Zone_Parse(&buffer[i * THERMAL_ZONE_SERIALIZED_SIZE], &staged[start_index + i])) {
+            return false;
+        }
+    }
+
+    /* Order-statistic zones share zone_values */
+    uint32_t value_total = 0;
+    for (uint8_t i = 0; i < start_index + count; i++) {
+        if (Zone_NeedsValues(&staged[i])) {
+            value_total += Zone_Area(&staged[i]);
+        }
+    }
+    if (value_total > MLX90640_PIXEL_COUNT) {
+        return false;
+    }
+
+    memcpy(zones, staged, sizeof(zones));
+    zone_count = start_index + count;
+    return true;
+}
+
+void ThermalZone_Clear(void)
+{
+    zone_count = 0;
+}
+
+uint8_t ThermalZone_GetCount(void)
+{
+    return zone_count;
+}
+
+TestStatus_t ThermalZone_Evaluate(const float* temps, float ta, ThermalZoneResult_t* results)
+{
+    ZoneAcc_t acc[THERMAL_ZONE_MAX];
+    uint16_t offset = 0;
+
+    if (temps == NULL || results == NULL) {
+        return STATUS_FAIL_INVALID;
+    }
+
+    /* Per-zone setup */
+    float ta_k = ta + KELVIN_OFFSET;
+    float tr_k = ta - MLX90640_TR_OFFSET + KELVIN_OFFSET;
+    float tatr_frame = Zone_TaTr(ta_k, tr_k, MLX90640_EMISSIVITY);
+
+    for (uint8_t z = 0; z < zone_count; z++) {
+        ZoneAcc_t* a = &acc[z];
+
+        a->sum = 0.0f;
+        a->min = INFINITY;
+        a->max = -INFINITY;
+        a->n = 0;
+        a->keep_values = Zone_NeedsValues(&zones[z]);
+        a->offset = offset;
+        if (a->keep_values) {
+            offset += Zone_Area(&zones[z]);
+        }
+
+        a->corrected = zones[z].emissivity != 0;
+        if (a->corrected) {
+            float e1 = zones[z].emissivity / 100.0f;
+            a->k = MLX90640_EMISSIVITY / e1;
+            a->c = Zone_TaTr(ta_k, tr_k, e1) - a->k * tatr_frame;
+        }
+    }
+
+    /* Single pass over the frame */
+    for (uint8_t y = 0; y < MLX90640_ROWS; y++) {
+        const float* row = &temps[y * MLX90640_COLS];
+
+        for (uint8_t x = 0; x < MLX90640_COLS; x++) {
+            float t = row[x];
+
+            for (uint8_t z = 0; z < zone_count; z++) {
+                const ThermalRoi_t* roi = &zones[z].roi;
+                if (y < roi->y_min || y > roi->y_max || x < roi->x_min || x > roi->x_max) {
+                    continue;
+                }
+
+                ZoneAcc_t* a = &acc[z];
+                float v = t;
+                if (a->corrected) {
+                    float tk = t + KELVIN_OFFSET;
+                    float t4 = a->k * (tk * tk) * (tk * tk) + a->c;
+                    if (t4 > 0.0f) {
+                        v = sqrtf(sqrtf(t4)) - KELVIN_OFFSET;
+                    }
+                }
+
+                a->sum += v;
+                if (v < a->min) a->min = v;
+                if (v > a->max) a->max = v;
+                if (a->keep_values) {
+                    zone_values[a->offset + a->n] = v;
+                }
+                a->n++;
+            }
+        }
+    }
+
+    /* Reduce and judge */
+    TestStatus_t overall = STATUS_PASS;
+
+    for (uint8_t z = 0; z < zone_count; z++) {
+        ZoneAcc_t* a = &acc[z];
+        float measured;
+
+        switch (zones[z].statistic) {
+            case MLX_STAT_PERCENTILE:
+                measured = ThermalStats_PercentileOf(&zone_values[a->offset], a->n, zones[z].percentile);
+                break;
+
+            case MLX_STAT_TRIMMED_MEAN:
+                measured = ThermalStats_TrimmedMeanOf(&zone_values[a->offset], a->n);
+                break;
+
+            case MLX_STAT_MAX:
+                measured = a->max;
+                break;
+
+            case MLX_STAT_MIN:
+                measured = a->min;
+                break;
+
+            case MLX_STAT_MEAN:
+            default:
+                measured = a->sum / a->n;
+                break;
+        }
+
+        int16_t diff = (int16_t)(measured * 10) - zones[z].target_temp;
+        if (diff < 0) diff = -diff;
+
+        results[z].measured = (int16_t)(measured * 10);
+        results[z].diff = diff;
+        results[z].status = (diff > zones[z].tolerance) ? STATUS_FAIL_INVALID : STATUS_PASS;
+
+        if (results[z].status != STATUS_PASS) {
+            overall = STATUS_FAIL_INVALID;
+        }
+    }
+
+    return overall;
+}
+
+uint8_t ThermalZone_SerializeResult(const ThermalZoneResult_t* result, uint8_t* buffer)
+{
+    if (result == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    /* Format: [status][measured(2)][diff(2)] - big-endian */
+    buffer[0] = (uint8_t)result->status;
+    buffer[1] = (uint8_t)(result->measured >> 8);
+    buffer[2] = (uint8_t)(result->measured & 0xFF);
+    buffer[3] = (uint8_t)(result->diff >> 8);
+    buffer[4] = (uint8_t)(result->diff & 0xFF);
+
+    return THERMAL_ZONE_RESULT_SIZE;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Parse and validate one zone
+ *
+ * Format: [x_min][y_min][x_max][y_max][statistic][percentile]
+ *         [target_hi][target_lo][tolerance_hi][tolerance_lo][emissivity]
+ */
+static bool Zone_Parse(const uint8_t* buffer, ThermalZone_t* zone)
+{
+    zone->roi.x_min = buffer[0];
+    zone->roi.y_min = buffer[1];
+    zone->roi.x_max = buffer[2];
+    zone->roi.y_max = buffer[3];
+    zone->statistic = buffer[4];
+    zone->percentile = buffer[5];
+    zone->target_temp = (int16_t)((buffer[6] << 8) | buffer[7]);
+    zone->tolerance = (int16_t)((buffer[8] << 8) | buffer[9]);
+    zone->emissivity = buffer[10];
+
+    if (!ThermalRoi_IsValid(&zone->roi)) {
+        return false;
+    }
+    if (zone->statistic < MLX_STAT_MEAN || zone->statistic > MLX_STAT_MIN) {
+        return false;
+    }
+    if (zone->statistic == MLX_STAT_PERCENTILE && zone->percentile > 100) {
+        return false;
+    }
+    if (zone->tolerance < 0 || zone->emissivity > 100) {
+        return false;
+    }
+
+    return true;
+}
+
+static bool Zone_NeedsValues(const ThermalZone_t* zone)
+{
+    return zone->statistic == MLX_STAT_PERCENTILE || zone->statistic == MLX_STAT_TRIMMED_MEAN;
+}
+
+static uint16_t Zone_Area(const ThermalZone_t* zone)
+{
+    return (uint16_t)((zone->roi.x_max - zone->roi.x_min + 1) * (zone->roi.y_max - zone->roi.y_min + 1));
+}
+
+/**
+ * @brief Background term of the vendor To model (Kelvin^4)
+ */
+static float Zone_TaTr(float ta_k, float tr_k, float emissivity)
+{
+    float tr4 = (tr_k * tr_k) * (tr_k * tr_k);
+    float ta4 = (ta_k * ta_k) * (ta_k * ta_k);
+    return tr4 - (tr4 - ta4) / emissivity;
+}
@@ -129,9 +129,8 @@ static HAL_StatusTypeDef VL53L0X_Init_Driver(void)
         return HAL_OK;
     }
 
-    /* NOTE: XSHUT power-up sequence is handled in main.cpp:
-     *   - MX_GPIO_Init(): 12V OFF, 2s delay, XSHUT LOW
-     *   - main(): 12V ON, 100ms delay, XSHUT HIGH
+    /* NOTE: XSHUT power-up sequence is handled by the boot sequencer (app/boot.c):
+     *   12V ON, rail settle, XSHUT HIGH, tBOOT - then this init is called.
      * No need to repeat here - sensor is already booted when this is called.
      */
 
@@ -0,0 +1,510 @@
+/**
+ * @file test_journal.c
+ * @brief Test result journal implementation
+ *
+ * Entries are a fixed 64-byte layout (two 256-bit flash words). The RAM
+ * ring holds entry seq in slot seq % TEST_JOURNAL_ENTRIES while
+ * next_seq - ram_count <= seq < next_seq, like the frame recorder.
+ *
+ * The flash copy alternates between two sectors starting at
+ * TEST_JOURNAL_FLASH_SECTOR. Within a sector it is append-only: slot k
+ * holds seq first + k, so lookup is O(1). A slot is consumed even if
+ * programming fails, which leaves a hole that the checksum rejects on
+ * read instead of shifting later entries. When the active sector is
+ * within TEST_JOURNAL_ERASE_AHEAD slots of full, TestJournal_Process
+ * erases the other one from the main loop, and appends move there once
+ * the active sector fills; a test never waits for an erase and the
+ * previous sector's history stays readable until then. At boot the slot
+ * after each sector's last programmed one is its write pointer, its last
+ * valid slot restores its first seq, and the sector ending later is the
+ * active one.
+ */
+
+#include "test/test_journal.h"
+#include "hal/crc_handler.h"
+#include "stm32h7xx_hal.h"
+#include <stddef.h>
+#include <string.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define JOURNAL_FLASH_WORD      (FLASH_NB_32BITWORD_IN_FLASHWORD * 4)
+#define JOURNAL_FLASH_SLOTS     (FLASH_SECTOR_SIZE / sizeof(JournalEntry_t))
+#define JOURNAL_FLASH_SECTORS   2
+
+/* Largest serialized entry: 12-byte header, per-sensor durations, report with 16-byte results */
+#define JOURNAL_REPORT_MAX      (7 + TEST_JOURNAL_RESULTS * (2 + sizeof(SensorResult_t)))
+#define JOURNAL_WIRE_MAX        (12 + TEST_JOURNAL_RESULTS * 2 + JOURNAL_REPORT_MAX)
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+typedef struct {
+    uint8_t         sensor_id;
+    uint8_t         status;
+    uint16_t        duration_ms;
+    SensorResult_t  result;
+} JournalResult_t;
+
+typedef struct {
+    uint32_t        seq;
+    uint32_t        timestamp;                          /* Report start tick (ms) */
+    uint32_t        recipe;                             /* FNV-1a of the specs used */
+    uint16_t        duration_ms;                        /* Whole report */
+    uint8_t         sensor_count;
+    uint8_t         pass_count;
+    uint8_t         fail_count;
+    uint8_t         reserved[3];
+    JournalResult_t results[TEST_JOURNAL_RESULTS];
+    uint32_t        checksum;                           /* CRC-32 over everything before it */
+} JournalEntry_t;
+
+#if TEST_JOURNAL_FLASH_SPILL
+typedef struct {
+    uint32_t        first;                              /* Seq of slot 0 */
+    uint16_t        count;                              /* Slots consumed since the last erase */
+} JournalSector_t;
+#endif
+
+_Static_assert(sizeof(JournalEntry_t) % JOURNAL_FLASH_WORD == 0, "Journal entry must be whole flash words");
+_Static_assert(JOURNAL_WIRE_MAX <= PROTOCOL_MAX_PAYLOAD - 5, "Journal entry must fit a JOURNAL_DATA response");
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static JournalEntry_t ram_entries[TEST_JOURNAL_ENTRIES];
+static uint32_t next_seq = 0;
+static uint16_t ram_count = 0;
+
+#if TEST_JOURNAL_FLASH_SPILL
+static JournalEntry_t flash_buffer __attribute__((aligned(32)));
+static JournalSector_t sectors[JOURNAL_FLASH_SECTORS];
+static uint8_t active = 0;                  /* Sector entries are appended to */
+#endif
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static uint32_t Journal_Checksum(const JournalEntry_t* entry);
+static uint32_t Journal_Recipe(const TestReport_t* report);
+static bool Journal_Lookup(uint32_t seq, JournalEntry_t* entry);
+static uint32_t Journal_OldestSeq(void);
+static uint8_t Journal_SerializeEntry(const JournalEntry_t* entry, uint8_t* buffer);
+#if TEST_JOURNAL_FLASH_SPILL
+static const JournalEntry_t* Journal_FlashSlot(uint8_t sector, uint16_t slot);
+static bool Journal_SlotErased(uint8_t sector, uint16_t slot);
+static bool Journal_RecoverSector(uint8_t sector, uint32_t* end);
+static HAL_StatusTypeDef Journal_Erase(uint8_t sector);
+static void Journal_Program(const JournalEntry_t* entry);
+#endif
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+void TestJournal_Init(void)
+{
+    next_seq = 0;
+    ram_count = 0;
+
+#if TEST_JOURNAL_FLASH_SPILL
+    active = 0;
+
+    for (uint8_t s = 0; s < JOURNAL_FLASH_SECTORS; s++) {
+        uint32_t end;
+        if (Journal_RecoverSector(s, &end) && end > next_seq) {
+            next_seq = end;
+            active = s;
+        }
+    }
+#endif
+}
+
+void TestJournal_Process(void)
+{
+#if TEST_JOURNAL_FLASH_SPILL
+    uint8_t spare = active ^ 1;
+
+    if ((uint32_t)sectors[active].count + TEST_JOURNAL_ERASE_AHEAD >= JOURNAL_FLASH_SLOTS && sectors[spare].count > 0) {
+        Journal_Erase(spare);
+    }
+#endif
+}
+
+void TestJournal_Record(const TestReport_t* report)
+{
+    if (report == NULL) {
+        return;
+    }
+
+    JournalEntry_t* entry = &ram_entries[next_seq % TEST_JOURNAL_ENTRIES];
+    uint32_t elapsed = HAL_GetTick() - report->timestamp;
+
+    memset(entry, 0, sizeof(*entry));
+    entry->seq = next_seq;
+    entry->timestamp = report->timestamp;
+    entry->recipe = Journal_Recipe(report);
+    entry->duration_ms = (elapsed < UINT16_MAX) ? (uint16_t)elapsed : UINT16_MAX;
+    entry->sensor_count = (report->sensor_count < TEST_JOURNAL_RESULTS) ? report->sensor_count : TEST_JOURNAL_RESULTS;
+    entry->pass_count = report->pass_count;
+    entry->fail_count = report->fail_count;
+
+    for (uint8_t i = 0; i < entry->sensor_count; i++) {
+        entry->results[i].sensor_id = (uint8_t)report->results[i].sensor_id;
+        entry->results[i].status = (uint8_t)report->results[i].status;
+        entry->results[i].duration_ms = report->results[i].duration_ms;
+        entry->results[i].result = report->results[i].result;
+    }
+    entry->checksum = Journal_Checksum(entry);
+
+    next_seq++;
+    if (ram_count < TEST_JOURNAL_ENTRIES) {
+        ram_count++;
+    }
+
+#if TEST_JOURNAL_FLASH_SPILL
+    Journal_Program(entry);
+#endif
+}
+
+HAL_StatusTypeDef TestJournal_Clear(void)
+{
+    ram_count = 0;
+
+#if TEST_JOURNAL_FLASH_SPILL
+    HAL_StatusTypeDef status = HAL_OK;
+
+    for (uint8_t s = 0; s < JOURNAL_FLASH_SECTORS; s++) {
+        if (Journal_Erase(s) != HAL_OK) {
+            status = HAL_ERROR;
+        }
+    }
+    active = 0;
+    return status;
+#else
+    return HAL_OK;
+#endif
+}
+
+void TestJournal_GetInfo(TestJournalInfo_t* info)
+{
+    if (info == NULL) {
+        return;
+    }
+
+    info->oldest_seq = Journal_OldestSeq();
+    info->next_seq = next_seq;
+    info->ram_count = ram_count;
+    info->ram_capacity = TEST_JOURNAL_ENTRIES;
+#if TEST_JOURNAL_FLASH_SPILL
+    info->flash_count = sectors[0].count + sectors[1].count;
+    info->flash_capacity = JOURNAL_FLASH_SLOTS * JOURNAL_FLASH_SECTORS;
+#else
+    info->flash_count = 0;
+    info->flash_capacity = 0;
+#endif
+}
+
+uint8_t TestJournal_SerializeInfo(const TestJournalInfo_t* info, uint8_t* buffer)
+{
+    if (info == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    /* Format: [oldest(4)][next(4)][ram_count(2)][ram_cap(2)][flash_count(2)][flash_cap(2)] - big-endian */
+    const uint16_t fields[4] = {
+        info->ram_count, info->ram_capacity, info->flash_count, info->flash_capacity,
+    };
+
+    uint8_t idx = 0;
+    buffer[idx++] = (uint8_t)(info->oldest_seq >> 24);
+    buffer[idx++] = (uint8_t)(info->oldest_seq >> 16);
+    buffer[idx++] = (uint8_t)(info->oldest_seq >> 8);
+    buffer[idx++] = (uint8_t)(info->oldest_seq & 0xFF);
+    buffer[idx++] = (uint8_t)(info->next_seq >> 24);
+    buffer[idx++] = (uint8_t)(info->next_seq >> 16);
+    buffer[idx++] = (uint8_t)(info->next_seq >> 8);
+    buffer[idx++] = (uint8_t)(info->next_seq & 0xFF);
+    for (uint8_t i = 0; i < 4; i++) {
+        buffer[idx++] = (uint8_t)(fields[i] >> 8);
+        buffer[idx++] = (uint8_t)(fields[i] & 0xFF);
+    }
+
+    return idx;
+}
+
+uint8_t TestJournal_Read(uint32_t* seq, uint8_t* buffer, uint8_t size, uint8_t* count)
+{
+    if (seq == NULL || buffer == NULL || count == NULL) {
+        return 0;
+    }
+
+    uint32_t cursor = *seq;
+    uint32_t oldest = Journal_OldestSeq();
+    uint8_t entry_buffer[JOURNAL_WIRE_MAX];
+    JournalEntry_t entry;
+    uint8_t idx = 0;
+
+    if (cursor < oldest || cursor > next_seq) {
+        cursor = oldest;    /* Older entries are gone; a cursor from before a reset restarts too */
+    }
+
+    *count = 0;
+    while (cursor < next_seq) {
+        if (!Journal_Lookup(cursor, &entry)) {
+            cursor++;       /* Hole left by a failed flash write */
+            continue;
+        }
+
+        uint8_t len = Journal_SerializeEntry(&entry, entry_buffer);
+        if ((uint16_t)idx + len > size) {
+            break;
+        }
+
+        memcpy(&buffer[idx], entry_buffer, len);
+        idx += len;
+        (*count)++;
+        cursor++;
+    }
+
+    *seq = cursor;
+    return idx;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief CRC-32 over the entry (everything before the checksum)
+ */
+static uint32_t Journal_Checksum(const JournalEntry_t* entry)
+{
+    return CRC_Handler_Calculate(CRC_ID_STORAGE, entry, offsetof(JournalEntry_t, checksum));
+}
+
+/**
+ * @brief Recipe id: FNV-1a over (sensor id, spec) of every sensor in the report
+ */
+static uint32_t Journal_Recipe(const TestReport_t* report)
+{
+    uint32_t hash = 0x811C9DC5UL;
+
+    for (uint8_t i = 0; i < report->sensor_count && i < MAX_SENSORS; i++) {
+        const SensorDriver_t* driver = SensorManager_GetByID(report->results[i].sensor_id);
+        SensorSpec_t spec;
+
+        memset(&spec, 0, sizeof(spec));
+        if (driver != NULL && driver->get_spec != NULL) {
+            driver->get_spec(&spec);
+        }
+
+        hash = (hash ^ (uint8_t)report->results[i].sensor_id) * 0x01000193UL;
+        for (uint8_t b = 0; b < sizeof(spec.raw); b++) {
+            hash = (hash ^ spec.raw[b]) * 0x01000193UL;
+        }
+    }
+
+    return hash;
+}
+
+static bool Journal_Lookup(uint32_t seq, JournalEntry_t* entry)
+{
+    if (seq >= next_seq) {
+        return false;
+    }
+
+    if (next_seq - seq <= ram_count) {
+        *entry = ram_entries[seq % TEST_JOURNAL_ENTRIES];
+        return true;
+    }
+
+#if TEST_JOURNAL_FLASH_SPILL
+    for (uint8_t s = 0; s < JOURNAL_FLASH_SECTORS; s++) {
+        if (seq >= sectors[s].first && seq - sectors[s].first < sectors[s].count) {
+            const JournalEntry_t* slot = Journal_FlashSlot(s, (uint16_t)(seq - sectors[s].first));
+            if (slot->seq == seq && slot->checksum == Journal_Checksum(slot)) {
+                *entry = *slot;
+                return true;
+            }
+        }
+    }
+#endif
+
+    return false;
+}
+
+static uint32_t Journal_OldestSeq(void)
+{
+    uint32_t oldest = next_seq - ram_count;
+
+#if TEST_JOURNAL_FLASH_SPILL
+    for (uint8_t s = 0; s < JOURNAL_FLASH_SECTORS; s++) {
+        if (sectors[s].count > 0 && sectors[s].first < oldest) {
+            oldest = sectors[s].first;
+        }
+    }
+#endif
+
+    return oldest;
+}
+
+/**
+ * @brief Serialize one entry in the JOURNAL_DATA wire format
+ */
+static uint8_t Journal_SerializeEntry(const JournalEntry_t* entry, uint8_t* buffer)
+{
+    TestReport_t report;
+
+    memset(&report, 0, sizeof(report));
+    report.sensor_count = entry->sensor_count;
+    report.pass_count = entry->pass_count;
+    report.fail_count = entry->fail_count;
+    report.timestamp = entry->timestamp;
+    for (uint8_t i = 0; i < entry->sensor_count; i++) {
+        report.results[i].sensor_id = (SensorID_t)entry->results[i].sensor_id;
+        report.results[i].status = (TestStatus_t)entry->results[i].status;
+        report.results[i].result = entry->results[i].result;
+    }
+
+    /* [len][seq(4)][recipe(4)][duration(2)][n][duration(2) x n][report] - big-endian */
+    uint8_t idx = 1;
+    buffer[idx++] = (uint8_t)(entry->seq >> 24);
+    buffer[idx++] = (uint8_t)(entry->seq >> 16);
+    buffer[idx++] = (uint8_t)(entry->seq >> 8);
+    buffer[idx++] = (uint8_t)(entry->seq & 0xFF);
+    buffer[idx++] = (uint8_t)(entry->recipe >> 24);
+    buffer[idx++] = (uint8_t)(entry->recipe >> 16);
+    buffer[idx++] = (uint8_t)(entry->recipe >> 8);
+    buffer[idx++] = (uint8_t)(entry->recipe & 0xFF);
+    buffer[idx++] = (uint8_t)(entry->duration_ms >> 8);
+    buffer[idx++] = (uint8_t)(entry->duration_ms & 0xFF);
+    buffer[idx++] = entry->sensor_count;
+    for (uint8_t i = 0; i < entry->sensor_count; i++) {
+        buffer[idx++] = (uint8_t)(entry->results[i].duration_ms >> 8);
+        buffer[idx++] = (uint8_t)(entry->results[i].duration_ms & 0xFF);
+    }
+    idx += (uint8_t)TestRunner_SerializeReport(&report, &buffer[idx]);
+
+    buffer[0] = idx - 1;
+    return idx;
+}
+
+#if TEST_JOURNAL_FLASH_SPILL
+
+static const JournalEntry_t* Journal_FlashSlot(uint8_t sector, uint16_t slot)
+{
+    return (const JournalEntry_t*)(TEST_JOURNAL_FLASH_ADDR + (uint32_t)sector * FLASH_SECTOR_SIZE +
+                                   (uint32_t)slot * sizeof(JournalEntry_t));
+}
+
+static bool Journal_SlotErased(uint8_t sector, uint16_t slot)
+{
+    const uint32_t* words = (const uint32_t*)Journal_FlashSlot(sector, slot);
+
+    for (uint32_t i = 0; i < sizeof(JournalEntry_t) / 4; i++) {
+        if (words[i] != 0xFFFFFFFFUL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Restore a sector's write pointer and first seq
+ *
+ * A sector holding no readable entry is erased.
+ *
+ * @param sector Journal sector index
+ * @param end Seq after the sector's last slot (output)
+ * @return true if the sector holds a readable entry
+ */
+static bool Journal_RecoverSector(uint8_t sector, uint32_t* end)
+{
+    JournalSector_t* state = &sectors[sector];
+
+    /* Scan from the end: a failed write can leave an erased hole before later entries */
+    state->first = 0;
+    state->count = JOURNAL_FLASH_SLOTS;
+    while (state->count > 0 && Journal_SlotErased(sector, state->count - 1)) {
+        state->count--;
+    }
+
+    for (int32_t k = (int32_t)state->count - 1; k >= 0; k--) {
+        const JournalEntry_t* slot = Journal_FlashSlot(sector, (uint16_t)k);
+        if (slot->checksum == Journal_Checksum(slot)) {
+            state->first = slot->seq - (uint32_t)k;
+            *end = state->first + state->count;
+            return true;
+        }
+    }
+
+    if (state->count > 0) {
+        Journal_Erase(sector);  /* Nothing readable: start the sector over */
+    }
+    return false;
+}
+
+static HAL_StatusTypeDef Journal_Erase(uint8_t sector)
+{
+    FLASH_EraseInitTypeDef erase;
+    uint32_t sector_error = 0;
+
+    erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    erase.Banks = FLASH_BANK_1;
+    erase.Sector = TEST_JOURNAL_FLASH_SECTOR + sector;
+    erase.NbSectors = 1;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+    HAL_FLASH_Unlock();
+    HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&erase, &sector_error);
+    HAL_FLASH_Lock();
+
+    /* On failure the content is unknown: serve nothing from it and retry the erase before writing */
+    sectors[sector].first = next_seq;
+    sectors[sector].count = (status == HAL_OK) ? 0 : JOURNAL_FLASH_SLOTS;
+    return status;
+}
+
+/**
+ * @brief Append one entry to the active sector, moving to the other once full
+ *
+ * The other sector is only written after TestJournal_Process erased it;
+ * until then the entry is kept in the RAM ring only.
+ */
+static void Journal_Program(const JournalEntry_t* entry)
+{
+    if (sectors[active].count >= JOURNAL_FLASH_SLOTS) {
+        uint8_t spare = active ^ 1;
+        if (sectors[spare].count > 0) {
+            return;
+        }
+        active = spare;
+    }
+
+    JournalSector_t* state = &sectors[active];
+    if (state->count == 0) {
+        state->first = entry->seq;
+    }
+
+    uint32_t addr = (uint32_t)(uintptr_t)Journal_FlashSlot(active, state->count);
+    const uint8_t* src = (const uint8_t*)&flash_buffer;
+    HAL_StatusTypeDef status = HAL_OK;
+
+    flash_buffer = *entry;
+    state->count++;         /* Consumed even on failure; the checksum marks the hole */
+
+    HAL_FLASH_Unlock();
+    for (uint32_t offset = 0; status == HAL_OK && offset < sizeof(flash_buffer); offset += JOURNAL_FLASH_WORD) {
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_FLASHWORD, addr + offset,
+                                   (uint32_t)(uintptr_t)&src[offset]);
+    }
+    HAL_FLASH_Lock();
+}
+
+#endif /* TEST_JOURNAL_FLASH_SPILL */
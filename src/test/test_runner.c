@@ -4,6 +4,7 @@
  */
 
 #include "test/test_runner.h"
+#include "test/test_journal.h"
 #include "stm32h7xx_hal.h"
 #include <string.h>
 
@@ -54,23 +55,21 @@ void TestRunner_Init(void)
 
 static void RunSensorTest(const SensorDriver_t* driver, SensorTestResult_t* result)
 {
+    uint32_t start = HAL_GetTick();
+
     result->sensor_id = driver->id;
 
     /* Initialize sensor if needed */
-    if (driver->init != NULL) {
-        HAL_StatusTypeDef init_status = driver->init();
-        if (init_status != HAL_OK) {
-            result->status = STATUS_FAIL_INIT;
-            return;
-        }
-    }
-
-    /* Run test */
-    if (driver->run_test != NULL) {
+    if (driver->init != NULL && driver->init() != HAL_OK) {
+        result->status = STATUS_FAIL_INIT;
+    } else if (driver->run_test != NULL) {
         result->status = driver->run_test(&result->result);
     } else {
         result->status = STATUS_NOT_TESTED;
     }
+
+    uint32_t elapsed = HAL_GetTick() - start;
+    result->duration_ms = (elapsed < UINT16_MAX) ? (uint16_t)elapsed : UINT16_MAX;
 }
 
 /*============================================================================*/
@@ -107,6 +106,8 @@ void TestRunner_RunAll(TestReport_t* report)
             report->fail_count++;
         }
     }
+
+    TestJournal_Record(report);
 }
 
 void TestRunner_RunSingle(SensorID_t sensor_id, TestReport_t* report)
@@ -128,16 +129,17 @@ void TestRunner_RunSingle(SensorID_t sensor_id, TestReport_t* report)
 
     if (driver == NULL) {
         test_result->status = STATUS_NOT_TESTED;
-        return;
-    }
-
-    RunSensorTest(driver, test_result);
+    } else {
+        RunSensorTest(driver, test_result);
 
-    if (test_result->status == STATUS_PASS) {
-        report->pass_count = 1;
-    } else if (test_result->status != STATUS_NOT_TESTED) {
-        report->fail_count = 1;
+        if (test_result->status == STATUS_PASS) {
+            report->pass_count = 1;
+        } else if (test_result->status != STATUS_NOT_TESTED) {
+            report->fail_count = 1;
+        }
     }
+
+    TestJournal_Record(report);
 }
 
 uint16_t TestRunner_SerializeReport(const TestReport_t* report, uint8_t* buffer)
@@ -239,6 +241,7 @@ void TestRunner_ProcessAsync(void)
 
         if (async_ctx.current_index >= sensor_count) {
             /* All sensors tested */
+            TestJournal_Record(&async_ctx.report);
             async_ctx.state = TEST_STATE_COMPLETE;
             return;
         }
@@ -260,6 +263,7 @@ void TestRunner_ProcessAsync(void)
 
         /* Check if all sensors done */
         if (async_ctx.current_index >= sensor_count) {
+            TestJournal_Record(&async_ctx.report);
             async_ctx.state = TEST_STATE_COMPLETE;
         }
 
@@ -282,6 +286,7 @@ void TestRunner_ProcessAsync(void)
             test_result->status = STATUS_NOT_TESTED;
         }
 
+        TestJournal_Record(&async_ctx.report);
         async_ctx.state = TEST_STATE_COMPLETE;
     }
 }
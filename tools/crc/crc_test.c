@@ -0,0 +1,182 @@
+/**
+ * @file crc_test.c
+ * @brief Host test of the CRC service software backend
+ *
+ * Builds src/hal/crc_handler.c with CRC_HW_ENABLED 0 (tables only) and
+ * checks it against known vectors: the catalogue check values, protocol
+ * frame blocks whose CRC-8 the host library (psa_protocol/crc.py) and
+ * zlib agree on, and a bitwise reference over every length and
+ * alignment, including running CRCs split at every byte. The target
+ * checks the peripheral against the check vector and these tables at init
+ * (CRC_Handler_Init), so the hardware backend is held to the same
+ * vectors there.
+ *
+ * Build and run (from the repository root; exits 1 on a mismatch):
+ *   gcc -O2 -DCRC_HW_ENABLED=0 -Iinclude tools/crc/crc_test.c src/hal/crc_handler.c \
+ *       -o crc_test && ./crc_test
+ */
+
+#include "hal/crc_handler.h"
+#include <stdio.h>
+
+#if CRC_HW_ENABLED
+#error "Build the host test with -DCRC_HW_ENABLED=0"
+#endif
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define CRC_TEST_BUFFER     300     /* Longer than CRC_HW_MIN_LEN and several slices */
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+typedef struct {
+    const char* name;
+    const uint8_t* data;
+    uint32_t len;
+    uint32_t crc8;          /* CRC_ID_FRAME */
+    uint32_t crc32;         /* CRC_ID_STORAGE */
+} CrcTest_Vector_t;
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static const uint8_t check_string[] = "123456789";
+static const uint8_t fox_string[] = "The quick brown fox jumps over the lazy dog";
+static const uint8_t ping_block[] = { 0x00, 0x01 };                 /* LEN CMD of PING */
+static const uint8_t sensor_list_block[] = { 0x03, 0x81, 0x01, 0x02, 0x03 };
+static const uint8_t ff_byte[] = { 0xFF };
+static uint8_t ramp[256];
+static uint8_t buffer[CRC_TEST_BUFFER + 4];
+
+static int failures = 0;
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static uint8_t CrcTest_Crc8Bitwise(const uint8_t* data, uint32_t len);
+static uint32_t CrcTest_Crc32Bitwise(const uint8_t* data, uint32_t len);
+static void CrcTest_Expect(const char* what, uint32_t got, uint32_t expected);
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+int main(void)
+{
+    for (int i = 0; i < 256; i++) {
+        ramp[i] = (uint8_t)i;
+    }
+
+    const CrcTest_Vector_t vectors[] = {
+        { "check \"123456789\"", check_string, 9, 0xF4, 0xCBF43926UL },
+        { "empty", check_string, 0, 0x00, 0x00000000UL },
+        { "PING block", ping_block, sizeof(ping_block), 0x07, 0x36DE2269UL },
+        { "0xFF", ff_byte, sizeof(ff_byte), 0xF3, 0xFF000000UL },
+        { "ramp 0..255", ramp, sizeof(ramp), 0x14, 0x29058C73UL },
+        { "fox", fox_string, sizeof(fox_string) - 1, 0xC1, 0x414FA339UL },
+        { "SENSOR_LIST block", sensor_list_block, sizeof(sensor_list_block), 0xC9, 0x7E9A059CUL },
+    };
+
+    if (CRC_Handler_Init() != CRC_BACKEND_SOFTWARE) {
+        printf("FAIL: expected the software backend\n");
+        return 1;
+    }
+
+    /* Known vectors */
+    for (size_t v = 0; v < sizeof(vectors) / sizeof(vectors[0]); v++) {
+        char what[64];
+        snprintf(what, sizeof(what), "CRC-8 %s", vectors[v].name);
+        CrcTest_Expect(what, CRC_Handler_Calculate(CRC_ID_FRAME, vectors[v].data, vectors[v].len),
+                       vectors[v].crc8);
+        snprintf(what, sizeof(what), "CRC-32 %s", vectors[v].name);
+        CrcTest_Expect(what, CRC_Handler_Calculate(CRC_ID_STORAGE, vectors[v].data, vectors[v].len),
+                       vectors[v].crc32);
+    }
+
+    /* Every length and alignment against the bitwise definition */
+    for (uint32_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t)(i * 7 + 13);
+    }
+    for (uint32_t offset = 0; offset < 4; offset++) {
+        for (uint32_t len = 0; len <= CRC_TEST_BUFFER; len++) {
+            const uint8_t* data = &buffer[offset];
+            uint32_t crc8 = CRC_Handler_Calculate(CRC_ID_FRAME, data, len);
+            uint32_t crc32 = CRC_Handler_Calculate(CRC_ID_STORAGE, data, len);
+            if (crc8 != CrcTest_Crc8Bitwise(data, len) || crc32 != CrcTest_Crc32Bitwise(data, len)) {
+                if (failures++ < 10) {
+                    printf("MISMATCH offset %u len %u\n", (unsigned)offset, (unsigned)len);
+                }
+            }
+        }
+    }
+
+    /* Running CRC split at every byte */
+    for (uint8_t id = 0; id < CRC_ID_COUNT; id++) {
+        uint32_t whole = CRC_Handler_Calculate((CrcID_t)id, &buffer[1], CRC_TEST_BUFFER);
+        for (uint32_t split = 0; split <= CRC_TEST_BUFFER; split++) {
+            uint32_t crc = CRC_Handler_Start((CrcID_t)id);
+            crc = CRC_Handler_Update((CrcID_t)id, crc, &buffer[1], split);
+            crc = CRC_Handler_Update((CrcID_t)id, crc, &buffer[1 + split], CRC_TEST_BUFFER - split);
+            if (CRC_Handler_Finish((CrcID_t)id, crc) != whole) {
+                if (failures++ < 10) {
+                    printf("MISMATCH id %u split %u\n", (unsigned)id, (unsigned)split);
+                }
+            }
+        }
+    }
+
+    printf("%s (%d failures)\n", failures ? "FAIL" : "PASS", failures);
+    return failures ? 1 : 0;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief CRC-8 poly 0x07, init 0, one bit at a time
+ */
+static uint8_t CrcTest_Crc8Bitwise(const uint8_t* data, uint32_t len)
+{
+    uint8_t crc = 0;
+
+    while (len-- > 0) {
+        crc ^= *data++;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief CRC-32 (reflected 0xEDB88320), init and final XOR 0xFFFFFFFF, one bit at a time
+ */
+static uint32_t CrcTest_Crc32Bitwise(const uint8_t* data, uint32_t len)
+{
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    while (len-- > 0) {
+        crc ^= *data++;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1UL) ? (crc >> 1) ^ 0xEDB88320UL : (crc >> 1);
+        }
+    }
+
+    return crc ^ 0xFFFFFFFFUL;
+}
+
+static void CrcTest_Expect(const char* what, uint32_t got, uint32_t expected)
+{
+    if (got != expected) {
+        printf("MISMATCH %s: 0x%08X, expected 0x%08X\n", what, (unsigned)got, (unsigned)expected);
+        failures++;
+    }
+}
@@ -0,0 +1,49 @@
+/**
+ * @file stm32h7xx_hal.h
+ * @brief Minimal HAL stand-in for host builds of hardware-free modules
+ *
+ * The sensor headers reach stm32h7xx_hal.h through sensor_types.h only
+ * for HAL_StatusTypeDef. Host tests of pure computation modules
+ * (tools/thermal) put this directory on the include path instead of the
+ * STM32Cube HAL; anything that needs a peripheral will not link.
+ *
+ * The flash declarations serve the test journal; its host test
+ * (tools/test/journal_test.c) implements them over memory mapped at the
+ * journal sectors' address.
+ */
+
+#ifndef STM32H7XX_HAL_H
+#define STM32H7XX_HAL_H
+
+#include <stdint.h>
+
+typedef enum {
+    HAL_OK       = 0x00U,
+    HAL_ERROR    = 0x01U,
+    HAL_BUSY     = 0x02U,
+    HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+/* Flash (stm32h723xx.h, stm32h7xx_hal_flash.h, stm32h7xx_hal_flash_ex.h) */
+#define FLASH_SECTOR_SIZE               0x00020000UL
+#define FLASH_NB_32BITWORD_IN_FLASHWORD 8U
+#define FLASH_TYPEPROGRAM_FLASHWORD     0x01U
+#define FLASH_TYPEERASE_SECTORS         0x00U
+#define FLASH_BANK_1                    0x01U
+#define FLASH_VOLTAGE_RANGE_3           0x20U
+
+typedef struct {
+    uint32_t TypeErase;
+    uint32_t Banks;
+    uint32_t Sector;
+    uint32_t NbSectors;
+    uint32_t VoltageRange;
+} FLASH_EraseInitTypeDef;
+
+uint32_t HAL_GetTick(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t FlashAddress, uint32_t DataAddress);
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef* pEraseInit, uint32_t* SectorError);
+
+#endif /* STM32H7XX_HAL_H */
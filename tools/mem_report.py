@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""
+Build-time memory report for the firmware ELF.
+
+Prints region usage from the linker symbols that src/app/mem_info.c also
+reads at run time, the largest RAM objects, and the deepest stack frames
+from the compiler's -fstack-usage (.su) files. Compare the static view
+with CMD_MEM_INFO's stack watermark on the target.
+
+Runs after every PlatformIO build (extra_scripts = post:tools/mem_report.py)
+or standalone:
+
+    python3 tools/mem_report.py .pio/build/stm32h723vg/firmware.elf
+"""
+
+import os
+import subprocess
+import sys
+from pathlib import Path
+
+TOP_OBJECTS = 12
+TOP_FRAMES = 12
+
+# (label, start symbol, end symbol, size symbol); DTCM ends at _end (heap and stack above)
+REGIONS = (
+    ("DTCM", "__dtcm_start", "_end", "__dtcm_size"),
+    ("AXI SRAM", "__axi_start", "__axi_end", "__axi_size"),
+    ("D3 SRAM", "__d3_start", "__d3_end", "__d3_size"),
+)
+
+RAM_TYPES = "bBdD"
+
+
+def read_symbols(nm: str, elf: Path, run_env=None):
+    """Return ({name: address}, [(size, type, name)]) from nm."""
+    out = subprocess.run([nm, "-S", "--size-sort", str(elf)], capture_output=True, text=True,
+                         check=True, env=run_env).stdout
+    sized = []
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 4:
+            sized.append((int(parts[1], 16), parts[2], parts[3]))
+
+    out = subprocess.run([nm, str(elf)], capture_output=True, text=True, check=True, env=run_env).stdout
+    addresses = {}
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 3:
+            addresses[parts[2]] = int(parts[0], 16)
+    return addresses, sized
+
+
+def stack_frames(build_dir: Path):
+    """Return [(bytes, qualifier, function)] from .su files under build_dir."""
+    frames = []
+    for su in build_dir.rglob("*.su"):
+        for line in su.read_text(errors="replace").splitlines():
+            parts = line.split("\t")
+            if len(parts) == 3 and parts[1].isdigit():
+                location = parts[0].rsplit(":", 1)[-1]
+                frames.append((int(parts[1]), parts[2], f"{location} ({su.stem})"))
+    return sorted(frames, reverse=True)
+
+
+def report(elf: Path, nm: str, run_env=None) -> None:
+    """Print the report for one ELF."""
+    sym, sized = read_symbols(nm, elf, run_env)
+
+    print("")
+    print("Memory report ({})".format(elf.name))
+    print("-" * 60)
+
+    dtcm_used = sym["_end"] - sym["__dtcm_start"]
+    for label, start, end, size in REGIONS:
+        used = sym[end] - sym[start]
+        total = sym[size]
+        print(f"{label:<10} {used:>8} / {total:>8} B  ({100.0 * used / total:5.1f}%)")
+
+    flash_used = sym["_sidata"] - sym["__flash_start"] + (sym["_edata"] - sym["_sdata"])
+    flash_size = sym["__flash_size"]
+    print(f"{'FLASH':<10} {flash_used:>8} / {flash_size:>8} B  ({100.0 * flash_used / flash_size:5.1f}%)")
+
+    data = sym["_edata"] - sym["_sdata"]
+    bss = sym["_ebss"] - sym["_sbss"]
+    print(f"DTCM: .data {data} B, .bss {bss} B, heap + stack room {sym['__dtcm_size'] - dtcm_used} B")
+
+    print("")
+    print(f"Largest RAM objects (top {TOP_OBJECTS}):")
+    ram = [s for s in sized if s[1] in RAM_TYPES]
+    for size, _, name in sorted(ram, reverse=True)[:TOP_OBJECTS]:
+        print(f"  {size:>8} B  {name}")
+
+    frames = stack_frames(elf.parent)
+    if frames:
+        print("")
+        print(f"Deepest stack frames (top {TOP_FRAMES}, -fstack-usage):")
+        for size, qualifier, name in frames[:TOP_FRAMES]:
+            print(f"  {size:>8} B  {name} [{qualifier}]")
+    print("")
+
+
+def _post_build(source, target, env):
+    elf = Path(env.subst("$BUILD_DIR")) / (env.subst("$PROGNAME") + ".elf")
+    cc = env.subst("$CC")
+    nm = os.path.join(os.path.dirname(cc), os.path.basename(cc).replace("gcc", "nm"))
+    try:
+        report(elf, nm, dict(env["ENV"]))
+    except (OSError, subprocess.CalledProcessError, KeyError) as e:
+        print(f"Memory report skipped: {e}")
+
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", _post_build)  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        if len(sys.argv) != 2:
+            sys.exit(__doc__)
+        report(Path(sys.argv[1]), os.environ.get("NM", "arm-none-eabi-nm"))
@@ -0,0 +1,283 @@
+/**
+ * @file bad_pixel_test.c
+ * @brief Host test of the MLX90640 bad-pixel correction table
+ *
+ * Marks broken and outlier pixels in a synthetic EEPROM (frame_synth.c),
+ * extracts the parameters and builds the correction table for both
+ * readout modes. Every entry must use only good neighbours measured in
+ * the bad pixel's own subpage, and correcting one subpage must touch no
+ * other pixel. On a temperature field linear in row and column the
+ * correction is exact wherever the neighbour set is symmetric (interior
+ * chess pixels, interleaved pixels with both row neighbours or edge
+ * extrapolation) and within one pixel step elsewhere. Adjacent bad pixels
+ * and more than MLX90640_MAX_BAD_PIXELS must be rejected by
+ * MLX90640_ExtractParameters.
+ *
+ * Build and run (from the repository root; exits 1 on a mismatch):
+ *   gcc -O2 -Iinclude -Ilib/MLX90640_API \
+ *       tools/mlx90640_calib/bad_pixel_test.c tools/mlx90640_calib/frame_synth.c \
+ *       lib/MLX90640_API/MLX90640_API.c -lm -o bad_pixel_test && ./bad_pixel_test
+ */
+
+#include "MLX90640_API.h"
+#include "MLX90640_I2C_Driver.h"
+#include "frame_synth.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define BAD_TEST_EE_SEED    0x061BAD01u
+#define BAD_TEST_FIELDS     50          /* Random linear fields per set and mode */
+#define BAD_TEST_EXACT      0.001f      /* °C, float rounding of an exact fit */
+#define BAD_TEST_GARBAGE    -273.0f     /* Value a bad pixel holds before correction */
+#define BAD_TEST_NONE       0xFFFF
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+typedef struct {
+    const char* name;
+    uint16_t broken[MLX90640_MAX_BAD_PIXELS];
+    uint16_t outlier[MLX90640_MAX_BAD_PIXELS];
+} BadTest_Set_t;
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static const BadTest_Set_t sets[] = {
+    { "interior", { 5 * 32 + 10, BAD_TEST_NONE, BAD_TEST_NONE, BAD_TEST_NONE },
+                  { 12 * 32 + 20, 20 * 32 + 3, BAD_TEST_NONE, BAD_TEST_NONE } },
+    { "corners and edges", { 0, 3 * 32 + 31, BAD_TEST_NONE, BAD_TEST_NONE },
+                           { 23 * 32, 20 * 32 + 31, BAD_TEST_NONE, BAD_TEST_NONE } },
+    { "edge next to a bad pixel", { 4 * 32, BAD_TEST_NONE, BAD_TEST_NONE, BAD_TEST_NONE },
+                                  { 4 * 32 + 2, 10 * 32 + 31, 10 * 32 + 29, BAD_TEST_NONE } },
+    { "none", { BAD_TEST_NONE, BAD_TEST_NONE, BAD_TEST_NONE, BAD_TEST_NONE },
+              { BAD_TEST_NONE, BAD_TEST_NONE, BAD_TEST_NONE, BAD_TEST_NONE } },
+};
+
+/* Sets ExtractParameters must reject */
+static const BadTest_Set_t rejected[] = {
+    { "row neighbours", { 100, 101, BAD_TEST_NONE, BAD_TEST_NONE },
+                        { BAD_TEST_NONE, BAD_TEST_NONE, BAD_TEST_NONE, BAD_TEST_NONE } },
+    { "column neighbours", { 100, BAD_TEST_NONE, BAD_TEST_NONE, BAD_TEST_NONE },
+                           { 132, BAD_TEST_NONE, BAD_TEST_NONE, BAD_TEST_NONE } },
+    { "diagonal neighbours", { BAD_TEST_NONE, BAD_TEST_NONE, BAD_TEST_NONE, BAD_TEST_NONE },
+                             { 100, 133, BAD_TEST_NONE, BAD_TEST_NONE } },
+    { "too many", { 10, 200, 400, BAD_TEST_NONE },
+                  { 300, 600, BAD_TEST_NONE, BAD_TEST_NONE } },
+};
+
+static uint16_t ee[FRAME_SYNTH_EE_WORDS];
+static paramsMLX90640 params;
+static MLX90640_BadPixelFix_t table[MLX90640_MAX_BAD_PIXELS];
+static float to[FRAME_SYNTH_PIXELS];
+static float before[FRAME_SYNTH_PIXELS];
+static uint32_t rng_state = 61;
+static int failures = 0;
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static uint32_t BadTest_Random(void);
+static int BadTest_Extract(const BadTest_Set_t* set);
+static int BadTest_IsBad(const BadTest_Set_t* set, int pixel);
+static int BadTest_SubPage(int pixel, int mode);
+static void BadTest_Table(const BadTest_Set_t* set, int mode, int count);
+static void BadTest_Correct(const BadTest_Set_t* set, int mode, int count);
+static void BadTest_Fail(const char* set, int mode, const char* what, int pixel);
+
+/*============================================================================*/
+/* I2C Stubs (the test never talks to a sensor)                               */
+/*============================================================================*/
+
+int MLX90640_I2CRead(uint8_t slaveAddr, uint16_t startAddress, uint16_t nMemAddressRead, uint16_t* data)
+{
+    (void)slaveAddr; (void)startAddress; (void)nMemAddressRead; (void)data;
+    return -1;
+}
+
+int MLX90640_I2CWrite(uint8_t slaveAddr, uint16_t writeAddress, uint16_t data)
+{
+    (void)slaveAddr; (void)writeAddress; (void)data;
+    return -1;
+}
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+int main(void)
+{
+    for (size_t s = 0; s < sizeof(sets) / sizeof(sets[0]); s++) {
+        if (BadTest_Extract(&sets[s]) != MLX90640_NO_ERROR) {
+            BadTest_Fail(sets[s].name, -1, "ExtractParameters failed", -1);
+            continue;
+        }
+
+        int expected = 0;
+        for (int i = 0; i < FRAME_SYNTH_PIXELS; i++) {
+            expected += BadTest_IsBad(&sets[s], i);
+        }
+
+        for (int mode = 0; mode <= 1; mode++) {
+            int count = MLX90640_BuildBadPixelTable(&params, mode, table);
+            if (count != expected) {
+                BadTest_Fail(sets[s].name, mode, "table size", count);
+                continue;
+            }
+            BadTest_Table(&sets[s], mode, count);
+            BadTest_Correct(&sets[s], mode, count);
+        }
+    }
+
+    for (size_t s = 0; s < sizeof(rejected) / sizeof(rejected[0]); s++) {
+        if (BadTest_Extract(&rejected[s]) == MLX90640_NO_ERROR) {
+            BadTest_Fail(rejected[s].name, -1, "accepted", -1);
+        }
+    }
+
+    printf("%s (%d failures)\n", failures ? "FAIL" : "PASS", failures);
+    return failures ? 1 : 0;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+static uint32_t BadTest_Random(void)
+{
+    rng_state = rng_state * 1664525UL + 1013904223UL;
+    return rng_state >> 8;
+}
+
+/**
+ * @brief Mark a set in a fresh EEPROM image and extract it
+ */
+static int BadTest_Extract(const BadTest_Set_t* set)
+{
+    FrameSynth_MakeEEPROM(ee, BAD_TEST_EE_SEED);
+    for (int i = 0; i < MLX90640_MAX_BAD_PIXELS; i++) {
+        if (set->broken[i] != BAD_TEST_NONE) {
+            ee[64 + set->broken[i]] = 0;
+        }
+        if (set->outlier[i] != BAD_TEST_NONE) {
+            ee[64 + set->outlier[i]] |= 0x0001;
+        }
+    }
+    return MLX90640_ExtractParameters(ee, &params);
+}
+
+static int BadTest_IsBad(const BadTest_Set_t* set, int pixel)
+{
+    for (int i = 0; i < MLX90640_MAX_BAD_PIXELS; i++) {
+        if (set->broken[i] == pixel || set->outlier[i] == pixel) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Subpage a pixel is measured in (chess: checkerboard, interleaved: row parity)
+ */
+static int BadTest_SubPage(int pixel, int mode)
+{
+    int row = pixel / 32;
+    int col = pixel % 32;
+    return (mode == 1) ? ((row ^ col) & 1) : (row & 1);
+}
+
+/**
+ * @brief Every entry is a bad pixel fixed from good same-subpage neighbours
+ */
+static void BadTest_Table(const BadTest_Set_t* set, int mode, int count)
+{
+    for (int i = 0; i < count; i++) {
+        const MLX90640_BadPixelFix_t* fix = &table[i];
+        float weights = 0.0f;
+
+        if (!BadTest_IsBad(set, fix->pixel)) {
+            BadTest_Fail(set->name, mode, "entry for a good pixel", fix->pixel);
+        }
+        if (fix->subPage != BadTest_SubPage(fix->pixel, mode)) {
+            BadTest_Fail(set->name, mode, "entry subpage", fix->pixel);
+        }
+        if (fix->count == 0 || fix->count > 4) {
+            BadTest_Fail(set->name, mode, "neighbour count", fix->pixel);
+            continue;
+        }
+
+        for (int k = 0; k < fix->count; k++) {
+            int n = fix->neighbour[k];
+            if (n >= FRAME_SYNTH_PIXELS || BadTest_IsBad(set, n)) {
+                BadTest_Fail(set->name, mode, "bad neighbour", fix->pixel);
+            } else if (BadTest_SubPage(n, mode) != fix->subPage) {
+                BadTest_Fail(set->name, mode, "neighbour from the other subpage", fix->pixel);
+            } else if (abs(n / 32 - fix->pixel / 32) > 1 || abs(n % 32 - fix->pixel % 32) > 2) {
+                BadTest_Fail(set->name, mode, "distant neighbour", fix->pixel);
+            }
+            weights += fix->weight[k];
+        }
+        if (fabsf(weights - 1.0f) > 1e-6f) {
+            BadTest_Fail(set->name, mode, "weights do not sum to 1", fix->pixel);
+        }
+    }
+}
+
+/**
+ * @brief Correct random linear fields one subpage at a time
+ */
+static void BadTest_Correct(const BadTest_Set_t* set, int mode, int count)
+{
+    for (int f = 0; f < BAD_TEST_FIELDS; f++) {
+        float base = 20.0f + (float)(BadTest_Random() % 2000) * 0.01f;
+        float row_step = -1.0f + (float)(BadTest_Random() % 200) * 0.01f;
+        float col_step = -1.0f + (float)(BadTest_Random() % 200) * 0.01f;
+
+        for (int i = 0; i < FRAME_SYNTH_PIXELS; i++) {
+            to[i] = BadTest_IsBad(set, i) ? BAD_TEST_GARBAGE : base + row_step * (i / 32) + col_step * (i % 32);
+        }
+
+        for (int subpage = 0; subpage <= 1; subpage++) {
+            memcpy(before, to, sizeof(to));
+            MLX90640_BadPixelsCorrection(table, count, subpage, to);
+
+            for (int i = 0; i < FRAME_SYNTH_PIXELS; i++) {
+                int fixed = BadTest_IsBad(set, i) && BadTest_SubPage(i, mode) == subpage;
+                if (!fixed && to[i] != before[i]) {
+                    BadTest_Fail(set->name, mode, "pixel outside the subpage's bad pixels changed", i);
+                }
+            }
+        }
+
+        for (int i = 0; i < count; i++) {
+            const MLX90640_BadPixelFix_t* fix = &table[i];
+            int row = fix->pixel / 32;
+            int col = fix->pixel % 32;
+            float truth = base + row_step * row + col_step * col;
+            float error = fabsf(to[fix->pixel] - truth);
+
+            /* Symmetric or extrapolated fits reproduce a linear field */
+            int exact = (mode == 1) ? (fix->count == 4) : (fix->count == 2);
+            float limit = exact ? BAD_TEST_EXACT : fabsf(row_step) + fabsf(col_step) + BAD_TEST_EXACT;
+            if (error > limit) {
+                BadTest_Fail(set->name, mode, exact ? "inexact fit" : "fit beyond one pixel step", fix->pixel);
+            }
+        }
+    }
+}
+
+static void BadTest_Fail(const char* set, int mode, const char* what, int pixel)
+{
+    if (failures++ < 10) {
+        printf("MISMATCH %s mode %d: %s (%d)\n", set, mode, what, pixel);
+    }
+}
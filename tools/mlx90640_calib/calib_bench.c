@@ -0,0 +1,210 @@
+/**
+ * @file calib_bench.c
+ * @brief Host benchmark of the MLX90640 calibration storage modes
+ *
+ * Extracts a synthetic EEPROM image, synthesizes raw frames of a run of
+ * temperature scenes (frame_synth.c) and prints the calibration size per
+ * sensor, the time per frame, the largest difference between computed
+ * and scene temperature, and a hash of every temperature and every
+ * pixel's compensated signal (which depend on the per-pixel calibration
+ * directly). Build once per mode; both builds must print the same hash
+ * (packed decoding reproduces the expanded tables exactly).
+ *
+ * Build and run (from the repository root):
+ *   for m in 0 1; do
+ *     gcc -O2 -DMLX90640_PACKED_CALIBRATION=$m -Iinclude -Ilib/MLX90640_API \
+ *         tools/mlx90640_calib/calib_bench.c tools/mlx90640_calib/frame_synth.c \
+ *         lib/MLX90640_API/MLX90640_API.c \
+ *         -lm -o calib_bench_$m && ./calib_bench_$m
+ *   done
+ *
+ * Host time only ranks the modes; on the target the decode is a few
+ * integer operations and one float division per pixel next to the float
+ * To equation.
+ */
+
+#include "MLX90640_API.h"
+#include "MLX90640_I2C_Driver.h"
+#include "frame_synth.h"
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define BENCH_FRAMES        16      /* Distinct synthetic frames (two subpages each) */
+#define BENCH_PASSES        200     /* Timed passes over all frames */
+#define BENCH_EMISSIVITY    0.95f
+#define BENCH_TR            22.0f
+#define BENCH_EE_SEED       0x2400A5C3u
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static uint32_t rng_state = 0x5C3E0D17u;
+
+static uint16_t ee[832];
+static paramsMLX90640 params;
+static float scenes[BENCH_FRAMES][768];
+static uint16_t frames[BENCH_FRAMES][2][834];
+static float to[BENCH_FRAMES][768];
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static uint32_t Bench_Rand(void);
+static void Bench_MakeScene(float* scene);
+static double Bench_Now(void);
+static uint32_t Bench_Hash(uint32_t hash, const void* data, size_t len);
+
+/*============================================================================*/
+/* I2C Stubs (the benchmark never talks to a sensor)                          */
+/*============================================================================*/
+
+int MLX90640_I2CRead(uint8_t slaveAddr, uint16_t startAddress, uint16_t nMemAddressRead, uint16_t* data)
+{
+    (void)slaveAddr; (void)startAddress; (void)nMemAddressRead; (void)data;
+    return -1;
+}
+
+int MLX90640_I2CWrite(uint8_t slaveAddr, uint16_t writeAddress, uint16_t data)
+{
+    (void)slaveAddr; (void)writeAddress; (void)data;
+    return -1;
+}
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+int main(void)
+{
+    FrameSynth_MakeEEPROM(ee, BENCH_EE_SEED);
+    if (MLX90640_ExtractParameters(ee, &params) != MLX90640_NO_ERROR) {
+        fprintf(stderr, "ExtractParameters failed\n");
+        return 1;
+    }
+
+    FrameSynth_Conditions_t cond;
+    FrameSynth_DefaultConditions(&cond);
+    cond.emissivity = BENCH_EMISSIVITY;
+    cond.tr = BENCH_TR;
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        cond.ta = 20.0f + f;                    /* Warming die, drifting supply */
+        cond.vdd = 3.25f + 0.01f * (f % 8);
+        Bench_MakeScene(scenes[f]);
+        if (FrameSynth_Frame(&params, &cond, scenes[f], frames[f]) != 0) {
+            fprintf(stderr, "FrameSynth_Frame failed or clipped\n");
+            return 1;
+        }
+    }
+
+    /* Warm up and fill the result frames */
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        MLX90640_CalculateTo(frames[f][0], &params, BENCH_EMISSIVITY, BENCH_TR, to[f]);
+        MLX90640_CalculateTo(frames[f][1], &params, BENCH_EMISSIVITY, BENCH_TR, to[f]);
+    }
+
+    double start = Bench_Now();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (int f = 0; f < BENCH_FRAMES; f++) {
+            MLX90640_CalculateTo(frames[f][0], &params, BENCH_EMISSIVITY, BENCH_TR, to[f]);
+            MLX90640_CalculateTo(frames[f][1], &params, BENCH_EMISSIVITY, BENCH_TR, to[f]);
+        }
+    }
+    double elapsed = Bench_Now() - start;
+
+    /* Round trip: only the pixel word rounding separates to from the scene */
+    float max_error = 0.0f;
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        for (int p = 0; p < 768; p++) {
+            if (to[f][p] != 0.0f && fabsf(to[f][p] - scenes[f][p]) > max_error) {
+                max_error = fabsf(to[f][p] - scenes[f][p]);
+            }
+        }
+    }
+
+    /* Identical temperatures and signals, identical hash */
+    uint32_t hash = Bench_Hash(2166136261u, to, sizeof(to));
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        for (int sp = 0; sp < 2; sp++) {
+            MLX90640_FrameTerms_t terms;
+            MLX90640_GetFrameTerms(frames[f][sp], &params, BENCH_EMISSIVITY, BENCH_TR, &terms);
+            for (int p = 0; p < 768; p++) {
+                float signal[2] = { 0.0f, 0.0f };
+                if (MLX90640_GetPixelSignal(frames[f][sp], &params, &terms, p, &signal[0], &signal[1]) > 0) {
+                    hash = Bench_Hash(hash, signal, sizeof(signal));
+                }
+            }
+        }
+    }
+
+    printf("mode        %s\n", MLX90640_PACKED_CALIBRATION ? "packed" : "expanded");
+    printf("calibration %u B per sensor (paramsMLX90640)\n", (unsigned)sizeof(paramsMLX90640));
+    printf("frame       %.1f us (32x24, both subpages)\n",
+           elapsed * 1e6 / (BENCH_PASSES * BENCH_FRAMES));
+    printf("to[0][400]  %.4f C (scene %.4f C)\n", to[0][400], scenes[0][400]);
+    printf("round trip  %.4f C max |to - scene|\n", max_error);
+    printf("hash        %08x\n", (unsigned)hash);
+    return 0;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief xorshift32
+ */
+static uint32_t Bench_Rand(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+/**
+ * @brief Scene: 15-45°C background with one 60-160°C hot spot
+ */
+static void Bench_MakeScene(float* scene)
+{
+    int hot_row = (int)(Bench_Rand() % 20);
+    int hot_col = (int)(Bench_Rand() % 28);
+    float hot = 60.0f + (float)(Bench_Rand() % 100);
+
+    for (int p = 0; p < 768; p++) {
+        int row = p / 32;
+        int col = p % 32;
+        scene[p] = 15.0f + (float)(Bench_Rand() % 3000) * 0.01f;
+        if (row >= hot_row && row < hot_row + 4 && col >= hot_col && col < hot_col + 4) {
+            scene[p] = hot;
+        }
+    }
+}
+
+/**
+ * @brief Monotonic time in seconds
+ */
+static double Bench_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief FNV-1a over raw bytes (float bit patterns)
+ */
+static uint32_t Bench_Hash(uint32_t hash, const void* data, size_t len)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
@@ -0,0 +1,327 @@
+/**
+ * @file frame_synth.c
+ * @brief Host synthesis of MLX90640 raw frames implementation
+ *
+ * Each raw word enters the forward model linearly once the words before
+ * it are fixed, so rather than restating the calibration equations the
+ * solver asks the API itself: it writes the word as 0, reads the term the
+ * API computes, and solves the straight line for the value that gives the
+ * target. That keeps the inverse exact for both calibration storage modes
+ * and for every mode/calibration-mode combination (interleaved/chess
+ * corrections, CP offset in the other mode) without duplicating them.
+ * Only Vdd and Ta, which sit before any of that, are inverted in closed
+ * form, and the final To equation, whose range selection depends on its
+ * own first-pass estimate, by a short fixed-point iteration
+ * (Synth_TemperatureToSignal).
+ */
+
+#include "frame_synth.h"
+#include <math.h>
+#include <stddef.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+/* Frame word addresses */
+#define SYNTH_VBE               768     /* PTAT artificial (Vbe) */
+#define SYNTH_CP_SP0            776
+#define SYNTH_GAIN              778
+#define SYNTH_PTAT              800
+#define SYNTH_CP_SP1            808
+#define SYNTH_VDD               810
+#define SYNTH_CONTROL           832
+#define SYNTH_STATUS            833
+
+#define SYNTH_VPTAT             1711    /* Typical PTAT word; Vbe is solved against it */
+#define SYNTH_CONTROL_SUBPAGES  0x0001  /* Subpage mode enabled */
+
+#define SYNTH_TO_MAX_PASSES     8       /* Synth_TemperatureToSignal iteration limit */
+#define SYNTH_TO_EPSILON        1e-5f   /* Converged when the estimate moves less (K) */
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static uint32_t Synth_Rand(uint32_t* state);
+static uint16_t Synth_Nibbles(uint32_t* state);
+static int Synth_Round(float value, int16_t* word);
+static int Synth_WriteSupply(const paramsMLX90640* params, const FrameSynth_Conditions_t* cond,
+                             uint16_t* frameData);
+static float Synth_TemperatureToSignal(const paramsMLX90640* params, const MLX90640_FrameTerms_t* terms,
+                                       float to);
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+void FrameSynth_MakeEEPROM(uint16_t* ee, uint32_t seed)
+{
+    uint32_t state = seed;
+
+    for (int i = 0; i < FRAME_SYNTH_EE_WORDS; i++) {
+        ee[i] = 0;
+    }
+
+    ee[10] = 0x0800;                        /* Calibrated in chess mode */
+    ee[16] = 0x4221;                        /* alphaPTAT, occ row/column/remnant scales */
+    ee[17] = 0xFFB0;                        /* offsetRef = -80 */
+    for (int i = 18; i < 32; i++) ee[i] = Synth_Nibbles(&state);
+    ee[32] = 0x4442;                        /* alphaScale, acc row/column/remnant scales */
+    ee[33] = 0x2F00;                        /* alphaRef */
+    for (int i = 34; i < 48; i++) ee[i] = Synth_Nibbles(&state);
+    ee[48] = 0x1900;                        /* gainEE */
+    ee[49] = 0x2FF1;                        /* vPTAT25 */
+    ee[50] = 0x5952;                        /* KvPTAT / KtPTAT */
+    ee[51] = 0x9D68;                        /* kVdd / vdd25 */
+    ee[52] = 0x2132;                        /* Kv row/column groups */
+    ee[53] = 0x2A69;                        /* Interleaved/chess corrections */
+    ee[54] = 0x4E52;                        /* Kta row/column groups */
+    ee[55] = 0x5049;
+    ee[56] = 0x2453;                        /* resolutionEE, kvScale, ktaScale1, ktaScale2 */
+    ee[57] = 0x0320;                        /* CP alpha */
+    ee[58] = 0x07C0;                        /* CP offset */
+    ee[59] = 0x2050;                        /* CP Kv / Kta */
+    ee[60] = 0x7D18;                        /* KsTa / tgc */
+    ee[61] = 0x9797;                        /* KsTo */
+    ee[62] = 0x9797;
+    ee[63] = 0x2889;                        /* Corner temperatures */
+
+    for (int p = 0; p < FRAME_SYNTH_PIXELS; p++) {
+        uint16_t offset = (uint16_t)(Synth_Rand(&state) % 48);
+        uint16_t alpha = (uint16_t)(Synth_Rand(&state) % 24);
+        uint16_t kta = (uint16_t)(Synth_Rand(&state) % 8);
+        ee[64 + p] = (uint16_t)((offset << 10) | (alpha << 4) | (kta << 1) | 0x8000);
+    }
+}
+
+void FrameSynth_DefaultConditions(FrameSynth_Conditions_t* cond)
+{
+    if (cond == NULL) {
+        return;
+    }
+
+    cond->ta = 25.0f;
+    cond->vdd = 3.3f;
+    cond->mode = 1;
+    cond->resolution = 2;
+    cond->refreshRate = 2;
+    cond->gainRatio = 1.0f;
+    cond->emissivity = MLX90640_EMISSIVITY;
+    cond->tr = cond->ta - MLX90640_TR_OFFSET;
+}
+
+int FrameSynth_Subpage(const paramsMLX90640* params, const FrameSynth_Conditions_t* cond,
+                       const float* to, int subPage, uint16_t* frameData)
+{
+    MLX90640_FrameTerms_t terms;
+    int16_t word;
+    int clipped = 0;
+
+    if (params == NULL || cond == NULL || to == NULL || frameData == NULL ||
+        subPage < 0 || subPage > 1 || cond->mode > 1 || cond->resolution > 3 ||
+        cond->refreshRate > 7 || !(cond->emissivity > 0.0f)) {
+        return FRAME_SYNTH_ERROR;
+    }
+
+    frameData[SYNTH_CONTROL] = (uint16_t)((cond->mode << 12) | (cond->resolution << 10) |
+                                          (cond->refreshRate << 7) | SYNTH_CONTROL_SUBPAGES);
+    frameData[SYNTH_STATUS] = (uint16_t)subPage;
+
+    if (Synth_WriteSupply(params, cond, frameData) != 0) {
+        return FRAME_SYNTH_ERROR;
+    }
+
+    /* Gain: terms.gain = gainEE / word */
+    float ratio = (cond->gainRatio > 0.0f) ? cond->gainRatio : 1.0f;
+    if (Synth_Round(params->gainEE * ratio, &word) != 0 || word == 0) {
+        return FRAME_SYNTH_ERROR;
+    }
+    frameData[SYNTH_GAIN] = (uint16_t)word;
+
+    /* CP pixels see the package at Ta: compensated CP signal 0 */
+    frameData[SYNTH_CP_SP0] = 0;
+    frameData[SYNTH_CP_SP1] = 0;
+    MLX90640_GetFrameTerms(frameData, params, cond->emissivity, cond->tr, &terms);
+    if (Synth_Round(-terms.irDataCP[0] / terms.gain, &word) != 0) {
+        return FRAME_SYNTH_ERROR;
+    }
+    frameData[SYNTH_CP_SP0] = (uint16_t)word;
+    if (Synth_Round(-terms.irDataCP[1] / terms.gain, &word) != 0) {
+        return FRAME_SYNTH_ERROR;
+    }
+    frameData[SYNTH_CP_SP1] = (uint16_t)word;
+    MLX90640_GetFrameTerms(frameData, params, cond->emissivity, cond->tr, &terms);
+
+    /* Pixels: irData = irData(word 0) + word * gain / emissivity */
+    for (int p = 0; p < FRAME_SYNTH_PIXELS; p++) {
+        float irData;
+        float alphaCompensated;
+        uint16_t previous = frameData[p];
+
+        frameData[p] = 0;
+        int signal = MLX90640_GetPixelSignal(frameData, params, &terms, p, &irData, &alphaCompensated);
+        if (signal == 0) {
+            frameData[p] = previous;    /* Other subpage keeps its last reading */
+            continue;
+        }
+        if (signal < 0) {
+            continue;                   /* Broken pixel reads 0 */
+        }
+
+        float target = Synth_TemperatureToSignal(params, &terms, to[p]) * alphaCompensated;
+        float value = (target - irData) * cond->emissivity / terms.gain;
+        if (Synth_Round(value, &word) != 0) {
+            word = (value > 0.0f) ? INT16_MAX : INT16_MIN;
+            clipped++;
+        }
+        frameData[p] = (uint16_t)word;
+    }
+
+    return clipped;
+}
+
+int FrameSynth_Frame(const paramsMLX90640* params, const FrameSynth_Conditions_t* cond,
+                     const float* to, uint16_t frames[2][FRAME_SYNTH_WORDS])
+{
+    if (frames == NULL) {
+        return FRAME_SYNTH_ERROR;
+    }
+
+    for (int i = 0; i < FRAME_SYNTH_WORDS; i++) {
+        frames[0][i] = 0;
+    }
+
+    int clipped0 = FrameSynth_Subpage(params, cond, to, 0, frames[0]);
+    if (clipped0 < 0) {
+        return clipped0;
+    }
+
+    for (int i = 0; i < FRAME_SYNTH_WORDS; i++) {
+        frames[1][i] = frames[0][i];
+    }
+
+    int clipped1 = FrameSynth_Subpage(params, cond, to, 1, frames[1]);
+    if (clipped1 < 0) {
+        return clipped1;
+    }
+
+    return clipped0 + clipped1;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief xorshift32
+ */
+static uint32_t Synth_Rand(uint32_t* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/**
+ * @brief Four small signed nibbles (-3..3), as in the row/column tables
+ */
+static uint16_t Synth_Nibbles(uint32_t* state)
+{
+    uint16_t word = 0;
+    for (int i = 0; i < 4; i++) {
+        word |= (uint16_t)(((int)(Synth_Rand(state) % 7) - 3) & 0x0F) << (4 * i);
+    }
+    return word;
+}
+
+/**
+ * @brief Round to the nearest int16 word
+ * @return 0 on success, -1 if value is out of range (word untouched)
+ */
+static int Synth_Round(float value, int16_t* word)
+{
+    float rounded = roundf(value);
+    if (!(rounded >= INT16_MIN && rounded <= INT16_MAX)) {
+        return -1;
+    }
+
+    *word = (int16_t)rounded;
+    return 0;
+}
+
+/**
+ * @brief Write the Vdd, PTAT and Vbe words for cond->vdd and cond->ta
+ *
+ * Inverts MLX90640_GetVdd, then MLX90640_GetTa at the Vdd the written
+ * word actually decodes to.
+ *
+ * @return 0 on success, -1 if a word is out of range
+ */
+static int Synth_WriteSupply(const paramsMLX90640* params, const FrameSynth_Conditions_t* cond,
+                             uint16_t* frameData)
+{
+    int16_t word;
+
+    /* Vdd = (word * 2^resolutionEE / 2^resolution - vdd25) / kVdd + 3.3 */
+    float vddWord = ((cond->vdd - 3.3f) * params->kVdd + params->vdd25) *
+                    ldexpf(1.0f, cond->resolution - params->resolutionEE);
+    if (Synth_Round(vddWord, &word) != 0) {
+        return -1;
+    }
+    frameData[SYNTH_VDD] = (uint16_t)word;
+    float vdd = MLX90640_GetVdd(frameData, params);
+
+    /* ptatArt = PTAT / (PTAT * alphaPTAT + Vbe) * 2^18 */
+    float ptatArt = ((cond->ta - 25.0f) * params->KtPTAT + params->vPTAT25) *
+                    (1.0f + params->KvPTAT * (vdd - 3.3f));
+    if (!(ptatArt > 0.0f)) {
+        return -1;
+    }
+    float vbe = SYNTH_VPTAT * ldexpf(1.0f, 18) / ptatArt - SYNTH_VPTAT * params->alphaPTAT;
+    if (Synth_Round(vbe, &word) != 0 || word <= 0) {
+        return -1;
+    }
+    frameData[SYNTH_PTAT] = SYNTH_VPTAT;
+    frameData[SYNTH_VBE] = (uint16_t)word;
+
+    return 0;
+}
+
+/**
+ * @brief Invert MLX90640_SignalToTemperature for one frame
+ *
+ * Returns the normalized signal s such that a pixel with
+ * irData == s * alphaCompensated reads to. The final To takes its range
+ * and sensitivity correction from the first-pass estimate, so solve for
+ * that estimate by fixed-point iteration starting from to; the error
+ * shrinks about tenfold per pass at the top of the range.
+ */
+static float Synth_TemperatureToSignal(const paramsMLX90640* params, const MLX90640_FrameTerms_t* terms,
+                                       float to)
+{
+    float tk4 = (to + 273.15f) * (to + 273.15f);
+    tk4 = tk4 * tk4 - terms->taTr;
+
+    float estimate = to;
+    float signal = 0.0f;
+    for (int pass = 0; pass < SYNTH_TO_MAX_PASSES; pass++) {
+        /* Range selection as in the API (GetToRange) */
+        int range = 0;
+        while (range < 4 && estimate >= params->ct[range + 1]) {
+            range++;
+        }
+        signal = tk4 * terms->alphaCorrR[range] * (1 + params->ksTo[range] * (estimate - params->ct[range]));
+
+        /* First-pass estimate of this signal, with alphaCompensated factored out */
+        float next = sqrtf(sqrtf(signal + terms->taTr)) * params->ksTo[1];
+        next = sqrtf(sqrtf(signal / ((1 - params->ksTo[1] * 273.15f) + next) + terms->taTr)) - 273.15f;
+        if (fabsf(next - estimate) < SYNTH_TO_EPSILON) {
+            break;
+        }
+        estimate = next;
+    }
+
+    return signal;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file frame_synth.h
+ * @brief Host synthesis of MLX90640 raw frames from a temperature scene
+ *
+ * Inverts the MLX90640_API equations for one set of calibration
+ * parameters: given ambient temperature, Vdd, readout mode, ADC
+ * resolution and a per-pixel object temperature map, it writes the raw
+ * RAM words (pixels, PTAT, Vbe, gain, both CP pixels) and the control and
+ * status words that MLX90640_CalculateTo turns back into that scene.
+ *
+ * Every analog word is quantized in the order the forward model reads it
+ * (Vdd, then Ta, then gain and CP, then pixels), and each later stage is
+ * solved against the values the API recovers from the already written
+ * words. The only error left is the rounding of each pixel word, a few
+ * hundredths of a degree near room temperature.
+ *
+ * Host only: links against lib/MLX90640_API and needs no sensor.
+ */
+
+#ifndef FRAME_SYNTH_H
+#define FRAME_SYNTH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "MLX90640_API.h"
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define FRAME_SYNTH_PIXELS      768
+#define FRAME_SYNTH_WORDS       834     /* 832 RAM words + control + status */
+#define FRAME_SYNTH_EE_WORDS    832     /* EEPROM image */
+
+#define FRAME_SYNTH_ERROR       -4      /* Conditions outside what the words can encode */
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Operating point of the simulated sensor
+ */
+typedef struct {
+    float ta;               /* Ambient (die) temperature, °C */
+    float vdd;              /* Supply voltage, V */
+    uint8_t mode;           /* 0: interleaved, 1: chess */
+    uint8_t resolution;     /* ADC resolution setting 0-3 (16-19 bit) */
+    uint8_t refreshRate;    /* Refresh rate setting 0-7 (control word only) */
+    float gainRatio;        /* Gain word / gainEE (gain drift), 0 for nominal */
+    float emissivity;       /* Emissivity the consumer will use */
+    float tr;               /* Reflected temperature the consumer will use, °C */
+} FrameSynth_Conditions_t;
+
+/*============================================================================*/
+/* Functions                                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Synthetic EEPROM image
+ *
+ * Typical scales and corrections (chess calibration) with random
+ * per-pixel offset, alpha and Kta fields and random row/column tables.
+ * The same seed gives the same image.
+ *
+ * @param ee EEPROM image (832 words, output)
+ * @param seed Random seed (non-zero)
+ */
+void FrameSynth_MakeEEPROM(uint16_t* ee, uint32_t seed);
+
+/**
+ * @brief Fill conditions with a typical operating point
+ *
+ * 25°C ambient, 3.3 V, chess mode, 18-bit, 2 Hz, nominal gain,
+ * emissivity 0.95 and reflected temperature 8°C below ambient (as the
+ * firmware assumes).
+ *
+ * @param cond Conditions (output)
+ */
+void FrameSynth_DefaultConditions(FrameSynth_Conditions_t* cond);
+
+/**
+ * @brief Synthesize one subpage
+ *
+ * Writes the frame's auxiliary, control and status words and every pixel
+ * measured in subPage under cond->mode. Pixels of the other subpage are
+ * left as they are, like the sensor RAM keeps the previous subpage, so
+ * calling this alternately on one buffer reproduces a live stream.
+ * Broken pixels (alpha 0) get raw 0.
+ *
+ * @param params Calibration parameters (MLX90640_ExtractParameters)
+ * @param cond Operating point
+ * @param to Object temperature per pixel, °C (768)
+ * @param subPage Subpage to measure (0/1)
+ * @param frameData Frame (834 words, input/output)
+ * @return Pixels clipped to the int16 range (>= 0), FRAME_SYNTH_ERROR if
+ *         Vdd, Ta or the gain cannot be encoded
+ */
+int FrameSynth_Subpage(const paramsMLX90640* params, const FrameSynth_Conditions_t* cond,
+                       const float* to, int subPage, uint16_t* frameData);
+
+/**
+ * @brief Synthesize both subpages of one scene
+ *
+ * frames[0] is subpage 0 over a zeroed RAM image, frames[1] is subpage 1
+ * over frames[0], as two consecutive sensor reads.
+ *
+ * @param params Calibration parameters
+ * @param cond Operating point
+ * @param to Object temperature per pixel, °C (768)
+ * @param frames Frames (output)
+ * @return Pixels clipped in both subpages (>= 0), FRAME_SYNTH_ERROR on error
+ */
+int FrameSynth_Frame(const paramsMLX90640* params, const FrameSynth_Conditions_t* cond,
+                     const float* to, uint16_t frames[2][FRAME_SYNTH_WORDS]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FRAME_SYNTH_H */
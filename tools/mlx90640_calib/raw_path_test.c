@@ -0,0 +1,203 @@
+/**
+ * @file raw_path_test.c
+ * @brief Host test: single-pixel spec decisions match the float path
+ *
+ * With MLX90640_RAW_FAST_PATH the firmware decides a single-pixel
+ * MLX90640 spec by converting only the spec pixel: the subpage terms
+ * (MLX90640_GetFrameTerms), the pixel's compensated signal
+ * (MLX90640_GetPixelSignal) and its temperature
+ * (MLX90640_SignalToTemperature). The float path computes the whole
+ * frame (MLX90640_CalculateTo) and passes when
+ * |(int16_t)(To * 10) - target| <= tolerance.
+ *
+ * For a set of specs (positive, negative and zero-crossing bands, zero
+ * tolerance) and operating points, this synthesizes uniform scenes
+ * stepping across each band edge (frame_synth.c) and converts every good
+ * pixel both ways. The temperatures must be bit-identical, so both paths
+ * report the same measured value and reach the same verdict, right at
+ * the band edges included.
+ *
+ * Build and run (from the repository root; exits 1 on a mismatch):
+ *   for m in 0 1; do
+ *     gcc -O2 -DMLX90640_PACKED_CALIBRATION=$m -Iinclude -Ilib/MLX90640_API \
+ *         tools/mlx90640_calib/raw_path_test.c tools/mlx90640_calib/frame_synth.c \
+ *         lib/MLX90640_API/MLX90640_API.c \
+ *         -lm -o raw_path_test_$m && ./raw_path_test_$m
+ *   done
+ */
+
+#include "MLX90640_API.h"
+#include "MLX90640_I2C_Driver.h"
+#include "frame_synth.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define RAW_TEST_EE_SEED    0x2400A5C3u
+#define RAW_TEST_STEP       0.01f   /* Scene step across an edge, °C */
+#define RAW_TEST_SPAN       0.25f   /* Scene range either side of an edge, °C */
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+typedef struct {
+    int16_t target;         /* 0.1 °C */
+    int16_t tolerance;      /* 0.1 °C */
+} RawTest_Spec_t;
+
+typedef struct {
+    float ta;
+    uint8_t mode;
+} RawTest_Point_t;
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static const RawTest_Spec_t specs[] = {
+    { 250, 10 },            /* Room temperature */
+    { 305, 0 },             /* Zero tolerance: one count wide */
+    { 1000, 50 },           /* Hot target, range 2 */
+    { 3, 5 },               /* Band crosses zero */
+    { -5, 3 },              /* Entirely below zero */
+    { -200, 15 },           /* Cold target, range 0 */
+};
+
+static const RawTest_Point_t points[] = {
+    { 25.0f, 1 },           /* Chess, as calibrated */
+    { 40.0f, 1 },
+    { 30.0f, 0 },           /* Interleaved: mode correction active */
+};
+
+static uint16_t ee[FRAME_SYNTH_EE_WORDS];
+static paramsMLX90640 params;
+static float scene[FRAME_SYNTH_PIXELS];
+static uint16_t frames[2][FRAME_SYNTH_WORDS];
+static float to[FRAME_SYNTH_PIXELS];
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static int RawTest_FloatPass(float temperature, const RawTest_Spec_t* spec);
+
+/*============================================================================*/
+/* I2C Stubs (the test never talks to a sensor)                               */
+/*============================================================================*/
+
+int MLX90640_I2CRead(uint8_t slaveAddr, uint16_t startAddress, uint16_t nMemAddressRead, uint16_t* data)
+{
+    (void)slaveAddr; (void)startAddress; (void)nMemAddressRead; (void)data;
+    return -1;
+}
+
+int MLX90640_I2CWrite(uint8_t slaveAddr, uint16_t writeAddress, uint16_t data)
+{
+    (void)slaveAddr; (void)writeAddress; (void)data;
+    return -1;
+}
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+int main(void)
+{
+    long decisions = 0, passes = 0, mismatches = 0;
+
+    FrameSynth_MakeEEPROM(ee, RAW_TEST_EE_SEED);
+    if (MLX90640_ExtractParameters(ee, &params) != MLX90640_NO_ERROR) {
+        fprintf(stderr, "ExtractParameters failed\n");
+        return 1;
+    }
+
+    for (size_t s = 0; s < sizeof(specs) / sizeof(specs[0]); s++) {
+        const RawTest_Spec_t* spec = &specs[s];
+        float lo = (spec->target - spec->tolerance) / 10.0f;
+        float hi = (spec->target + spec->tolerance) / 10.0f;
+
+        for (size_t c = 0; c < sizeof(points) / sizeof(points[0]); c++) {
+            FrameSynth_Conditions_t cond;
+            FrameSynth_DefaultConditions(&cond);
+            cond.ta = points[c].ta;
+            cond.tr = cond.ta - MLX90640_TR_OFFSET;
+            cond.mode = points[c].mode;
+
+            for (int edge = 0; edge < 2; edge++) {
+                float center = edge ? hi : lo;
+                int steps = (int)lroundf(RAW_TEST_SPAN / RAW_TEST_STEP);
+
+                for (int k = -steps; k <= steps; k++) {
+                    for (int p = 0; p < FRAME_SYNTH_PIXELS; p++) {
+                        scene[p] = center + k * RAW_TEST_STEP;
+                    }
+                    if (FrameSynth_Frame(&params, &cond, scene, frames) != 0) {
+                        fprintf(stderr, "FrameSynth_Frame failed or clipped at %.2f C\n", scene[0]);
+                        return 1;
+                    }
+
+                    /* Float path: complete frame, as MLX90640_ReadCompleteFrame */
+                    MLX90640_CalculateTo(frames[0], &params, cond.emissivity, cond.tr, to);
+                    MLX90640_CalculateTo(frames[1], &params, cond.emissivity, cond.tr, to);
+
+                    /* Pixel path: each pixel on the subpage that measures it */
+                    for (int sp = 0; sp < 2; sp++) {
+                        MLX90640_FrameTerms_t terms;
+                        MLX90640_GetFrameTerms(frames[sp], &params, cond.emissivity, cond.tr, &terms);
+
+                        for (int p = 0; p < FRAME_SYNTH_PIXELS; p++) {
+                            float irData, alphaCompensated;
+                            if (MLX90640_GetPixelSignal(frames[sp], &params, &terms, p,
+                                                        &irData, &alphaCompensated) <= 0) {
+                                continue;
+                            }
+
+                            float pixel = MLX90640_SignalToTemperature(&params, &terms, irData, alphaCompensated);
+                            int ref = RawTest_FloatPass(to[p], spec);
+                            decisions++;
+                            passes += ref;
+                            if (pixel == to[p] && RawTest_FloatPass(pixel, spec) == ref) {
+                                continue;
+                            }
+                            if (mismatches++ < 10) {
+                                printf("MISMATCH spec %d+/-%d ta %.1f mode %u pixel %d: "
+                                       "pixel path %.6f C, float path %.6f C\n",
+                                       spec->target, spec->tolerance, cond.ta, cond.mode, p,
+                                       pixel, to[p]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    printf("decisions   %ld (%ld pass)\n", decisions, passes);
+    printf("mismatches  %ld\n", mismatches);
+    if (passes == 0 || passes == decisions) {
+        printf("FAIL: sweep did not cross the band edges\n");
+        return 1;
+    }
+    printf("%s\n", mismatches ? "FAIL" : "PASS");
+    return mismatches ? 1 : 0;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Verdict of the float path (MLX90640_ExecuteTest) for one reading
+ */
+static int RawTest_FloatPass(float temperature, const RawTest_Spec_t* spec)
+{
+    int16_t measured = (int16_t)(temperature * 10);
+    int16_t diff = measured - spec->target;
+    if (diff < 0) diff = -diff;
+    return diff <= spec->tolerance;
+}
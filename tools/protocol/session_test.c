@@ -0,0 +1,409 @@
+/**
+ * @file session_test.c
+ * @brief Host test of the protocol session layer (protocol.c)
+ *
+ * Links the real protocol.c, frame.c and the software CRC backend with
+ * two memory-backed channels standing in for UART_Transport and
+ * RTT_Transport, and a Commands_* stub that echoes each request back
+ * (cmd | 0x80, same payload). Requests on the two channels are
+ * interleaved down to single bytes and every reply is checked to come
+ * back on the channel the request arrived on, in order and in that
+ * channel's framing: split frames, a CRC error, a COBS switch on one
+ * link only, and more backlog than PROTOCOL_RX_BUFFER_SIZE.
+ *
+ * Build and run (from the repository root; exits 1 on a mismatch):
+ *   gcc -O2 -DCRC_HW_ENABLED=0 -Iinclude tools/protocol/session_test.c \
+ *       src/protocol/protocol.c src/protocol/frame.c src/hal/crc_handler.c \
+ *       -o session_test && ./session_test
+ */
+
+#include "protocol/protocol.h"
+#include "protocol/frame.h"
+#include "protocol/commands.h"
+#include "hal/crc_handler.h"
+#include <stdio.h>
+#include <string.h>
+
+#if CRC_HW_ENABLED
+#error "Build the host test with -DCRC_HW_ENABLED=0"
+#endif
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define MEM_CHANNEL_SIZE    4096    /* Per direction, per channel */
+#define SESSION_REQUESTS    40      /* Requests per channel in the interleave tests */
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+/**
+ * @brief Memory-backed byte stream: the test writes rx, protocol.c writes tx
+ */
+typedef struct {
+    uint8_t     rx[MEM_CHANNEL_SIZE];
+    uint16_t    rx_len;
+    uint16_t    rx_pos;
+    uint8_t     tx[MEM_CHANNEL_SIZE];
+    uint16_t    tx_len;
+    uint16_t    writes;             /* transport->write calls (one per reply) */
+} MemChannel_t;
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static MemChannel_t uart_mem;
+static MemChannel_t rtt_mem;
+static int failures = 0;
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static void MemChannel_Reset(MemChannel_t* mem);
+static uint16_t MemChannel_Read(MemChannel_t* mem, uint8_t* buffer, uint16_t max_len);
+static void MemChannel_Write(MemChannel_t* mem, const uint8_t* data, uint16_t len);
+static uint16_t UART_Mem_Read(uint8_t* buffer, uint16_t max_len);
+static void UART_Mem_Write(const uint8_t* data, uint16_t len);
+static uint16_t RTT_Mem_Read(uint8_t* buffer, uint16_t max_len);
+static void RTT_Mem_Write(const uint8_t* data, uint16_t len);
+
+static void SessionTest_Reset(void);
+static uint16_t SessionTest_Request(uint8_t channel_tag, uint8_t seq, FrameMode_t mode, uint8_t* wire);
+static uint16_t SessionTest_Reply(uint8_t channel_tag, uint8_t seq, FrameMode_t mode, uint8_t* wire);
+static void SessionTest_Expect(const char* what, const MemChannel_t* mem,
+                               const uint8_t* expected, uint16_t expected_len);
+static void SessionTest_Interleaved(uint16_t chunk);
+static void SessionTest_CrcError(void);
+static void SessionTest_FramingPerChannel(void);
+static void SessionTest_Backlog(void);
+
+/*============================================================================*/
+/* Memory Transports                                                          */
+/*============================================================================*/
+
+/* protocol.c registers these two by name in Protocol_Init */
+const Transport_t UART_Transport = {
+    .name   = "UART4",
+    .init   = NULL,
+    .read   = UART_Mem_Read,
+    .write  = UART_Mem_Write,
+};
+
+const Transport_t RTT_Transport = {
+    .name   = "RTT",
+    .init   = NULL,
+    .read   = RTT_Mem_Read,
+    .write  = RTT_Mem_Write,
+};
+
+/*============================================================================*/
+/* Command Stubs                                                              */
+/*============================================================================*/
+
+void Commands_Init(void)
+{
+}
+
+bool Commands_Process(const Frame_t* request, Frame_t* response)
+{
+    Frame_Init(response, (uint8_t)(request->cmd | 0x80));
+    Frame_AddBytes(response, request->payload, request->payload_len);
+    return true;
+}
+
+void Commands_BuildNAK(Frame_t* response, ErrorCode_t error_code)
+{
+    Frame_Init(response, CMD_NAK);
+    Frame_AddByte(response, (uint8_t)error_code);
+}
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+int main(void)
+{
+    if (CRC_Handler_Init() != CRC_BACKEND_SOFTWARE) {
+        printf("FAIL: expected the software backend\n");
+        return 1;
+    }
+
+    /* Byte-at-a-time up to whole-stream feeding, both links in lockstep */
+    const uint16_t chunks[] = { 1, 2, 3, 7, 16, 64, MEM_CHANNEL_SIZE };
+    for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+        SessionTest_Interleaved(chunks[c]);
+    }
+
+    SessionTest_CrcError();
+    SessionTest_FramingPerChannel();
+    SessionTest_Backlog();
+
+    printf("%s (%d failures)\n", failures ? "FAIL" : "PASS", failures);
+    return failures ? 1 : 0;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+static void MemChannel_Reset(MemChannel_t* mem)
+{
+    memset(mem, 0, sizeof(*mem));
+}
+
+static uint16_t MemChannel_Read(MemChannel_t* mem, uint8_t* buffer, uint16_t max_len)
+{
+    uint16_t n = (uint16_t)(mem->rx_len - mem->rx_pos);
+    if (n > max_len) {
+        n = max_len;
+    }
+    memcpy(buffer, &mem->rx[mem->rx_pos], n);
+    mem->rx_pos += n;
+    return n;
+}
+
+static void MemChannel_Write(MemChannel_t* mem, const uint8_t* data, uint16_t len)
+{
+    if (mem->tx_len + len > MEM_CHANNEL_SIZE) {
+        printf("FAIL: %s tx overflow\n", mem == &uart_mem ? "UART4" : "RTT");
+        failures++;
+        return;
+    }
+    memcpy(&mem->tx[mem->tx_len], data, len);
+    mem->tx_len += len;
+    mem->writes++;
+}
+
+static uint16_t UART_Mem_Read(uint8_t* buffer, uint16_t max_len)
+{
+    return MemChannel_Read(&uart_mem, buffer, max_len);
+}
+
+static void UART_Mem_Write(const uint8_t* data, uint16_t len)
+{
+    MemChannel_Write(&uart_mem, data, len);
+}
+
+static uint16_t RTT_Mem_Read(uint8_t* buffer, uint16_t max_len)
+{
+    return MemChannel_Read(&rtt_mem, buffer, max_len);
+}
+
+static void RTT_Mem_Write(const uint8_t* data, uint16_t len)
+{
+    MemChannel_Write(&rtt_mem, data, len);
+}
+
+static void SessionTest_Reset(void)
+{
+    MemChannel_Reset(&uart_mem);
+    MemChannel_Reset(&rtt_mem);
+    Protocol_Init();
+}
+
+/**
+ * @brief Wire bytes of one request tagged with its channel and sequence number
+ *
+ * The payload length varies with seq so frames of different sizes
+ * straddle each other when the channels are interleaved.
+ */
+static uint16_t SessionTest_Request(uint8_t channel_tag, uint8_t seq, FrameMode_t mode, uint8_t* wire)
+{
+    Frame_t frame;
+
+    Frame_Init(&frame, (uint8_t)(0x10 + (seq % 0x30)));
+    Frame_AddByte(&frame, channel_tag);
+    Frame_AddByte(&frame, seq);
+    for (uint8_t i = 0; i < (uint8_t)((seq * 5 + channel_tag) % (PROTOCOL_MAX_PAYLOAD - 2)); i++) {
+        Frame_AddByte(&frame, (uint8_t)(channel_tag ^ i));
+    }
+
+    return (mode == FRAME_MODE_COBS) ? Frame_BuildCOBS(&frame, wire) : Frame_Build(&frame, wire);
+}
+
+/**
+ * @brief Wire bytes the echo stub must send back for that request
+ */
+static uint16_t SessionTest_Reply(uint8_t channel_tag, uint8_t seq, FrameMode_t mode, uint8_t* wire)
+{
+    uint8_t request_wire[FRAME_MAX_SIZE + 2];
+    Frame_t request;
+    Frame_t reply;
+    uint16_t consumed;
+    uint16_t len = SessionTest_Request(channel_tag, seq, mode, request_wire);
+
+    if (mode == FRAME_MODE_COBS) {
+        Frame_ParseCOBS(request_wire, len, &request, &consumed);
+    } else {
+        Frame_Parse(request_wire, len, &request, &consumed);
+    }
+    Commands_Process(&request, &reply);
+
+    return (mode == FRAME_MODE_COBS) ? Frame_BuildCOBS(&reply, wire) : Frame_Build(&reply, wire);
+}
+
+static void SessionTest_Expect(const char* what, const MemChannel_t* mem,
+                               const uint8_t* expected, uint16_t expected_len)
+{
+    if (mem->tx_len != expected_len || memcmp(mem->tx, expected, expected_len) != 0) {
+        uint16_t at = 0;
+        while (at < mem->tx_len && at < expected_len && mem->tx[at] == expected[at]) {
+            at++;
+        }
+        printf("MISMATCH %s: %u bytes sent, %u expected, first difference at %u\n",
+               what, (unsigned)mem->tx_len, (unsigned)expected_len, (unsigned)at);
+        failures++;
+    }
+}
+
+/**
+ * @brief SESSION_REQUESTS per link, fed chunk bytes per link per Protocol_Process
+ */
+static void SessionTest_Interleaved(uint16_t chunk)
+{
+    static uint8_t uart_expected[MEM_CHANNEL_SIZE];
+    static uint8_t rtt_expected[MEM_CHANNEL_SIZE];
+    uint16_t uart_expected_len = 0;
+    uint16_t rtt_expected_len = 0;
+    char what[48];
+
+    SessionTest_Reset();
+    for (uint8_t seq = 0; seq < SESSION_REQUESTS; seq++) {
+        uart_mem.rx_len += SessionTest_Request('U', seq, FRAME_MODE_CLASSIC, &uart_mem.rx[uart_mem.rx_len]);
+        rtt_mem.rx_len += SessionTest_Request('R', seq, FRAME_MODE_CLASSIC, &rtt_mem.rx[rtt_mem.rx_len]);
+        uart_expected_len += SessionTest_Reply('U', seq, FRAME_MODE_CLASSIC, &uart_expected[uart_expected_len]);
+        rtt_expected_len += SessionTest_Reply('R', seq, FRAME_MODE_CLASSIC, &rtt_expected[rtt_expected_len]);
+    }
+
+    /* Release the streams to the transports chunk bytes at a time */
+    uint16_t uart_total = uart_mem.rx_len;
+    uint16_t rtt_total = rtt_mem.rx_len;
+    uint16_t released = 0;
+    while (uart_mem.rx_pos < uart_total || rtt_mem.rx_pos < rtt_total) {
+        released = (uint16_t)((released + chunk > MEM_CHANNEL_SIZE) ? MEM_CHANNEL_SIZE : released + chunk);
+        uart_mem.rx_len = (released < uart_total) ? released : uart_total;
+        rtt_mem.rx_len = (released < rtt_total) ? released : rtt_total;
+        Protocol_Process();
+    }
+    Protocol_Process();
+
+    snprintf(what, sizeof(what), "UART4 replies, chunk %u", (unsigned)chunk);
+    SessionTest_Expect(what, &uart_mem, uart_expected, uart_expected_len);
+    snprintf(what, sizeof(what), "RTT replies, chunk %u", (unsigned)chunk);
+    SessionTest_Expect(what, &rtt_mem, rtt_expected, rtt_expected_len);
+
+    if (uart_mem.writes != SESSION_REQUESTS || rtt_mem.writes != SESSION_REQUESTS) {
+        printf("MISMATCH chunk %u: %u/%u writes, expected %u per link\n", (unsigned)chunk,
+               (unsigned)uart_mem.writes, (unsigned)rtt_mem.writes, SESSION_REQUESTS);
+        failures++;
+    }
+}
+
+/**
+ * @brief A corrupted frame on RTT is NAKed on RTT only, mid-frame on UART4
+ */
+static void SessionTest_CrcError(void)
+{
+    uint8_t wire[FRAME_MAX_SIZE];
+    uint8_t expected[2 * FRAME_MAX_SIZE];
+    uint16_t expected_len;
+    Frame_t nak;
+
+    SessionTest_Reset();
+
+    /* First half of a UART4 request */
+    uint16_t uart_len = SessionTest_Request('U', 9, FRAME_MODE_CLASSIC, uart_mem.rx);
+    uart_mem.rx_len = uart_len / 2;
+
+    /* Bad CRC on RTT, then a good request */
+    uint16_t len = SessionTest_Request('R', 1, FRAME_MODE_CLASSIC, wire);
+    wire[len - 2] ^= 0x5A;
+    memcpy(rtt_mem.rx, wire, len);
+    rtt_mem.rx_len = len;
+    rtt_mem.rx_len += SessionTest_Request('R', 2, FRAME_MODE_CLASSIC, &rtt_mem.rx[len]);
+    Protocol_Process();
+
+    Commands_BuildNAK(&nak, ERR_CRC_FAIL);
+    expected_len = Frame_Build(&nak, expected);
+    expected_len += SessionTest_Reply('R', 2, FRAME_MODE_CLASSIC, &expected[expected_len]);
+    SessionTest_Expect("RTT NAK then reply", &rtt_mem, expected, expected_len);
+    SessionTest_Expect("UART4 before its frame completes", &uart_mem, expected, 0);
+
+    /* Rest of the UART4 request */
+    uart_mem.rx_len = uart_len;
+    Protocol_Process();
+    expected_len = SessionTest_Reply('U', 9, FRAME_MODE_CLASSIC, expected);
+    SessionTest_Expect("UART4 completed frame", &uart_mem, expected, expected_len);
+}
+
+/**
+ * @brief CMD_SET_FRAMING on RTT switches RTT to COBS and leaves UART4 classic
+ */
+static void SessionTest_FramingPerChannel(void)
+{
+    static uint8_t uart_expected[MEM_CHANNEL_SIZE];
+    static uint8_t rtt_expected[MEM_CHANNEL_SIZE];
+    uint16_t uart_expected_len = 0;
+    uint16_t rtt_expected_len = 0;
+    Frame_t frame;
+
+    SessionTest_Reset();
+
+    /* Switch request, answered in the old (classic) framing */
+    Frame_Init(&frame, CMD_SET_FRAMING);
+    Frame_AddByte(&frame, FRAME_MODE_COBS);
+    rtt_mem.rx_len = Frame_Build(&frame, rtt_mem.rx);
+    Frame_Init(&frame, CMD_FRAMING);
+    Frame_AddByte(&frame, FRAME_MODE_COBS);
+    rtt_expected_len = Frame_Build(&frame, rtt_expected);
+
+    for (uint8_t seq = 0; seq < 8; seq++) {
+        rtt_mem.rx_len += SessionTest_Request('R', seq, FRAME_MODE_COBS, &rtt_mem.rx[rtt_mem.rx_len]);
+        rtt_expected_len += SessionTest_Reply('R', seq, FRAME_MODE_COBS, &rtt_expected[rtt_expected_len]);
+        uart_mem.rx_len += SessionTest_Request('U', seq, FRAME_MODE_CLASSIC, &uart_mem.rx[uart_mem.rx_len]);
+        uart_expected_len += SessionTest_Reply('U', seq, FRAME_MODE_CLASSIC, &uart_expected[uart_expected_len]);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        Protocol_Process();
+    }
+
+    SessionTest_Expect("RTT after switching to COBS", &rtt_mem, rtt_expected, rtt_expected_len);
+    SessionTest_Expect("UART4 still classic", &uart_mem, uart_expected, uart_expected_len);
+}
+
+/**
+ * @brief More queued on one link than its receive buffer holds
+ *
+ * Each Protocol_Process takes only what fits; the rest waits in the
+ * transport and nothing is lost or answered on the other link.
+ */
+static void SessionTest_Backlog(void)
+{
+    static uint8_t expected[MEM_CHANNEL_SIZE];
+    uint16_t expected_len = 0;
+    uint16_t passes = 0;
+
+    SessionTest_Reset();
+    for (uint8_t seq = 0; seq < SESSION_REQUESTS; seq++) {
+        uart_mem.rx_len += SessionTest_Request('U', seq, FRAME_MODE_CLASSIC, &uart_mem.rx[uart_mem.rx_len]);
+        expected_len += SessionTest_Reply('U', seq, FRAME_MODE_CLASSIC, &expected[expected_len]);
+    }
+
+    if (uart_mem.rx_len <= PROTOCOL_RX_BUFFER_SIZE) {
+        printf("FAIL: backlog of %u bytes does not exceed the receive buffer\n", (unsigned)uart_mem.rx_len);
+        failures++;
+    }
+
+    while (uart_mem.rx_pos < uart_mem.rx_len && passes++ < 1000) {
+        Protocol_Process();
+    }
+    Protocol_Process();
+
+    SessionTest_Expect("UART4 backlog", &uart_mem, expected, expected_len);
+    SessionTest_Expect("RTT during UART4 backlog", &rtt_mem, expected, 0);
+}
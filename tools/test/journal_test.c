@@ -0,0 +1,437 @@
+/**
+ * @file journal_test.c
+ * @brief Host test of the test result journal (test_journal.c)
+ *
+ * Maps host memory at TEST_JOURNAL_FLASH_ADDR and implements the flash
+ * HAL over it (erased = 0xFF, a flash word is programmed once), so the
+ * journal runs unchanged. Checks against the sequence of recorded
+ * reports:
+ * - reading from any sequence number, in chunks, continues where the
+ *   previous call stopped and returns every held entry in order;
+ * - TestJournal_Init (a reset) restores next_seq and the flash history,
+ *   across a failed write that left an erased hole and a sector holding
+ *   only garbage;
+ * - wrapping through both sectors never erases inside TestJournal_Record,
+ *   keeps at least one full sector of history, and a full journal whose
+ *   spare sector was not erased yet keeps recording in RAM.
+ *
+ * Build and run (from the repository root; exits 1 on a mismatch; -no-pie
+ * keeps the journal's flash buffer below 4 GB for the 32-bit HAL address):
+ *   gcc -O2 -no-pie -DCRC_HW_ENABLED=0 -Iinclude -Ilib/MLX90640_API -Itools/host \
+ *       tools/test/journal_test.c src/test/test_journal.c src/hal/crc_handler.c \
+ *       -o journal_test && ./journal_test
+ */
+
+#include "test/test_journal.h"
+#include "hal/crc_handler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define JOURNAL_TEST_SECTORS    2
+#define JOURNAL_TEST_SLOTS      (FLASH_SECTOR_SIZE / 64)
+#define JOURNAL_TEST_FLASH_SIZE (JOURNAL_TEST_SECTORS * FLASH_SECTOR_SIZE)
+#define JOURNAL_TEST_WORD       (FLASH_NB_32BITWORD_IN_FLASHWORD * 4)
+#define JOURNAL_TEST_CHUNK      60      /* JOURNAL_READ payload budget: two entries per call */
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static uint8_t* flash;
+static uint32_t tick = 0;
+static int erases[JOURNAL_TEST_SECTORS];
+static int erase_allowed = 1;
+static uint32_t fail_address = 0;           /* Flash word whose program fails (0 = none) */
+static uint32_t rng_state = 65;
+static int failures = 0;
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static uint32_t JournalTest_Random(void);
+static void JournalTest_Record(uint32_t seq);
+static uint32_t JournalTest_ReadAll(uint32_t from, uint32_t* first, uint32_t* last, uint32_t* holes);
+static void JournalTest_Fresh(void);
+static void JournalTest_Recovery(void);
+static void JournalTest_Wrap(void);
+static void JournalTest_SpareNotErased(void);
+static void JournalTest_Expect(const char* what, long got, long expected);
+
+/*============================================================================*/
+/* HAL and Module Stubs                                                       */
+/*============================================================================*/
+
+uint32_t HAL_GetTick(void)
+{
+    return tick;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t FlashAddress, uint32_t DataAddress)
+{
+    uint32_t offset = FlashAddress - TEST_JOURNAL_FLASH_ADDR;
+
+    if (TypeProgram != FLASH_TYPEPROGRAM_FLASHWORD || offset >= JOURNAL_TEST_FLASH_SIZE ||
+        offset % JOURNAL_TEST_WORD != 0) {
+        JournalTest_Expect("program address", (long)FlashAddress, -1);
+        return HAL_ERROR;
+    }
+    if (FlashAddress == fail_address) {
+        return HAL_ERROR;
+    }
+    for (uint32_t i = 0; i < JOURNAL_TEST_WORD; i++) {
+        if (flash[offset + i] != 0xFF) {
+            JournalTest_Expect("program over programmed word", (long)FlashAddress, -1);
+            return HAL_ERROR;
+        }
+    }
+
+    memcpy(&flash[offset], (const void*)(uintptr_t)DataAddress, JOURNAL_TEST_WORD);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef* pEraseInit, uint32_t* SectorError)
+{
+    uint32_t sector = pEraseInit->Sector - TEST_JOURNAL_FLASH_SECTOR;
+
+    *SectorError = 0xFFFFFFFFUL;
+    if (sector >= JOURNAL_TEST_SECTORS || pEraseInit->NbSectors != 1) {
+        JournalTest_Expect("erase sector", (long)pEraseInit->Sector, -1);
+        return HAL_ERROR;
+    }
+    if (!erase_allowed) {
+        JournalTest_Expect("erase inside TestJournal_Record", (long)pEraseInit->Sector, -1);
+    }
+
+    memset(&flash[sector * FLASH_SECTOR_SIZE], 0xFF, FLASH_SECTOR_SIZE);
+    erases[sector]++;
+    return HAL_OK;
+}
+
+const SensorDriver_t* SensorManager_GetByID(SensorID_t id)
+{
+    (void)id;
+    return NULL;
+}
+
+/**
+ * @brief Report stand-in: [sensor_count][pass][fail][timestamp(4)]
+ */
+uint16_t TestRunner_SerializeReport(const TestReport_t* report, uint8_t* buffer)
+{
+    buffer[0] = report->sensor_count;
+    buffer[1] = report->pass_count;
+    buffer[2] = report->fail_count;
+    buffer[3] = (uint8_t)(report->timestamp >> 24);
+    buffer[4] = (uint8_t)(report->timestamp >> 16);
+    buffer[5] = (uint8_t)(report->timestamp >> 8);
+    buffer[6] = (uint8_t)(report->timestamp & 0xFF);
+    return 7;
+}
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+int main(void)
+{
+    flash = mmap((void*)(uintptr_t)TEST_JOURNAL_FLASH_ADDR, JOURNAL_TEST_FLASH_SIZE,
+                 PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (flash != (uint8_t*)(uintptr_t)TEST_JOURNAL_FLASH_ADDR) {
+        fprintf(stderr, "cannot map the journal sectors at 0x%08lx\n", (unsigned long)TEST_JOURNAL_FLASH_ADDR);
+        return 1;
+    }
+    CRC_Handler_Init();
+
+    JournalTest_Fresh();
+    JournalTest_Recovery();
+    JournalTest_Wrap();
+    JournalTest_SpareNotErased();
+
+    printf("%s (%d failures)\n", failures ? "FAIL" : "PASS", failures);
+    return failures ? 1 : 0;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+static uint32_t JournalTest_Random(void)
+{
+    rng_state = rng_state * 1664525UL + 1013904223UL;
+    return rng_state >> 8;
+}
+
+/**
+ * @brief Record one report whose timestamp encodes its expected seq
+ *
+ * Erasing is only legal from TestJournal_Process.
+ */
+static void JournalTest_Record(uint32_t seq)
+{
+    TestReport_t report;
+
+    memset(&report, 0, sizeof(report));
+    report.sensor_count = 1;
+    report.pass_count = (uint8_t)(JournalTest_Random() & 1);
+    report.fail_count = 1 - report.pass_count;
+    report.timestamp = seq * 7;
+    report.results[0].sensor_id = SENSOR_ID_MLX90640;
+    report.results[0].status = report.pass_count ? STATUS_PASS : STATUS_FAIL_INVALID;
+    report.results[0].duration_ms = (uint16_t)seq;
+
+    tick = report.timestamp + 3;
+    erase_allowed = 0;
+    TestJournal_Record(&report);
+    erase_allowed = 1;
+}
+
+/**
+ * @brief Drain the journal from a sequence number in JOURNAL_READ-sized calls
+ *
+ * Checks that every entry is well formed and that seqs increase.
+ *
+ * @param from First seq requested
+ * @param first Seq of the first entry returned (output)
+ * @param last Seq of the last entry returned (output)
+ * @param holes Seqs skipped between the first and last entry (output)
+ * @return Number of entries returned
+ */
+static uint32_t JournalTest_ReadAll(uint32_t from, uint32_t* first, uint32_t* last, uint32_t* holes)
+{
+    uint8_t buffer[JOURNAL_TEST_CHUNK];
+    uint32_t cursor = from;
+    uint32_t entries = 0;
+
+    *first = *last = *holes = 0;
+    for (;;) {
+        uint8_t count = 0;
+        uint32_t before = cursor;
+        uint8_t len = TestJournal_Read(&cursor, buffer, sizeof(buffer), &count);
+        if (count == 0) {
+            JournalTest_Expect("read stops without bytes", len, 0);
+            JournalTest_Expect("read stops at cursor", cursor >= before, 1);
+            return entries;
+        }
+
+        uint8_t idx = 0;
+        for (uint8_t e = 0; e < count; e++) {
+            const uint8_t* entry = &buffer[idx];
+            uint32_t seq = ((uint32_t)entry[1] << 24) | ((uint32_t)entry[2] << 16) |
+                           ((uint32_t)entry[3] << 8) | entry[4];
+            uint32_t timestamp = ((uint32_t)entry[17] << 24) | ((uint32_t)entry[18] << 16) |
+                                 ((uint32_t)entry[19] << 8) | entry[20];
+
+            JournalTest_Expect("entry length", entry[0], 1 + 10 + 2 + 7);
+            JournalTest_Expect("entry duration", (entry[9] << 8) | entry[10], 3);
+            JournalTest_Expect("entry sensor duration", (entry[12] << 8) | entry[13], (long)(seq & 0xFFFF));
+            JournalTest_Expect("entry timestamp", (long)timestamp, (long)seq * 7);
+            if (entries == 0) {
+                *first = seq;
+            } else {
+                JournalTest_Expect("seq increases", seq > *last, 1);
+                *holes += seq - *last - 1;
+            }
+            *last = seq;
+            entries++;
+            idx += entry[0] + 1;
+        }
+        JournalTest_Expect("read length", len, idx);
+        JournalTest_Expect("cursor past last entry", cursor > *last, 1);
+    }
+}
+
+/**
+ * @brief Blank flash: record, read back in chunks and from the middle
+ */
+static void JournalTest_Fresh(void)
+{
+    uint32_t first, last, holes;
+    TestJournalInfo_t info;
+
+    memset(flash, 0xFF, JOURNAL_TEST_FLASH_SIZE);
+    TestJournal_Init();
+    TestJournal_GetInfo(&info);
+    JournalTest_Expect("fresh next seq", (long)info.next_seq, 0);
+    JournalTest_Expect("fresh flash count", info.flash_count, 0);
+    JournalTest_Expect("flash capacity", info.flash_capacity, JOURNAL_TEST_SECTORS * JOURNAL_TEST_SLOTS);
+    JournalTest_Expect("fresh read", (long)JournalTest_ReadAll(0, &first, &last, &holes), 0);
+
+    for (uint32_t seq = 0; seq < 100; seq++) {
+        JournalTest_Record(seq);
+    }
+
+    /* The RAM ring holds the last 64; the rest comes from flash */
+    JournalTest_Expect("read all", (long)JournalTest_ReadAll(0, &first, &last, &holes), 100);
+    JournalTest_Expect("read all first", (long)first, 0);
+    JournalTest_Expect("read all holes", (long)holes, 0);
+    JournalTest_Expect("read since 57", (long)JournalTest_ReadAll(57, &first, &last, &holes), 43);
+    JournalTest_Expect("read since 57 first", (long)first, 57);
+    JournalTest_Expect("read since next", (long)JournalTest_ReadAll(100, &first, &last, &holes), 0);
+
+    /* A cursor from before a reset (past next_seq) restarts at the oldest */
+    JournalTest_Expect("read stale cursor", (long)JournalTest_ReadAll(5000, &first, &last, &holes), 100);
+    JournalTest_Expect("read stale cursor first", (long)first, 0);
+
+    TestJournal_GetInfo(&info);
+    JournalTest_Expect("next seq", (long)info.next_seq, 100);
+    JournalTest_Expect("oldest seq", (long)info.oldest_seq, 0);
+    JournalTest_Expect("ram count", info.ram_count, TEST_JOURNAL_ENTRIES);
+    JournalTest_Expect("flash count", info.flash_count, 100);
+}
+
+/**
+ * @brief Reset recovery, a failed write and a garbage sector
+ */
+static void JournalTest_Recovery(void)
+{
+    uint32_t first, last, holes;
+    TestJournalInfo_t info;
+
+    /* Reset: the RAM ring is gone, flash restores history and numbering */
+    TestJournal_Init();
+    TestJournal_GetInfo(&info);
+    JournalTest_Expect("reset next seq", (long)info.next_seq, 100);
+    JournalTest_Expect("reset ram count", info.ram_count, 0);
+    JournalTest_Expect("reset read", (long)JournalTest_ReadAll(0, &first, &last, &holes), 100);
+    JournalTest_Expect("reset read since 80", (long)JournalTest_ReadAll(80, &first, &last, &holes), 20);
+
+    /* Seq 103 fails to program and leaves its slot erased */
+    for (uint32_t seq = 100; seq < 110; seq++) {
+        fail_address = (seq == 103) ? TEST_JOURNAL_FLASH_ADDR + 103 * 64 : 0;
+        JournalTest_Record(seq);
+    }
+    fail_address = 0;
+
+    TestJournal_Init();
+    TestJournal_GetInfo(&info);
+    JournalTest_Expect("hole next seq", (long)info.next_seq, 110);
+    JournalTest_Expect("hole read", (long)JournalTest_ReadAll(0, &first, &last, &holes), 109);
+    JournalTest_Expect("hole read holes", (long)holes, 1);
+    JournalTest_Expect("hole read last", (long)last, 109);
+
+    /* Numbering continues after the hole, not into it */
+    JournalTest_Record(110);
+    JournalTest_Expect("after hole read", (long)JournalTest_ReadAll(108, &first, &last, &holes), 3);
+
+    /* A sector holding nothing readable is erased at boot, the other is kept */
+    memset(&flash[FLASH_SECTOR_SIZE], 0x5A, 64);
+    int before = erases[1];
+    TestJournal_Init();
+    TestJournal_GetInfo(&info);
+    JournalTest_Expect("garbage sector erased", erases[1] - before, 1);
+    JournalTest_Expect("garbage sector blank", flash[FLASH_SECTOR_SIZE], 0xFF);
+    JournalTest_Expect("garbage next seq", (long)info.next_seq, 111);
+    JournalTest_Expect("garbage read", (long)JournalTest_ReadAll(0, &first, &last, &holes), 110);
+}
+
+/**
+ * @brief Wrap through both sectors with the main loop erasing ahead
+ */
+static void JournalTest_Wrap(void)
+{
+    uint32_t first, last, holes;
+    TestJournalInfo_t info;
+    uint32_t seq = 111;
+    uint32_t end = 111 + 3 * JOURNAL_TEST_SLOTS + 500;
+    int resets = 0;
+
+    JournalTest_Expect("clear", TestJournal_Clear(), HAL_OK);
+    TestJournal_GetInfo(&info);
+    JournalTest_Expect("clear keeps numbering", (long)info.next_seq, 111);
+    JournalTest_Expect("clear read", (long)JournalTest_ReadAll(0, &first, &last, &holes), 0);
+    erases[0] = erases[1] = 0;
+
+    for (; seq < end; seq++) {
+        JournalTest_Record(seq);
+        TestJournal_Process();
+
+        /* Reset now and then, including right around the sector switches */
+        if (seq % 997 == 0 || seq == 111 + JOURNAL_TEST_SLOTS || seq == 111 + 2 * JOURNAL_TEST_SLOTS - 1) {
+            TestJournal_Init();
+            resets++;
+            TestJournal_GetInfo(&info);
+            JournalTest_Expect("wrap reset next seq", (long)info.next_seq, (long)seq + 1);
+        }
+
+        /* Everything since the clear, or at least one full sector, stays readable */
+        if (seq % 211 == 0 || seq + 1 == end) {
+            uint32_t held = seq + 1 - 111;
+            uint32_t floor = JOURNAL_TEST_SLOTS - TEST_JOURNAL_ERASE_AHEAD;
+            uint32_t n = JournalTest_ReadAll(0, &first, &last, &holes);
+            JournalTest_Expect("wrap last", (long)last, (long)seq);
+            JournalTest_Expect("wrap holes", (long)holes, 0);
+            JournalTest_Expect("wrap history", n >= ((held < floor) ? held : floor), 1);
+            JournalTest_Expect("wrap history bound", n <= JOURNAL_TEST_SECTORS * JOURNAL_TEST_SLOTS, 1);
+        }
+    }
+
+    /* Sector 1 started blank, so only sector 0 (once) and sector 1 (once) needed erasing */
+    JournalTest_Expect("wrap erases sector 0", erases[0], 1);
+    JournalTest_Expect("wrap erases sector 1", erases[1], 1);
+    JournalTest_Expect("wrap resets", resets > 3, 1);
+}
+
+/**
+ * @brief A full journal whose spare sector is not erased keeps recording in RAM
+ */
+static void JournalTest_SpareNotErased(void)
+{
+    uint32_t first, last, holes;
+    TestJournalInfo_t info;
+    uint32_t seq;
+
+    TestJournal_GetInfo(&info);
+    seq = info.next_seq;
+
+    /* Fill the active sector without the main loop running */
+    while (info.flash_count < JOURNAL_TEST_SECTORS * JOURNAL_TEST_SLOTS) {
+        JournalTest_Record(seq++);
+        TestJournal_GetInfo(&info);
+    }
+    uint32_t flash_last = seq - 1;
+    for (int i = 0; i < 10; i++) {
+        JournalTest_Record(seq++);
+    }
+
+    TestJournal_GetInfo(&info);
+    JournalTest_Expect("full flash count", info.flash_count, JOURNAL_TEST_SECTORS * JOURNAL_TEST_SLOTS);
+    JournalTest_Expect("full read", (long)JournalTest_ReadAll(0, &first, &last, &holes),
+                       JOURNAL_TEST_SECTORS * JOURNAL_TEST_SLOTS + 10);
+    JournalTest_Expect("full read last", (long)last, (long)seq - 1);
+
+    /* The main loop erases the older sector; recording resumes in flash */
+    TestJournal_Process();
+    JournalTest_Record(seq++);
+    TestJournal_Init();
+    TestJournal_GetInfo(&info);
+    JournalTest_Expect("resumed next seq", (long)info.next_seq, (long)seq);
+    JournalTest_Expect("resumed read", (long)JournalTest_ReadAll(0, &first, &last, &holes), JOURNAL_TEST_SLOTS + 1);
+    JournalTest_Expect("resumed gap", (long)holes, 10);
+    JournalTest_Expect("resumed gap start", (long)(seq - 1 - 10 - 1), (long)flash_last);
+}
+
+static void JournalTest_Expect(const char* what, long got, long expected)
+{
+    if (got != expected) {
+        if (failures++ < 10) {
+            printf("MISMATCH %s: %ld, expected %ld\n", what, got, expected);
+        }
+    }
+}
@@ -0,0 +1,226 @@
+/**
+ * @file filter_test.c
+ * @brief Host test of the per-pixel temporal filter (thermal_filter.c)
+ *
+ * Feeds random frames through every EMA alpha and window length and
+ * checks the filtered image against a double-precision reference: the
+ * EMA recurrence seeded with the first frame, and the mean of the last N
+ * samples rounded to 0.01 °C (fewer while the window fills). Also checks
+ * the settle frame counts, clamping of out-of-range samples, reset on
+ * reconfiguration and the parameter limits.
+ *
+ * Build and run (from the repository root; exits 1 on a mismatch):
+ *   gcc -O2 -Iinclude -Ilib/MLX90640_API -Itools/host tools/thermal/filter_test.c \
+ *       src/sensors/thermal_filter.c -lm -o filter_test && ./filter_test
+ */
+
+#include "sensors/thermal_filter.h"
+#include "sensors/mlx90640.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define FILTER_TEST_FRAMES      40      /* Frames per configuration (> 4 windows) */
+#define FILTER_TEST_TOLERANCE   0.002   /* °C between float filter and double reference */
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static float image[MLX90640_PIXEL_COUNT];
+static float history[FILTER_TEST_FRAMES][MLX90640_PIXEL_COUNT];
+static double reference[MLX90640_PIXEL_COUNT];
+static uint32_t rng_state = 60;
+static int failures = 0;
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static uint32_t FilterTest_Random(void);
+static void FilterTest_Frame(int index);
+static void FilterTest_Ema(uint8_t alpha);
+static void FilterTest_Window(uint8_t length);
+static void FilterTest_Limits(void);
+static void FilterTest_CompareImage(const char* what, int frame);
+static void FilterTest_Expect(const char* what, int got, int expected);
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+int main(void)
+{
+    for (int alpha = 1; alpha <= 100; alpha++) {
+        FilterTest_Ema((uint8_t)alpha);
+    }
+    for (int length = 2; length <= THERMAL_FILTER_MAX_WINDOW; length++) {
+        FilterTest_Window((uint8_t)length);
+    }
+    FilterTest_Limits();
+
+    printf("%s (%d failures)\n", failures ? "FAIL" : "PASS", failures);
+    return failures ? 1 : 0;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+static uint32_t FilterTest_Random(void)
+{
+    rng_state = rng_state * 1664525UL + 1013904223UL;
+    return rng_state >> 8;
+}
+
+/**
+ * @brief Fill history[index] with a random frame and feed it to the filter
+ */
+static void FilterTest_Frame(int index)
+{
+    for (int i = 0; i < MLX90640_PIXEL_COUNT; i++) {
+        history[index][i] = -40.0f + (float)(FilterTest_Random() % 34000) * 0.01f + 0.003f;
+        ThermalFilter_Pixel(image, i, history[index][i]);
+    }
+    ThermalFilter_EndFrame();
+}
+
+static void FilterTest_Ema(uint8_t alpha)
+{
+    char what[48];
+    double a = alpha / 100.0;
+
+    snprintf(what, sizeof(what), "EMA %u configure", alpha);
+    FilterTest_Expect(what, ThermalFilter_Configure(THERMAL_FILTER_EMA, alpha), 1);
+
+    /* Smallest n >= 1 with (1 - a)^n below 5% (alpha 95 leaves exactly 5% and needs 2) */
+    int settle = 1;
+    while (pow(1.0 - a, settle) > 0.05 - 1e-6) {
+        settle++;
+    }
+
+    for (int f = 0; f < FILTER_TEST_FRAMES; f++) {
+        FilterTest_Frame(f);
+        for (int i = 0; i < MLX90640_PIXEL_COUNT; i++) {
+            reference[i] = (f == 0) ? history[0][i] : reference[i] + a * (history[f][i] - reference[i]);
+        }
+        snprintf(what, sizeof(what), "EMA %u", alpha);
+        FilterTest_CompareImage(what, f);
+
+        ThermalFilterInfo_t info;
+        ThermalFilter_GetInfo(&info);
+        snprintf(what, sizeof(what), "EMA %u frame %d settled", alpha, f);
+        FilterTest_Expect(what, info.settled, f + 1 >= settle);
+    }
+
+    ThermalFilterInfo_t info;
+    ThermalFilter_GetInfo(&info);
+    snprintf(what, sizeof(what), "EMA %u settle frames", alpha);
+    FilterTest_Expect(what, info.settle_frames, settle);
+}
+
+static void FilterTest_Window(uint8_t length)
+{
+    char what[48];
+
+    snprintf(what, sizeof(what), "window %u configure", length);
+    FilterTest_Expect(what, ThermalFilter_Configure(THERMAL_FILTER_WINDOW, length), 1);
+
+    for (int f = 0; f < FILTER_TEST_FRAMES; f++) {
+        FilterTest_Frame(f);
+
+        int first = (f + 1 > length) ? f + 1 - length : 0;
+        for (int i = 0; i < MLX90640_PIXEL_COUNT; i++) {
+            double sum = 0.0;
+            for (int k = first; k <= f; k++) {
+                sum += round(history[k][i] * 100.0) / 100.0;
+            }
+            reference[i] = sum / (f + 1 - first);
+        }
+        snprintf(what, sizeof(what), "window %u", length);
+        FilterTest_CompareImage(what, f);
+
+        ThermalFilterInfo_t info;
+        ThermalFilter_GetInfo(&info);
+        snprintf(what, sizeof(what), "window %u frame %d settled", length, f);
+        FilterTest_Expect(what, info.settled, f + 1 >= length);
+    }
+}
+
+/**
+ * @brief Parameter limits, OFF pass-through, clamping, reset and info bytes
+ */
+static void FilterTest_Limits(void)
+{
+    FilterTest_Expect("EMA 0 rejected", ThermalFilter_Configure(THERMAL_FILTER_EMA, 0), 0);
+    FilterTest_Expect("EMA 101 rejected", ThermalFilter_Configure(THERMAL_FILTER_EMA, 101), 0);
+    FilterTest_Expect("window 1 rejected", ThermalFilter_Configure(THERMAL_FILTER_WINDOW, 1), 0);
+    FilterTest_Expect("window past max rejected",
+                      ThermalFilter_Configure(THERMAL_FILTER_WINDOW, THERMAL_FILTER_MAX_WINDOW + 1), 0);
+    FilterTest_Expect("unknown mode rejected", ThermalFilter_Configure(0x03, 4), 0);
+
+    /* A rejected configuration keeps the previous window mode */
+    FilterTest_Expect("still enabled", ThermalFilter_IsEnabled(), 1);
+
+    /* OFF copies samples through and reports nothing settled */
+    FilterTest_Expect("OFF configure", ThermalFilter_Configure(THERMAL_FILTER_OFF, 55), 1);
+    FilterTest_Expect("OFF disabled", ThermalFilter_IsEnabled(), 0);
+    FilterTest_Frame(0);
+    for (int i = 0; i < MLX90640_PIXEL_COUNT; i++) {
+        reference[i] = history[0][i];
+    }
+    FilterTest_CompareImage("OFF", 0);
+
+    ThermalFilterInfo_t info;
+    ThermalFilter_GetInfo(&info);
+    FilterTest_Expect("OFF param", info.param, 0);
+    FilterTest_Expect("OFF frames", info.frames, 0);
+    FilterTest_Expect("OFF settled", info.settled, 0);
+
+    /* Window samples beyond the 16-bit 0.01 °C range clamp */
+    ThermalFilter_Configure(THERMAL_FILTER_WINDOW, 2);
+    ThermalFilter_Pixel(image, 0, 400.0f);
+    ThermalFilter_Pixel(image, 1, -400.0f);
+    ThermalFilter_EndFrame();
+    FilterTest_Expect("clamp high", (int)lrintf(image[0] * 100.0f), 32767);
+    FilterTest_Expect("clamp low", (int)lrintf(image[1] * 100.0f), -32768);
+
+    /* Reconfiguring drops the old window history */
+    ThermalFilter_Configure(THERMAL_FILTER_WINDOW, 2);
+    ThermalFilter_Pixel(image, 0, 10.0f);
+    ThermalFilter_EndFrame();
+    FilterTest_Expect("history dropped", (int)lrintf(image[0] * 100.0f), 1000);
+
+    /* Info wire format */
+    ThermalFilterInfo_t sample = { THERMAL_FILTER_EMA, 20, 0x1234, 14, true };
+    uint8_t bytes[THERMAL_FILTER_INFO_SIZE];
+    static const uint8_t expected[THERMAL_FILTER_INFO_SIZE] = { 0x01, 20, 0x12, 0x34, 0x00, 14, 1 };
+    FilterTest_Expect("info size", ThermalFilter_SerializeInfo(&sample, bytes), THERMAL_FILTER_INFO_SIZE);
+    FilterTest_Expect("info bytes", memcmp(bytes, expected, sizeof(expected)) == 0, 1);
+}
+
+static void FilterTest_CompareImage(const char* what, int frame)
+{
+    for (int i = 0; i < MLX90640_PIXEL_COUNT; i++) {
+        if (fabs(image[i] - reference[i]) > FILTER_TEST_TOLERANCE) {
+            if (failures++ < 10) {
+                printf("MISMATCH %s frame %d pixel %d: %.4f, expected %.4f\n",
+                       what, frame, i, image[i], reference[i]);
+            }
+        }
+    }
+}
+
+static void FilterTest_Expect(const char* what, int got, int expected)
+{
+    if (got != expected) {
+        if (failures++ < 10) {
+            printf("MISMATCH %s: %d, expected %d\n", what, got, expected);
+        }
+    }
+}
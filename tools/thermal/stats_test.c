@@ -0,0 +1,253 @@
+/**
+ * @file stats_test.c
+ * @brief Host test of the thermal statistics (thermal_stats.c)
+ *
+ * Checks the quickselect-based order statistics against a full sort:
+ * every percentile 0..100 of arrays of every shape that trips a
+ * selection (ties, constant, sorted, reversed, single element), and
+ * ThermalStats_Compute over random frames and ROIs. Percentiles select
+ * an element, so they must match the sorted reference exactly; mean,
+ * stddev and trimmed mean sum in a different order and may differ by one
+ * 0.1 °C count after truncation.
+ *
+ * Build and run (from the repository root; exits 1 on a mismatch):
+ *   gcc -O2 -Iinclude -Ilib/MLX90640_API -Itools/host tools/thermal/stats_test.c \
+ *       src/sensors/thermal_stats.c -lm -o stats_test && ./stats_test
+ */
+
+#include "sensors/thermal_stats.h"
+#include "sensors/mlx90640.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define STATS_TEST_FRAMES       300     /* Random frames, each with a random ROI */
+#define STATS_TEST_ARRAYS       400     /* Random arrays per shape for PercentileOf */
+
+/*============================================================================*/
+/* Types                                                                      */
+/*============================================================================*/
+
+typedef enum {
+    SHAPE_RANDOM = 0,
+    SHAPE_TIES,             /* Few distinct values */
+    SHAPE_CONSTANT,
+    SHAPE_SORTED,
+    SHAPE_REVERSED,
+    SHAPE_COUNT
+} StatsTest_Shape_t;
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static float frame[MLX90640_PIXEL_COUNT];
+static float values[MLX90640_PIXEL_COUNT];
+static float sorted[MLX90640_PIXEL_COUNT];
+static uint32_t rng_state = 56;
+static int failures = 0;
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static uint32_t StatsTest_Random(void);
+static float StatsTest_Value(StatsTest_Shape_t shape, uint16_t i, uint16_t count);
+static int StatsTest_Compare(const void* a, const void* b);
+static uint16_t StatsTest_Rank(uint16_t count, uint8_t percentile);
+static void StatsTest_PercentileOf(void);
+static void StatsTest_Compute(void);
+static void StatsTest_Expect(const char* what, int got, int expected, int slack);
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+int main(void)
+{
+    StatsTest_PercentileOf();
+    StatsTest_Compute();
+
+    printf("%s (%d failures)\n", failures ? "FAIL" : "PASS", failures);
+    return failures ? 1 : 0;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+static uint32_t StatsTest_Random(void)
+{
+    rng_state = rng_state * 1664525UL + 1013904223UL;
+    return rng_state >> 8;
+}
+
+/**
+ * @brief Value i of count for a shape, in a -20..120 °C range
+ */
+static float StatsTest_Value(StatsTest_Shape_t shape, uint16_t i, uint16_t count)
+{
+    switch (shape) {
+        case SHAPE_TIES:
+            return 20.0f + (float)(StatsTest_Random() % 4) * 0.5f;
+        case SHAPE_CONSTANT:
+            return 36.6f;
+        case SHAPE_SORTED:
+            return -20.0f + 140.0f * i / count;
+        case SHAPE_REVERSED:
+            return 120.0f - 140.0f * i / count;
+        default:
+            return -20.0f + (float)(StatsTest_Random() % 14000) * 0.01f;
+    }
+}
+
+static int StatsTest_Compare(const void* a, const void* b)
+{
+    float x = *(const float*)a;
+    float y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Nearest rank, written out independently of thermal_stats.c
+ */
+static uint16_t StatsTest_Rank(uint16_t count, uint8_t percentile)
+{
+    return (uint16_t)floor(percentile * (count - 1) / 100.0 + 0.5);
+}
+
+/**
+ * @brief Every percentile of every shape against the sorted array
+ */
+static void StatsTest_PercentileOf(void)
+{
+    for (int shape = 0; shape < SHAPE_COUNT; shape++) {
+        for (int run = 0; run < STATS_TEST_ARRAYS; run++) {
+            uint16_t count = (run < 4) ? (uint16_t)(run + 1) : (uint16_t)(1 + StatsTest_Random() % MLX90640_PIXEL_COUNT);
+
+            for (uint16_t i = 0; i < count; i++) {
+                sorted[i] = StatsTest_Value((StatsTest_Shape_t)shape, i, count);
+            }
+            memcpy(frame, sorted, count * sizeof(float));
+            qsort(sorted, count, sizeof(float), StatsTest_Compare);
+
+            for (int p = 0; p <= 100; p++) {
+                memcpy(values, frame, count * sizeof(float));
+                float got = ThermalStats_PercentileOf(values, count, (uint8_t)p);
+                float expected = sorted[StatsTest_Rank(count, (uint8_t)p)];
+                if (got != expected) {
+                    if (failures++ < 10) {
+                        printf("MISMATCH shape %d count %u P%d: %.3f, expected %.3f\n",
+                               shape, (unsigned)count, p, got, expected);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief ThermalStats_Compute over random frames and ROIs against a sorted copy
+ */
+static void StatsTest_Compute(void)
+{
+    for (int run = 0; run < STATS_TEST_FRAMES; run++) {
+        StatsTest_Shape_t shape = (StatsTest_Shape_t)(run % SHAPE_COUNT);
+        for (uint16_t i = 0; i < MLX90640_PIXEL_COUNT; i++) {
+            frame[i] = StatsTest_Value(shape, i, MLX90640_PIXEL_COUNT);
+        }
+
+        ThermalRoi_t roi;
+        if (run == 0) {
+            ThermalRoi_SetFull(&roi);
+        } else {
+            roi.x_min = (uint8_t)(StatsTest_Random() % MLX90640_COLS);
+            roi.y_min = (uint8_t)(StatsTest_Random() % MLX90640_ROWS);
+            roi.x_max = (uint8_t)(roi.x_min + StatsTest_Random() % (MLX90640_COLS - roi.x_min));
+            roi.y_max = (uint8_t)(roi.y_min + StatsTest_Random() % (MLX90640_ROWS - roi.y_min));
+        }
+
+        /* Reference */
+        uint16_t n = 0;
+        double sum = 0.0;
+        for (uint8_t y = roi.y_min; y <= roi.y_max; y++) {
+            for (uint8_t x = roi.x_min; x <= roi.x_max; x++) {
+                sorted[n] = frame[y * MLX90640_COLS + x];
+                sum += sorted[n++];
+            }
+        }
+        qsort(sorted, n, sizeof(float), StatsTest_Compare);
+
+        double mean = sum / n;
+        double var = 0.0;
+        for (uint16_t i = 0; i < n; i++) {
+            var += (sorted[i] - mean) * (sorted[i] - mean);
+        }
+        uint16_t k_low = StatsTest_Rank(n, THERMAL_STATS_P_LOW);
+        uint16_t k_med = StatsTest_Rank(n, 50);
+        uint16_t k_high = StatsTest_Rank(n, THERMAL_STATS_P_HIGH);
+        double trimmed = 0.0;
+        for (uint16_t i = k_low; i <= k_high; i++) {
+            trimmed += sorted[i];
+        }
+        trimmed /= (k_high - k_low + 1);
+
+        ThermalStats_t stats;
+        ThermalStats_Compute(frame, &roi, &stats);
+
+        char what[48];
+        snprintf(what, sizeof(what), "frame %d count", run);
+        StatsTest_Expect(what, stats.count, n, 0);
+        snprintf(what, sizeof(what), "frame %d min", run);
+        StatsTest_Expect(what, stats.min_temp, (int16_t)(sorted[0] * 10), 0);
+        snprintf(what, sizeof(what), "frame %d max", run);
+        StatsTest_Expect(what, stats.max_temp, (int16_t)(sorted[n - 1] * 10), 0);
+        snprintf(what, sizeof(what), "frame %d p_low", run);
+        StatsTest_Expect(what, stats.p_low, (int16_t)(sorted[k_low] * 10), 0);
+        snprintf(what, sizeof(what), "frame %d median", run);
+        StatsTest_Expect(what, stats.median, (int16_t)(sorted[k_med] * 10), 0);
+        snprintf(what, sizeof(what), "frame %d p_high", run);
+        StatsTest_Expect(what, stats.p_high, (int16_t)(sorted[k_high] * 10), 0);
+        snprintf(what, sizeof(what), "frame %d mean", run);
+        StatsTest_Expect(what, stats.mean, (int16_t)(mean * 10), 1);
+        snprintf(what, sizeof(what), "frame %d stddev", run);
+        StatsTest_Expect(what, stats.stddev, (int16_t)(sqrt(var / n) * 10), 1);
+        snprintf(what, sizeof(what), "frame %d trimmed mean", run);
+        StatsTest_Expect(what, stats.trimmed_mean, (int16_t)(trimmed * 10), 1);
+
+        uint32_t binned = 0;
+        for (uint8_t b = 0; b < THERMAL_HIST_BINS; b++) {
+            binned += stats.histogram[b];
+        }
+        snprintf(what, sizeof(what), "frame %d histogram total", run);
+        StatsTest_Expect(what, (int)binned, n, 0);
+
+        /* Single-percentile entry points agree with Compute */
+        snprintf(what, sizeof(what), "frame %d Percentile(50)", run);
+        StatsTest_Expect(what, (int16_t)(ThermalStats_Percentile(frame, &roi, 50) * 10), stats.median, 0);
+        snprintf(what, sizeof(what), "frame %d Percentile(100)", run);
+        StatsTest_Expect(what, (int16_t)(ThermalStats_Percentile(frame, &roi, 100) * 10), stats.max_temp, 0);
+        snprintf(what, sizeof(what), "frame %d TrimmedMean", run);
+        StatsTest_Expect(what, (int16_t)(ThermalStats_TrimmedMean(frame, &roi) * 10), stats.trimmed_mean, 1);
+    }
+
+    /* Out-of-frame ROI yields nothing */
+    ThermalRoi_t bad = { 4, 0, 3, 5 };
+    ThermalStats_t stats;
+    ThermalStats_Compute(frame, &bad, &stats);
+    StatsTest_Expect("inverted ROI count", stats.count, 0, 0);
+}
+
+static void StatsTest_Expect(const char* what, int got, int expected, int slack)
+{
+    if (abs(got - expected) > slack) {
+        if (failures++ < 10) {
+            printf("MISMATCH %s: %d, expected %d\n", what, got, expected);
+        }
+    }
+}
@@ -0,0 +1,310 @@
+/**
+ * @file zone_test.c
+ * @brief Host test of the multi-ROI zone evaluation (thermal_zone.c)
+ *
+ * Checks the single-pass evaluation against a per-zone reference that
+ * gathers each zone's pixels on its own, applies the vendor emissivity
+ * model in double precision and sorts: random frames with up to
+ * THERMAL_ZONE_MAX overlapping zones of every statistic. Uncorrected
+ * zones select or compare the same floats, so min, max and percentiles
+ * must match exactly; means and emissivity-corrected zones may differ by
+ * one 0.1 °C count after truncation. Also checks that ThermalZone_Set
+ * rejects invalid specs without touching the stored list.
+ *
+ * Build and run (from the repository root; exits 1 on a mismatch):
+ *   gcc -O2 -Iinclude -Ilib/MLX90640_API -Itools/host tools/thermal/zone_test.c \
+ *       src/sensors/thermal_zone.c src/sensors/thermal_stats.c -lm -o zone_test && ./zone_test
+ */
+
+#include "sensors/thermal_zone.h"
+#include "sensors/mlx90640.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define ZONE_TEST_FRAMES        300     /* Random frames, each with a random zone set */
+
+/*============================================================================*/
+/* Private Variables                                                          */
+/*============================================================================*/
+
+static float frame[MLX90640_PIXEL_COUNT];
+static double sorted[MLX90640_PIXEL_COUNT];
+static ThermalZone_t specs[THERMAL_ZONE_MAX];
+static uint32_t rng_state = 57;
+static int failures = 0;
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static uint32_t ZoneTest_Random(void);
+static void ZoneTest_Serialize(const ThermalZone_t* zone, uint8_t* buffer);
+static ThermalZone_t ZoneTest_RandomZone(uint16_t* value_budget);
+static int ZoneTest_Compare(const void* a, const void* b);
+static double ZoneTest_Reference(const ThermalZone_t* zone, float ta);
+static void ZoneTest_Evaluate(void);
+static void ZoneTest_Set(void);
+static void ZoneTest_Expect(const char* what, int got, int expected, int slack);
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+int main(void)
+{
+    ZoneTest_Evaluate();
+    ZoneTest_Set();
+
+    printf("%s (%d failures)\n", failures ? "FAIL" : "PASS", failures);
+    return failures ? 1 : 0;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+static uint32_t ZoneTest_Random(void)
+{
+    rng_state = rng_state * 1664525UL + 1013904223UL;
+    return rng_state >> 8;
+}
+
+/**
+ * @brief Wire format of one zone, written out independently of Zone_Parse
+ */
+static void ZoneTest_Serialize(const ThermalZone_t* zone, uint8_t* buffer)
+{
+    buffer[0] = zone->roi.x_min;
+    buffer[1] = zone->roi.y_min;
+    buffer[2] = zone->roi.x_max;
+    buffer[3] = zone->roi.y_max;
+    buffer[4] = zone->statistic;
+    buffer[5] = zone->percentile;
+    buffer[6] = (uint8_t)((uint16_t)zone->target_temp >> 8);
+    buffer[7] = (uint8_t)(zone->target_temp & 0xFF);
+    buffer[8] = (uint8_t)((uint16_t)zone->tolerance >> 8);
+    buffer[9] = (uint8_t)(zone->tolerance & 0xFF);
+    buffer[10] = zone->emissivity;
+}
+
+/**
+ * @brief Random valid zone; order-statistic zones are kept within the value budget
+ */
+static ThermalZone_t ZoneTest_RandomZone(uint16_t* value_budget)
+{
+    ThermalZone_t zone;
+
+    zone.roi.x_min = (uint8_t)(ZoneTest_Random() % MLX90640_COLS);
+    zone.roi.y_min = (uint8_t)(ZoneTest_Random() % MLX90640_ROWS);
+    zone.roi.x_max = (uint8_t)(zone.roi.x_min + ZoneTest_Random() % (MLX90640_COLS - zone.roi.x_min));
+    zone.roi.y_max = (uint8_t)(zone.roi.y_min + ZoneTest_Random() % (MLX90640_ROWS - zone.roi.y_min));
+    zone.statistic = (uint8_t)(MLX_STAT_MEAN + ZoneTest_Random() % (MLX_STAT_MIN - MLX_STAT_MEAN + 1));
+    zone.percentile = (uint8_t)(ZoneTest_Random() % 101);
+    zone.target_temp = (int16_t)(ZoneTest_Random() % 600);
+    zone.tolerance = (int16_t)(ZoneTest_Random() % 200);
+    zone.emissivity = (ZoneTest_Random() % 2) ? (uint8_t)(10 + ZoneTest_Random() % 91) : 0;
+
+    uint16_t area = (uint16_t)((zone.roi.x_max - zone.roi.x_min + 1) * (zone.roi.y_max - zone.roi.y_min + 1));
+    if (zone.statistic == MLX_STAT_PERCENTILE || zone.statistic == MLX_STAT_TRIMMED_MEAN) {
+        if (area > *value_budget) {
+            zone.statistic = MLX_STAT_MEAN;
+        } else {
+            *value_budget -= area;
+        }
+    }
+
+    return zone;
+}
+
+static int ZoneTest_Compare(const void* a, const void* b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Statistic of one zone, gathered on its own and sorted
+ */
+static double ZoneTest_Reference(const ThermalZone_t* zone, float ta)
+{
+    double ta_k = ta + 273.15;
+    double tr_k = ta - MLX90640_TR_OFFSET + 273.15;
+    double ta4 = pow(ta_k, 4);
+    double tr4 = pow(tr_k, 4);
+    double e0 = MLX90640_EMISSIVITY;
+    double e1 = zone->emissivity / 100.0;
+    uint16_t n = 0;
+    double sum = 0.0;
+
+    for (uint8_t y = zone->roi.y_min; y <= zone->roi.y_max; y++) {
+        for (uint8_t x = zone->roi.x_min; x <= zone->roi.x_max; x++) {
+            double v = frame[y * MLX90640_COLS + x];
+            if (zone->emissivity != 0) {
+                /* Recover the object's radiance from e0, re-emit it at e1 */
+                double object4 = (pow(v + 273.15, 4) - (tr4 - (tr4 - ta4) / e0)) / e1 * e0
+                               + (tr4 - (tr4 - ta4) / e1);
+                if (object4 > 0.0) {
+                    v = pow(object4, 0.25) - 273.15;
+                }
+            }
+            sorted[n++] = v;
+            sum += v;
+        }
+    }
+    qsort(sorted, n, sizeof(double), ZoneTest_Compare);
+
+    switch (zone->statistic) {
+        case MLX_STAT_PERCENTILE:
+            return sorted[(uint16_t)floor(zone->percentile * (n - 1) / 100.0 + 0.5)];
+
+        case MLX_STAT_TRIMMED_MEAN: {
+            uint16_t lo = (uint16_t)floor(THERMAL_STATS_P_LOW * (n - 1) / 100.0 + 0.5);
+            uint16_t hi = (uint16_t)floor(THERMAL_STATS_P_HIGH * (n - 1) / 100.0 + 0.5);
+            double trimmed = 0.0;
+            for (uint16_t i = lo; i <= hi; i++) {
+                trimmed += sorted[i];
+            }
+            return trimmed / (hi - lo + 1);
+        }
+
+        case MLX_STAT_MAX:
+            return sorted[n - 1];
+
+        case MLX_STAT_MIN:
+            return sorted[0];
+
+        case MLX_STAT_MEAN:
+        default:
+            return sum / n;
+    }
+}
+
+/**
+ * @brief Random zone sets over random frames against the per-zone reference
+ */
+static void ZoneTest_Evaluate(void)
+{
+    uint8_t buffer[THERMAL_ZONE_MAX * THERMAL_ZONE_SERIALIZED_SIZE];
+    ThermalZoneResult_t results[THERMAL_ZONE_MAX];
+
+    for (int run = 0; run < ZONE_TEST_FRAMES; run++) {
+        for (uint16_t i = 0; i < MLX90640_PIXEL_COUNT; i++) {
+            frame[i] = -20.0f + (float)(ZoneTest_Random() % 14000) * 0.01f;
+        }
+        float ta = 15.0f + (float)(ZoneTest_Random() % 2000) * 0.01f;
+
+        uint16_t value_budget = MLX90640_PIXEL_COUNT;
+        uint8_t count = (uint8_t)(1 + ZoneTest_Random() % THERMAL_ZONE_MAX);
+        for (uint8_t z = 0; z < count; z++) {
+            specs[z] = ZoneTest_RandomZone(&value_budget);
+            ZoneTest_Serialize(&specs[z], &buffer[z * THERMAL_ZONE_SERIALIZED_SIZE]);
+        }
+
+        /* Odd runs load the set in two appends */
+        bool stored;
+        uint8_t first = (run % 2) ? (uint8_t)((count + 1) / 2) : count;
+        stored = ThermalZone_Set(0, buffer, first);
+        if (stored && first < count) {
+            stored = ThermalZone_Set(first, &buffer[first * THERMAL_ZONE_SERIALIZED_SIZE], count - first);
+        }
+        ZoneTest_Expect("valid zone set stored", stored, 1, 0);
+        ZoneTest_Expect("zone count", ThermalZone_GetCount(), count, 0);
+
+        TestStatus_t overall = ThermalZone_Evaluate(frame, ta, results);
+
+        bool all_pass = true;
+        for (uint8_t z = 0; z < count; z++) {
+            double expected = ZoneTest_Reference(&specs[z], ta);
+            int16_t measured = (int16_t)((float)expected * 10);     /* Scaled in float, as on target */
+            int slack = (specs[z].emissivity != 0 || specs[z].statistic == MLX_STAT_MEAN
+                         || specs[z].statistic == MLX_STAT_TRIMMED_MEAN) ? 1 : 0;
+            char what[48];
+
+            snprintf(what, sizeof(what), "frame %d zone %u stat %u", run, z, specs[z].statistic);
+            ZoneTest_Expect(what, results[z].measured, measured, slack);
+
+            /* Verdict follows the reported value */
+            int diff = abs(results[z].measured - specs[z].target_temp);
+            snprintf(what, sizeof(what), "frame %d zone %u diff", run, z);
+            ZoneTest_Expect(what, results[z].diff, diff, 0);
+            snprintf(what, sizeof(what), "frame %d zone %u status", run, z);
+            ZoneTest_Expect(what, results[z].status,
+                            (diff > specs[z].tolerance) ? STATUS_FAIL_INVALID : STATUS_PASS, 0);
+            all_pass = all_pass && results[z].status == STATUS_PASS;
+        }
+        ZoneTest_Expect("overall status", overall, all_pass ? STATUS_PASS : STATUS_FAIL_INVALID, 0);
+    }
+
+    /* Result wire format */
+    ThermalZoneResult_t result = { STATUS_FAIL_INVALID, -123, 456 };
+    uint8_t bytes[THERMAL_ZONE_RESULT_SIZE];
+    ZoneTest_Expect("result size", ThermalZone_SerializeResult(&result, bytes), THERMAL_ZONE_RESULT_SIZE, 0);
+    ZoneTest_Expect("result status", bytes[0], STATUS_FAIL_INVALID, 0);
+    ZoneTest_Expect("result measured", (int16_t)((bytes[1] << 8) | bytes[2]), -123, 0);
+    ZoneTest_Expect("result diff", (int16_t)((bytes[3] << 8) | bytes[4]), 456, 0);
+}
+
+/**
+ * @brief Invalid specs are rejected and leave the stored list unchanged
+ */
+static void ZoneTest_Set(void)
+{
+    const ThermalZone_t good = { { 0, 0, 7, 7 }, MLX_STAT_PERCENTILE, 90, 250, 20, 0 };
+    const ThermalZone_t full = { { 0, 0, MLX90640_COLS - 1, MLX90640_ROWS - 1 }, MLX_STAT_TRIMMED_MEAN, 0, 250, 20, 0 };
+    uint8_t buffer[2 * THERMAL_ZONE_SERIALIZED_SIZE];
+
+    ZoneTest_Serialize(&good, buffer);
+    ThermalZone_Clear();
+    ZoneTest_Expect("store one", ThermalZone_Set(0, buffer, 1), 1, 0);
+
+    ThermalZone_t bad[] = { good, good, good, good, good, good, good };
+    bad[0].roi.x_min = 8;                   /* Inverted ROI */
+    bad[1].roi.y_max = MLX90640_ROWS;       /* Outside the frame */
+    bad[2].statistic = MLX_STAT_PIXEL;
+    bad[3].statistic = MLX_STAT_MIN + 1;
+    bad[4].percentile = 101;
+    bad[5].tolerance = -1;
+    bad[6].emissivity = 101;
+
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        char what[32];
+        ZoneTest_Serialize(&bad[i], &buffer[THERMAL_ZONE_SERIALIZED_SIZE]);
+        snprintf(what, sizeof(what), "bad zone %u rejected", (unsigned)i);
+        ZoneTest_Expect(what, ThermalZone_Set(1, &buffer[THERMAL_ZONE_SERIALIZED_SIZE], 1), 0, 0);
+        snprintf(what, sizeof(what), "bad zone %u in a pair rejected", (unsigned)i);
+        ZoneTest_Expect(what, ThermalZone_Set(0, buffer, 2), 0, 0);
+    }
+    ZoneTest_Expect("count kept after rejects", ThermalZone_GetCount(), 1, 0);
+
+    /* Append must continue the list, and the list is bounded */
+    ZoneTest_Expect("append gap rejected", ThermalZone_Set(2, buffer, 1), 0, 0);
+    ZoneTest_Expect("no zones rejected", ThermalZone_Set(0, buffer, 0), 0, 0);
+    for (uint8_t z = 1; z < THERMAL_ZONE_MAX; z++) {
+        ZoneTest_Serialize(&good, buffer);
+        ZoneTest_Expect("append within max", ThermalZone_Set(z, buffer, 1), 1, 0);
+    }
+    ZoneTest_Expect("append past max rejected", ThermalZone_Set(THERMAL_ZONE_MAX, buffer, 1), 0, 0);
+
+    /* Order-statistic zones cannot overflow the shared value buffer */
+    ZoneTest_Serialize(&full, buffer);
+    ZoneTest_Expect("full-frame order zone stored", ThermalZone_Set(0, buffer, 1), 1, 0);
+    ZoneTest_Serialize(&good, buffer);
+    ZoneTest_Expect("value budget exceeded", ThermalZone_Set(1, buffer, 1), 0, 0);
+    ZoneTest_Expect("count kept after budget reject", ThermalZone_GetCount(), 1, 0);
+}
+
+static void ZoneTest_Expect(const char* what, int got, int expected, int slack)
+{
+    if (abs(got - expected) > slack) {
+        if (failures++ < 10) {
+            printf("MISMATCH %s: %d, expected %d\n", what, got, expected);
+        }
+    }
+}
@@ -0,0 +1,112 @@
+/**
+ * @file classifier_ref.c
+ * @brief Host reference run of the thermal defect classifier
+ *
+ * Links the firmware's classifier and model sources against the plain-C
+ * CMSIS-NN kernels, so a frame classifies here exactly as on the target
+ * (integer kernels, same rounding). Use it to check an exported model on
+ * captured frames before flashing it.
+ *
+ * Build (from the repository root; the NN kernels are those platformio.ini lists):
+ *   NN=Drivers/CMSIS/NN/Source
+ *   gcc -O2 -DTHERMAL_CLASSIFIER_ENABLED=1 -Iinclude -IDrivers/CMSIS/Include \
+ *       -IDrivers/CMSIS/DSP/Include -IDrivers/CMSIS/NN/Include \
+ *       tools/thermal_classifier/classifier_ref.c \
+ *       src/sensors/thermal_classifier.c src/sensors/thermal_classifier_model.c \
+ *       $NN/ActivationFunctions/arm_relu_q7.c \
+ *       $NN/ConvolutionFunctions/arm_convolve_HWC_q7_basic_nonsquare.c \
+ *       $NN/ConvolutionFunctions/arm_nn_mat_mult_kernel_q7_q15.c \
+ *       $NN/FullyConnectedFunctions/arm_fully_connected_q7.c \
+ *       $NN/NNSupportFunctions/arm_q7_to_q15_no_shift.c \
+ *       $NN/NNSupportFunctions/arm_q7_to_q15_reordered_no_shift.c \
+ *       $NN/SoftmaxFunctions/arm_softmax_q7.c -lm -o classifier_ref
+ *
+ * Input: one frame per line, "Ta To[0] ... To[767]" in °C (row-major
+ * 32x24), separated by spaces or commas. Output: one line per frame with
+ * the class and confidence.
+ */
+
+#include "sensors/thermal_classifier.h"
+#include "sensors/thermal_classifier_model.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/*============================================================================*/
+/* Constants                                                                  */
+/*============================================================================*/
+
+#define REF_PIXELS      (TC_IN_W * TC_IN_H)
+
+static const char* const class_names[THERMAL_CLASS_COUNT] = {
+    "OK", "COLD_ZONE", "HOTSPOT", "DEAD_HEATER", "MISALIGNED"
+};
+
+/*============================================================================*/
+/* Private Function Prototypes                                                */
+/*============================================================================*/
+
+static int Ref_ReadValue(FILE* in, float* value);
+
+/*============================================================================*/
+/* Public Functions                                                           */
+/*============================================================================*/
+
+int main(int argc, char** argv)
+{
+    FILE* in = stdin;
+    static float frame[REF_PIXELS];
+    ThermalClassifierStats_t stats;
+    float ta;
+    int frames = 0;
+
+    if (argc > 1 && (in = fopen(argv[1], "r")) == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    ThermalClassifier_GetStats(&stats);
+    printf("# model version %u, %lu MACs, %lu B RAM, %lu B weights\n",
+           ThermalClassifier_Model.version, (unsigned long)stats.macs,
+           (unsigned long)stats.ram_bytes, (unsigned long)stats.flash_bytes);
+
+    while (Ref_ReadValue(in, &ta)) {
+        for (int i = 0; i < REF_PIXELS; i++) {
+            if (!Ref_ReadValue(in, &frame[i])) {
+                fprintf(stderr, "frame %d: truncated at pixel %d\n", frames, i);
+                return 1;
+            }
+        }
+
+        uint8_t confidence;
+        ThermalClass_t cls = ThermalClassifier_Classify(frame, ta, &confidence);
+        if (cls == THERMAL_CLASS_NONE) {
+            printf("%d NONE 0\n", frames);
+        } else {
+            printf("%d %s %u\n", frames, class_names[cls], confidence);
+        }
+        frames++;
+    }
+
+    if (in != stdin) fclose(in);
+    return 0;
+}
+
+/*============================================================================*/
+/* Private Functions                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Read the next number, skipping separators; 0 at end of input
+ */
+static int Ref_ReadValue(FILE* in, float* value)
+{
+    int c;
+
+    while ((c = fgetc(in)) != EOF && (c == ',' || c == ' ' || c == '\t' || c == '\r' || c == '\n')) {
+    }
+    if (c == EOF) {
+        return 0;
+    }
+    ungetc(c, in);
+    return fscanf(in, "%f", value) == 1;
+}
@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+"""
+Export a trained thermal defect classifier to src/sensors/thermal_classifier_model.c.
+
+The network is fixed by include/sensors/thermal_classifier_model.h
+(three 3x3/stride-2/pad-1 convolutions with ReLU, one dense layer, five
+classes). Train it in any framework on frames of (To - Ta) in °C, shaped
+24x32x1 (H, W, C), then dump the float weights to JSON:
+
+    {
+      "version": 1,
+      "input_frac": 1,
+      "layers": {
+        "conv1": {"kernel": [...], "bias": [...], "act_max": 12.5},
+        "conv2": {...},
+        "conv3": {...},
+        "fc":    {"kernel": [...], "bias": [...], "act_max": 9.0}
+      }
+    }
+
+Kernels use the Keras layout: [ky][kx][in][out] for convolutions and
+[in][out] for the dense layer (inputs flattened in H, W, C order, which is
+the CMSIS-NN HWC order). CMSIS-NN pads one pixel on every side, so train
+each convolution as ZeroPadding2D(1) + Conv2D(padding="valid", strides=2);
+Keras "same" padding pads only bottom/right at stride 2. act_max is the largest absolute layer output seen
+on the calibration frames (pre-softmax logits for fc). input_frac sets the
+input LSB to 2^-input_frac °C; inputs saturate at ±128 LSB.
+
+Quantisation is the CMSIS-NN q7 power-of-two scheme: every tensor gets
+7 - ceil(log2(max|x|)) fractional bits and the layer shifts follow from
+them. log2(e) is folded into the dense layer so the logits are base-2, as
+arm_softmax_q7 expects.
+
+Usage:
+    python3 tools/thermal_classifier/export_model.py model.json
+    python3 tools/thermal_classifier/export_model.py --placeholder
+"""
+
+import argparse
+import json
+import math
+import sys
+from pathlib import Path
+
+REPO = Path(__file__).resolve().parents[2]
+DEFAULT_OUT = REPO / "src" / "sensors" / "thermal_classifier_model.c"
+
+KERNEL = 3
+# name: (in_ch, out_ch) for convolutions, (in, out) for fc
+SHAPES = {
+    "conv1": (1, 8),
+    "conv2": (8, 16),
+    "conv3": (16, 16),
+    "fc": (4 * 3 * 16, 5),
+}
+LAYERS = ("conv1", "conv2", "conv3", "fc")
+
+
+def flatten(x):
+    """Flatten nested lists to a list of floats."""
+    if isinstance(x, (list, tuple)):
+        return [v for item in x for v in flatten(item)]
+    return [float(x)]
+
+
+def frac_bits(max_abs: float) -> int:
+    """Fractional bits that fit max_abs in q7."""
+    if max_abs <= 0.0:
+        return 7
+    return 7 - math.ceil(math.log2(max_abs))
+
+
+def quantise(values, frac: int):
+    """Round to q7 with the given fractional bits, saturating."""
+    scale = 2.0 ** frac
+    return [max(-128, min(127, math.floor(v * scale + 0.5))) for v in values]
+
+
+def reorder(name: str, kernel):
+    """Keras kernel layout to CMSIS-NN [out][ky][kx][in] / [out][in]."""
+    ch_in, ch_out = SHAPES[name]
+    flat = flatten(kernel)
+    if name == "fc":
+        if len(flat) != ch_in * ch_out:
+            raise ValueError(f"fc: expected {ch_in * ch_out} weights, got {len(flat)}")
+        return [flat[i * ch_out + o] for o in range(ch_out) for i in range(ch_in)]
+
+    count = KERNEL * KERNEL * ch_in * ch_out
+    if len(flat) != count:
+        raise ValueError(f"{name}: expected {count} weights, got {len(flat)}")
+    out = []
+    for o in range(ch_out):
+        for ky in range(KERNEL):
+            for kx in range(KERNEL):
+                for i in range(ch_in):
+                    out.append(flat[((ky * KERNEL + kx) * ch_in + i) * ch_out + o])
+    return out
+
+
+def quantise_model(model: dict):
+    """Quantise every layer; returns (layers, logit_frac)."""
+    in_frac = int(model.get("input_frac", 1))
+    layers = {}
+
+    for name in LAYERS:
+        spec = model["layers"][name]
+        weights = reorder(name, spec["kernel"])
+        bias = flatten(spec["bias"])
+        act_max = float(spec["act_max"])
+        if len(bias) != SHAPES[name][1]:
+            raise ValueError(f"{name}: expected {SHAPES[name][1]} biases, got {len(bias)}")
+
+        if name == "fc":
+            weights = [w * math.log2(math.e) for w in weights]
+            bias = [b * math.log2(math.e) for b in bias]
+            act_max *= math.log2(math.e)
+
+        w_frac = frac_bits(max(abs(w) for w in weights))
+        b_frac = min(frac_bits(max(abs(b) for b in bias)), in_frac + w_frac)
+        out_frac = min(frac_bits(act_max), in_frac + w_frac)
+
+        layers[name] = {
+            "weights": quantise(weights, w_frac),
+            "bias": quantise(bias, b_frac),
+            "bias_shift": in_frac + w_frac - b_frac,
+            "out_shift": in_frac + w_frac - out_frac,
+        }
+        print(f"{name}: in q.{in_frac} w q.{w_frac} b q.{b_frac} out q.{out_frac} "
+              f"(bias_shift {layers[name]['bias_shift']}, out_shift {layers[name]['out_shift']})")
+        in_frac = out_frac
+
+    return layers, in_frac
+
+
+def placeholder():
+    """All-zero layers for the untrained model (version 0)."""
+    layers = {}
+    for name in LAYERS:
+        ch_in, ch_out = SHAPES[name]
+        count = ch_in * ch_out * (1 if name == "fc" else KERNEL * KERNEL)
+        layers[name] = {"weights": [0] * count, "bias": [0] * ch_out, "bias_shift": 0, "out_shift": 0}
+    return layers
+
+
+def c_array(name: str, values) -> str:
+    """Format a static const int8_t array, 16 values per line."""
+    lines = []
+    for i in range(0, len(values), 16):
+        lines.append("    " + ", ".join(f"{v:4d}" for v in values[i:i + 16]) + ",")
+    return f"static const int8_t {name}[{len(values)}] = {{\n" + "\n".join(lines) + "\n};\n"
+
+
+def render(layers: dict, version: int, input_frac: int, logit_frac: int, source: str) -> str:
+    """Render the generated C source."""
+    out = [
+        "/**",
+        " * @file thermal_classifier_model.c",
+        " * @brief Thermal defect classifier weights (generated, do not edit)",
+        " *",
+        f" * Generated by tools/thermal_classifier/export_model.py from {source}.",
+    ]
+    if version == 0:
+        out.append(" * Untrained placeholder: the classifier reports no class until a")
+        out.append(" * trained model is exported over this file.")
+    out += [
+        " */",
+        "",
+        '#include "sensors/thermal_classifier_model.h"',
+        "",
+    ]
+    for name in LAYERS:
+        out.append(c_array(f"{name}_weights", layers[name]["weights"]))
+        out.append(c_array(f"{name}_bias", layers[name]["bias"]))
+
+    out.append("const ThermalClassifierModel_t ThermalClassifier_Model = {")
+    out.append(f"    .version    = {version},")
+    out.append(f"    .input_frac = {input_frac},")
+    out.append(f"    .logit_frac = {logit_frac},")
+    for name in LAYERS:
+        layer = layers[name]
+        out.append(f"    .{name:<5} = {{ {name}_weights, {name}_bias, "
+                   f"{layer['bias_shift']}, {layer['out_shift']} }},")
+    out.append("};")
+    return "\n".join(out) + "\n"
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("model", nargs="?", help="Float model JSON")
+    parser.add_argument("--placeholder", action="store_true", help="Write the untrained placeholder")
+    parser.add_argument("-o", "--output", type=Path, default=DEFAULT_OUT, help="Generated C file")
+    args = parser.parse_args()
+
+    if args.placeholder:
+        text = render(placeholder(), 0, 1, 0, "--placeholder")
+    elif args.model:
+        model = json.loads(Path(args.model).read_text())
+        version = int(model.get("version", 1))
+        if version == 0:
+            parser.error("version 0 is reserved for the placeholder")
+        layers, logit_frac = quantise_model(model)
+        text = render(layers, version, int(model.get("input_frac", 1)), logit_frac, Path(args.model).name)
+    else:
+        parser.error("give a model JSON or --placeholder")
+
+    args.output.write_text(text)
+    print(f"Wrote {args.output}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+"""
+Per-file compiler flags for vendor sources.
+
+The application builds with -Wall -Wextra. CMSIS-NN's support header
+compares q31_t with Q31_MIN (0x80000000L, unsigned long on ILP32), which
+raises -Wsign-compare in every NN source; the vendor code is kept as
+shipped, so that one warning is silenced for those files only.
+
+Registered as a PlatformIO pre script (extra_scripts = pre:tools/vendor_flags.py).
+"""
+
+Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+
+# (path fragment, extra CCFLAGS)
+VENDOR_FLAGS = (
+    ("Drivers/CMSIS/NN/Source/", ["-Wno-sign-compare"]),
+)
+
+
+def _vendor_flags(build_env, node):
+    path = node.srcnode().get_path().replace("\\", "/")
+    for fragment, flags in VENDOR_FLAGS:
+        if fragment in path:
+            return build_env.Object(node, CCFLAGS=build_env["CCFLAGS"] + flags)
+    return node
+
+
+env.AddBuildMiddleware(_vendor_flags)  # noqa: F821